@@ -17,6 +17,44 @@
  */
 PetscErrorCode DMPlexReconstructGradients_Internal(DM dm, PetscFV fvm, PetscInt fStart, PetscInt fEnd, Vec faceGeometry, Vec cellGeometry, Vec locX, Vec grad);
 
+PetscLogEvent ABLATE_FV_Gradient;
+PetscLogEvent ABLATE_FV_FaceGather;
+PetscLogEvent ABLATE_FV_Flux;
+PetscLogEvent ABLATE_FV_Scatter;
+PetscLogEvent ABLATE_FV_PointSource;
+PetscLogEvent ABLATE_FV_AuxUpdate;
+
+/* the bytes of the residual work arrays for the current face chunk, and the maximum over every residual.  The dm keeps its work arrays, so the maximum stays allocated */
+static PetscLogDouble ABLATE_FV_WorkArrayBytes = 0.0;
+static PetscLogDouble ABLATE_FV_WorkArrayMaximumBytes = 0.0;
+
+PetscErrorCode ABLATE_FVSupportGetWorkArrayMaximumBytes(PetscLogDouble *bytes)
+{
+    PetscFunctionBegin;
+    PetscValidPointer(bytes, 1);
+    *bytes = ABLATE_FV_WorkArrayMaximumBytes;
+    PetscFunctionReturn(0);
+}
+
+PetscErrorCode ABLATE_FVSupportRegisterLogEvents(void)
+{
+    static PetscBool registered = PETSC_FALSE;
+    PetscClassId     classId;
+    PetscErrorCode   ierr;
+
+    PetscFunctionBegin;
+    if (registered) PetscFunctionReturn(0);
+    registered = PETSC_TRUE;
+    ierr = PetscClassIdRegister("ABLATE FV", &classId);CHKERRQ(ierr);
+    ierr = PetscLogEventRegister("FVGradient", classId, &ABLATE_FV_Gradient);CHKERRQ(ierr);
+    ierr = PetscLogEventRegister("FVFaceGather", classId, &ABLATE_FV_FaceGather);CHKERRQ(ierr);
+    ierr = PetscLogEventRegister("FVFlux", classId, &ABLATE_FV_Flux);CHKERRQ(ierr);
+    ierr = PetscLogEventRegister("FVScatter", classId, &ABLATE_FV_Scatter);CHKERRQ(ierr);
+    ierr = PetscLogEventRegister("FVPointSource", classId, &ABLATE_FV_PointSource);CHKERRQ(ierr);
+    ierr = PetscLogEventRegister("FVAuxUpdate", classId, &ABLATE_FV_AuxUpdate);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+}
+
 /*@
   DMPlexReconstructGradientsFVM - reconstruct the gradient of a vector using a finite volume method for a specific field
 
@@ -134,6 +172,7 @@ PetscErrorCode ABLATE_DMPlexComputeRHSFunctionFVM(FVMRHSFluxFunctionDescription
     PetscErrorCode ierr;
 
     PetscFunctionBegin;
+    ierr = ABLATE_FVSupportRegisterLogEvents();CHKERRQ(ierr);
     ierr = DMConvert(dm,DMPLEX, &plex);CHKERRQ(ierr);
     ierr = DMPlexGetDepth(plex, &depth);CHKERRQ(ierr);
     ierr = DMGetStratumIS(plex, "dim", depth, &cellIS);CHKERRQ(ierr);
@@ -190,6 +229,7 @@ static PetscErrorCode ABLATE_DMPlexGetFaceFields(DM dm, PetscInt fStart, PetscIn
     const PetscScalar *facegeom, *cellgeom, *x, **lgrads;
     PetscBool         *isFE;
     PetscInt           dim, Nf, f, Nc, numFaces = fEnd - fStart, iface, face;
+    PetscLogDouble     flops = 0.0;
     PetscErrorCode     ierr;
 
     PetscFunctionBegin;
@@ -223,6 +263,7 @@ static PetscErrorCode ABLATE_DMPlexGetFaceFields(DM dm, PetscInt fStart, PetscIn
     ierr = VecGetArrayRead(cellGeometry, &cellgeom);CHKERRQ(ierr);
     ierr = DMGetWorkArray(dm, numFaces*Nc, MPIU_SCALAR, uL);CHKERRQ(ierr);
     ierr = DMGetWorkArray(dm, numFaces*Nc, MPIU_SCALAR, uR);CHKERRQ(ierr);
+    ABLATE_FV_WorkArrayBytes += 2.0*numFaces*Nc*sizeof(PetscScalar);
 
     if (locGrads) {
         ierr = PetscCalloc1(Nf, &lgrads);CHKERRQ(ierr);
@@ -236,6 +277,7 @@ static PetscErrorCode ABLATE_DMPlexGetFaceFields(DM dm, PetscInt fStart, PetscIn
         // size up the work arrays
         ierr = DMGetWorkArray(dm, dim*numFaces*Nc, MPIU_SCALAR, gradL);CHKERRQ(ierr);
         ierr = DMGetWorkArray(dm, dim*numFaces*Nc, MPIU_SCALAR, gradR);CHKERRQ(ierr);
+        ABLATE_FV_WorkArrayBytes += 2.0*dim*numFaces*Nc*sizeof(PetscScalar);
     }else{
         *gradL = NULL;
         *gradR = NULL;
@@ -282,6 +324,7 @@ static PetscErrorCode ABLATE_DMPlexGetFaceFields(DM dm, PetscInt fStart, PetscIn
                 ierr = DMPlexPointLocalRead(dmGrads[f], cells[1], lgrads[f], &gR);CHKERRQ(ierr);
                 DMPlex_WaxpyD_Internal(dim, -1, cgL->centroid, fg->centroid, dxL);
                 DMPlex_WaxpyD_Internal(dim, -1, cgR->centroid, fg->centroid, dxR);
+                flops += 4*dim + numComp*(4*dim + 2);
                 // Project the cell centered value onto the face
                 for (c = 0; c < numComp; ++c) {
                     uLl[iface * Nc + offsets[f] + c] = xL[c] + DMPlex_DotD_Internal(dim, &gL[c * dim], dxL);
@@ -325,6 +368,7 @@ static PetscErrorCode ABLATE_DMPlexGetFaceFields(DM dm, PetscInt fStart, PetscIn
         ++iface;
     }
     *Nface = iface;
+    ierr = PetscLogFlops(flops);CHKERRQ(ierr);
     ierr = VecRestoreArrayRead(locX, &x);CHKERRQ(ierr);
     ierr = VecRestoreArrayRead(faceGeometry, &facegeom);CHKERRQ(ierr);
     ierr = VecRestoreArrayRead(cellGeometry, &cellgeom);CHKERRQ(ierr);
@@ -645,6 +689,7 @@ PetscErrorCode ABLATE_DMPlexComputeFluxResidual_Internal(FVMRHSFluxFunctionDescr
     PetscErrorCode   ierr;
 
     PetscFunctionBeginUser;
+    ierr = ABLATE_FVSupportRegisterLogEvents();CHKERRQ(ierr);
     /* FEM+FVM */
     ierr = ISGetPointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
     ierr = DMPlexGetHeightStratum(dm, 1, &fStart, &fEnd);CHKERRQ(ierr);
@@ -677,6 +722,7 @@ PetscErrorCode ABLATE_DMPlexComputeFluxResidual_Internal(FVMRHSFluxFunctionDescr
     ierr = PetscCalloc1(nf, &locGrads);CHKERRQ(ierr);
 
     /* Reconstruct and limit cell gradients */
+    ierr = PetscLogEventBegin(ABLATE_FV_Gradient, dm, 0, 0, 0);CHKERRQ(ierr);
     // for each field compute the gradient in the localGrads vector
     for (PetscInt f = 0; f < nf; f++){
         PetscFV fvm;
@@ -735,6 +781,7 @@ PetscErrorCode ABLATE_DMPlexComputeFluxResidual_Internal(FVMRHSFluxFunctionDescr
             ierr = DMRestoreGlobalVector(dmAuxGrads[f], &grad);CHKERRQ(ierr);
         }
     }
+    ierr = PetscLogEventEnd(ABLATE_FV_Gradient, dm, 0, 0, 0);CHKERRQ(ierr);
 
 
     /* Loop over chunks */
@@ -756,12 +803,17 @@ PetscErrorCode ABLATE_DMPlexComputeFluxResidual_Internal(FVMRHSFluxFunctionDescr
         ierr = DMGetWorkArray(dm, numFaces*totDim, MPIU_SCALAR, &fluxR);CHKERRQ(ierr);
         ierr = PetscArrayzero(fluxL, numFaces*totDim);CHKERRQ(ierr);
         ierr = PetscArrayzero(fluxR, numFaces*totDim);CHKERRQ(ierr);
+        ABLATE_FV_WorkArrayBytes = 2.0*numFaces*totDim*sizeof(PetscScalar);
 
         // extract all of the field locations
+        ierr = PetscLogEventBegin(ABLATE_FV_FaceGather, dm, 0, 0, 0);CHKERRQ(ierr);
         ierr = ABLATE_DMPlexGetFaceFields(dm, fS, fE, locX, faceGeometryFVM, cellGeometryFVM, locGrads, &numFaces, &uL, &uR, &gradL, &gradR, PETSC_TRUE);CHKERRQ(ierr);
         ierr = ABLATE_DMPlexGetFaceFields(dmAux, fS, fE, locA, faceGeometryFVM, cellGeometryFVM, locAuxGrads, &numFaces, &auxL, &auxR, &gradAuxL, &gradAuxR, PETSC_FALSE);CHKERRQ(ierr);// NOTE: aux fields are not projected
+        ierr = PetscLogEventEnd(ABLATE_FV_FaceGather, dm, 0, 0, 0);CHKERRQ(ierr);
+        ABLATE_FV_WorkArrayMaximumBytes = PetscMax(ABLATE_FV_WorkArrayMaximumBytes, ABLATE_FV_WorkArrayBytes);
 
         /* Loop over each rhs function */
+        ierr = PetscLogEventBegin(ABLATE_FV_Flux, dm, 0, 0, 0);CHKERRQ(ierr);
         for (PetscInt d = 0; d < numberFunctionDescriptions; ++d) {
             PetscObject  obj;
             PetscClassId id;
@@ -779,14 +831,18 @@ PetscErrorCode ABLATE_DMPlexComputeFluxResidual_Internal(FVMRHSFluxFunctionDescr
             Ne = numFaces;
             /* Riemann solve over faces (need fields at face centroids) */
             /*   We need to evaluate FE fields at those coordinates */
+            if (functionDescriptions[d].logEvent >= 0) {ierr = PetscLogEventBegin(functionDescriptions[d].logEvent, dm, 0, 0, 0);CHKERRQ(ierr);}
             ierr = ABLATE_PetscFVIntegrateRHSFunction(&functionDescriptions[d], fv, ds,dsAux, Ne, fgeom, vol, uL, uR, gradL, gradR, auxL, auxR, gradAuxL, gradAuxR, fluxL, fluxR);CHKERRQ(ierr);
+            if (functionDescriptions[d].logEvent >= 0) {ierr = PetscLogEventEnd(functionDescriptions[d].logEvent, dm, 0, 0, 0);CHKERRQ(ierr);}
         }
+        ierr = PetscLogEventEnd(ABLATE_FV_Flux, dm, 0, 0, 0);CHKERRQ(ierr);
 
         /* Loop over domain and add each face flux back to the cell center*/
         {
             PetscScalar *fa;
             PetscInt     iface;
 
+            ierr = PetscLogEventBegin(ABLATE_FV_Scatter, dm, 0, 0, 0);CHKERRQ(ierr);
             ierr = VecGetArray(locF, &fa);CHKERRQ(ierr);
             for (PetscInt f = 0; f < nf; ++f) {
                 PetscFV      fv;
@@ -821,8 +877,10 @@ PetscErrorCode ABLATE_DMPlexComputeFluxResidual_Internal(FVMRHSFluxFunctionDescr
                     }
                     ++iface;
                 }
+                ierr = PetscLogFlops(2.0*pdim*iface);CHKERRQ(ierr);
             }
             ierr = VecRestoreArray(locF, &fa);CHKERRQ(ierr);
+            ierr = PetscLogEventEnd(ABLATE_FV_Scatter, dm, 0, 0, 0);CHKERRQ(ierr);
         }
 
         /* Handle time derivative */
@@ -904,6 +962,8 @@ PetscErrorCode ABLATE_DMPlexComputeFluxResidual_Internal(FVMRHSFluxFunctionDescr
 PetscErrorCode FVFlowUpdateAuxFieldsFV(DM dm, DM auxDM, PetscReal time, Vec locXVec, Vec locAuxField, PetscInt numberUpdateFunctions, FVAuxFieldUpdateFunction* updateFunctions, void** data) {
     PetscFunctionBeginUser;
     PetscErrorCode ierr;
+    ierr = ABLATE_FVSupportRegisterLogEvents();CHKERRQ(ierr);
+    ierr = PetscLogEventBegin(ABLATE_FV_AuxUpdate, dm, 0, 0, 0);CHKERRQ(ierr);
 
     // Extract the cell geometry, and the dm that holds the information
     Vec cellGeomVec;
@@ -953,6 +1013,7 @@ PetscErrorCode FVFlowUpdateAuxFieldsFV(DM dm, DM auxDM, PetscReal time, Vec locX
     ierr = VecRestoreArrayRead(cellGeomVec, &cellGeomArray);CHKERRQ(ierr);
     ierr = VecRestoreArrayRead(locXVec, &locFlowFieldArray);CHKERRQ(ierr);
     ierr = VecRestoreArray(locAuxField, &localAuxFlowFieldArray);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(ABLATE_FV_AuxUpdate, dm, 0, 0, 0);CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }
@@ -960,6 +1021,8 @@ PetscErrorCode FVFlowUpdateAuxFieldsFV(DM dm, DM auxDM, PetscReal time, Vec locX
 PetscErrorCode ABLATE_DMPlexComputePointResidual_Internal(FVMRHSPointFunctionDescription *functionDescriptions, PetscInt numberFunctionDescription, DM dm, IS cellIS, PetscReal time, Vec locX, Vec locX_t, PetscReal t, Vec locF) {
     PetscFunctionBeginUser;
     PetscErrorCode ierr;
+    ierr = ABLATE_FVSupportRegisterLogEvents();CHKERRQ(ierr);
+    ierr = PetscLogEventBegin(ABLATE_FV_PointSource, dm, 0, 0, 0);CHKERRQ(ierr);
 
     /* FEM+FVM */
     PetscInt         cStart, cEnd;
@@ -1100,6 +1163,7 @@ PetscErrorCode ABLATE_DMPlexComputePointResidual_Internal(FVMRHSPointFunctionDes
     ierr = VecRestoreArrayRead(locA, &locAArray);CHKERRQ(ierr);
     ierr = VecRestoreArrayRead(cellGeometryVec, &cellGeometryArray);CHKERRQ(ierr);
     ierr = ISRestorePointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(ABLATE_FV_PointSource, dm, 0, 0, 0);CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }
\ No newline at end of file
@@ -26,6 +26,9 @@ struct _FVMRHSFluxFunctionDescription {
 
     PetscInt auxFields[MAX_FVM_RHS_FUNCTION_FIELDS];
     PetscInt numberAuxFields;
+
+    // the log event used to profile this function (or -1 to skip)
+    PetscLogEvent logEvent;
 };
 
 typedef struct _FVMRHSFluxFunctionDescription FVMRHSFluxFunctionDescription;
@@ -49,6 +52,29 @@ struct _FVMRHSPointFunctionDescription {
 
 typedef struct _FVMRHSPointFunctionDescription FVMRHSPointFunctionDescription;
 
+/**
+ * The log events for each phase of the finite volume residual.  These are valid after ABLATE_FVSupportRegisterLogEvents is called.
+ */
+PETSC_EXTERN PetscLogEvent ABLATE_FV_Gradient;
+PETSC_EXTERN PetscLogEvent ABLATE_FV_FaceGather;
+PETSC_EXTERN PetscLogEvent ABLATE_FV_Flux;
+PETSC_EXTERN PetscLogEvent ABLATE_FV_Scatter;
+PETSC_EXTERN PetscLogEvent ABLATE_FV_PointSource;
+PETSC_EXTERN PetscLogEvent ABLATE_FV_AuxUpdate;
+
+/**
+ * Registers the finite volume log events (only the first call registers the events)
+ * @return
+ */
+PETSC_EXTERN PetscErrorCode ABLATE_FVSupportRegisterLogEvents(void);
+
+/**
+ * Returns the maximum bytes of the face work arrays (values, gradients, and fluxes) used by any flux residual on this rank
+ * @param bytes
+ * @return
+ */
+PETSC_EXTERN PetscErrorCode ABLATE_FVSupportGetWorkArrayMaximumBytes(PetscLogDouble *bytes);
+
 /**
   DMPlexTSComputeRHSFunctionFVM - Form the local forcing F from the local input X using flux and pointfunctions specified by the user
 
@@ -1,5 +1,6 @@
 #include "builder.hpp"
 #include "flow/flow.hpp"
+#include "monitors/checkpointMonitor.hpp"
 #include "monitors/monitor.hpp"
 #include "particles/particles.hpp"
 #include "solve/timeStepper.hpp"
@@ -18,11 +19,19 @@ void ablate::Builder::Run(std::shared_ptr<ablate::parser::Factory> parser) {
     auto flow = parser->GetByName<flow::Flow>("flow");
     flow->SetupSolve(timeStepper->GetTS());
 
+    // the flow, every particle group, and any monitors with state (e.g. statistics) are checkpointed and restarted together
+    std::vector<std::shared_ptr<monitors::Monitorable>> checkpointObjects = {flow};
+
     // get the monitors from the flow factory
     auto flowMonitors = parser->GetFactory("flow")->GetByName<std::vector<monitors::Monitor>>("monitors", std::vector<std::shared_ptr<monitors::Monitor>>());
     for (auto flowMonitor : flowMonitors) {
         flowMonitor->Register(flow);
         timeStepper->AddMonitor(flowMonitor);
+
+        auto monitorable = std::dynamic_pointer_cast<monitors::Monitorable>(flowMonitor);
+        if (monitorable && std::dynamic_pointer_cast<monitors::Checkpointable>(flowMonitor)) {
+            checkpointObjects.push_back(monitorable);
+        }
     }
 
     // get any particles that may be in the flow
@@ -34,6 +43,7 @@ void ablate::Builder::Run(std::shared_ptr<ablate::parser::Factory> parser) {
         for (std::size_t particleIndex = 0; particleIndex < particleList.size(); particleIndex++) {
             auto particle = particleList[particleIndex];
             particle->InitializeFlow(flow);
+            checkpointObjects.push_back(particle);
 
             // Get any particle monitors
             auto particleMonitors = particleFactorySequence[particleIndex]->GetByName<std::vector<monitors::Monitor>>("monitors", std::vector<std::shared_ptr<monitors::Monitor>>());
@@ -44,6 +54,22 @@ void ablate::Builder::Run(std::shared_ptr<ablate::parser::Factory> parser) {
         }
     }
 
+    // optionally write checkpoints
+    auto checkpointMonitor = parser->Get(parser::ArgumentIdentifier<monitors::CheckpointMonitor>{.inputName = "checkpoint", .optional = true});
+    if (checkpointMonitor) {
+        for (auto& object : checkpointObjects) {
+            checkpointMonitor->Register(object);
+        }
+        timeStepper->AddMonitor(checkpointMonitor);
+    }
+
+    // replace the initial state with a checkpoint
+    auto restartFile = parser->Get(parser::ArgumentIdentifier<std::filesystem::path>{.inputName = "restart", .optional = true});
+    if (!restartFile.empty()) {
+        auto state = monitors::CheckpointMonitor::Restore(restartFile, checkpointObjects);
+        timeStepper->Restart(state.time, state.steps, state.dt);
+    }
+
     // run
     timeStepper->Solve(flow);
 }
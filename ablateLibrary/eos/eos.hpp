@@ -14,6 +14,12 @@ using DecodeStateFunction = PetscErrorCode (*)(PetscInt dim, PetscReal density,
                                                PetscReal* p, void* ctx);
 using ComputeTemperatureFunction = PetscErrorCode (*)(PetscInt dim, PetscReal density, PetscReal totalEnergy, const PetscReal* massFlux, const PetscReal densityYi[], PetscReal* T, void* ctx);
 
+/**
+ * Computes the temperature and returns the number of iterations used by an iterative eos
+ */
+using ComputeTemperatureIterationsFunction = PetscErrorCode (*)(PetscInt dim, PetscReal density, PetscReal totalEnergy, const PetscReal* massFlux, const PetscReal densityYi[], PetscReal* T,
+                                                                PetscInt* iterations, void* ctx);
+
 /**
  * The EOS is a combination of species model and EOS.  This allows the eos to dictate the order/number of species.  This can be relaxed in the future
  */
@@ -34,6 +40,12 @@ class EOS {
     virtual ComputeTemperatureFunction GetComputeTemperatureFunction() = 0;
     virtual void* GetComputeTemperatureContext() = 0;
 
+    /**
+     * The temperature function that also returns its iterations, this is null when the temperature is computed directly.  The context is the
+     * GetComputeTemperatureContext.
+     */
+    virtual ComputeTemperatureIterationsFunction GetComputeTemperatureIterationsFunction() { return nullptr; }
+
     // species model functions
     virtual const std::vector<std::string>& GetSpecies() const = 0;
 
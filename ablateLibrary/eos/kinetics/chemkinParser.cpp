@@ -0,0 +1,489 @@
+#include "chemkinParser.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include "eos/tChem.hpp"
+
+namespace {
+// the universal gas constant in the units used for the activation energy
+constexpr double calPerMoleK = 1.98720425864083;
+constexpr double joulePerMoleK = 8.31446261815324;
+
+std::string Trim(const std::string& value) {
+    auto start = value.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) {
+        return "";
+    }
+    auto end = value.find_last_not_of(" \t\r\n");
+    return value.substr(start, end - start + 1);
+}
+
+std::string ToUpper(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::toupper(c); });
+    return value;
+}
+
+std::string StripComment(const std::string& line) { return line.substr(0, line.find('!')); }
+
+std::vector<std::string> Tokenize(const std::string& line) {
+    std::istringstream stream(line);
+    std::vector<std::string> tokens;
+    std::string token;
+    while (stream >> token) {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+std::vector<std::string> Split(const std::string& line, char delimiter) {
+    std::vector<std::string> tokens;
+    std::size_t start = 0;
+    std::size_t end;
+    while ((end = line.find(delimiter, start)) != std::string::npos) {
+        tokens.push_back(line.substr(start, end - start));
+        start = end + 1;
+    }
+    tokens.push_back(line.substr(start));
+    return tokens;
+}
+
+bool StartsWithKeyword(const std::string& line, const std::string& keyword) { return ToUpper(line).rfind(keyword, 0) == 0; }
+
+/**
+ * Reads a fixed width field from a thermo line, returning the default if the field is blank
+ */
+double ReadFixedWidth(const std::string& line, std::size_t start, std::size_t width, double defaultValue = 0.0) {
+    if (start >= line.size()) {
+        return defaultValue;
+    }
+    auto field = Trim(line.substr(start, width));
+    return field.empty() ? defaultValue : std::stod(field);
+}
+
+/**
+ * Reads the atomic weight for each element from the periodic table used by TChem
+ */
+std::map<std::string, double> ReadAtomicWeights() {
+    std::map<std::string, double> atomicWeights;
+    std::istringstream stream(ablate::eos::TChem::periodicTable);
+    int numberElements, numberColumns;
+    stream >> numberElements >> numberColumns;
+    for (int start = 0; start < numberElements; start += numberColumns) {
+        const int count = std::min(numberColumns, numberElements - start);
+        std::vector<std::string> names(count);
+        for (auto& name : names) {
+            stream >> name;
+        }
+        for (auto& name : names) {
+            stream >> atomicWeights[name];
+        }
+    }
+    return atomicWeights;
+}
+
+/**
+ * Adds the species/coefficient to the stoichiometry, combining repeated species
+ */
+void AddStoichiometry(std::vector<std::pair<int, double>>& side, int species, double coefficient) {
+    for (auto& term : side) {
+        if (term.first == species) {
+            term.second += coefficient;
+            return;
+        }
+    }
+    side.emplace_back(species, coefficient);
+}
+}  // namespace
+
+std::shared_ptr<ablate::eos::kinetics::Mechanism> ablate::eos::kinetics::ChemkinParser::Parse(const std::filesystem::path& mechFile, const std::filesystem::path& thermoFile) {
+    std::ifstream mechStream(mechFile);
+    if (!mechStream.is_open()) {
+        throw std::invalid_argument("Unable to open the mechanism file " + mechFile.string());
+    }
+    std::ifstream thermoStream(thermoFile);
+    if (!thermoStream.is_open()) {
+        throw std::invalid_argument("Unable to open the thermo file " + thermoFile.string());
+    }
+    return Parse(mechStream, thermoStream);
+}
+
+std::shared_ptr<ablate::eos::kinetics::Mechanism> ablate::eos::kinetics::ChemkinParser::Parse(std::istream& mechStream, std::istream& thermoStream) {
+    auto mechanism = std::make_shared<Mechanism>();
+    mechanism->reactantOffsets.push_back(0);
+    mechanism->productOffsets.push_back(0);
+    mechanism->efficiencyOffsets.push_back(0);
+
+    // the thermo data can be specified in the mech or thermo file
+    std::map<std::string, ThermoData> thermo;
+    std::stringstream mechThermo;
+
+    enum class Section { None, Elements, Species, Reactions, Thermo };
+    Section section = Section::None;
+    double activationEnergyScale = 1.0 / calPerMoleK;
+
+    std::string line;
+    while (std::getline(mechStream, line)) {
+        auto content = Trim(StripComment(line));
+        if (content.empty()) {
+            continue;
+        }
+
+        // check for the start of a new section
+        if (section == Section::None) {
+            auto tokens = Tokenize(content);
+            auto keyword = ToUpper(tokens.front());
+            if (StartsWithKeyword(keyword, "ELEM")) {
+                section = Section::Elements;
+                tokens.erase(tokens.begin());
+                content = "";
+                for (const auto& token : tokens) {
+                    content += token + " ";
+                }
+            } else if (StartsWithKeyword(keyword, "SPEC")) {
+                section = Section::Species;
+                tokens.erase(tokens.begin());
+                content = "";
+                for (const auto& token : tokens) {
+                    content += token + " ";
+                }
+            } else if (StartsWithKeyword(keyword, "THER")) {
+                section = Section::Thermo;
+                mechThermo << line << std::endl;
+                continue;
+            } else if (StartsWithKeyword(keyword, "REAC")) {
+                section = Section::Reactions;
+                for (std::size_t t = 1; t < tokens.size(); t++) {
+                    auto unit = ToUpper(tokens[t]);
+                    if (unit == "CAL/MOLE") {
+                        activationEnergyScale = 1.0 / calPerMoleK;
+                    } else if (unit == "KCAL/MOLE") {
+                        activationEnergyScale = 1000.0 / calPerMoleK;
+                    } else if (unit == "JOULES/MOLE") {
+                        activationEnergyScale = 1.0 / joulePerMoleK;
+                    } else if (unit == "KJOULES/MOLE") {
+                        activationEnergyScale = 1000.0 / joulePerMoleK;
+                    } else if (unit == "KELVINS") {
+                        activationEnergyScale = 1.0;
+                    } else if (unit != "MOLES") {
+                        throw std::invalid_argument("Unsupported reaction units " + tokens[t]);
+                    }
+                }
+                continue;
+            } else {
+                throw std::invalid_argument("Unknown CHEMKIN section " + tokens.front());
+            }
+        }
+
+        switch (section) {
+            case Section::Elements:
+            case Section::Species:
+                for (const auto& token : Tokenize(content)) {
+                    if (ToUpper(token) == "END") {
+                        section = Section::None;
+                        break;
+                    }
+                    if (section == Section::Elements) {
+                        // elements may include an atomic weight, i.e. D/2.014/, which is not used
+                        mechanism->elements.push_back(ToUpper(Trim(Split(token, '/').front())));
+                    } else {
+                        mechanism->species.push_back(token);
+                    }
+                }
+                break;
+            case Section::Thermo:
+                mechThermo << line << std::endl;
+                if (ToUpper(content) == "END") {
+                    section = Section::None;
+                }
+                break;
+            case Section::Reactions:
+                if (ToUpper(content) == "END") {
+                    section = Section::None;
+                } else if (content.find('=') != std::string::npos) {
+                    ParseReaction(*mechanism, content, activationEnergyScale);
+                } else {
+                    ParseAuxiliaryLine(*mechanism, content, activationEnergyScale);
+                }
+                break;
+            case Section::None:
+                break;
+        }
+    }
+
+    // Load the thermo data, with the mech file taking precedence
+    ParseThermo(mechThermo, thermo);
+    ParseThermo(thermoStream, thermo);
+
+    // Copy over the thermo data for each species
+    const auto atomicWeights = ReadAtomicWeights();
+    for (const auto& species : mechanism->species) {
+        auto thermoData = thermo.find(species);
+        if (thermoData == thermo.end()) {
+            throw std::invalid_argument("Unable to locate thermo data for species " + species);
+        }
+        mechanism->thermoMidTemperature.push_back(thermoData->second.midTemperature);
+        mechanism->thermoLowCoefficients.insert(mechanism->thermoLowCoefficients.end(), thermoData->second.lowCoefficients, thermoData->second.lowCoefficients + 7);
+        mechanism->thermoHighCoefficients.insert(mechanism->thermoHighCoefficients.end(), thermoData->second.highCoefficients, thermoData->second.highCoefficients + 7);
+
+        double molecularWeight = 0.0;
+        for (const auto& [element, count] : thermoData->second.composition) {
+            auto atomicWeight = atomicWeights.find(element);
+            if (atomicWeight == atomicWeights.end()) {
+                throw std::invalid_argument("Unknown element " + element + " in species " + species);
+            }
+            molecularWeight += count * atomicWeight->second;
+        }
+        mechanism->molecularWeight.push_back(molecularWeight);
+    }
+
+    // check that each falloff reaction was fully specified
+    for (std::size_t r = 0; r < mechanism->NumberReactions(); r++) {
+        if (mechanism->falloff[r] >= 0 && std::isnan(mechanism->lowPreExponential[mechanism->falloff[r]])) {
+            throw std::invalid_argument("The falloff reaction " + mechanism->equations[r] + " requires LOW parameters");
+        }
+    }
+
+    return mechanism;
+}
+
+void ablate::eos::kinetics::ChemkinParser::ParseThermo(std::istream& stream, std::map<std::string, ThermoData>& thermo) {
+    double defaultMidTemperature = 1000.0;
+    bool inThermo = false;
+
+    std::string line;
+    while (std::getline(stream, line)) {
+        auto content = Trim(StripComment(line));
+        if (content.empty()) {
+            continue;
+        }
+        if (!inThermo) {
+            if (StartsWithKeyword(content, "THER")) {
+                inThermo = true;
+            }
+            continue;
+        }
+        if (ToUpper(content) == "END") {
+            break;
+        }
+
+        // the first line of each species ends with a 1 in column 80, otherwise this is the default temperature ranges
+        if (content.back() != '1' || line.size() < 45) {
+            auto tokens = Tokenize(content);
+            if (tokens.size() == 3) {
+                defaultMidTemperature = std::stod(tokens[1]);
+            }
+            continue;
+        }
+
+        ThermoData data{};
+        auto name = Tokenize(line.substr(0, 18)).front();
+        for (std::size_t e = 0; e < 4; e++) {
+            auto element = ToUpper(Trim(line.substr(24 + 5 * e, 2)));
+            auto count = ReadFixedWidth(line, 26 + 5 * e, 3);
+            if (!element.empty() && element != "0" && count != 0.0) {
+                data.composition[element] += count;
+            }
+        }
+        data.midTemperature = ReadFixedWidth(line, 65, 8, defaultMidTemperature);
+
+        // read the next three lines of coefficients
+        double coefficients[14];
+        std::size_t c = 0;
+        for (std::size_t l = 0; l < 3; l++) {
+            std::string coefficientLine;
+            if (!std::getline(stream, coefficientLine)) {
+                throw std::invalid_argument("Incomplete thermo data for species " + name);
+            }
+            for (std::size_t i = 0; i < (l == 2 ? 4 : 5); i++) {
+                coefficients[c++] = ReadFixedWidth(coefficientLine, 15 * i, 15);
+            }
+        }
+        std::copy(coefficients, coefficients + 7, data.highCoefficients);
+        std::copy(coefficients + 7, coefficients + 14, data.lowCoefficients);
+
+        // only use the first definition of each species
+        thermo.emplace(name, data);
+    }
+}
+
+void ablate::eos::kinetics::ChemkinParser::ParseReaction(ablate::eos::kinetics::Mechanism& mechanism, const std::string& line, double activationEnergyScale) {
+    auto tokens = Tokenize(line);
+    if (tokens.size() < 4) {
+        throw std::invalid_argument("Unable to parse reaction " + line);
+    }
+
+    // the last three values are the Arrhenius coefficients
+    std::string equation;
+    for (std::size_t t = 0; t < tokens.size() - 3; t++) {
+        equation += tokens[t];
+    }
+    mechanism.equations.push_back(equation);
+    mechanism.preExponential.push_back(std::stod(tokens[tokens.size() - 3]));
+    mechanism.temperatureExponent.push_back(std::stod(tokens[tokens.size() - 2]));
+    mechanism.activationTemperature.push_back(std::stod(tokens[tokens.size() - 1]) * activationEnergyScale);
+
+    // check for falloff, i.e. (+M) or (+species)
+    std::string falloffCollider;
+    std::size_t falloffStart;
+    while ((falloffStart = equation.find("(+")) != std::string::npos) {
+        auto falloffEnd = equation.find(')', falloffStart);
+        if (falloffEnd == std::string::npos) {
+            throw std::invalid_argument("Unable to parse falloff reaction " + line);
+        }
+        falloffCollider = equation.substr(falloffStart + 2, falloffEnd - falloffStart - 2);
+        equation.erase(falloffStart, falloffEnd - falloffStart + 1);
+    }
+
+    // split the reactants and products
+    std::string reactants, products;
+    bool reversible = true;
+    std::size_t split;
+    if ((split = equation.find("<=>")) != std::string::npos) {
+        reactants = equation.substr(0, split);
+        products = equation.substr(split + 3);
+    } else if ((split = equation.find("=>")) != std::string::npos) {
+        reversible = false;
+        reactants = equation.substr(0, split);
+        products = equation.substr(split + 2);
+    } else {
+        split = equation.find('=');
+        reactants = equation.substr(0, split);
+        products = equation.substr(split + 1);
+    }
+    mechanism.reversible.push_back(reversible);
+
+    // parse each side of the reaction
+    bool thirdBody = false;
+    auto parseSide = [&mechanism, &thirdBody, &line](const std::string& side) {
+        std::vector<std::pair<int, double>> terms;
+        for (const auto& term : Split(side, '+')) {
+            if (term.empty()) {
+                continue;
+            }
+            if (ToUpper(term) == "M") {
+                thirdBody = true;
+                continue;
+            }
+
+            // check to see if this is a species, otherwise there is a leading coefficient
+            auto speciesName = term;
+            double coefficient = 1.0;
+            auto species = std::find(mechanism.species.begin(), mechanism.species.end(), speciesName);
+            if (species == mechanism.species.end()) {
+                auto nameStart = term.find_first_not_of("0123456789.");
+                if (nameStart != std::string::npos && nameStart > 0) {
+                    coefficient = std::stod(term.substr(0, nameStart));
+                    speciesName = term.substr(nameStart);
+                    species = std::find(mechanism.species.begin(), mechanism.species.end(), speciesName);
+                }
+            }
+            if (species == mechanism.species.end()) {
+                throw std::invalid_argument("Unknown species " + speciesName + " in reaction " + line);
+            }
+            AddStoichiometry(terms, (int)std::distance(mechanism.species.begin(), species), coefficient);
+        }
+        return terms;
+    };
+
+    for (const auto& [species, coefficient] : parseSide(reactants)) {
+        mechanism.reactantSpecies.push_back(species);
+        mechanism.reactantCoefficients.push_back(coefficient);
+    }
+    mechanism.reactantOffsets.push_back(mechanism.reactantSpecies.size());
+    for (const auto& [species, coefficient] : parseSide(products)) {
+        mechanism.productSpecies.push_back(species);
+        mechanism.productCoefficients.push_back(coefficient);
+    }
+    mechanism.productOffsets.push_back(mechanism.productSpecies.size());
+
+    // set up the third body and falloff data
+    if (thirdBody || !falloffCollider.empty()) {
+        int collider = -1;
+        if (!falloffCollider.empty() && ToUpper(falloffCollider) != "M") {
+            auto species = std::find(mechanism.species.begin(), mechanism.species.end(), falloffCollider);
+            if (species == mechanism.species.end()) {
+                throw std::invalid_argument("Unknown third body " + falloffCollider + " in reaction " + line);
+            }
+            collider = (int)std::distance(mechanism.species.begin(), species);
+        }
+        mechanism.thirdBody.push_back((int)mechanism.thirdBodySpecies.size());
+        mechanism.thirdBodySpecies.push_back(collider);
+        mechanism.efficiencyOffsets.push_back(mechanism.efficiencySpecies.size());
+    } else {
+        mechanism.thirdBody.push_back(-1);
+    }
+
+    if (!falloffCollider.empty()) {
+        mechanism.falloff.push_back((int)mechanism.falloffType.size());
+        mechanism.falloffType.push_back(Mechanism::Lindemann);
+        mechanism.lowPreExponential.push_back(std::numeric_limits<double>::quiet_NaN());
+        mechanism.lowTemperatureExponent.push_back(0.0);
+        mechanism.lowActivationTemperature.push_back(0.0);
+        mechanism.troeA.push_back(0.0);
+        mechanism.troeT3.push_back(0.0);
+        mechanism.troeT1.push_back(0.0);
+        mechanism.troeT2.push_back(0.0);
+        mechanism.troeHasT2.push_back(false);
+    } else {
+        mechanism.falloff.push_back(-1);
+    }
+}
+
+void ablate::eos::kinetics::ChemkinParser::ParseAuxiliaryLine(ablate::eos::kinetics::Mechanism& mechanism, const std::string& line, double activationEnergyScale) {
+    if (mechanism.equations.empty()) {
+        throw std::invalid_argument("Auxiliary reaction data " + line + " must follow a reaction");
+    }
+    const std::size_t reaction = mechanism.equations.size() - 1;
+
+    auto tokens = Split(line, '/');
+    for (std::size_t t = 0; t < tokens.size(); t++) {
+        auto keyword = Trim(tokens[t]);
+        auto keywordUpper = ToUpper(keyword);
+        if (keyword.empty()) {
+            continue;
+        }
+        if (keywordUpper == "DUP" || keywordUpper == "DUPLICATE") {
+            continue;
+        }
+        if (t + 1 >= tokens.size()) {
+            throw std::invalid_argument("Unable to parse auxiliary reaction data " + line);
+        }
+        auto values = Tokenize(tokens[++t]);
+
+        if (keywordUpper == "LOW") {
+            if (mechanism.falloff[reaction] < 0 || values.size() != 3) {
+                throw std::invalid_argument("Invalid LOW parameters for reaction " + mechanism.equations[reaction]);
+            }
+            auto f = mechanism.falloff[reaction];
+            mechanism.lowPreExponential[f] = std::stod(values[0]);
+            mechanism.lowTemperatureExponent[f] = std::stod(values[1]);
+            mechanism.lowActivationTemperature[f] = std::stod(values[2]) * activationEnergyScale;
+        } else if (keywordUpper == "TROE") {
+            if (mechanism.falloff[reaction] < 0 || values.size() < 3 || values.size() > 4) {
+                throw std::invalid_argument("Invalid TROE parameters for reaction " + mechanism.equations[reaction]);
+            }
+            auto f = mechanism.falloff[reaction];
+            mechanism.falloffType[f] = Mechanism::Troe;
+            mechanism.troeA[f] = std::stod(values[0]);
+            mechanism.troeT3[f] = std::stod(values[1]);
+            mechanism.troeT1[f] = std::stod(values[2]);
+            if (values.size() == 4) {
+                mechanism.troeT2[f] = std::stod(values[3]);
+                mechanism.troeHasT2[f] = true;
+            }
+        } else if (std::find(mechanism.species.begin(), mechanism.species.end(), keyword) != mechanism.species.end()) {
+            // enhanced third body efficiency
+            auto tb = mechanism.thirdBody[reaction];
+            if (tb < 0 || mechanism.thirdBodySpecies[tb] >= 0 || values.size() != 1) {
+                throw std::invalid_argument("Invalid third body efficiency " + keyword + " for reaction " + mechanism.equations[reaction]);
+            }
+            mechanism.efficiencySpecies.push_back((int)std::distance(mechanism.species.begin(), std::find(mechanism.species.begin(), mechanism.species.end(), keyword)));
+            mechanism.efficiencies.push_back(std::stod(values[0]));
+            mechanism.efficiencyOffsets.back() = mechanism.efficiencySpecies.size();
+        } else {
+            throw std::invalid_argument("Unsupported auxiliary reaction keyword " + keyword + " for reaction " + mechanism.equations[reaction]);
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef ABLATELIBRARY_CHEMKINPARSER_HPP
+#define ABLATELIBRARY_CHEMKINPARSER_HPP
+
+#include <filesystem>
+#include <istream>
+#include <map>
+#include <memory>
+#include "mechanism.hpp"
+
+namespace ablate::eos::kinetics {
+
+/**
+ * Parses the CHEMKIN mechanism and thermodynamic (NASA 7 coefficient) files into a flat mechanism.  Elementary, third body, Lindemann, and Troe falloff reactions are supported.
+ */
+class ChemkinParser {
+   private:
+    ChemkinParser() = delete;
+
+    /**
+     * Parses the THERMO section(s) of the stream and adds any new species to the thermo data
+     */
+    struct ThermoData {
+        double midTemperature;
+        double lowCoefficients[7];
+        double highCoefficients[7];
+        std::map<std::string, double> composition;
+    };
+    static void ParseThermo(std::istream& stream, std::map<std::string, ThermoData>& thermo);
+
+    /**
+     * Parses a single reaction line and the following auxiliary lines
+     */
+    static void ParseReaction(Mechanism& mechanism, const std::string& line, double activationEnergyScale);
+
+    /**
+     * Parses the auxiliary data (LOW, TROE, third body efficiencies, DUPLICATE) for the most recent reaction
+     */
+    static void ParseAuxiliaryLine(Mechanism& mechanism, const std::string& line, double activationEnergyScale);
+
+   public:
+    /**
+     * Parse the mechanism from CHEMKIN formatted files
+     * @param mechFile
+     * @param thermoFile
+     * @return
+     */
+    static std::shared_ptr<Mechanism> Parse(const std::filesystem::path& mechFile, const std::filesystem::path& thermoFile);
+
+    /**
+     * Parse the mechanism from CHEMKIN formatted streams
+     * @param mechStream
+     * @param thermoStream
+     * @return
+     */
+    static std::shared_ptr<Mechanism> Parse(std::istream& mechStream, std::istream& thermoStream);
+};
+
+}  // namespace ablate::eos::kinetics
+#endif  // ABLATELIBRARY_CHEMKINPARSER_HPP
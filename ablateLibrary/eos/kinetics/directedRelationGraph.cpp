@@ -0,0 +1,103 @@
+#include "directedRelationGraph.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+ablate::eos::kinetics::DirectedRelationGraph::DirectedRelationGraph(std::shared_ptr<Mechanism> mechanismIn)
+    : mechanism(mechanismIn), numberSpecies(mechanismIn->NumberSpecies()), numberReactions(mechanismIn->NumberReactions()) {
+    // combine the reactants and products of each reaction into a list of unique participants with the net coefficient
+    participantOffsets.push_back(0);
+    std::vector<std::vector<int>> reactionsBySpecies(numberSpecies);
+    for (std::size_t r = 0; r < numberReactions; r++) {
+        std::map<int, double> participants;
+        for (std::size_t i = mechanism->reactantOffsets[r]; i < mechanism->reactantOffsets[r + 1]; i++) {
+            participants[mechanism->reactantSpecies[i]] -= mechanism->reactantCoefficients[i];
+        }
+        for (std::size_t i = mechanism->productOffsets[r]; i < mechanism->productOffsets[r + 1]; i++) {
+            participants[mechanism->productSpecies[i]] += mechanism->productCoefficients[i];
+        }
+        for (const auto& participant : participants) {
+            participantSpecies.push_back(participant.first);
+            participantCoefficients.push_back(participant.second);
+            reactionsBySpecies[participant.first].push_back((int)r);
+        }
+        participantOffsets.push_back(participantSpecies.size());
+    }
+
+    speciesReactionOffsets.push_back(0);
+    for (const auto& reactions : reactionsBySpecies) {
+        speciesReactions.insert(speciesReactions.end(), reactions.begin(), reactions.end());
+        speciesReactionOffsets.push_back(speciesReactions.size());
+    }
+
+    // size the workspace
+    concentrations.resize(numberSpecies);
+    ratesOfProgress.resize(numberReactions);
+    interaction.resize(numberSpecies);
+    queue.reserve(numberSpecies);
+}
+
+std::size_t ablate::eos::kinetics::DirectedRelationGraph::Reduce(Kinetics& kinetics, double pressure, const double* state, const std::vector<int>& targets, double threshold,
+                                                                 std::vector<unsigned char>& activeSpecies, std::vector<unsigned char>& activeReactions) {
+    // compute the rates of progress for the full mechanism
+    kinetics.ResetActiveReactions();
+    kinetics.ComputeConcentrations(pressure, state, concentrations.data());
+    kinetics.ComputeRatesOfProgress(state[0], concentrations.data(), ratesOfProgress.data());
+
+    // march through the graph starting at the targets
+    activeSpecies.assign(numberSpecies, 0);
+    queue.clear();
+    for (const auto& target : targets) {
+        if (!activeSpecies[target]) {
+            activeSpecies[target] = 1;
+            queue.push_back(target);
+        }
+    }
+
+    for (std::size_t q = 0; q < queue.size(); q++) {
+        const int a = queue[q];
+
+        // sum the contribution of each reaction with species a to each other participating species
+        std::fill(interaction.begin(), interaction.end(), 0.0);
+        double total = 0.0;
+        for (std::size_t ri = speciesReactionOffsets[a]; ri < speciesReactionOffsets[a + 1]; ri++) {
+            const int r = speciesReactions[ri];
+            double contribution = 0.0;
+            for (std::size_t i = participantOffsets[r]; i < participantOffsets[r + 1]; i++) {
+                if (participantSpecies[i] == a) {
+                    contribution = std::abs(participantCoefficients[i] * ratesOfProgress[r]);
+                    break;
+                }
+            }
+            total += contribution;
+            for (std::size_t i = participantOffsets[r]; i < participantOffsets[r + 1]; i++) {
+                interaction[participantSpecies[i]] += contribution;
+            }
+        }
+
+        // keep every species that species a strongly depends upon
+        if (total <= 0.0) {
+            continue;
+        }
+        const double cutoff = threshold * total;
+        for (std::size_t b = 0; b < numberSpecies; b++) {
+            if (!activeSpecies[b] && interaction[b] > cutoff) {
+                activeSpecies[b] = 1;
+                queue.push_back((int)b);
+            }
+        }
+    }
+
+    // only keep the reactions where every participant is active
+    activeReactions.assign(numberReactions, 1);
+    for (std::size_t r = 0; r < numberReactions; r++) {
+        for (std::size_t i = participantOffsets[r]; i < participantOffsets[r + 1]; i++) {
+            if (!activeSpecies[participantSpecies[i]]) {
+                activeReactions[r] = 0;
+                break;
+            }
+        }
+    }
+
+    return queue.size();
+}
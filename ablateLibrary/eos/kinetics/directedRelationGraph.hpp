@@ -0,0 +1,58 @@
+#ifndef ABLATELIBRARY_DIRECTEDRELATIONGRAPH_HPP
+#define ABLATELIBRARY_DIRECTEDRELATIONGRAPH_HPP
+
+#include <memory>
+#include <vector>
+#include "kinetics.hpp"
+#include "mechanism.hpp"
+
+namespace ablate::eos::kinetics {
+
+/**
+ * Reduces a mechanism at a single thermodynamic state using the directed relation graph (DRG) method.  The interaction coefficient between species A and B is
+ *      r_AB = sum_i |nu_iA q_i delta_iB| / sum_i |nu_iA q_i|
+ * where q_i is the rate of progress of reaction i and delta_iB is one if species B participates in reaction i.  Starting from the target species, every species
+ * reachable through an edge with r_AB above the threshold is kept.  A reaction is kept only if all of its reactants and products are kept, so the kept
+ * reactions conserve the mass of the kept species and the remaining species can be frozen.
+ */
+class DirectedRelationGraph {
+   private:
+    const std::shared_ptr<Mechanism> mechanism;
+    const std::size_t numberSpecies;
+    const std::size_t numberReactions;
+
+    // the unique participating species and net stoichiometric coefficient for each reaction (CSR)
+    std::vector<std::size_t> participantOffsets;
+    std::vector<int> participantSpecies;
+    std::vector<double> participantCoefficients;
+
+    // the reactions that each species participates in (CSR)
+    std::vector<std::size_t> speciesReactionOffsets;
+    std::vector<int> speciesReactions;
+
+    // workspace
+    std::vector<double> concentrations;
+    std::vector<double> ratesOfProgress;
+    std::vector<double> interaction;
+    std::vector<int> queue;
+
+   public:
+    explicit DirectedRelationGraph(std::shared_ptr<Mechanism> mechanism);
+
+    /**
+     * Computes the active species and reactions at the state (T, Yi).
+     * @param kinetics the kinetics used to compute the rates of progress.  All reactions are evaluated.
+     * @param pressure the pressure (Pa)
+     * @param state the state (T, Yi)
+     * @param targets the species that must be kept
+     * @param threshold the interaction coefficient below which an edge is ignored
+     * @param activeSpecies resulting flag for each species
+     * @param activeReactions resulting flag for each reaction
+     * @return the number of active species
+     */
+    std::size_t Reduce(Kinetics& kinetics, double pressure, const double* state, const std::vector<int>& targets, double threshold, std::vector<unsigned char>& activeSpecies,
+                       std::vector<unsigned char>& activeReactions);
+};
+
+}  // namespace ablate::eos::kinetics
+#endif  // ABLATELIBRARY_DIRECTEDRELATIONGRAPH_HPP
@@ -0,0 +1,707 @@
+#include "kinetics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+/**
+ * Computes value^exponent with a fast path for the common integer stoichiometric coefficients
+ */
+inline double Power(double value, double exponent) {
+    if (exponent == 1.0) {
+        return value;
+    } else if (exponent == 2.0) {
+        return value * value;
+    } else if (exponent == 3.0) {
+        return value * value * value;
+    }
+    return std::pow(value, exponent);
+}
+
+/**
+ * Computes d(value^exponent)/d value
+ */
+inline double PowerDerivative(double value, double exponent) {
+    if (exponent == 1.0) {
+        return 1.0;
+    } else if (exponent == 2.0) {
+        return 2.0 * value;
+    } else if (exponent == 3.0) {
+        return 3.0 * value * value;
+    }
+    return exponent * std::pow(value, exponent - 1.0);
+}
+
+/**
+ * Computes exp(-T/Tref) and its temperature derivative, skipping the term when Tref is zero
+ */
+inline void TroeTerm(double temperature, double referenceTemperature, double& value, double& derivative) {
+    if (referenceTemperature == 0.0) {
+        value = 0.0;
+        derivative = 0.0;
+    } else {
+        value = std::exp(-temperature / referenceTemperature);
+        derivative = -value / referenceTemperature;
+    }
+}
+/**
+ * Blends the high and low pressure limits of a falloff reaction.  The high pressure d ln(k)/dT is read from rateTDerivative and replaced with the blended value.
+ * @param rate the blended rate constant
+ * @param rateTDerivative d ln(rate)/dT
+ * @param rateMDerivative d rate/d[M]
+ */
+inline void ComputeFalloffRate(const ablate::eos::kinetics::Mechanism& mechanism, int f, double temperature, double invT, double highRate, double lowRate, double thirdBodyConcentration,
+                               double& rate, double& rateTDerivative, double& rateMDerivative) {
+    const double ln10 = 2.302585092994046;
+    const double highRateTDerivative = rateTDerivative;
+    const double lowRateTDerivative = (mechanism.lowTemperatureExponent[f] + mechanism.lowActivationTemperature[f] * invT) * invT;
+
+    // the reduced pressure
+    const double reducedPressure = std::max(lowRate * thirdBodyConcentration / highRate, 1E-300);
+    const double reducedPressureTDerivative = lowRateTDerivative - highRateTDerivative;
+
+    // the broadening factor log10(F) and its derivatives
+    double logF = 0.0;
+    double logFLogPrDerivative = 0.0;
+    double logFTDerivative = 0.0;
+    if (mechanism.falloffType[f] == ablate::eos::kinetics::Mechanism::Troe) {
+        const double a = mechanism.troeA[f];
+        double t3, t3Derivative, t1, t1Derivative;
+        TroeTerm(temperature, mechanism.troeT3[f], t3, t3Derivative);
+        TroeTerm(temperature, mechanism.troeT1[f], t1, t1Derivative);
+        double fCent = (1.0 - a) * t3 + a * t1;
+        double fCentDerivative = (1.0 - a) * t3Derivative + a * t1Derivative;
+        if (mechanism.troeHasT2[f]) {
+            const double t2 = std::exp(-mechanism.troeT2[f] * invT);
+            fCent += t2;
+            fCentDerivative += mechanism.troeT2[f] * invT * invT * t2;
+        }
+        fCent = std::max(fCent, 1E-300);
+
+        const double logFCent = std::log10(fCent);
+        const double c = -0.4 - 0.67 * logFCent;
+        const double n = 0.75 - 1.27 * logFCent;
+        const double x = std::log10(reducedPressure) + c;
+        const double denominator = n - 0.14 * x;
+        const double f1 = x / denominator;
+        const double g = 1.0 / (1.0 + f1 * f1);
+        const double gF1Derivative = -2.0 * f1 * g * g;
+
+        logF = logFCent * g;
+        const double f1LogPrDerivative = n / (denominator * denominator);
+        const double f1LogFCentDerivative = (-0.67 * denominator - x * (-1.27 + 0.14 * 0.67)) / (denominator * denominator);
+        logFLogPrDerivative = logFCent * gF1Derivative * f1LogPrDerivative;
+        const double logFLogFCentDerivative = g + logFCent * gF1Derivative * f1LogFCentDerivative;
+        logFTDerivative = logFLogFCentDerivative * fCentDerivative / (fCent * ln10);
+    }
+    const double broadening = std::pow(10.0, logF);
+
+    rate = highRate * reducedPressure / (1.0 + reducedPressure) * broadening;
+    rateTDerivative = highRateTDerivative + reducedPressureTDerivative / (1.0 + reducedPressure) + logFLogPrDerivative * reducedPressureTDerivative + ln10 * logFTDerivative;
+    rateMDerivative = lowRate * broadening / (1.0 + reducedPressure) * (1.0 / (1.0 + reducedPressure) + logFLogPrDerivative);
+}
+}  // namespace
+
+ablate::eos::kinetics::Kinetics::Kinetics(std::shared_ptr<Mechanism> mechanismIn)
+    : mechanism(mechanismIn), numberSpecies(mechanismIn->NumberSpecies()), numberReactions(mechanismIn->NumberReactions()) {
+    // precompute the net change in moles for each reaction
+    deltaMoles.resize(numberReactions, 0.0);
+    for (std::size_t r = 0; r < numberReactions; r++) {
+        for (std::size_t i = mechanism->reactantOffsets[r]; i < mechanism->reactantOffsets[r + 1]; i++) {
+            deltaMoles[r] -= mechanism->reactantCoefficients[i];
+        }
+        for (std::size_t i = mechanism->productOffsets[r]; i < mechanism->productOffsets[r + 1]; i++) {
+            deltaMoles[r] += mechanism->productCoefficients[i];
+        }
+    }
+
+    // expand the third body efficiencies into a dense array so that [M] is a flat dot product
+    const std::size_t numberThirdBodies = mechanism->thirdBodySpecies.size();
+    thirdBodyEfficiencies.resize(numberThirdBodies * numberSpecies);
+    for (std::size_t tb = 0; tb < numberThirdBodies; tb++) {
+        double* efficiency = &thirdBodyEfficiencies[tb * numberSpecies];
+        if (mechanism->thirdBodySpecies[tb] >= 0) {
+            std::fill(efficiency, efficiency + numberSpecies, 0.0);
+            efficiency[mechanism->thirdBodySpecies[tb]] = 1.0;
+        } else {
+            std::fill(efficiency, efficiency + numberSpecies, 1.0);
+            for (std::size_t i = mechanism->efficiencyOffsets[tb]; i < mechanism->efficiencyOffsets[tb + 1]; i++) {
+                efficiency[mechanism->efficiencySpecies[i]] = mechanism->efficiencies[i];
+            }
+        }
+    }
+
+    // size the workspace
+    speciesCp.resize(numberSpecies);
+    speciesEnthalpy.resize(numberSpecies);
+    speciesEntropy.resize(numberSpecies);
+    speciesCpDerivative.resize(numberSpecies);
+    speciesGibbs.resize(numberSpecies);
+    forwardRateConstant.resize(numberReactions);
+    forwardRateConstantTDerivative.resize(numberReactions);
+    forwardRateConstantMDerivative.resize(numberReactions);
+    inverseEquilibriumConstant.resize(numberReactions);
+    equilibriumConstantTDerivative.resize(numberReactions);
+    thirdBodyConcentration.resize(numberThirdBodies);
+    concentrations.resize(numberSpecies);
+    productionRates.resize(numberSpecies);
+    productionRatesCDerivative.resize(numberSpecies * numberSpecies);
+    productionRatesTDerivative.resize(numberSpecies);
+    productionRatesCSum.resize(numberSpecies);
+
+    // size the batch workspace
+    batchTemperature.resize(BATCH_SIZE);
+    batchLogTemperature.resize(BATCH_SIZE);
+    batchInverseTemperature.resize(BATCH_SIZE);
+    batchLogStandardConcentration.resize(BATCH_SIZE);
+    batchDensity.resize(BATCH_SIZE);
+    batchConcentrations.resize(numberSpecies * BATCH_SIZE);
+    batchSpeciesCp.resize(numberSpecies * BATCH_SIZE);
+    batchSpeciesEnthalpy.resize(numberSpecies * BATCH_SIZE);
+    batchSpeciesGibbs.resize(numberSpecies * BATCH_SIZE);
+    batchForwardRateConstant.resize(numberReactions * BATCH_SIZE);
+    batchReverseRateConstant.resize(numberReactions * BATCH_SIZE);
+    batchThirdBodyConcentration.resize(numberThirdBodies * BATCH_SIZE);
+    batchForwardProduct.resize(BATCH_SIZE);
+    batchReverseProduct.resize(BATCH_SIZE);
+    batchProductionRates.resize(numberSpecies * BATCH_SIZE);
+
+    // by default every reaction is evaluated
+    reactionActive.resize(numberReactions, 1);
+}
+
+void ablate::eos::kinetics::Kinetics::SetActiveReactions(const std::vector<unsigned char>& active) {
+    if (active.size() != numberReactions) {
+        throw std::invalid_argument("The active reaction mask must contain " + std::to_string(numberReactions) + " values");
+    }
+    reactionActive = active;
+}
+
+void ablate::eos::kinetics::Kinetics::ResetActiveReactions() { std::fill(reactionActive.begin(), reactionActive.end(), 1); }
+
+void ablate::eos::kinetics::Kinetics::ComputeSpeciesThermo(double temperature) {
+    const double logT = std::log(temperature);
+    const double T = temperature;
+    for (std::size_t k = 0; k < numberSpecies; k++) {
+        const double* a = T < mechanism->thermoMidTemperature[k] ? &mechanism->thermoLowCoefficients[7 * k] : &mechanism->thermoHighCoefficients[7 * k];
+        speciesCp[k] = a[0] + T * (a[1] + T * (a[2] + T * (a[3] + T * a[4])));
+        speciesEnthalpy[k] = a[0] + T * (a[1] / 2.0 + T * (a[2] / 3.0 + T * (a[3] / 4.0 + T * a[4] / 5.0))) + a[5] / T;
+        speciesEntropy[k] = a[0] * logT + T * (a[1] + T * (a[2] / 2.0 + T * (a[3] / 3.0 + T * a[4] / 4.0))) + a[6];
+        speciesCpDerivative[k] = a[1] + T * (2.0 * a[2] + T * (3.0 * a[3] + T * 4.0 * a[4]));
+        speciesGibbs[k] = speciesEnthalpy[k] - speciesEntropy[k];
+    }
+}
+
+void ablate::eos::kinetics::Kinetics::ComputeRateConstants(double temperature, const double* concentrationsIn) {
+    const double logT = std::log(temperature);
+    const double invT = 1.0 / temperature;
+    const double* preExponential = mechanism->preExponential.data();
+    const double* temperatureExponent = mechanism->temperatureExponent.data();
+    const double* activationTemperature = mechanism->activationTemperature.data();
+
+    // the modified Arrhenius rate constants and d ln(kf)/dT
+    for (std::size_t r = 0; r < numberReactions; r++) {
+        if (!reactionActive[r]) {
+            forwardRateConstant[r] = 0.0;
+            forwardRateConstantTDerivative[r] = 0.0;
+            forwardRateConstantMDerivative[r] = 0.0;
+            continue;
+        }
+        forwardRateConstant[r] = preExponential[r] * std::exp(temperatureExponent[r] * logT - activationTemperature[r] * invT);
+        forwardRateConstantTDerivative[r] = (temperatureExponent[r] + activationTemperature[r] * invT) * invT;
+        forwardRateConstantMDerivative[r] = 0.0;
+    }
+
+    // the third body concentrations
+    for (std::size_t tb = 0; tb < thirdBodyConcentration.size(); tb++) {
+        const double* efficiency = &thirdBodyEfficiencies[tb * numberSpecies];
+        double concentration = 0.0;
+        for (std::size_t k = 0; k < numberSpecies; k++) {
+            concentration += efficiency[k] * concentrationsIn[k];
+        }
+        thirdBodyConcentration[tb] = concentration;
+    }
+
+    // blend the high and low pressure limits for the falloff reactions
+    for (std::size_t r = 0; r < numberReactions; r++) {
+        const int f = mechanism->falloff[r];
+        if (f < 0 || !reactionActive[r]) {
+            continue;
+        }
+        const double lowRate = mechanism->lowPreExponential[f] * std::exp(mechanism->lowTemperatureExponent[f] * logT - mechanism->lowActivationTemperature[f] * invT);
+        ComputeFalloffRate(*mechanism,
+                           f,
+                           temperature,
+                           invT,
+                           forwardRateConstant[r],
+                           lowRate,
+                           thirdBodyConcentration[mechanism->thirdBody[r]],
+                           forwardRateConstant[r],
+                           forwardRateConstantTDerivative[r],
+                           forwardRateConstantMDerivative[r]);
+    }
+
+    // the equilibrium constants in concentration units
+    const double logStandardConcentration = std::log(PATM / (RU * temperature) * 1E-6);
+    for (std::size_t r = 0; r < numberReactions; r++) {
+        if (!mechanism->reversible[r] || !reactionActive[r]) {
+            inverseEquilibriumConstant[r] = 0.0;
+            equilibriumConstantTDerivative[r] = 0.0;
+            continue;
+        }
+        double deltaGibbs = 0.0;
+        double deltaEnthalpy = 0.0;
+        for (std::size_t i = mechanism->reactantOffsets[r]; i < mechanism->reactantOffsets[r + 1]; i++) {
+            deltaGibbs -= mechanism->reactantCoefficients[i] * speciesGibbs[mechanism->reactantSpecies[i]];
+            deltaEnthalpy -= mechanism->reactantCoefficients[i] * speciesEnthalpy[mechanism->reactantSpecies[i]];
+        }
+        for (std::size_t i = mechanism->productOffsets[r]; i < mechanism->productOffsets[r + 1]; i++) {
+            deltaGibbs += mechanism->productCoefficients[i] * speciesGibbs[mechanism->productSpecies[i]];
+            deltaEnthalpy += mechanism->productCoefficients[i] * speciesEnthalpy[mechanism->productSpecies[i]];
+        }
+        const double logEquilibriumConstant = -deltaGibbs + deltaMoles[r] * logStandardConcentration;
+        inverseEquilibriumConstant[r] = std::exp(-logEquilibriumConstant);
+        equilibriumConstantTDerivative[r] = (deltaEnthalpy - deltaMoles[r]) * invT;
+    }
+}
+
+void ablate::eos::kinetics::Kinetics::ComputeRatesOfProgress(double temperature, const double* concentrationsIn, double* ratesOfProgress) {
+    ComputeSpeciesThermo(temperature);
+    ComputeRateConstants(temperature, concentrationsIn);
+
+    for (std::size_t r = 0; r < numberReactions; r++) {
+        if (!reactionActive[r]) {
+            ratesOfProgress[r] = 0.0;
+            continue;
+        }
+        double forward = forwardRateConstant[r];
+        for (std::size_t i = mechanism->reactantOffsets[r]; i < mechanism->reactantOffsets[r + 1]; i++) {
+            forward *= Power(concentrationsIn[mechanism->reactantSpecies[i]], mechanism->reactantCoefficients[i]);
+        }
+        double reverse = forwardRateConstant[r] * inverseEquilibriumConstant[r];
+        for (std::size_t i = mechanism->productOffsets[r]; i < mechanism->productOffsets[r + 1]; i++) {
+            reverse *= Power(concentrationsIn[mechanism->productSpecies[i]], mechanism->productCoefficients[i]);
+        }
+        const int tb = mechanism->thirdBody[r];
+        const double scale = (tb >= 0 && mechanism->falloff[r] < 0) ? thirdBodyConcentration[tb] : 1.0;
+        ratesOfProgress[r] = scale * (forward - reverse);
+    }
+}
+
+void ablate::eos::kinetics::Kinetics::ComputeProductionRates(double temperature, const double* concentrationsIn, double* productionRatesOut, double* productionRatesCDerivativeOut,
+                                                             double* productionRatesTDerivativeOut) {
+    ComputeSpeciesThermo(temperature);
+    ComputeRateConstants(temperature, concentrationsIn);
+
+    const bool computeDerivatives = productionRatesCDerivativeOut && productionRatesTDerivativeOut;
+    std::fill(productionRatesOut, productionRatesOut + numberSpecies, 0.0);
+    if (computeDerivatives) {
+        std::fill(productionRatesCDerivativeOut, productionRatesCDerivativeOut + numberSpecies * numberSpecies, 0.0);
+        std::fill(productionRatesTDerivativeOut, productionRatesTDerivativeOut + numberSpecies, 0.0);
+    }
+
+    const auto& reactantOffsets = mechanism->reactantOffsets;
+    const auto& reactantSpecies = mechanism->reactantSpecies;
+    const auto& reactantCoefficients = mechanism->reactantCoefficients;
+    const auto& productOffsets = mechanism->productOffsets;
+    const auto& productSpecies = mechanism->productSpecies;
+    const auto& productCoefficients = mechanism->productCoefficients;
+
+    for (std::size_t r = 0; r < numberReactions; r++) {
+        if (!reactionActive[r]) {
+            continue;
+        }
+        const double forwardRate = forwardRateConstant[r];
+        const double reverseRate = forwardRate * inverseEquilibriumConstant[r];
+
+        double forwardProduct = 1.0;
+        for (std::size_t i = reactantOffsets[r]; i < reactantOffsets[r + 1]; i++) {
+            forwardProduct *= Power(concentrationsIn[reactantSpecies[i]], reactantCoefficients[i]);
+        }
+        double reverseProduct = 1.0;
+        for (std::size_t i = productOffsets[r]; i < productOffsets[r + 1]; i++) {
+            reverseProduct *= Power(concentrationsIn[productSpecies[i]], productCoefficients[i]);
+        }
+
+        const int tb = mechanism->thirdBody[r];
+        const bool thirdBodyReaction = tb >= 0 && mechanism->falloff[r] < 0;
+        const double scale = thirdBodyReaction ? thirdBodyConcentration[tb] : 1.0;
+        const double netRate = forwardRate * forwardProduct - reverseRate * reverseProduct;
+        const double rateOfProgress = scale * netRate;
+
+        for (std::size_t i = reactantOffsets[r]; i < reactantOffsets[r + 1]; i++) {
+            productionRatesOut[reactantSpecies[i]] -= reactantCoefficients[i] * rateOfProgress;
+        }
+        for (std::size_t i = productOffsets[r]; i < productOffsets[r + 1]; i++) {
+            productionRatesOut[productSpecies[i]] += productCoefficients[i] * rateOfProgress;
+        }
+
+        if (!computeDerivatives) {
+            continue;
+        }
+
+        // adds d(rate of progress)/d(variable) to each species in this reaction
+        auto addDerivative = [&](double* derivative, std::size_t stride, double rateDerivative) {
+            for (std::size_t i = reactantOffsets[r]; i < reactantOffsets[r + 1]; i++) {
+                derivative[reactantSpecies[i] * stride] -= reactantCoefficients[i] * rateDerivative;
+            }
+            for (std::size_t i = productOffsets[r]; i < productOffsets[r + 1]; i++) {
+                derivative[productSpecies[i] * stride] += productCoefficients[i] * rateDerivative;
+            }
+        };
+
+        // temperature derivative at constant concentration
+        const double forwardTDerivative = forwardRateConstantTDerivative[r];
+        const double reverseTDerivative = forwardTDerivative - equilibriumConstantTDerivative[r];
+        addDerivative(productionRatesTDerivativeOut, 1, scale * (forwardTDerivative * forwardRate * forwardProduct - reverseTDerivative * reverseRate * reverseProduct));
+
+        // concentration derivatives through the reactant and product concentrations
+        for (std::size_t a = reactantOffsets[r]; a < reactantOffsets[r + 1]; a++) {
+            double productDerivative = PowerDerivative(concentrationsIn[reactantSpecies[a]], reactantCoefficients[a]);
+            for (std::size_t b = reactantOffsets[r]; b < reactantOffsets[r + 1]; b++) {
+                if (a != b) {
+                    productDerivative *= Power(concentrationsIn[reactantSpecies[b]], reactantCoefficients[b]);
+                }
+            }
+            addDerivative(productionRatesCDerivativeOut + reactantSpecies[a], numberSpecies, scale * forwardRate * productDerivative);
+        }
+        for (std::size_t a = productOffsets[r]; a < productOffsets[r + 1]; a++) {
+            double productDerivative = PowerDerivative(concentrationsIn[productSpecies[a]], productCoefficients[a]);
+            for (std::size_t b = productOffsets[r]; b < productOffsets[r + 1]; b++) {
+                if (a != b) {
+                    productDerivative *= Power(concentrationsIn[productSpecies[b]], productCoefficients[b]);
+                }
+            }
+            addDerivative(productionRatesCDerivativeOut + productSpecies[a], numberSpecies, -scale * reverseRate * productDerivative);
+        }
+
+        // concentration derivatives through the third body concentration
+        if (tb >= 0) {
+            const double thirdBodyDerivative =
+                thirdBodyReaction ? netRate : forwardRateConstantMDerivative[r] * (forwardProduct - inverseEquilibriumConstant[r] * reverseProduct);
+            const double* efficiency = &thirdBodyEfficiencies[tb * numberSpecies];
+            for (std::size_t l = 0; l < numberSpecies; l++) {
+                if (efficiency[l] != 0.0) {
+                    addDerivative(productionRatesCDerivativeOut + l, numberSpecies, efficiency[l] * thirdBodyDerivative);
+                }
+            }
+        }
+    }
+}
+
+double ablate::eos::kinetics::Kinetics::ComputeConcentrations(double pressure, const double* state, double* concentrationsOut) const {
+    const double temperature = state[0];
+    const double* yi = state + 1;
+    const double* molecularWeight = mechanism->molecularWeight.data();
+
+    double inverseMolecularWeight = 0.0;
+    for (std::size_t k = 0; k < numberSpecies; k++) {
+        inverseMolecularWeight += yi[k] / molecularWeight[k];
+    }
+
+    // total concentration in mol/cm^3 and density in g/cm^3
+    const double totalConcentration = pressure / (RU * temperature) * 1E-6;
+    const double density = totalConcentration / inverseMolecularWeight;
+    for (std::size_t k = 0; k < numberSpecies; k++) {
+        concentrationsOut[k] = density * yi[k] / molecularWeight[k];
+    }
+    return density;
+}
+
+void ablate::eos::kinetics::Kinetics::ComputeSourceFromProductionRates(double density, const double* state, double* source, double& cpMix) const {
+    const double temperature = state[0];
+    const double* yi = state + 1;
+    const double* molecularWeight = mechanism->molecularWeight.data();
+
+    // mixture cp in J/(g K) and the heat release in J/(cm^3 s)
+    cpMix = 0.0;
+    double heatRelease = 0.0;
+    for (std::size_t k = 0; k < numberSpecies; k++) {
+        cpMix += yi[k] * speciesCp[k] * RU / molecularWeight[k];
+        heatRelease += speciesEnthalpy[k] * RU * temperature * productionRates[k];
+    }
+
+    source[0] = -heatRelease / (density * cpMix);
+    for (std::size_t k = 0; k < numberSpecies; k++) {
+        source[k + 1] = productionRates[k] * molecularWeight[k] / density;
+    }
+}
+
+void ablate::eos::kinetics::Kinetics::ComputeBatchProductionRates(std::size_t numberPoints) {
+    const std::size_t m = numberPoints;
+    const double* temperature = batchTemperature.data();
+    double* logT = batchLogTemperature.data();
+    double* invT = batchInverseTemperature.data();
+    double* logStandardConcentration = batchLogStandardConcentration.data();
+    for (std::size_t p = 0; p < m; p++) {
+        logT[p] = std::log(temperature[p]);
+        invT[p] = 1.0 / temperature[p];
+        logStandardConcentration[p] = std::log(PATM / (RU * temperature[p]) * 1E-6);
+    }
+
+    // the non-dimensional cp/R, h/RT and g/RT for each species
+    for (std::size_t k = 0; k < numberSpecies; k++) {
+        const double* low = &mechanism->thermoLowCoefficients[7 * k];
+        const double* high = &mechanism->thermoHighCoefficients[7 * k];
+        const double midTemperature = mechanism->thermoMidTemperature[k];
+        double* cp = &batchSpeciesCp[k * BATCH_SIZE];
+        double* enthalpy = &batchSpeciesEnthalpy[k * BATCH_SIZE];
+        double* gibbs = &batchSpeciesGibbs[k * BATCH_SIZE];
+        for (std::size_t p = 0; p < m; p++) {
+            const double T = temperature[p];
+            const double* a = T < midTemperature ? low : high;
+            cp[p] = a[0] + T * (a[1] + T * (a[2] + T * (a[3] + T * a[4])));
+            enthalpy[p] = a[0] + T * (a[1] / 2.0 + T * (a[2] / 3.0 + T * (a[3] / 4.0 + T * a[4] / 5.0))) + a[5] * invT[p];
+            gibbs[p] = enthalpy[p] - (a[0] * logT[p] + T * (a[1] + T * (a[2] / 2.0 + T * (a[3] / 3.0 + T * a[4] / 4.0))) + a[6]);
+        }
+    }
+
+    // the modified Arrhenius rate constants
+    for (std::size_t r = 0; r < numberReactions; r++) {
+        double* forwardRate = &batchForwardRateConstant[r * BATCH_SIZE];
+        if (!reactionActive[r]) {
+            std::fill(forwardRate, forwardRate + m, 0.0);
+            continue;
+        }
+        const double preExponential = mechanism->preExponential[r];
+        const double temperatureExponent = mechanism->temperatureExponent[r];
+        const double activationTemperature = mechanism->activationTemperature[r];
+        for (std::size_t p = 0; p < m; p++) {
+            forwardRate[p] = preExponential * std::exp(temperatureExponent * logT[p] - activationTemperature * invT[p]);
+        }
+    }
+
+    // the third body concentrations
+    for (std::size_t tb = 0; tb < thirdBodyConcentration.size(); tb++) {
+        const double* efficiency = &thirdBodyEfficiencies[tb * numberSpecies];
+        double* concentration = &batchThirdBodyConcentration[tb * BATCH_SIZE];
+        std::fill(concentration, concentration + m, 0.0);
+        for (std::size_t k = 0; k < numberSpecies; k++) {
+            if (efficiency[k] == 0.0) {
+                continue;
+            }
+            const double* speciesConcentration = &batchConcentrations[k * BATCH_SIZE];
+            for (std::size_t p = 0; p < m; p++) {
+                concentration[p] += efficiency[k] * speciesConcentration[p];
+            }
+        }
+    }
+
+    // blend the high and low pressure limits for the falloff reactions
+    for (std::size_t r = 0; r < numberReactions; r++) {
+        const int f = mechanism->falloff[r];
+        if (f < 0 || !reactionActive[r]) {
+            continue;
+        }
+        double* forwardRate = &batchForwardRateConstant[r * BATCH_SIZE];
+        const double* concentration = &batchThirdBodyConcentration[mechanism->thirdBody[r] * BATCH_SIZE];
+        for (std::size_t p = 0; p < m; p++) {
+            const double lowRate = mechanism->lowPreExponential[f] * std::exp(mechanism->lowTemperatureExponent[f] * logT[p] - mechanism->lowActivationTemperature[f] * invT[p]);
+            double rateTDerivative = (mechanism->temperatureExponent[r] + mechanism->activationTemperature[r] * invT[p]) * invT[p];
+            double rateMDerivative;
+            ComputeFalloffRate(*mechanism, f, temperature[p], invT[p], forwardRate[p], lowRate, concentration[p], forwardRate[p], rateTDerivative, rateMDerivative);
+        }
+    }
+
+    // the reverse rate constants from the equilibrium constants in concentration units
+    double* deltaGibbs = batchReverseProduct.data();
+    for (std::size_t r = 0; r < numberReactions; r++) {
+        double* reverseRate = &batchReverseRateConstant[r * BATCH_SIZE];
+        if (!mechanism->reversible[r] || !reactionActive[r]) {
+            std::fill(reverseRate, reverseRate + m, 0.0);
+            continue;
+        }
+        std::fill(deltaGibbs, deltaGibbs + m, 0.0);
+        for (std::size_t i = mechanism->reactantOffsets[r]; i < mechanism->reactantOffsets[r + 1]; i++) {
+            const double coefficient = mechanism->reactantCoefficients[i];
+            const double* gibbs = &batchSpeciesGibbs[mechanism->reactantSpecies[i] * BATCH_SIZE];
+            for (std::size_t p = 0; p < m; p++) {
+                deltaGibbs[p] -= coefficient * gibbs[p];
+            }
+        }
+        for (std::size_t i = mechanism->productOffsets[r]; i < mechanism->productOffsets[r + 1]; i++) {
+            const double coefficient = mechanism->productCoefficients[i];
+            const double* gibbs = &batchSpeciesGibbs[mechanism->productSpecies[i] * BATCH_SIZE];
+            for (std::size_t p = 0; p < m; p++) {
+                deltaGibbs[p] += coefficient * gibbs[p];
+            }
+        }
+        const double* forwardRate = &batchForwardRateConstant[r * BATCH_SIZE];
+        for (std::size_t p = 0; p < m; p++) {
+            reverseRate[p] = forwardRate[p] * std::exp(deltaGibbs[p] - deltaMoles[r] * logStandardConcentration[p]);
+        }
+    }
+
+    // the rates of progress added to each species in the reaction
+    std::fill(batchProductionRates.begin(), batchProductionRates.end(), 0.0);
+    double* forwardProduct = batchForwardProduct.data();
+    double* reverseProduct = batchReverseProduct.data();
+    for (std::size_t r = 0; r < numberReactions; r++) {
+        if (!reactionActive[r]) {
+            continue;
+        }
+        std::copy_n(&batchForwardRateConstant[r * BATCH_SIZE], m, forwardProduct);
+        std::copy_n(&batchReverseRateConstant[r * BATCH_SIZE], m, reverseProduct);
+        for (std::size_t i = mechanism->reactantOffsets[r]; i < mechanism->reactantOffsets[r + 1]; i++) {
+            const double coefficient = mechanism->reactantCoefficients[i];
+            const double* concentration = &batchConcentrations[mechanism->reactantSpecies[i] * BATCH_SIZE];
+            for (std::size_t p = 0; p < m; p++) {
+                forwardProduct[p] *= Power(concentration[p], coefficient);
+            }
+        }
+        for (std::size_t i = mechanism->productOffsets[r]; i < mechanism->productOffsets[r + 1]; i++) {
+            const double coefficient = mechanism->productCoefficients[i];
+            const double* concentration = &batchConcentrations[mechanism->productSpecies[i] * BATCH_SIZE];
+            for (std::size_t p = 0; p < m; p++) {
+                reverseProduct[p] *= Power(concentration[p], coefficient);
+            }
+        }
+
+        // the net rate is stored in the forward product
+        const int tb = mechanism->thirdBody[r];
+        if (tb >= 0 && mechanism->falloff[r] < 0) {
+            const double* concentration = &batchThirdBodyConcentration[tb * BATCH_SIZE];
+            for (std::size_t p = 0; p < m; p++) {
+                forwardProduct[p] = concentration[p] * (forwardProduct[p] - reverseProduct[p]);
+            }
+        } else {
+            for (std::size_t p = 0; p < m; p++) {
+                forwardProduct[p] -= reverseProduct[p];
+            }
+        }
+
+        for (std::size_t i = mechanism->reactantOffsets[r]; i < mechanism->reactantOffsets[r + 1]; i++) {
+            const double coefficient = mechanism->reactantCoefficients[i];
+            double* rate = &batchProductionRates[mechanism->reactantSpecies[i] * BATCH_SIZE];
+            for (std::size_t p = 0; p < m; p++) {
+                rate[p] -= coefficient * forwardProduct[p];
+            }
+        }
+        for (std::size_t i = mechanism->productOffsets[r]; i < mechanism->productOffsets[r + 1]; i++) {
+            const double coefficient = mechanism->productCoefficients[i];
+            double* rate = &batchProductionRates[mechanism->productSpecies[i] * BATCH_SIZE];
+            for (std::size_t p = 0; p < m; p++) {
+                rate[p] += coefficient * forwardProduct[p];
+            }
+        }
+    }
+}
+
+void ablate::eos::kinetics::Kinetics::ComputeProductionRates(std::size_t numberPoints, const double* temperature, const double* concentrationsIn, double* productionRatesOut) {
+    for (std::size_t start = 0; start < numberPoints; start += BATCH_SIZE) {
+        const std::size_t m = std::min(BATCH_SIZE, numberPoints - start);
+
+        // copy the points into the batch, stored point fastest
+        for (std::size_t p = 0; p < m; p++) {
+            batchTemperature[p] = temperature[start + p];
+            for (std::size_t k = 0; k < numberSpecies; k++) {
+                batchConcentrations[k * BATCH_SIZE + p] = concentrationsIn[(start + p) * numberSpecies + k];
+            }
+        }
+
+        ComputeBatchProductionRates(m);
+
+        for (std::size_t p = 0; p < m; p++) {
+            for (std::size_t k = 0; k < numberSpecies; k++) {
+                productionRatesOut[(start + p) * numberSpecies + k] = batchProductionRates[k * BATCH_SIZE + p];
+            }
+        }
+    }
+}
+
+void ablate::eos::kinetics::Kinetics::ComputeSource(std::size_t numberPoints, const double* pressure, const double* state, double* source) {
+    const std::size_t stateSize = numberSpecies + 1;
+    const double* molecularWeight = mechanism->molecularWeight.data();
+    for (std::size_t start = 0; start < numberPoints; start += BATCH_SIZE) {
+        const std::size_t m = std::min(BATCH_SIZE, numberPoints - start);
+
+        // compute the density and species concentrations of each point in the batch
+        for (std::size_t p = 0; p < m; p++) {
+            const double* pointState = state + (start + p) * stateSize;
+            batchTemperature[p] = pointState[0];
+            batchDensity[p] = ComputeConcentrations(pressure[start + p], pointState, concentrations.data());
+            for (std::size_t k = 0; k < numberSpecies; k++) {
+                batchConcentrations[k * BATCH_SIZE + p] = concentrations[k];
+            }
+        }
+
+        ComputeBatchProductionRates(m);
+
+        // the constant pressure source, see ComputeSourceFromProductionRates
+        for (std::size_t p = 0; p < m; p++) {
+            const double* yi = state + (start + p) * stateSize + 1;
+            double* pointSource = source + (start + p) * stateSize;
+            const double density = batchDensity[p];
+            double cpMix = 0.0;
+            double heatRelease = 0.0;
+            for (std::size_t k = 0; k < numberSpecies; k++) {
+                const double productionRate = batchProductionRates[k * BATCH_SIZE + p];
+                cpMix += yi[k] * batchSpeciesCp[k * BATCH_SIZE + p] * RU / molecularWeight[k];
+                heatRelease += batchSpeciesEnthalpy[k * BATCH_SIZE + p] * RU * batchTemperature[p] * productionRate;
+                pointSource[k + 1] = productionRate * molecularWeight[k] / density;
+            }
+            pointSource[0] = -heatRelease / (density * cpMix);
+        }
+    }
+}
+
+void ablate::eos::kinetics::Kinetics::ComputeSourceJacobian(double pressure, const double* state, double* source, double* jacobian) {
+    const std::size_t n = numberSpecies + 1;
+    const double temperature = state[0];
+    const double* yi = state + 1;
+    const double* molecularWeight = mechanism->molecularWeight.data();
+
+    const double density = ComputeConcentrations(pressure, state, concentrations.data());
+    ComputeProductionRates(temperature, concentrations.data(), productionRates.data(), productionRatesCDerivative.data(), productionRatesTDerivative.data());
+    double cpMix;
+    ComputeSourceFromProductionRates(density, state, source, cpMix);
+
+    // the mixture molecular weight and d cp/dT
+    double mixtureMolecularWeight = 0.0;
+    double cpMixTDerivative = 0.0;
+    for (std::size_t k = 0; k < numberSpecies; k++) {
+        mixtureMolecularWeight += yi[k] / molecularWeight[k];
+        cpMixTDerivative += yi[k] * speciesCpDerivative[k] * RU / molecularWeight[k];
+    }
+    mixtureMolecularWeight = 1.0 / mixtureMolecularWeight;
+
+    // At constant pressure, dC_l/dY_j = rho/W_l delta_lj - C_l Wmix/W_j and dC_l/dT = -C_l/T.  Store sum_l dw_k/dC_l C_l to apply the chain rule.
+    auto& concentrationSum = productionRatesCSum;
+    for (std::size_t k = 0; k < numberSpecies; k++) {
+        const double* row = &productionRatesCDerivative[k * numberSpecies];
+        double sum = 0.0;
+        for (std::size_t l = 0; l < numberSpecies; l++) {
+            sum += row[l] * concentrations[l];
+        }
+        concentrationSum[k] = sum;
+    }
+    auto productionRateYDerivative = [&](std::size_t k, std::size_t j) {
+        return productionRatesCDerivative[k * numberSpecies + j] * density / molecularWeight[j] - concentrationSum[k] * mixtureMolecularWeight / molecularWeight[j];
+    };
+
+    // the species rows, dYk/dt = w_k W_k / rho with drho/dY_j = -rho Wmix/W_j and drho/dT = -rho/T
+    for (std::size_t k = 0; k < numberSpecies; k++) {
+        const double productionRateTDerivative = productionRatesTDerivative[k] - concentrationSum[k] / temperature;
+        jacobian[(k + 1)] = molecularWeight[k] / density * productionRateTDerivative + source[k + 1] / temperature;
+        for (std::size_t j = 0; j < numberSpecies; j++) {
+            jacobian[(k + 1) + (j + 1) * n] = molecularWeight[k] / density * productionRateYDerivative(k, j) + source[k + 1] * mixtureMolecularWeight / molecularWeight[j];
+        }
+    }
+
+    // the temperature row, dT/dt = -sum(h_k w_k)/(rho cp)
+    double heatReleaseTDerivative = 0.0;
+    for (std::size_t k = 0; k < numberSpecies; k++) {
+        const double productionRateTDerivative = productionRatesTDerivative[k] - concentrationSum[k] / temperature;
+        heatReleaseTDerivative += speciesEnthalpy[k] * RU * temperature * productionRateTDerivative + speciesCp[k] * RU * productionRates[k];
+    }
+    jacobian[0] = -heatReleaseTDerivative / (density * cpMix) - source[0] * (-1.0 / temperature + cpMixTDerivative / cpMix);
+    for (std::size_t j = 0; j < numberSpecies; j++) {
+        double heatReleaseYDerivative = 0.0;
+        for (std::size_t k = 0; k < numberSpecies; k++) {
+            heatReleaseYDerivative += speciesEnthalpy[k] * RU * temperature * productionRateYDerivative(k, j);
+        }
+        const double cpMixYDerivative = speciesCp[j] * RU / molecularWeight[j];
+        jacobian[(j + 1) * n] = -heatReleaseYDerivative / (density * cpMix) - source[0] * (-mixtureMolecularWeight / molecularWeight[j] + cpMixYDerivative / cpMix);
+    }
+}
@@ -0,0 +1,165 @@
+#ifndef ABLATELIBRARY_KINETICS_HPP
+#define ABLATELIBRARY_KINETICS_HPP
+
+#include <memory>
+#include <vector>
+#include "mechanism.hpp"
+
+namespace ablate::eos::kinetics {
+
+/**
+ * Evaluates the species production rates, constant pressure source terms, and the analytic source Jacobian for a parsed mechanism.  The rate constants are evaluated
+ * with flat loops over the reactions.  The batched production rates and sources evaluate up to BATCH_SIZE points together with the points in the innermost loop, so
+ * each loop over the reactions or species is a contiguous loop over the points.  The mechanism is shared and read-only, so separate Kinetics objects (each with its own
+ * workspace) can be used concurrently.
+ */
+class Kinetics {
+   public:
+    // the universal gas constant (J/(mol K))
+    inline static const double RU = 8.31446261815324;
+    // the reference pressure for the equilibrium constants (Pa)
+    inline static const double PATM = 101325.0;
+
+   private:
+    const std::shared_ptr<Mechanism> mechanism;
+    const std::size_t numberSpecies;
+    const std::size_t numberReactions;
+
+    // precomputed reaction data
+    std::vector<double> deltaMoles;
+    std::vector<double> thirdBodyEfficiencies;
+
+    // per point workspace
+    std::vector<double> speciesCp;
+    std::vector<double> speciesEnthalpy;
+    std::vector<double> speciesEntropy;
+    std::vector<double> speciesCpDerivative;
+    std::vector<double> speciesGibbs;
+    std::vector<double> forwardRateConstant;
+    std::vector<double> forwardRateConstantTDerivative;
+    std::vector<double> forwardRateConstantMDerivative;
+    std::vector<double> inverseEquilibriumConstant;
+    std::vector<double> equilibriumConstantTDerivative;
+    std::vector<double> thirdBodyConcentration;
+    std::vector<double> concentrations;
+    std::vector<double> productionRates;
+    std::vector<double> productionRatesCDerivative;
+    std::vector<double> productionRatesTDerivative;
+    std::vector<double> productionRatesCSum;
+
+    // reactions that are not active are skipped (zero rate of progress)
+    std::vector<unsigned char> reactionActive;
+
+    // batch workspace, each value is stored point fastest (value[i * BATCH_SIZE + p])
+    std::vector<double> batchTemperature;
+    std::vector<double> batchLogTemperature;
+    std::vector<double> batchInverseTemperature;
+    std::vector<double> batchLogStandardConcentration;
+    std::vector<double> batchDensity;
+    std::vector<double> batchConcentrations;
+    std::vector<double> batchSpeciesCp;
+    std::vector<double> batchSpeciesEnthalpy;
+    std::vector<double> batchSpeciesGibbs;
+    std::vector<double> batchForwardRateConstant;
+    std::vector<double> batchReverseRateConstant;
+    std::vector<double> batchThirdBodyConcentration;
+    std::vector<double> batchForwardProduct;
+    std::vector<double> batchReverseProduct;
+    std::vector<double> batchProductionRates;
+
+    /**
+     * computes the non-dimensional cp/R, h/RT, s/R and d(cp/R)/dT for each species
+     */
+    void ComputeSpeciesThermo(double temperature);
+
+    /**
+     * computes the forward rate constants (including falloff), their temperature and third body derivatives, the equilibrium constants, and third body concentrations
+     */
+    void ComputeRateConstants(double temperature, const double* concentrations);
+
+    /**
+     * computes the mixture cp and the source terms from the production rates and the state
+     */
+    void ComputeSourceFromProductionRates(double density, const double* state, double* source, double& cpMix) const;
+
+    /**
+     * computes the production rate (mol/(cm^3 s)) for each species.  If requested the derivatives with respect to concentration (row major, dw_k/dC_l) and temperature are also computed.
+     */
+    void ComputeProductionRates(double temperature, const double* concentrations, double* productionRates, double* productionRatesCDerivative, double* productionRatesTDerivative);
+
+    /**
+     * computes the production rates for the first numberPoints (at most BATCH_SIZE) points in batchTemperature and batchConcentrations.  The result is stored in
+     * batchProductionRates and the species thermo in batchSpeciesCp and batchSpeciesEnthalpy.
+     */
+    void ComputeBatchProductionRates(std::size_t numberPoints);
+
+   public:
+    // the number of points evaluated together by the batched functions
+    inline static const std::size_t BATCH_SIZE = 32;
+
+    explicit Kinetics(std::shared_ptr<Mechanism> mechanism);
+
+    inline const Mechanism& GetMechanism() const { return *mechanism; }
+    inline std::size_t GetNumberSpecies() const { return numberSpecies; }
+    inline std::size_t GetNumberReactions() const { return numberReactions; }
+
+    /**
+     * Limits the evaluation to a subset of the reactions.  Inactive reactions are skipped and contribute nothing to the rates, source, or Jacobian.
+     * @param active a flag for each reaction
+     */
+    void SetActiveReactions(const std::vector<unsigned char>& active);
+
+    /**
+     * Restores the evaluation of every reaction
+     */
+    void ResetActiveReactions();
+
+    /**
+     * Computes the production rate (mol/(cm^3 s)) for each species for a batch of points.  The points are evaluated BATCH_SIZE at a time.
+     * @param numberPoints
+     * @param temperature the temperature (K) at each point
+     * @param concentrations the species concentrations (mol/cm^3), numberSpecies per point
+     * @param productionRates the resulting production rate, numberSpecies per point
+     */
+    void ComputeProductionRates(std::size_t numberPoints, const double* temperature, const double* concentrations, double* productionRates);
+
+    /**
+     * Computes the constant pressure source (dT/dt, dYi/dt) for a batch of points with state (T, Yi).  This is equivalent to TC_getSrc.  Like
+     * ComputeProductionRates, the points are evaluated BATCH_SIZE at a time.
+     * @param numberPoints
+     * @param pressure the pressure (Pa) at each point
+     * @param state the state (T, Yi), numberSpecies + 1 per point
+     * @param source the source (dT/dt, dYi/dt), numberSpecies + 1 per point
+     */
+    void ComputeSource(std::size_t numberPoints, const double* pressure, const double* state, double* source);
+
+    /**
+     * Computes the constant pressure source and its analytic Jacobian with respect to the state (T, Yi) for a single point.  The Jacobian is stored column major,
+     * jacobian[i + j*(numberSpecies+1)] = d source_i / d state_j, matching TC_getJacTYN.
+     * @param pressure
+     * @param state
+     * @param source
+     * @param jacobian
+     */
+    void ComputeSourceJacobian(double pressure, const double* state, double* source, double* jacobian);
+
+    /**
+     * Computes the rates of progress (mol/(cm^3 s)) for each reaction at a single point
+     * @param temperature
+     * @param concentrations
+     * @param ratesOfProgress
+     */
+    void ComputeRatesOfProgress(double temperature, const double* concentrations, double* ratesOfProgress);
+
+    /**
+     * Converts the state (T, Yi) at the given pressure to the density (g/cm^3) and species concentrations (mol/cm^3)
+     * @param pressure
+     * @param state
+     * @param concentrations
+     * @return the density (g/cm^3)
+     */
+    double ComputeConcentrations(double pressure, const double* state, double* concentrations) const;
+};
+
+}  // namespace ablate::eos::kinetics
+#endif  // ABLATELIBRARY_KINETICS_HPP
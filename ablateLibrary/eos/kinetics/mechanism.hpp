@@ -0,0 +1,72 @@
+#ifndef ABLATELIBRARY_MECHANISM_HPP
+#define ABLATELIBRARY_MECHANISM_HPP
+
+#include <string>
+#include <vector>
+
+namespace ablate::eos::kinetics {
+
+/**
+ * The parsed mechanism and thermodynamic data stored as flat arrays.  All rate parameters are in CHEMKIN units (mol, cm, s) with the activation energy stored as an activation temperature (K).
+ */
+struct Mechanism {
+    enum FalloffType { Lindemann = 0, Troe = 1 };
+
+    // element and species names
+    std::vector<std::string> elements;
+    std::vector<std::string> species;
+
+    // species molecular weight (g/mol)
+    std::vector<double> molecularWeight;
+
+    // NASA 7 coefficient polynomials, 7 coefficients per species for the low and high temperature ranges
+    std::vector<double> thermoMidTemperature;
+    std::vector<double> thermoLowCoefficients;
+    std::vector<double> thermoHighCoefficients;
+
+    // the equation for each reaction
+    std::vector<std::string> equations;
+
+    // the modified Arrhenius coefficients for each reaction, k = A T^b exp(-Ta/T)
+    std::vector<double> preExponential;
+    std::vector<double> temperatureExponent;
+    std::vector<double> activationTemperature;
+    std::vector<int> reversible;
+
+    // the reactant and product stoichiometry in compressed row format
+    std::vector<std::size_t> reactantOffsets;
+    std::vector<int> reactantSpecies;
+    std::vector<double> reactantCoefficients;
+    std::vector<std::size_t> productOffsets;
+    std::vector<int> productSpecies;
+    std::vector<double> productCoefficients;
+
+    // the index into the third body data for each reaction (-1 if not a third body or falloff reaction)
+    std::vector<int> thirdBody;
+    // the single species acting as the third body (-1 for the mixture)
+    std::vector<int> thirdBodySpecies;
+    // the enhanced efficiencies for each third body in compressed row format.  Unlisted species have an efficiency of one.
+    std::vector<std::size_t> efficiencyOffsets;
+    std::vector<int> efficiencySpecies;
+    std::vector<double> efficiencies;
+
+    // the index into the falloff data for each reaction (-1 if not a falloff reaction)
+    std::vector<int> falloff;
+    std::vector<int> falloffType;
+    // the low pressure Arrhenius coefficients
+    std::vector<double> lowPreExponential;
+    std::vector<double> lowTemperatureExponent;
+    std::vector<double> lowActivationTemperature;
+    // the Troe parameters a, T***, T*, T** (the T** term is optional)
+    std::vector<double> troeA;
+    std::vector<double> troeT3;
+    std::vector<double> troeT1;
+    std::vector<double> troeT2;
+    std::vector<int> troeHasT2;
+
+    inline std::size_t NumberSpecies() const { return species.size(); }
+    inline std::size_t NumberReactions() const { return preExponential.size(); }
+};
+
+}  // namespace ablate::eos::kinetics
+#endif  // ABLATELIBRARY_MECHANISM_HPP
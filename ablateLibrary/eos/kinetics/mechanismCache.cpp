@@ -0,0 +1,211 @@
+#include "mechanismCache.hpp"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+/**
+ * Visits every field of the mechanism in a fixed order so that the writer and reader cannot get out of sync
+ */
+template <typename MechanismType, typename Visitor>
+void VisitFields(MechanismType& mechanism, Visitor&& visit) {
+    visit(mechanism.elements);
+    visit(mechanism.species);
+    visit(mechanism.molecularWeight);
+    visit(mechanism.thermoMidTemperature);
+    visit(mechanism.thermoLowCoefficients);
+    visit(mechanism.thermoHighCoefficients);
+    visit(mechanism.equations);
+    visit(mechanism.preExponential);
+    visit(mechanism.temperatureExponent);
+    visit(mechanism.activationTemperature);
+    visit(mechanism.reversible);
+    visit(mechanism.reactantOffsets);
+    visit(mechanism.reactantSpecies);
+    visit(mechanism.reactantCoefficients);
+    visit(mechanism.productOffsets);
+    visit(mechanism.productSpecies);
+    visit(mechanism.productCoefficients);
+    visit(mechanism.thirdBody);
+    visit(mechanism.thirdBodySpecies);
+    visit(mechanism.efficiencyOffsets);
+    visit(mechanism.efficiencySpecies);
+    visit(mechanism.efficiencies);
+    visit(mechanism.falloff);
+    visit(mechanism.falloffType);
+    visit(mechanism.lowPreExponential);
+    visit(mechanism.lowTemperatureExponent);
+    visit(mechanism.lowActivationTemperature);
+    visit(mechanism.troeA);
+    visit(mechanism.troeT3);
+    visit(mechanism.troeT1);
+    visit(mechanism.troeT2);
+    visit(mechanism.troeHasT2);
+}
+
+class BufferWriter {
+   private:
+    std::vector<char>& buffer;
+
+    void WriteBytes(const void* data, std::size_t size) {
+        if (size == 0) {
+            return;
+        }
+        const char* bytes = static_cast<const char*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+   public:
+    explicit BufferWriter(std::vector<char>& buffer) : buffer(buffer) {}
+
+    template <typename T>
+    void operator()(const std::vector<T>& values) {
+        std::uint64_t size = values.size();
+        WriteBytes(&size, sizeof(size));
+        WriteBytes(values.data(), values.size() * sizeof(T));
+    }
+
+    void operator()(const std::vector<std::string>& values) {
+        std::uint64_t size = values.size();
+        WriteBytes(&size, sizeof(size));
+        for (const auto& value : values) {
+            std::uint64_t length = value.size();
+            WriteBytes(&length, sizeof(length));
+            WriteBytes(value.data(), value.size());
+        }
+    }
+};
+
+class BufferReader {
+   private:
+    const std::vector<char>& buffer;
+    std::size_t position = 0;
+
+    void ReadBytes(void* data, std::size_t size) {
+        if (size == 0) {
+            return;
+        }
+        if (position + size > buffer.size()) {
+            throw std::runtime_error("The serialized mechanism is truncated");
+        }
+        std::memcpy(data, buffer.data() + position, size);
+        position += size;
+    }
+
+   public:
+    explicit BufferReader(const std::vector<char>& buffer) : buffer(buffer) {}
+
+    template <typename T>
+    void operator()(std::vector<T>& values) {
+        std::uint64_t size;
+        ReadBytes(&size, sizeof(size));
+        if (size > (buffer.size() - position) / sizeof(T)) {
+            throw std::runtime_error("The serialized mechanism is truncated");
+        }
+        values.resize(size);
+        ReadBytes(values.data(), size * sizeof(T));
+    }
+
+    void operator()(std::vector<std::string>& values) {
+        std::uint64_t size;
+        ReadBytes(&size, sizeof(size));
+        values.clear();
+        for (std::uint64_t i = 0; i < size; i++) {
+            std::uint64_t length;
+            ReadBytes(&length, sizeof(length));
+            if (length > buffer.size() - position) {
+                throw std::runtime_error("The serialized mechanism is truncated");
+            }
+            values.emplace_back(buffer.data() + position, length);
+            position += length;
+        }
+    }
+
+    bool Complete() const { return position == buffer.size(); }
+};
+}  // namespace
+
+std::uint64_t ablate::eos::kinetics::MechanismCache::Hash(std::istream& stream) {
+    const std::uint64_t prime = 1099511628211ULL;
+    std::uint64_t hash = 14695981039346656037ULL;
+    char chunk[4096];
+    while (stream.read(chunk, sizeof(chunk)) || stream.gcount() > 0) {
+        for (std::streamsize i = 0; i < stream.gcount(); i++) {
+            hash ^= (std::uint64_t)(unsigned char)chunk[i];
+            hash *= prime;
+        }
+    }
+    return hash;
+}
+
+std::uint64_t ablate::eos::kinetics::MechanismCache::Hash(const std::filesystem::path& file) {
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream) {
+        throw std::invalid_argument("Unable to open " + file.string() + " to compute the hash");
+    }
+    return Hash(stream);
+}
+
+std::vector<char> ablate::eos::kinetics::MechanismCache::Serialize(const Mechanism& mechanism) {
+    std::vector<char> buffer;
+    VisitFields(mechanism, BufferWriter(buffer));
+    return buffer;
+}
+
+std::shared_ptr<ablate::eos::kinetics::Mechanism> ablate::eos::kinetics::MechanismCache::Deserialize(const std::vector<char>& buffer) {
+    auto mechanism = std::make_shared<Mechanism>();
+    BufferReader reader(buffer);
+    VisitFields(*mechanism, reader);
+    if (!reader.Complete()) {
+        throw std::runtime_error("The serialized mechanism has unexpected trailing data");
+    }
+    return mechanism;
+}
+
+void ablate::eos::kinetics::MechanismCache::Write(std::ostream& stream, const std::vector<char>& buffer, std::uint64_t mechHash, std::uint64_t thermoHash) {
+    const std::uint64_t size = buffer.size();
+    stream.write(MAGIC, sizeof(MAGIC));
+    stream.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    stream.write(reinterpret_cast<const char*>(&mechHash), sizeof(mechHash));
+    stream.write(reinterpret_cast<const char*>(&thermoHash), sizeof(thermoHash));
+    stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    stream.write(buffer.data(), buffer.size());
+}
+
+bool ablate::eos::kinetics::MechanismCache::Read(std::istream& stream, std::uint64_t mechHash, std::uint64_t thermoHash, std::vector<char>& buffer) {
+    char magic[sizeof(MAGIC)];
+    std::uint32_t version;
+    std::uint64_t cachedMechHash, cachedThermoHash, size;
+    stream.read(magic, sizeof(magic));
+    stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+    stream.read(reinterpret_cast<char*>(&cachedMechHash), sizeof(cachedMechHash));
+    stream.read(reinterpret_cast<char*>(&cachedThermoHash), sizeof(cachedThermoHash));
+    stream.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!stream || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION || cachedMechHash != mechHash || cachedThermoHash != thermoHash) {
+        return false;
+    }
+
+    // the size is checked against the rest of the stream so that a corrupt header cannot allocate an arbitrarily large buffer
+    const auto dataStart = stream.tellg();
+    stream.seekg(0, std::ios::end);
+    const auto dataEnd = stream.tellg();
+    stream.seekg(dataStart);
+    if (!stream || dataStart < 0 || dataEnd < dataStart || size > (std::uint64_t)(dataEnd - dataStart)) {
+        return false;
+    }
+
+    buffer.resize(size);
+    stream.read(buffer.data(), size);
+    if (!stream || (std::uint64_t)stream.gcount() != size) {
+        return false;
+    }
+
+    // a cache that was truncated or corrupted after it was written still matches the hashes, so the contents must unpack
+    try {
+        Deserialize(buffer);
+    } catch (std::exception&) {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,78 @@
+#ifndef ABLATELIBRARY_MECHANISMCACHE_HPP
+#define ABLATELIBRARY_MECHANISMCACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <vector>
+#include "mechanism.hpp"
+
+namespace ablate::eos::kinetics {
+
+/**
+ * Stores a parsed mechanism in a versioned binary format so that it can be reloaded (or broadcast) without parsing the CHEMKIN text files.  The cache is keyed
+ * by the hashes of the mechanism and thermo files and is considered stale if either file or the format version changes.
+ */
+class MechanismCache {
+   public:
+    // increment whenever the Mechanism layout or the parser output changes
+    inline static const std::uint32_t VERSION = 1;
+
+   private:
+    MechanismCache() = delete;
+
+    inline static const char MAGIC[8] = {'A', 'B', 'L', 'M', 'E', 'C', 'H', '\0'};
+
+   public:
+    /**
+     * Computes the 64 bit FNV-1a hash of the stream contents
+     * @param stream
+     * @return
+     */
+    static std::uint64_t Hash(std::istream& stream);
+
+    /**
+     * Computes the 64 bit FNV-1a hash of the file contents
+     * @param file
+     * @return
+     */
+    static std::uint64_t Hash(const std::filesystem::path& file);
+
+    /**
+     * Packs the mechanism into a byte buffer
+     * @param mechanism
+     * @return
+     */
+    static std::vector<char> Serialize(const Mechanism& mechanism);
+
+    /**
+     * Unpacks a mechanism from a byte buffer created by Serialize
+     * @param buffer
+     * @return
+     */
+    static std::shared_ptr<Mechanism> Deserialize(const std::vector<char>& buffer);
+
+    /**
+     * Writes the serialized mechanism with a header holding the version and input hashes
+     * @param stream
+     * @param buffer the serialized mechanism
+     * @param mechHash
+     * @param thermoHash
+     */
+    static void Write(std::ostream& stream, const std::vector<char>& buffer, std::uint64_t mechHash, std::uint64_t thermoHash);
+
+    /**
+     * Reads the serialized mechanism if the header matches the version and input hashes and the contents can be deserialized
+     * @param stream a seekable stream
+     * @param mechHash
+     * @param thermoHash
+     * @param buffer the serialized mechanism
+     * @return false if the cache is missing, stale, or corrupt
+     */
+    static bool Read(std::istream& stream, std::uint64_t mechHash, std::uint64_t thermoHash, std::vector<char>& buffer);
+};
+
+}  // namespace ablate::eos::kinetics
+#endif  // ABLATELIBRARY_MECHANISMCACHE_HPP
@@ -1,7 +1,16 @@
 #include "tChem.hpp"
 
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include "kinetics/chemkinParser.hpp"
+#include "kinetics/mechanismCache.hpp"
+#include "utilities/petscError.hpp"
+#include "utilities/workingDirectory.hpp"
 
 #if defined(PETSC_HAVE_TCHEM)
 #if defined(MAX)
@@ -17,20 +26,45 @@
 #error TChem is required.  Reconfigure PETSc using --download-tchem.
 #endif
 
-ablate::eos::TChem::TChem(std::filesystem::path mechFileIn, std::filesystem::path thermoFileIn)
-    : EOS("TChemV1"), errorChecker("Error in TChem library, return code "), mechFile(mechFileIn), thermoFile(thermoFileIn) {
-    // TChem requires a periodic file in the working directory.  To simplify setup, we will just write it every time we are run
+ablate::eos::TChem::TChem(std::filesystem::path mechFileIn, std::filesystem::path thermoFileIn, std::filesystem::path mechanismCacheFileIn)
+    : EOS("TChemV1"), errorChecker("Error in TChem library, return code "), mechFile(mechFileIn), thermoFile(thermoFileIn), mechanismCacheFile(mechanismCacheFileIn) {
+    // only rank 0 reads the input files from the (shared) file system
+    const auto mechContents = BroadcastFromRoot([this]() { return ReadFile(mechFile); });
+    const auto thermoContents = BroadcastFromRoot([this]() { return ReadFile(thermoFile); });
+
+    // TChem reads the input files and the periodic table and writes its logs in the working directory, so each rank initializes from copies in a node local
+    // scratch directory
     int rank;
     MPI_Comm_rank(PETSC_COMM_WORLD, &rank) >> checkMpiError;
-    if (rank == 0) {
-        std::ofstream periodicTableFile(periodicTableFileName);
-        periodicTableFile << periodicTable;
-        periodicTableFile.close();
+    char tmpDirectory[PETSC_MAX_PATH_LEN];
+    PetscGetTmp(PETSC_COMM_SELF, tmpDirectory, sizeof(tmpDirectory)) >> checkError;
+    const auto scratchDirectory = std::filesystem::path(tmpDirectory) / ("ablateTChem_" + std::to_string(getpid()) + "_" + std::to_string(rank));
+    std::filesystem::create_directories(scratchDirectory);
+    const auto writeScratchFile = [&scratchDirectory](const std::string &name, const char *data, std::size_t size) {
+        std::ofstream stream(scratchDirectory / name, std::ios::binary);
+        stream.write(data, size);
+        stream.close();
+        if (!stream) {
+            throw std::runtime_error("Unable to write the TChem scratch file " + (scratchDirectory / name).string());
+        }
+    };
+
+    int tChemError;
+    try {
+        writeScratchFile("mech.dat", mechContents.data(), mechContents.size());
+        writeScratchFile("thermo.dat", thermoContents.data(), thermoContents.size());
+        writeScratchFile(periodicTableFileName, periodicTable, std::strlen(periodicTable));
+
+        // initialize TChem (with tabulation off?) in the scratch directory, the working directory is restored even if TChem throws
+        utilities::WorkingDirectory scratchWorkingDirectory(scratchDirectory);
+        tChemError = TC_initChem((char *)"mech.dat", (char *)"thermo.dat", 0, 1.0);
+    } catch (...) {
+        std::error_code removeError;
+        std::filesystem::remove_all(scratchDirectory, removeError);
+        throw;
     }
-    MPI_Barrier(PETSC_COMM_WORLD);
-
-    // initialize TChem (with tabulation off?)
-    TC_initChem((char *)mechFile.c_str(), (char *)thermoFile.c_str(), 0, 1.0) >> errorChecker;
+    std::filesystem::remove_all(scratchDirectory);
+    tChemError >> errorChecker;
 
     // March over and get each species name
     numberSpecies = TC_getNspec();
@@ -55,6 +89,80 @@ ablate::eos::TChem::~TChem() {
 
 const std::vector<std::string> &ablate::eos::TChem::GetSpecies() const { return species; }
 
+std::shared_ptr<ablate::eos::kinetics::Mechanism> ablate::eos::TChem::GetMechanism() {
+    if (mechanism) {
+        return mechanism;
+    }
+
+    // only rank 0 touches the file system, the serialized mechanism is shared with every rank
+    auto buffer = BroadcastFromRoot([this]() {
+        std::vector<char> serialized;
+        const auto mechHash = kinetics::MechanismCache::Hash(mechFile);
+        const auto thermoHash = kinetics::MechanismCache::Hash(thermoFile);
+
+        // use the cache if it was built from the same input files
+        bool cacheCurrent = false;
+        if (!mechanismCacheFile.empty() && std::filesystem::exists(mechanismCacheFile)) {
+            std::ifstream cacheStream(mechanismCacheFile, std::ios::binary);
+            cacheCurrent = kinetics::MechanismCache::Read(cacheStream, mechHash, thermoHash, serialized);
+        }
+
+        // otherwise parse the text files and update the cache
+        if (!cacheCurrent) {
+            serialized = kinetics::MechanismCache::Serialize(*kinetics::ChemkinParser::Parse(mechFile, thermoFile));
+            if (!mechanismCacheFile.empty()) {
+                std::ofstream cacheStream(mechanismCacheFile, std::ios::binary | std::ios::trunc);
+                kinetics::MechanismCache::Write(cacheStream, serialized, mechHash, thermoHash);
+            }
+        }
+        return serialized;
+    });
+
+    mechanism = kinetics::MechanismCache::Deserialize(buffer);
+    return mechanism;
+}
+
+std::vector<char> ablate::eos::TChem::BroadcastFromRoot(const std::function<std::vector<char>()> &read) {
+    int rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD, &rank) >> checkMpiError;
+
+    // the status is shared with the size so that the other ranks are not left waiting for data when rank 0 fails
+    std::vector<char> buffer;
+    unsigned long long statusAndSize[2] = {0, 0};
+    if (rank == 0) {
+        try {
+            buffer = read();
+        } catch (std::exception &exception) {
+            const std::string message = exception.what();
+            buffer.assign(message.begin(), message.end());
+            statusAndSize[0] = 1;
+        }
+        statusAndSize[1] = buffer.size();
+    }
+    MPI_Bcast(statusAndSize, 2, MPI_UNSIGNED_LONG_LONG, 0, PETSC_COMM_WORLD) >> checkMpiError;
+    buffer.resize(statusAndSize[1]);
+
+    // the mpi count is an int, so large buffers are broadcast in chunks
+    const unsigned long long chunkSize = std::numeric_limits<int>::max();
+    for (unsigned long long offset = 0; offset < statusAndSize[1]; offset += chunkSize) {
+        const int count = (int)std::min(chunkSize, statusAndSize[1] - offset);
+        MPI_Bcast(buffer.data() + offset, count, MPI_CHAR, 0, PETSC_COMM_WORLD) >> checkMpiError;
+    }
+
+    if (statusAndSize[0]) {
+        throw std::runtime_error(std::string(buffer.begin(), buffer.end()));
+    }
+    return buffer;
+}
+
+std::vector<char> ablate::eos::TChem::ReadFile(const std::filesystem::path &file) {
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream) {
+        throw std::invalid_argument("Unable to read the TChem input file " + file.string());
+    }
+    return std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
 void ablate::eos::TChem::View(std::ostream &stream) const {
     stream << "EOS: " << type << std::endl;
     stream << "\tmechFile: " << mechFile << std::endl;
@@ -88,8 +196,9 @@ int ablate::eos::TChem::ComputeSensibleInternalEnergy(int numSpec, double *tempY
     return err;
 }
 
-PetscErrorCode ablate::eos::TChem::ComputeTemperature(int numSpec, double *tempYiWorkingArray, PetscReal internalEnergyRef, double mwMix, double &T) {
+PetscErrorCode ablate::eos::TChem::ComputeTemperature(int numSpec, double *tempYiWorkingArray, PetscReal internalEnergyRef, double mwMix, double &T, PetscInt &iterations) {
     PetscFunctionBeginUser;
+    iterations = 0;
 
     // This is an iterative process to go compute temperature from density
     double t2 = 300.0;
@@ -115,6 +224,7 @@ PetscErrorCode ablate::eos::TChem::ComputeTemperature(int numSpec, double *tempY
         double f1 = internalEnergyRef - e1;
 
         for (int it = 0; it < ITERMAX_T; it++) {
+            iterations = it + 1;
             t2 = t1 - f1 * (t1 - t0) / (f1 - f0 + 1E-30);
             t2 = PetscMax(1.0, t2);
             tempYiWorkingArray[0] = t2;
@@ -137,6 +247,15 @@ PetscErrorCode ablate::eos::TChem::ComputeTemperature(int numSpec, double *tempY
 
 PetscErrorCode ablate::eos::TChem::TChemComputeTemperature(PetscInt dim, PetscReal density, PetscReal totalEnergy, const PetscReal *massFlux, const PetscReal densityYi[], PetscReal *T, void *ctx) {
     PetscFunctionBeginUser;
+    PetscInt iterations;
+    PetscErrorCode ierr = TChemComputeTemperatureIterations(dim, density, totalEnergy, massFlux, densityYi, T, &iterations, ctx);
+    CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+}
+
+PetscErrorCode ablate::eos::TChem::TChemComputeTemperatureIterations(PetscInt dim, PetscReal density, PetscReal totalEnergy, const PetscReal *massFlux, const PetscReal densityYi[], PetscReal *T,
+                                                                     PetscInt *iterations, void *ctx) {
+    PetscFunctionBeginUser;
     TChem *tChem = (TChem *)ctx;
 
     // Compute the internal energy from total ener
@@ -161,7 +280,7 @@ PetscErrorCode ablate::eos::TChem::TChemComputeTemperature(PetscInt dim, PetscRe
     TCCHKERRQ(err);
 
     // compute the temperature
-    PetscErrorCode ierr = ComputeTemperature(tChem->numberSpecies, tempYiWorkingArray, internalEnergyRef, mwMix, *T);
+    PetscErrorCode ierr = ComputeTemperature(tChem->numberSpecies, tempYiWorkingArray, internalEnergyRef, mwMix, *T, *iterations);
     CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
@@ -192,7 +311,8 @@ PetscErrorCode ablate::eos::TChem::TChemGasDecodeState(PetscInt dim, PetscReal d
 
     // compute the temperature
     double temperature;
-    PetscErrorCode ierr = ComputeTemperature(tChem->numberSpecies, tempYiWorkingArray, *internalEnergy, mwMix, temperature);
+    PetscInt iterations;
+    PetscErrorCode ierr = ComputeTemperature(tChem->numberSpecies, tempYiWorkingArray, *internalEnergy, mwMix, temperature, iterations);
     CHKERRQ(ierr);
 
     // compute r
@@ -240,4 +360,5 @@ const char *ablate::eos::TChem::periodicTable =
 
 #include "parser/registrar.hpp"
 REGISTER(ablate::eos::EOS, ablate::eos::TChem, "TChem ideal gas eos", ARG(std::filesystem::path, "mechFile", "the mech file (CHEMKIN Format)"),
-         ARG(std::filesystem::path, "thermoFile", "the thermo file (CHEMKIN Format)"));
\ No newline at end of file
+         ARG(std::filesystem::path, "thermoFile", "the thermo file (CHEMKIN Format)"),
+         OPT(std::string, "mechanismCache", "optional binary cache file of the parsed mechanism.  It is rebuilt if the mech or thermo file changes."));
\ No newline at end of file
@@ -2,7 +2,10 @@
 #define ABLATECLIENTTEMPLATE_TCHEM_HPP
 
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include "eos.hpp"
+#include "kinetics/mechanism.hpp"
 #include "utilities/intErrorChecker.hpp"
 
 namespace ablate::eos {
@@ -21,6 +24,12 @@ class TChem : public EOS {
     std::filesystem::path mechFile;
     std::filesystem::path thermoFile;
 
+    // optional binary cache of the parsed mechanism
+    std::filesystem::path mechanismCacheFile;
+
+    // the parsed mechanism, loaded on first use
+    std::shared_ptr<kinetics::Mechanism> mechanism;
+
     // prestore all species
     std::vector<std::string> species;
     int numberSpecies;
@@ -30,12 +39,26 @@ class TChem : public EOS {
     std::vector<double> sourceWorkingVector;
 
     // write/reproduce the periodic table
-    static const char* periodicTable;
     inline static const char* periodicTableFileName = "periodictable.dat";
 
+    /**
+     * Runs the reader on rank 0 and broadcasts the result to every rank (collective on PETSC_COMM_WORLD).  If the reader throws on rank 0, the error is
+     * broadcast instead and every rank throws.
+     * @param read
+     * @return
+     */
+    static std::vector<char> BroadcastFromRoot(const std::function<std::vector<char>()>& read);
+
+    /**
+     * Reads the contents of a file
+     */
+    static std::vector<char> ReadFile(const std::filesystem::path& file);
+
     static PetscErrorCode TChemGasDecodeState(PetscInt dim, PetscReal density, PetscReal totalEnergy, const PetscReal* velocity, const PetscReal densityYi[], PetscReal* internalEnergy, PetscReal* a,
                                               PetscReal* p, void* ctx);
     static PetscErrorCode TChemComputeTemperature(PetscInt dim, PetscReal density, PetscReal totalEnergy, const PetscReal* massFlux, const PetscReal densityYi[], PetscReal* T, void* ctx);
+    static PetscErrorCode TChemComputeTemperatureIterations(PetscInt dim, PetscReal density, PetscReal totalEnergy, const PetscReal* massFlux, const PetscReal densityYi[], PetscReal* T,
+                                                            PetscInt* iterations, void* ctx);
 
     // Private static helper functions
     inline const static double TREF = 298.15;
@@ -47,17 +70,41 @@ class TChem : public EOS {
      * @param internalEnergyRef
      * @param mwMix
      * @param T
+     * @param iterations the number of secant iterations used
      * @return
      */
-    static PetscErrorCode ComputeTemperature(int numSpec, double* tempYiWorkingArray, PetscReal internalEnergyRef, double mwMix, double& T);
+    static PetscErrorCode ComputeTemperature(int numSpec, double* tempYiWorkingArray, PetscReal internalEnergyRef, double mwMix, double& T, PetscInt& iterations);
 
    public:
-    TChem(std::filesystem::path mechFile, std::filesystem::path thermoFile);
+    /**
+     * The periodic table (element names and atomic weights) used by TChem
+     */
+    static const char* periodicTable;
+
+    /**
+     * Reads the mechanism and thermo files on rank 0 and broadcasts them.  Each rank initializes TChem from copies in a node local scratch directory (see
+     * PetscGetTmp), so only rank 0 reads from the shared file system.
+     * @param mechFile
+     * @param thermoFile
+     * @param mechanismCacheFile the optional binary cache of the parsed mechanism used by GetMechanism
+     */
+    TChem(std::filesystem::path mechFile, std::filesystem::path thermoFile, std::filesystem::path mechanismCacheFile = {});
     ~TChem();
 
     // general functions
     void View(std::ostream& stream) const override;
 
+    // access to the input files
+    const std::filesystem::path& GetMechFile() const { return mechFile; }
+    const std::filesystem::path& GetThermoFile() const { return thermoFile; }
+
+    /**
+     * Returns the parsed mechanism.  The mechanism is loaded on the first call (collective on PETSC_COMM_WORLD): rank 0 reads the binary cache file if it is
+     * current, otherwise it parses the CHEMKIN files and updates the cache.  The mechanism is then broadcast to every rank.
+     * @return
+     */
+    std::shared_ptr<kinetics::Mechanism> GetMechanism();
+
     // species model functions
     const std::vector<std::string>& GetSpecies() const override;
 
@@ -66,6 +113,7 @@ class TChem : public EOS {
     void* GetDecodeStateContext() override { return this; }
     ComputeTemperatureFunction GetComputeTemperatureFunction() override { return TChemComputeTemperature; }
     void* GetComputeTemperatureContext() override { return this; }
+    ComputeTemperatureIterationsFunction GetComputeTemperatureIterationsFunction() override { return TChemComputeTemperatureIterations; }
 
     /**
      * the tempYiWorkingArray array is expected to be filled
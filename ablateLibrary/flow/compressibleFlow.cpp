@@ -29,7 +29,7 @@ ablate::flow::CompressibleFlow::CompressibleFlow(std::string name, std::shared_p
 #include "parser/registrar.hpp"
 REGISTER(ablate::flow::Flow, ablate::flow::CompressibleFlow, "compressible finite volume flow", ARG(std::string, "name", "the name of the flow field"),
          ARG(ablate::mesh::Mesh, "mesh", "the  mesh and discretization"), ARG(ablate::eos::EOS, "eos", "the equation of state used to describe the flow"),
-         ARG(ablate::parameters::Parameters, "parameters", "the compressible flow parameters cfl, gamma, etc."),
+         ARG(ablate::parameters::Parameters, "parameters", "the compressible flow parameters cfl, gamma, cellCost (record the per cell cost aux field), etc."),
          OPT(ablate::flow::fluxCalculator::FluxCalculator, "fluxCalculator", "the flux calculators (defaults to AUSM)"), OPT(ablate::parameters::Parameters, "options", "the options passed to PETSc"),
          OPT(std::vector<mathFunctions::FieldSolution>, "initialization", "the flow field initialization"),
          OPT(std::vector<flow::boundaryConditions::BoundaryCondition>, "boundaryConditions", "the boundary conditions for the flow field"),
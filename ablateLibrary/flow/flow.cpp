@@ -1,4 +1,6 @@
 #include "flow.hpp"
+#include <algorithm>
+#include "utilities/memoryTracker.hpp"
 #include "utilities/mpiError.hpp"
 #include "utilities/petscError.hpp"
 #include "utilities/petscOptions.hpp"
@@ -32,9 +34,19 @@ ablate::flow::Flow::Flow(std::string name, std::shared_ptr<mesh::Mesh> mesh, std
     if (!auxiliaryFields.empty()) {
         this->preStepFunctions.push_back(UpdateAuxFields);
     }
+
+    // report the memory held by the dm (the aux dm shares its topology) and the solution and aux vectors
+    utilities::MemoryTracker::Register(utilities::MemoryTracker::Mesh, this, [this]() {
+        return utilities::MemoryTracker::GetBytes(GetDM()) + utilities::MemoryTracker::GetBytes(auxDM, false);
+    });
+    utilities::MemoryTracker::Register(utilities::MemoryTracker::Vectors, this, [this]() {
+        return utilities::MemoryTracker::GetBytes(flowField) + utilities::MemoryTracker::GetBytes(auxField);
+    });
 }
 
 ablate::flow::Flow::~Flow() {
+    utilities::MemoryTracker::Unregister(this);
+
     // clean up the petsc objects
     if (flowField) {
         VecDestroy(&flowField) >> checkError;
@@ -45,6 +57,12 @@ ablate::flow::Flow::~Flow() {
     if (auxDM) {
         DMDestroy(&auxDM) >> checkError;
     }
+    if (exactSolutionCache) {
+        VecDestroy(&exactSolutionCache) >> checkError;
+    }
+    if (exactSolutionCellCenterCache) {
+        VecDestroy(&exactSolutionCellCenterCache) >> checkError;
+    }
     if (petscOptions) {
         ablate::utilities::PetscOptionsDestroyAndCheck(name, &petscOptions);
     }
@@ -373,40 +391,170 @@ void ablate::flow::Flow::View(PetscViewer viewer, PetscInt steps, PetscReal time
         DMGetOutputSequenceNumber(GetDM(), &dmSequence, &dmTime) >> checkError;
         DMSetOutputSequenceNumber(auxDM, dmSequence, dmTime) >> checkError;
 
-        Vec auxGlobalField;
-        DMGetGlobalVector(auxDM, &auxGlobalField) >> checkError;
-
-        // copy over the name of the auxFieldVector
-        const char* name;
-        PetscObjectGetName((PetscObject)auxField, &name) >> checkError;
-        PetscObjectSetName((PetscObject)auxGlobalField, name) >> checkError;
-        DMLocalToGlobal(auxDM, auxField, INSERT_VALUES, auxGlobalField) >> checkError;
+        Vec auxGlobalField = GetAuxGlobalVector();
         VecView(auxGlobalField, viewer) >> checkError;
         DMRestoreGlobalVector(auxDM, &auxGlobalField) >> checkError;
     }
 
     if (!exactSolutions.empty()) {
-        Vec exactVec;
-        DMGetGlobalVector(dm->GetDomain(), &exactVec) >> checkError;
-
-        // Get the number of fields
-        PetscDS ds;
-        DMGetDS(dm->GetDomain(), &ds) >> checkError;
-        PetscInt numberOfFields;
-        PetscDSGetNumFields(ds, &numberOfFields) >> checkError;
-        std::vector<ablate::mathFunctions::PetscFunction> exactFuncs(numberOfFields);
-        std::vector<void*> exactCtxs(numberOfFields);
-        for (auto f = 0; f < numberOfFields; ++f) {
-            PetscDSGetExactSolution(ds, f, &exactFuncs[f], &exactCtxs[f]) >> checkError;
-            if (!exactFuncs[f]) {
-                throw std::invalid_argument("The exact solution has not set");
-            }
+        Vec exactVec = GetExactSolutionVector(time);
+        VecView(exactVec, viewer) >> checkError;
+        DMRestoreGlobalVector(dm->GetDomain(), &exactVec) >> checkError;
+    }
+}
+
+void ablate::flow::Flow::ViewSetup(PetscViewer viewer) const { DMView(GetDM(), viewer) >> checkError; }
+
+bool ablate::flow::Flow::GetViewVectors(PetscInt steps, PetscReal time, Vec u, std::vector<Vec>& vectors) const {
+    vectors.clear();
+    vectors.push_back(flowField);
+    if (auxField) {
+        vectors.push_back(GetAuxGlobalVector());
+    }
+    if (!exactSolutions.empty()) {
+        vectors.push_back(GetExactSolutionVector(time));
+    }
+    return true;
+}
+
+void ablate::flow::Flow::RestoreViewVectors(std::vector<Vec>& vectors) const {
+    std::size_t v = 1;
+    if (auxField) {
+        DMRestoreGlobalVector(auxDM, &vectors[v++]) >> checkError;
+    }
+    if (!exactSolutions.empty()) {
+        DMRestoreGlobalVector(dm->GetDomain(), &vectors[v++]) >> checkError;
+    }
+    vectors.clear();
+}
+
+void ablate::flow::Flow::Save(monitors::Checkpoint& checkpoint) {
+    checkpoint.WriteVector("flowField", flowField);
+    if (auxField) {
+        Vec auxGlobalField = GetAuxGlobalVector();
+        checkpoint.WriteVector("auxField", auxGlobalField);
+        DMRestoreGlobalVector(auxDM, &auxGlobalField) >> checkError;
+    }
+}
+
+void ablate::flow::Flow::Restore(monitors::Checkpoint& checkpoint, PetscReal time) {
+    checkpoint.ReadVector("flowField", flowField);
+    if (auxField) {
+        Vec auxGlobalField = GetAuxGlobalVector();
+        checkpoint.ReadVector("auxField", auxGlobalField);
+        DMGlobalToLocal(auxDM, auxGlobalField, INSERT_VALUES, auxField) >> checkError;
+        DMRestoreGlobalVector(auxDM, &auxGlobalField) >> checkError;
+    }
+}
+
+Vec ablate::flow::Flow::GetAuxGlobalVector() const {
+    Vec auxGlobalField;
+    DMGetGlobalVector(auxDM, &auxGlobalField) >> checkError;
+
+    // copy over the name of the auxFieldVector
+    const char* name;
+    PetscObjectGetName((PetscObject)auxField, &name) >> checkError;
+    PetscObjectSetName((PetscObject)auxGlobalField, name) >> checkError;
+    DMLocalToGlobal(auxDM, auxField, INSERT_VALUES, auxGlobalField) >> checkError;
+    return auxGlobalField;
+}
+
+Vec ablate::flow::Flow::GetExactSolutionVector(PetscReal time) const {
+    Vec exactVec;
+    DMGetGlobalVector(dm->GetDomain(), &exactVec) >> checkError;
+    ProjectExactSolution(time, exactVec);
+    PetscObjectSetName((PetscObject)exactVec, "exact") >> checkError;
+    return exactVec;
+}
+
+bool ablate::flow::Flow::IsExactSolutionTimeDependent() const {
+    // an exact solution set directly in the PetscDS may depend upon time, so every field must have a known exact solution
+    for (const auto& flowFieldDescriptor : flowFieldDescriptors) {
+        auto exactSolution = std::find_if(exactSolutions.begin(), exactSolutions.end(), [&flowFieldDescriptor](const auto& solution) {
+            return solution->GetName() == flowFieldDescriptor.fieldName && solution->HasSolutionField();
+        });
+        if (exactSolution == exactSolutions.end() || (*exactSolution)->GetSolutionField().IsTimeDependent()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ablate::flow::Flow::ProjectExactSolution(PetscReal time, Vec exactVec, bool cellCenters) const {
+    // reuse the projection of a time independent exact solution
+    Vec& cache = cellCenters ? exactSolutionCellCenterCache : exactSolutionCache;
+    if (cache) {
+        VecCopy(cache, exactVec) >> checkError;
+        return;
+    }
+
+    // Get the number of fields
+    PetscDS ds;
+    DMGetDS(dm->GetDomain(), &ds) >> checkError;
+    PetscInt numberOfFields;
+    PetscDSGetNumFields(ds, &numberOfFields) >> checkError;
+    PetscInt* numberComponentsPerField;
+    PetscDSGetComponents(ds, &numberComponentsPerField) >> checkError;
+    std::vector<ablate::mathFunctions::PetscFunction> exactFuncs(numberOfFields);
+    std::vector<void*> exactCtxs(numberOfFields);
+    for (auto f = 0; f < numberOfFields; ++f) {
+        PetscDSGetExactSolution(ds, f, &exactFuncs[f], &exactCtxs[f]) >> checkError;
+        if (!exactFuncs[f]) {
+            throw std::invalid_argument("The exact solution has not set");
         }
+    }
+
+    // the finite volume fields can be evaluated directly at the cell centroids, all other fields are projected
+    std::vector<PetscInt> cellCenterFields;
+    bool projectFields = !cellCenters;
+    for (PetscInt f = 0; f < numberOfFields && cellCenters; f++) {
+        PetscObject field;
+        PetscClassId id;
+        DMGetField(dm->GetDomain(), f, NULL, &field) >> checkError;
+        PetscObjectGetClassId(field, &id) >> checkError;
+        if (id == PETSCFV_CLASSID) {
+            cellCenterFields.push_back(f);
+        } else {
+            projectFields = true;
+        }
+    }
 
+    if (projectFields) {
         DMProjectFunction(dm->GetDomain(), time, &exactFuncs[0], &exactCtxs[0], INSERT_ALL_VALUES, exactVec) >> checkError;
+    }
 
-        PetscObjectSetName((PetscObject)exactVec, "exact") >> checkError;
-        VecView(exactVec, viewer) >> checkError;
-        DMRestoreGlobalVector(dm->GetDomain(), &exactVec) >> checkError;
+    if (!cellCenterFields.empty()) {
+        PetscInt cStart, cEnd;
+        DMPlexGetSimplexOrBoxCells(dm->GetDomain(), 0, &cStart, &cEnd) >> checkError;
+
+        // the cell geometry is computed once and stored with the dm
+        Vec cellGeometry;
+        DM cellDm;
+        const PetscScalar* cellGeometryArray;
+        DMPlexGetGeometryFVM(dm->GetDomain(), NULL, &cellGeometry, NULL) >> checkError;
+        VecGetDM(cellGeometry, &cellDm) >> checkError;
+        VecGetArrayRead(cellGeometry, &cellGeometryArray) >> checkError;
+
+        PetscScalar* exactArray;
+        VecGetArray(exactVec, &exactArray) >> checkError;
+        for (PetscInt c = cStart; c < cEnd; ++c) {
+            PetscFVCellGeom* cellGeom;
+            DMPlexPointLocalRead(cellDm, c, cellGeometryArray, &cellGeom) >> checkError;
+            for (const auto f : cellCenterFields) {
+                // cells not owned by this rank are not in the global vector
+                PetscScalar* values = nullptr;
+                DMPlexPointGlobalFieldRef(dm->GetDomain(), c, f, exactArray, &values) >> checkError;
+                if (values) {
+                    exactFuncs[f](dim, time, cellGeom->centroid, numberComponentsPerField[f], values, exactCtxs[f]) >> checkError;
+                }
+            }
+        }
+        VecRestoreArray(exactVec, &exactArray) >> checkError;
+        VecRestoreArrayRead(cellGeometry, &cellGeometryArray) >> checkError;
+    }
+
+    if (!IsExactSolutionTimeDependent()) {
+        VecDuplicate(exactVec, &cache) >> checkError;
+        VecCopy(exactVec, cache) >> checkError;
     }
 }
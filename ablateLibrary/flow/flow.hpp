@@ -4,6 +4,7 @@
 #include <petsc.h>
 #include <functional>
 #include <memory>
+#include <monitors/checkpointable.hpp>
 #include <monitors/viewable.hpp>
 #include <optional>
 #include <parameters/parameters.hpp>
@@ -17,7 +18,7 @@
 
 namespace ablate::flow {
 
-class Flow : public solve::Solvable, public monitors::Viewable {
+class Flow : public solve::Solvable, public monitors::Viewable, public monitors::Checkpointable {
    protected:
     // descriptions to the fields on the dm
     std::vector<FlowFieldDescriptor> flowFieldDescriptors;
@@ -35,6 +36,20 @@ class Flow : public solve::Solvable, public monitors::Viewable {
      */
     void RegisterField(FlowFieldDescriptor flowFieldDescription, DM dm);
 
+    /**
+     * Copies the aux field into a named global vector that must be restored to the auxDM
+     */
+    Vec GetAuxGlobalVector() const;
+
+    /**
+     * Projects the exact solution into a global vector (named exact) that must be restored to the dm
+     */
+    Vec GetExactSolutionVector(PetscReal time) const;
+
+    // the projection of a time independent exact solution is computed once (with quadrature and at the cell centers)
+    mutable Vec exactSolutionCache = nullptr;
+    mutable Vec exactSolutionCellCenterCache = nullptr;
+
    protected:
     const std::string name;
 
@@ -91,6 +106,36 @@ class Flow : public solve::Solvable, public monitors::Viewable {
      */
     void View(PetscViewer viewer, PetscInt steps, PetscReal time, Vec u) const override;
 
+    /**
+     * Writes the mesh
+     * @param viewer
+     */
+    void ViewSetup(PetscViewer viewer) const override;
+
+    /**
+     * Gets the flow field, the aux field, and the exact solution written by View
+     * @param steps
+     * @param time
+     * @param u
+     * @param vectors
+     * @return
+     */
+    bool GetViewVectors(PetscInt steps, PetscReal time, Vec u, std::vector<Vec>& vectors) const override;
+    void RestoreViewVectors(std::vector<Vec>& vectors) const override;
+
+    /**
+     * Writes the flow field and the aux field to the checkpoint
+     * @param checkpoint
+     */
+    void Save(monitors::Checkpoint& checkpoint) override;
+
+    /**
+     * Replaces the flow field and the aux field with the values in the checkpoint
+     * @param checkpoint
+     * @param time
+     */
+    void Restore(monitors::Checkpoint& checkpoint, PetscReal time) override;
+
     /**
      * Adds function to be called before each flow step
      * @param preStep
@@ -124,6 +169,24 @@ class Flow : public solve::Solvable, public monitors::Viewable {
     std::optional<int> GetFieldId(const std::string& fieldName) const;
 
     std::optional<int> GetAuxFieldId(const std::string& fieldName) const;
+
+    const std::vector<FlowFieldDescriptor>& GetFieldDescriptors() const { return flowFieldDescriptors; }
+
+    const std::vector<FlowFieldDescriptor>& GetAuxFieldDescriptors() const { return auxFieldDescriptors; }
+
+    /**
+     * Returns true if any of the exact solutions depend upon time
+     * @return
+     */
+    bool IsExactSolutionTimeDependent() const;
+
+    /**
+     * Projects the exact solution set in the PetscDS into a global vector.  A time independent exact solution is only projected once.
+     * @param time
+     * @param exactVec the global vector to hold the exact solution
+     * @param cellCenters evaluate the finite volume fields at the cell centroids without quadrature
+     */
+    void ProjectExactSolution(PetscReal time, Vec exactVec, bool cellCenters = false) const;
 };
 }  // namespace ablate::flow
 
@@ -1,5 +1,10 @@
 #include "fvFlow.hpp"
+#include <algorithm>
 #include <flow/processes/flowProcess.hpp>
+#include <typeinfo>
+#include <utilities/demangler.hpp>
+#include <utilities/logEvents.hpp>
+#include <utilities/memoryTracker.hpp>
 #include <utilities/mpiError.hpp>
 #include <utilities/petscError.hpp>
 
@@ -38,12 +43,35 @@ ablate::flow::FVFlow::FVFlow(std::string name, std::shared_ptr<mesh::Mesh> mesh,
             RegisterField(field);
         }
     }
+
+    // the optional measured cost of each cell, this is reset before the processes add to it each step
+    if (parameters && parameters->Get<bool>("cellCost", false)) {
+        RegisterField(FlowFieldDescriptor{.solutionField = false,
+                                          .fieldName = CellCostField,
+                                          .fieldPrefix = CellCostField,
+                                          .components = 3,
+                                          .fieldType = FieldType::FV,
+                                          .componentNames = {"chemistry", "particles", "eos"}});
+        preStepFunctions.push_back(ResetCellCost);
+    }
     FinalizeRegisterFields();
 
-    // march over process and link to the flow
+    // record the residual phase events so that they are reported with the process events
+    ABLATE_FVSupportRegisterLogEvents() >> checkError;
+    utilities::LogEvents::Record("FVAuxUpdate", ABLATE_FV_AuxUpdate);
+    utilities::LogEvents::Record("FVGradient", ABLATE_FV_Gradient);
+    utilities::LogEvents::Record("FVFaceGather", ABLATE_FV_FaceGather);
+    utilities::LogEvents::Record("FVFlux", ABLATE_FV_Flux);
+    utilities::LogEvents::Record("FVScatter", ABLATE_FV_Scatter);
+    utilities::LogEvents::Record("FVPointSource", ABLATE_FV_PointSource);
+
+    // march over process and link to the flow, the functions registered by each process are profiled with an event named for the process
     for (const auto& process : flowProcesses) {
+        auto processName = utilities::Demangler::Demangle(typeid(*process).name());
+        registeringLogEvent = utilities::LogEvents::Register(processName.substr(processName.rfind(':') + 1));
         process->Initialize(*this);
     }
+    registeringLogEvent = utilities::LogEvents::Register("FVRHSFunction");
 
     // Start problem setup
     PetscDS prob;
@@ -51,6 +79,57 @@ ablate::flow::FVFlow::FVFlow(std::string name, std::shared_ptr<mesh::Mesh> mesh,
 
     // Set the flux calculator solver for each component
     PetscDSSetFromOptions(prob) >> checkError;
+
+    // report the finite volume geometry, the gradients, and the residual work arrays
+    utilities::MemoryTracker::Register(utilities::MemoryTracker::Mesh, this, [this]() {
+        Vec faceGeometry, cellGeometry;
+        DMPlexGetGeometryFVM(GetDM(), &faceGeometry, &cellGeometry, NULL) >> checkError;
+        return utilities::MemoryTracker::GetBytes(faceGeometry) + utilities::MemoryTracker::GetBytes(cellGeometry);
+    });
+    utilities::MemoryTracker::Register(utilities::MemoryTracker::Gradients, this, [this]() { return GetGradientBytes(GetDM()) + GetGradientBytes(GetAuxDM()); });
+    utilities::MemoryTracker::Register(utilities::MemoryTracker::ResidualWork, this, []() {
+        PetscLogDouble bytes;
+        ABLATE_FVSupportGetWorkArrayMaximumBytes(&bytes) >> checkError;
+        return bytes;
+    });
+}
+
+ablate::flow::FVFlow::~FVFlow() { utilities::MemoryTracker::Unregister(this); }
+
+PetscLogDouble ablate::flow::FVFlow::GetGradientBytes(DM fieldDm) {
+    if (!fieldDm) {
+        return 0.0;
+    }
+
+    // each field with gradients has a gradient dm with a local and a (pooled) global gradient vector
+    PetscLogDouble bytes = 0.0;
+    PetscInt numberFields;
+    DMGetNumFields(fieldDm, &numberFields) >> checkError;
+    for (PetscInt f = 0; f < numberFields; f++) {
+        PetscObject field;
+        PetscClassId id;
+        DMGetField(fieldDm, f, NULL, &field) >> checkError;
+        PetscObjectGetClassId(field, &id) >> checkError;
+        if (id != PETSCFV_CLASSID) {
+            continue;
+        }
+        PetscBool computeGradients;
+        PetscFVGetComputeGradients((PetscFV)field, &computeGradients) >> checkError;
+        if (!computeGradients) {
+            continue;
+        }
+
+        DM gradDm;
+        DMPlexGetDataFVM_MulfiField(fieldDm, (PetscFV)field, NULL, NULL, &gradDm) >> checkError;
+        if (gradDm) {
+            PetscSection section;
+            PetscInt storageSize;
+            DMGetLocalSection(gradDm, &section) >> checkError;
+            PetscSectionGetStorageSize(section, &storageSize) >> checkError;
+            bytes += utilities::MemoryTracker::GetBytes(gradDm, false) + 2.0 * storageSize * sizeof(PetscScalar);
+        }
+    }
+    return bytes;
 }
 
 ablate::flow::FVFlow::FVFlow(std::string name, std::shared_ptr<mesh::Mesh> mesh, std::shared_ptr<parameters::Parameters> parameters, std::vector<std::shared_ptr<FlowFieldDescriptor>> fieldDescriptors,
@@ -98,13 +177,31 @@ PetscErrorCode ablate::flow::FVFlow::FVRHSFunctionLocal(DM dm, PetscReal time, V
     CHKERRQ(ierr);
 
     // iterate over any arbitrary RHS functions
-    for (const auto& rhsFunction : flow->rhsArbitraryFunctions) {
-        ierr = rhsFunction.first(dm, time, locXVec, globFVec, rhsFunction.second);
+    for (const auto& [function, context, logEvent] : flow->rhsArbitraryFunctions) {
+        ierr = PetscLogEventBegin(logEvent, dm, 0, 0, 0);
+        CHKERRQ(ierr);
+        ierr = function(dm, time, locXVec, globFVec, context);
+        CHKERRQ(ierr);
+        ierr = PetscLogEventEnd(logEvent, dm, 0, 0, 0);
         CHKERRQ(ierr);
     }
 
     PetscFunctionReturn(0);
 }
+void ablate::flow::FVFlow::Save(monitors::Checkpoint& checkpoint) {
+    Flow::Save(checkpoint);
+    for (const auto& process : flowProcesses) {
+        process->Save(checkpoint);
+    }
+}
+
+void ablate::flow::FVFlow::Restore(monitors::Checkpoint& checkpoint, PetscReal time) {
+    Flow::Restore(checkpoint, time);
+    for (const auto& process : flowProcesses) {
+        process->Restore(checkpoint);
+    }
+}
+
 void ablate::flow::FVFlow::CompleteProblemSetup(TS ts) {
     Flow::CompleteProblemSetup(ts);
 
@@ -162,7 +259,8 @@ void ablate::flow::FVFlow::RegisterRHSFunction(FVMRHSFluxFunction function, void
                                                       .inputFields = {-1, -1, -1, -1}, /**default to empty.  Right now it is hard coded to be a 4 length array.  This should be relaxed**/
                                                       .numberInputFields = (PetscInt)inputFields.size(),
                                                       .auxFields = {-1, -1, -1, -1}, /**default to empty**/
-                                                      .numberAuxFields = (PetscInt)auxFields.size()};
+                                                      .numberAuxFields = (PetscInt)auxFields.size(),
+                                                      .logEvent = registeringLogEvent};
 
     if (inputFields.size() > MAX_FVM_RHS_FUNCTION_FIELDS || auxFields.size() > MAX_FVM_RHS_FUNCTION_FIELDS) {
         std::runtime_error("Cannot register more than " + std::to_string(MAX_FVM_RHS_FUNCTION_FIELDS) + " fields in RegisterRHSFunction.");
@@ -229,7 +327,7 @@ void ablate::flow::FVFlow::RegisterRHSFunction(FVMRHSPointFunction function, voi
     rhsPointFunctionDescriptions.push_back(functionDescription);
 }
 
-void ablate::flow::FVFlow::RegisterRHSFunction(RHSArbitraryFunction function, void* context) { rhsArbitraryFunctions.push_back(std::make_pair(function, context)); }
+void ablate::flow::FVFlow::RegisterRHSFunction(RHSArbitraryFunction function, void* context) { rhsArbitraryFunctions.emplace_back(function, context, registeringLogEvent); }
 
 void ablate::flow::FVFlow::RegisterAuxFieldUpdate(FVAuxFieldUpdateFunction function, void* context, std::string auxField) {
     // find the field location
@@ -282,9 +380,59 @@ void ablate::flow::FVFlow::ComputeTimeStep(TS ts, ablate::flow::Flow& flow) {
 }
 void ablate::flow::FVFlow::RegisterComputeTimeStepFunction(ComputeTimeStepFunction function, void* ctx) { timeStepFunctions.push_back(std::make_pair(function, ctx)); }
 
+void ablate::flow::FVFlow::ResetCellCost(TS ts, ablate::flow::Flow& flow) {
+    auto cellCostId = flow.GetAuxFieldId(CellCostField).value();
+    PetscInt cStart, cEnd;
+    DMPlexGetHeightStratum(flow.GetDM(), 0, &cStart, &cEnd) >> checkError;
+
+    PetscScalar* auxArray;
+    VecGetArray(flow.GetAuxField(), &auxArray) >> checkError;
+    for (PetscInt c = cStart; c < cEnd; ++c) {
+        PetscScalar* cost;
+        DMPlexPointLocalFieldRef(flow.GetAuxDM(), c, cellCostId, auxArray, &cost) >> checkError;
+        std::fill(cost, cost + 3, 0.0);
+    }
+    VecRestoreArray(flow.GetAuxField(), &auxArray) >> checkError;
+}
+
+void ablate::flow::FVFlow::AddCellCost(CellCostComponents component, const std::vector<PetscInt>& cells, const std::vector<PetscReal>& costs) {
+    auto cellCostId = GetAuxFieldId(CellCostField);
+    if (!cellCostId) {
+        return;
+    }
+
+    PetscScalar* auxArray;
+    VecGetArray(auxField, &auxArray) >> checkError;
+    for (std::size_t i = 0; i < cells.size(); i++) {
+        PetscScalar* cost;
+        DMPlexPointLocalFieldRef(auxDM, cells[i], cellCostId.value(), auxArray, &cost) >> checkError;
+        cost[component] += costs[i];
+    }
+    VecRestoreArray(auxField, &auxArray) >> checkError;
+}
+
+void ablate::flow::FVFlow::UpdateAuxFieldsFromSolution(PetscReal time, Vec globalSolution) {
+    if (auxFieldUpdateFunctions.empty()) {
+        return;
+    }
+
+    DM domain = GetDM();
+    Vec locXVec;
+    DMGetLocalVector(domain, &locXVec) >> checkError;
+    DMGlobalToLocal(domain, globalSolution, INSERT_VALUES, locXVec) >> checkError;
+
+    // fill the boundary values in the same way as the rhs so the ghost cell aux values are updated
+    Vec facegeom, cellgeom;
+    DMPlexGetGeometryFVM(domain, &facegeom, &cellgeom, NULL) >> checkError;
+    DMPlexInsertBoundaryValues(domain, PETSC_FALSE, locXVec, time, facegeom, cellgeom, NULL) >> checkError;
+
+    FVFlowUpdateAuxFieldsFV(domain, auxDM, time, locXVec, auxField, auxFieldUpdateFunctions.size(), &auxFieldUpdateFunctions[0], &auxFieldUpdateContexts[0]) >> checkError;
+    DMRestoreLocalVector(domain, &locXVec) >> checkError;
+}
+
 #include "parser/registrar.hpp"
 REGISTER(ablate::flow::Flow, ablate::flow::FVFlow, "finite volume flow", ARG(std::string, "name", "the name of the flow field"), ARG(ablate::mesh::Mesh, "mesh", "the  mesh and discretization"),
-         OPT(ablate::parameters::Parameters, "parameters", "the parameters used by the flow"), ARG(std::vector<ablate::flow::FlowFieldDescriptor>, "fields", "field descriptions"),
+         OPT(ablate::parameters::Parameters, "parameters", "the parameters used by the flow (cellCost records the per cell cost aux field)"), ARG(std::vector<ablate::flow::FlowFieldDescriptor>, "fields", "field descriptions"),
          ARG(std::vector<ablate::flow::processes::FlowProcess>, "processes", "the processes used to describe the flow"),
          OPT(ablate::parameters::Parameters, "options", "the options passed to PETSC for the flow"), OPT(std::vector<mathFunctions::FieldSolution>, "initialization", "the flow field initialization"),
          OPT(std::vector<flow::boundaryConditions::BoundaryCondition>, "boundaryConditions", "the boundary conditions for the flow field"),
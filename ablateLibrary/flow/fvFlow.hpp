@@ -4,6 +4,7 @@
 #include <fvSupport.h>
 #include <eos/eos.hpp>
 #include <string>
+#include <tuple>
 #include <vector>
 #include "flow.hpp"
 
@@ -19,13 +20,20 @@ class FVFlow : public Flow {
     using RHSArbitraryFunction = PetscErrorCode (*)(DM dm, PetscReal time, Vec locXVec, Vec globFVec, void* ctx);
     using ComputeTimeStepFunction = double (*)(TS ts, Flow&, void* ctx);
 
+    /**
+     * The optional aux field holding the measured cost of each cell over the last step (enabled with the cellCost parameter).  The components are the chemistry
+     * integration time (s), the number of particles, and the eos (temperature) iterations.  The components may be combined into a weight for partitioning.
+     */
+    inline static const char CellCostField[] = "cellCost";
+    typedef enum { CHEMISTRY_COST, PARTICLE_COST, EOS_COST } CellCostComponents;
+
    private:
     // hold the update functions for flux and point sources
     std::vector<FVMRHSFluxFunctionDescription> rhsFluxFunctionDescriptions;
     std::vector<FVMRHSPointFunctionDescription> rhsPointFunctionDescriptions;
 
-    // allow the use of any arbitrary rhs functions
-    std::vector<std::pair<RHSArbitraryFunction, void*>> rhsArbitraryFunctions;
+    // allow the use of any arbitrary rhs functions, each is profiled with the log event of the process that registered it
+    std::vector<std::tuple<RHSArbitraryFunction, void*, PetscLogEvent>> rhsArbitraryFunctions;
     // functions to update each aux field
     std::vector<FVAuxFieldUpdateFunction> auxFieldUpdateFunctions;
     std::vector<void*> auxFieldUpdateContexts;
@@ -36,9 +44,18 @@ class FVFlow : public Flow {
     // Hold the flow processes.  This is mostly just to hold a pointer to them
     std::vector<std::shared_ptr<processes::FlowProcess>> flowProcesses;
 
+    // the log event assigned to rhs functions as they are registered (the event of each process while it is initialized)
+    PetscLogEvent registeringLogEvent = -1;
+
     // static function to update the flowfield
     static void ComputeTimeStep(TS, Flow&);
 
+    // zero the cell cost before each step
+    static void ResetCellCost(TS, Flow&);
+
+    // the bytes held by the gradient dm and vectors of each field in the dm
+    static PetscLogDouble GetGradientBytes(DM fieldDm);
+
    public:
     FVFlow(std::string name, std::shared_ptr<mesh::Mesh> mesh, std::shared_ptr<parameters::Parameters> parameters, std::vector<FlowFieldDescriptor> fieldDescriptors,
            std::vector<std::shared_ptr<processes::FlowProcess>> flowProcesses, std::shared_ptr<parameters::Parameters> options,
@@ -49,10 +66,23 @@ class FVFlow : public Flow {
            std::vector<std::shared_ptr<mathFunctions::FieldSolution>> initialization, std::vector<std::shared_ptr<boundaryConditions::BoundaryCondition>> boundaryConditions,
            std::vector<std::shared_ptr<mathFunctions::FieldSolution>> auxiliaryFields, std::vector<std::shared_ptr<mathFunctions::FieldSolution>> exactSolution);
 
-    ~FVFlow() override = default;
+    ~FVFlow() override;
 
     void CompleteProblemSetup(TS ts) override;
 
+    /**
+     * Writes the flow and the state of each flow process to the checkpoint
+     * @param checkpoint
+     */
+    void Save(monitors::Checkpoint& checkpoint) override;
+
+    /**
+     * Restores the flow and the state of each flow process from the checkpoint
+     * @param checkpoint
+     * @param time
+     */
+    void Restore(monitors::Checkpoint& checkpoint, PetscReal time) override;
+
     /**
      * Function passed into PETSc to compute the FV RHS
      * @param dm
@@ -110,6 +140,22 @@ class FVFlow : public Flow {
      * @param auxFields
      */
     void RegisterComputeTimeStepFunction(ComputeTimeStepFunction function, void* ctx);
+
+    /**
+     * Adds the cost of each local cell to a component of the cell cost field.  This does nothing when the cell cost is not enabled.
+     * @param component
+     * @param cells the local cells, a cell may be listed more than once
+     * @param costs the cost of each listed cell
+     */
+    void AddCellCost(CellCostComponents component, const std::vector<PetscInt>& cells, const std::vector<PetscReal>& costs);
+
+    /**
+     * Recomputes the aux fields (e.g. temperature and velocity) from the global solution.  This is needed when a process changes the solution outside
+     * of the rhs evaluation, so that the aux fields seen by the monitors match the solution.
+     * @param time
+     * @param globalSolution
+     */
+    void UpdateAuxFieldsFromSolution(PetscReal time, Vec globalSolution);
 };
 
 }  // namespace ablate::flow
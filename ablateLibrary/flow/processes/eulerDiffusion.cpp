@@ -32,6 +32,29 @@ PetscErrorCode ablate::flow::processes::EulerDiffusion::UpdateAuxVelocityField(P
     PetscFunctionReturn(0);
 }
 
+PetscErrorCode ablate::flow::processes::EulerDiffusion::UpdateAuxCellCostField(PetscReal time, PetscInt dim, const PetscFVCellGeom *cellGeom, const PetscScalar *conservedValues,
+                                                                               PetscScalar *auxField, void *ctx) {
+    PetscFunctionBeginUser;
+    PetscReal density = conservedValues[EulerAdvection::RHO];
+    PetscReal totalEnergy = conservedValues[EulerAdvection::RHOE] / density;
+    EulerDiffusionData flowParameters = (EulerDiffusionData)ctx;
+
+    // the temperature is recomputed so that its iterations are returned with it, this is only done when the cell cost is recorded
+    PetscReal temperature;
+    PetscInt iterations;
+    PetscErrorCode ierr = flowParameters->computeTemperatureIterationsFunction(dim,
+                                                                               density,
+                                                                               totalEnergy,
+                                                                               conservedValues + EulerAdvection::RHOU,
+                                                                               flowParameters->numberSpecies ? conservedValues + EulerAdvection::RHOU + dim : NULL,
+                                                                               &temperature,
+                                                                               &iterations,
+                                                                               flowParameters->computeTemperatureContext);
+    CHKERRQ(ierr);
+    auxField[FVFlow::EOS_COST] += iterations;
+    PetscFunctionReturn(0);
+}
+
 ablate::flow::processes::EulerDiffusion::EulerDiffusion(std::shared_ptr<parameters::Parameters> parameters, std::shared_ptr<eos::EOS> eosIn) : eos(eosIn) {
     PetscNew(&eulerDiffusionData);
 
@@ -42,6 +65,7 @@ ablate::flow::processes::EulerDiffusion::EulerDiffusion(std::shared_ptr<paramete
     // set the decode state function
     eulerDiffusionData->computeTemperatureFunction = eos->GetComputeTemperatureFunction();
     eulerDiffusionData->computeTemperatureContext = eos->GetComputeTemperatureContext();
+    eulerDiffusionData->computeTemperatureIterationsFunction = eos->GetComputeTemperatureIterationsFunction();
     eulerDiffusionData->numberSpecies = eos->GetSpecies().size();
 }
 
@@ -57,6 +81,10 @@ void ablate::flow::processes::EulerDiffusion::Initialize(ablate::flow::FVFlow &f
     // add in aux update variables TODO: remove hard coded order of the temperature using a aOff type argument
     flow.RegisterAuxFieldUpdate(UpdateAuxTemperatureField, eulerDiffusionData, "T");
     flow.RegisterAuxFieldUpdate(UpdateAuxVelocityField, eulerDiffusionData, "vel");
+    // the eos cost is only recorded for an iterative eos, otherwise the component stays zero
+    if (flow.GetAuxFieldId(FVFlow::CellCostField) && eulerDiffusionData->computeTemperatureIterationsFunction) {
+        flow.RegisterAuxFieldUpdate(UpdateAuxCellCostField, eulerDiffusionData, FVFlow::CellCostField);
+    }
 
     // PetscErrorCode PetscOptionsGetBool(PetscOptions options,const char pre[],const char name[],PetscBool *ivalue,PetscBool *set)
     PetscBool automaticTimeStepCalculator = PETSC_TRUE;
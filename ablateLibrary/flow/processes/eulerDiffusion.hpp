@@ -21,6 +21,9 @@ class EulerDiffusion : public FlowProcess {
         // EOS function calls
         PetscErrorCode (*computeTemperatureFunction)(PetscInt dim, PetscReal density, PetscReal totalEnergy, const PetscReal* massFlux, const PetscReal* densityYi, PetscReal* T, void* ctx);
         void* computeTemperatureContext;
+        // the optional temperature function that returns its iterations, used to record the eos cost of each cell
+        PetscErrorCode (*computeTemperatureIterationsFunction)(PetscInt dim, PetscReal density, PetscReal totalEnergy, const PetscReal* massFlux, const PetscReal* densityYi, PetscReal* T,
+                                                               PetscInt* iterations, void* ctx);
     };
     typedef struct _EulerDiffusionData* EulerDiffusionData;
 
@@ -44,6 +47,14 @@ class EulerDiffusion : public FlowProcess {
      */
     static PetscErrorCode CompressibleFlowComputeStressTensor(PetscInt dim, PetscReal mu, const PetscReal* gradVelL, const PetscReal* gradVelR, PetscReal* tau);
 
+    /**
+     * Adds the eos (temperature) iterations of the cell to the eos component of the cell cost field.  The aux fields are updated with each rhs evaluation, so the
+     * component holds the iterations summed over the step once the cost has been reset before the step.
+     * ctx = EulerDiffusionData
+     * @return
+     */
+    static PetscErrorCode UpdateAuxCellCostField(PetscReal time, PetscInt dim, const PetscFVCellGeom* cellGeom, const PetscScalar* conservedValues, PetscScalar* auxField, void* ctx);
+
    private:
     EulerDiffusionData eulerDiffusionData;
     std::shared_ptr<eos::EOS> eos;
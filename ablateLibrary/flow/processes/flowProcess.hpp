@@ -8,6 +8,18 @@ class FlowProcess {
    public:
     virtual ~FlowProcess() = default;
     virtual void Initialize(ablate::flow::FVFlow& flow) = 0;
+
+    /**
+     * Writes any state kept between steps to the flow checkpoint.  The dataset names must be unique between processes.
+     * @param checkpoint
+     */
+    virtual void Save(monitors::Checkpoint& checkpoint) {}
+
+    /**
+     * Restores the state written with Save
+     * @param checkpoint
+     */
+    virtual void Restore(monitors::Checkpoint& checkpoint) {}
 };
 
 }  // namespace ablate::flow::processes
@@ -1,4 +1,10 @@
 #include "tChemReactions.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utilities/logEvents.hpp>
+#include <utilities/memoryTracker.hpp>
+#include <utilities/mpiError.hpp>
 #include <utilities/petscError.hpp>
 
 #if defined(PETSC_HAVE_TCHEM)
@@ -15,51 +21,110 @@
 #error TChem is required for this example.  Reconfigure PETSc using --download-tchem.
 #endif
 
-ablate::flow::processes::TChemReactions::TChemReactions(std::shared_ptr<eos::TChem> eosIn)
+ablate::flow::processes::TChemReactions::TChemReactions(std::shared_ptr<eos::TChem> eosIn, std::shared_ptr<parameters::Parameters> options)
     : fieldDm(nullptr),
       sourceVec(nullptr),
       eos(eosIn),
       numberSpecies(eosIn->GetSpecies().size()),
+      loadBalance(options ? options->Get<bool>("loadBalance", false) : false),
+      loadBalanceTolerance(options ? options->Get<PetscReal>("loadBalanceTolerance", 0.1) : 0.1),
+      adaptiveChemistry(options ? options->Get<bool>("adaptiveChemistry", false) : false),
+      adaptiveChemistryThreshold(options ? options->Get<PetscReal>("adaptiveChemistryThreshold", 0.05) : 0.05),
+      adaptiveChemistryTolerance(options ? options->Get<PetscReal>("adaptiveChemistryTolerance", 0.01) : 0.01),
+      adaptiveChemistryMonitor(options ? options->Get<bool>("adaptiveChemistryMonitor", false) : false),
+      strangSplitting(options ? ParseSplitting(options->Get<std::string>("splitting", "source")) : false),
+      firstHalfTimeStep(0.0),
+      reducedPressure(0.0),
+      reducedCells(0),
+      reducedSpeciesSum(0.0),
+      reducedReactionsSum(0.0),
+      stepReducedStatistics{0.0, 0.0, 0.0},
       ts(nullptr),
       pointData(nullptr),
       jacobian(nullptr),
       tchemScratch(nullptr),
       jacobianScratch(nullptr),
       rows(nullptr) {
+    integrateLogEvent = utilities::LogEvents::Register("TChemIntegrate");
+    utilities::MemoryTracker::Register(utilities::MemoryTracker::Chemistry, this, [this]() { return GetMemoryBytes(); });
+
     // size up the scratch variables
-    PetscMalloc3(numberSpecies + 1, &tchemScratch, PetscSqr(numberSpecies + 1), &jacobianScratch, numberSpecies, &rows) >> checkError;
+    PetscMalloc3(numberSpecies + 1, &tchemScratch, PetscSqr(numberSpecies + 1), &jacobianScratch, numberSpecies + 1, &rows) >> checkError;
     // The rows will not change, so set them once
     for (std::size_t i = 0; i < numberSpecies + 1; i++) {
         rows[i] = i;
     }
 
+    // Create the full point ode solver
+    CreatePointSolver(numberSpecies + 1, SinglePointChemistryRHS, SinglePointChemistryJacobian, this, ts, pointData, jacobian);
+
+    // Set up the native kinetics used to reduce the mechanism in each cell
+    if (adaptiveChemistry) {
+        auto targets = options->Get<std::vector<std::string>>("adaptiveChemistryTargets", {});
+        if (targets.empty()) {
+            throw std::invalid_argument("adaptiveChemistryTargets must be specified when using adaptiveChemistry");
+        }
+        const auto& species = eos->GetSpecies();
+        for (const auto& target : targets) {
+            auto it = std::find(species.begin(), species.end(), target);
+            if (it == species.end()) {
+                throw std::invalid_argument("Unknown adaptiveChemistryTargets species " + target);
+            }
+            adaptiveChemistryTargets.push_back((int)std::distance(species.begin(), it));
+        }
+
+        auto mechanism = eos->GetMechanism();
+        kinetics = std::make_shared<eos::kinetics::Kinetics>(mechanism);
+        relationGraph = std::make_unique<eos::kinetics::DirectedRelationGraph>(mechanism);
+
+        reducedIndices.reserve(numberSpecies + 1);
+        fullState.resize(numberSpecies + 1);
+        fullSource.resize(numberSpecies + 1);
+        fullJacobian.resize(PetscSqr(numberSpecies + 1));
+        reducedJacobian.resize(PetscSqr(numberSpecies + 1));
+    }
+}
+
+bool ablate::flow::processes::TChemReactions::ParseSplitting(const std::string& splitting) {
+    if (splitting == "source") {
+        return false;
+    } else if (splitting == "strang") {
+        return true;
+    }
+    throw std::invalid_argument("Unknown chemistry splitting " + splitting + ".  Valid options are source or strang.");
+}
+
+void ablate::flow::processes::TChemReactions::CreatePointSolver(PetscInt size, TSRHSFunction rhsFunction, TSRHSJacobian rhsJacobian, void* ctx, TS& pointTs, Vec& pointVec,
+                                                                Mat& pointJacobian) {
     // Create a vector and mat for local ode calculation
-    VecCreateSeq(PETSC_COMM_SELF, numberSpecies + 1, &pointData) >> checkError;
-    MatCreateSeqDense(PETSC_COMM_SELF, numberSpecies + 1, numberSpecies + 1, NULL, &jacobian) >> checkError;
-    MatSetFromOptions(jacobian) >> checkError;
+    VecCreateSeq(PETSC_COMM_SELF, size, &pointVec) >> checkError;
+    MatCreateSeqDense(PETSC_COMM_SELF, size, size, NULL, &pointJacobian) >> checkError;
+    MatSetFromOptions(pointJacobian) >> checkError;
 
     /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
               Create timestepping solver context
               - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
-    TSCreate(PETSC_COMM_WORLD, &ts) >> checkError;
-    TSSetType(ts, TSARKIMEX) >> checkError;
-    TSARKIMEXSetFullyImplicit(ts, PETSC_TRUE) >> checkError;
-    TSARKIMEXSetType(ts, TSARKIMEX4) >> checkError;
-    TSSetRHSFunction(ts, NULL, SinglePointChemistryRHS, this) >> checkError;
-    TSSetRHSJacobian(ts, jacobian, jacobian, SinglePointChemistryJacobian, this) >> checkError;
-    TSSetExactFinalTime(ts, TS_EXACTFINALTIME_STEPOVER) >> checkError;
+    TSCreate(PETSC_COMM_SELF, &pointTs) >> checkError;
+    TSSetType(pointTs, TSARKIMEX) >> checkError;
+    TSARKIMEXSetFullyImplicit(pointTs, PETSC_TRUE) >> checkError;
+    TSARKIMEXSetType(pointTs, TSARKIMEX4) >> checkError;
+    TSSetRHSFunction(pointTs, NULL, rhsFunction, ctx) >> checkError;
+    TSSetRHSJacobian(pointTs, pointJacobian, pointJacobian, rhsJacobian, ctx) >> checkError;
+    TSSetExactFinalTime(pointTs, TS_EXACTFINALTIME_STEPOVER) >> checkError;
 
     // set the adapting control
-    TSSetSolution(ts, pointData) >> checkError;
+    TSSetSolution(pointTs, pointVec) >> checkError;
     PetscReal dt = 1e-10; /* Initial time step */
-    TSSetTimeStep(ts, dt) >> checkError;
+    TSSetTimeStep(pointTs, dt) >> checkError;
     TSAdapt adapt;
-    TSGetAdapt(ts, &adapt) >> checkError;
+    TSGetAdapt(pointTs, &adapt) >> checkError;
     TSAdaptSetStepLimits(adapt, 1e-12, 1E-4) >> checkError; /* Also available with -ts_adapt_dt_min/-ts_adapt_dt_max */
-    TSSetMaxSNESFailures(ts, -1) >> checkError;             /* Retry step an unlimited number of times */
-    TSSetFromOptions(ts) >> checkError;
+    TSSetMaxSNESFailures(pointTs, -1) >> checkError;        /* Retry step an unlimited number of times */
+    TSSetFromOptions(pointTs) >> checkError;
 }
+
 ablate::flow::processes::TChemReactions::~TChemReactions() {
+    utilities::MemoryTracker::Unregister(this);
     if (fieldDm) {
         DMDestroy(&fieldDm) >> checkError;
     }
@@ -75,9 +140,54 @@ ablate::flow::processes::TChemReactions::~TChemReactions() {
     if (jacobian) {
         MatDestroy(&jacobian) >> checkError;
     }
+    for (auto& reducedSolver : reducedSolvers) {
+        TSDestroy(&reducedSolver.second.ts) >> checkError;
+        VecDestroy(&reducedSolver.second.pointData) >> checkError;
+        MatDestroy(&reducedSolver.second.jacobian) >> checkError;
+    }
     PetscFree3(tchemScratch, jacobianScratch, rows) >> checkError;
 }
 
+PetscLogDouble ablate::flow::processes::TChemReactions::GetMemoryBytes() const {
+    // the source vector and the tchem scratch arrays
+    const PetscLogDouble size = numberSpecies + 1;
+    PetscLogDouble bytes = utilities::MemoryTracker::GetBytes(sourceVec) + (size + size * size) * sizeof(double) + size * sizeof(PetscInt);
+
+    // each point solver holds a state vector and a dense jacobian
+    bytes += (size + size * size) * sizeof(PetscScalar);
+    for (const auto& reducedSolver : reducedSolvers) {
+        bytes += (PetscLogDouble)(reducedSolver.first + reducedSolver.first * reducedSolver.first) * sizeof(PetscScalar);
+    }
+
+    // the cell cost and the reduced mechanism work arrays
+    bytes += utilities::MemoryTracker::GetBytes(cellCost) + utilities::MemoryTracker::GetBytes(costCells) + utilities::MemoryTracker::GetBytes(reducedIndices) +
+             utilities::MemoryTracker::GetBytes(activeSpecies) + utilities::MemoryTracker::GetBytes(activeReactions) + utilities::MemoryTracker::GetBytes(fullState) +
+             utilities::MemoryTracker::GetBytes(fullSource) + utilities::MemoryTracker::GetBytes(fullJacobian) + utilities::MemoryTracker::GetBytes(reducedJacobian);
+    return bytes;
+}
+
+void ablate::flow::processes::TChemReactions::Save(monitors::Checkpoint& checkpoint) {
+    // the cost is only available once the chemistry has been integrated
+    std::vector<PetscInt> cells;
+    std::vector<PetscInt> offsets(1, 0);
+    if (cellCost.size() == costCells.size()) {
+        cells = costCells;
+        offsets.resize(cells.size() + 1);
+        std::iota(offsets.begin(), offsets.end(), 0);
+    }
+    checkpoint.WritePointRecords("chemistryCellCost", fieldDm, cells, offsets, cellCost.data());
+}
+
+void ablate::flow::processes::TChemReactions::Restore(monitors::Checkpoint& checkpoint) {
+    std::vector<PetscInt> cells, offsets;
+    std::vector<PetscReal> cost;
+    checkpoint.ReadPointRecords("chemistryCellCost", fieldDm, monitors::Checkpoint::GetOwnedPoints(fieldDm), cells, offsets, cost);
+    restoredCellCost.clear();
+    for (std::size_t i = 0; i < cells.size(); i++) {
+        restoredCellCost[cells[i]] = cost[offsets[i]];
+    }
+}
+
 void ablate::flow::processes::TChemReactions::Initialize(ablate::flow::FVFlow& flow) {
     // Create a copy of the dm for the solver
     DM coordDM;
@@ -99,12 +209,16 @@ void ablate::flow::processes::TChemReactions::Initialize(ablate::flow::FVFlow& f
     // create a vector to hold the source terms
     DMCreateLocalVector(fieldDm, &sourceVec) >> checkError;
 
-    // Before each step, compute the source term over the entire dt
-    auto chemistryPreStep = std::bind(&ablate::flow::processes::TChemReactions::ChemistryFlowPreStep, this, std::placeholders::_1, std::placeholders::_2);
-    flow.RegisterPreStep(chemistryPreStep);
+    // Before each step, compute the source term over the entire dt (or advance the first half step when split)
+    flow.RegisterPreStep([this](TS flowTs, ablate::flow::Flow& flowObject) { ChemistryFlowPreStep(flowTs, flowObject) >> checkError; });
 
-    // Add the rhs point function for the source
-    flow.RegisterRHSFunction(AddChemistrySourceToFlow, this);
+    if (strangSplitting) {
+        // After each step, advance the second half step
+        flow.RegisterPostStep([this](TS flowTs, ablate::flow::Flow& flowObject) { ChemistryFlowPostStep(flowTs, flowObject) >> checkError; });
+    } else {
+        // Add the rhs point function for the source
+        flow.RegisterRHSFunction(AddChemistrySourceToFlow, this);
+    }
 }
 
 PetscErrorCode ablate::flow::processes::TChemReactions::SinglePointChemistryRHS(TS ts, PetscReal t, Vec X, Vec F, void* ptr) {
@@ -174,7 +288,187 @@ PetscErrorCode ablate::flow::processes::TChemReactions::SinglePointChemistryJaco
     PetscFunctionReturn(0);
 }
 
+PetscErrorCode ablate::flow::processes::TChemReactions::ReducedPointChemistryRHS(TS ts, PetscReal t, Vec X, Vec F, void* ptr) {
+    ablate::flow::processes::TChemReactions* solver = (ablate::flow::processes::TChemReactions*)ptr;
+    PetscErrorCode ierr;
+    PetscScalar* fArray;
+    const PetscScalar* xArray;
+
+    PetscFunctionBeginUser;
+    ierr = VecGetArrayRead(X, &xArray);
+    CHKERRQ(ierr);
+    ierr = VecGetArray(F, &fArray);
+    CHKERRQ(ierr);
+
+    // update the active values in the full state, the frozen species keep their value
+    const std::size_t reducedSize = solver->reducedIndices.size();
+    for (std::size_t i = 0; i < reducedSize; i++) {
+        solver->fullState[solver->reducedIndices[i]] = xArray[i];
+    }
+
+    // get the source (assuming constant pressure/mass) from only the active reactions
+    solver->kinetics->ComputeSource(1, &solver->reducedPressure, solver->fullState.data(), solver->fullSource.data());
+    for (std::size_t i = 0; i < reducedSize; i++) {
+        fArray[i] = solver->fullSource[solver->reducedIndices[i]];
+    }
+
+    ierr = VecRestoreArrayRead(X, &xArray);
+    CHKERRQ(ierr);
+    ierr = VecRestoreArray(F, &fArray);
+    CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+}
+
+PetscErrorCode ablate::flow::processes::TChemReactions::ReducedPointChemistryJacobian(TS ts, PetscReal t, Vec X, Mat aMat, Mat pMat, void* ptr) {
+    ablate::flow::processes::TChemReactions* solver = (ablate::flow::processes::TChemReactions*)ptr;
+    PetscErrorCode ierr;
+    const std::size_t fullSize = solver->numberSpecies + 1;
+    const std::size_t reducedSize = solver->reducedIndices.size();
+
+    PetscFunctionBeginUser;
+    const PetscScalar* xArray;
+    ierr = VecGetArrayRead(X, &xArray);
+    CHKERRQ(ierr);
+    for (std::size_t i = 0; i < reducedSize; i++) {
+        solver->fullState[solver->reducedIndices[i]] = xArray[i];
+    }
+    ierr = VecRestoreArrayRead(X, &xArray);
+    CHKERRQ(ierr);
+
+    // compute the analytical jacobian assuming constant pressure and copy the active rows/columns (column major)
+    solver->kinetics->ComputeSourceJacobian(solver->reducedPressure, solver->fullState.data(), solver->fullSource.data(), solver->fullJacobian.data());
+    for (std::size_t j = 0; j < reducedSize; j++) {
+        for (std::size_t i = 0; i < reducedSize; i++) {
+            solver->reducedJacobian[i + j * reducedSize] = solver->fullJacobian[solver->reducedIndices[i] + solver->reducedIndices[j] * fullSize];
+        }
+    }
+
+    // Load the matrix
+    ierr = MatSetOption(pMat, MAT_ROW_ORIENTED, PETSC_FALSE);
+    CHKERRQ(ierr);
+    ierr = MatSetOption(pMat, MAT_IGNORE_ZERO_ENTRIES, PETSC_TRUE);
+    CHKERRQ(ierr);
+    ierr = MatZeroEntries(pMat);
+    CHKERRQ(ierr);
+    ierr = MatSetValues(pMat, (PetscInt)reducedSize, solver->rows, (PetscInt)reducedSize, solver->rows, solver->reducedJacobian.data(), INSERT_VALUES);
+    CHKERRQ(ierr);
+    ierr = MatAssemblyBegin(pMat, MAT_FINAL_ASSEMBLY);
+    CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(pMat, MAT_FINAL_ASSEMBLY);
+    CHKERRQ(ierr);
+    if (aMat != pMat) {
+        ierr = MatAssemblyBegin(aMat, MAT_FINAL_ASSEMBLY);
+        CHKERRQ(ierr);
+        ierr = MatAssemblyEnd(aMat, MAT_FINAL_ASSEMBLY);
+        CHKERRQ(ierr);
+    }
+    PetscFunctionReturn(0);
+}
+
+void ablate::flow::processes::TChemReactions::ReduceMechanism(const PetscReal* state) {
+    reducedPressure = state[numberSpecies + 1];
+
+    // compute the full temperature source for the error control
+    kinetics->ResetActiveReactions();
+    kinetics->ComputeSource(1, &reducedPressure, state, fullSource.data());
+    const PetscReal fullTemperatureSource = fullSource[0];
+
+    // reduce the threshold until the temperature source error (relative, with a 1 K/s floor) is within the tolerance
+    bool accepted = false;
+    PetscReal threshold = adaptiveChemistryThreshold;
+    const int maxAttempts = 3;
+    for (int attempt = 0; attempt < maxAttempts && !accepted; attempt++, threshold *= 0.1) {
+        relationGraph->Reduce(*kinetics, reducedPressure, state, adaptiveChemistryTargets, threshold, activeSpecies, activeReactions);
+        kinetics->SetActiveReactions(activeReactions);
+        kinetics->ComputeSource(1, &reducedPressure, state, fullSource.data());
+        accepted = PetscAbsReal(fullSource[0] - fullTemperatureSource) <= adaptiveChemistryTolerance * PetscMax(PetscAbsReal(fullTemperatureSource), 1.0);
+    }
+
+    // fall back to the full mechanism
+    if (!accepted) {
+        activeSpecies.assign(numberSpecies, 1);
+        activeReactions.assign(kinetics->GetNumberReactions(), 1);
+        kinetics->ResetActiveReactions();
+    }
+
+    // map the reduced state (T, active Yi) to the full state
+    reducedIndices.clear();
+    reducedIndices.push_back(0);
+    for (std::size_t s = 0; s < numberSpecies; s++) {
+        if (activeSpecies[s]) {
+            reducedIndices.push_back(s + 1);
+        }
+    }
+
+    // record the statistics
+    const PetscReal numberActiveReactions = (PetscReal)std::count(activeReactions.begin(), activeReactions.end(), 1);
+    reducedCells++;
+    reducedSpeciesSum += reducedIndices.size() - 1;
+    reducedReactionsSum += numberActiveReactions;
+    stepReducedStatistics[0] += 1.0;
+    stepReducedStatistics[1] += reducedIndices.size() - 1;
+    stepReducedStatistics[2] += numberActiveReactions;
+}
+
+ablate::flow::processes::TChemReactions::AdaptiveChemistryStatistics ablate::flow::processes::TChemReactions::GetAdaptiveChemistryStatistics() const {
+    return {.numberCells = reducedCells,
+            .averageSpecies = reducedCells ? reducedSpeciesSum / reducedCells : 0.0,
+            .averageReactions = reducedCells ? reducedReactionsSum / reducedCells : 0.0};
+}
+
 PetscErrorCode ablate::flow::processes::TChemReactions::ChemistryFlowPreStep(TS flowTs, ablate::flow::Flow& flow) {
+    PetscErrorCode ierr;
+
+    PetscFunctionBegin;
+    // store the current dt
+    PetscReal dt;
+    ierr = TSGetTimeStep(flowTs, &dt);
+    CHKERRQ(ierr);
+
+    if (strangSplitting) {
+        // advance the chemistry over the first half step and apply it directly to the flow.  The post step completes the step actually taken
+        firstHalfTimeStep = 0.5 * dt;
+        ierr = IntegrateChemistry(flowTs, flow, firstHalfTimeStep, PETSC_TRUE);
+        CHKERRQ(ierr);
+
+        // the solution was changed outside the ts, so any stored stages or multistep history are no longer valid
+        ierr = TSRestartStep(flowTs);
+    } else {
+        // compute the source over the entire dt
+        ierr = IntegrateChemistry(flowTs, flow, dt, PETSC_FALSE);
+    }
+    CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+}
+
+PetscErrorCode ablate::flow::processes::TChemReactions::ChemistryFlowPostStep(TS flowTs, ablate::flow::Flow& flow) {
+    PetscErrorCode ierr;
+
+    PetscFunctionBegin;
+    // the ts may have taken a different step than was requested in the pre step (e.g. adaptive or final time step)
+    PetscReal time, previousTime;
+    ierr = TSGetTime(flowTs, &time);
+    CHKERRQ(ierr);
+    ierr = TSGetPrevTime(flowTs, &previousTime);
+    CHKERRQ(ierr);
+
+    // advance the chemistry over the rest of the step just taken so that the chemistry and transport cover the same time
+    PetscReal secondHalfTimeStep = PetscMax(0.0, (time - previousTime) - firstHalfTimeStep);
+    if (secondHalfTimeStep > 0.0) {
+        ierr = IntegrateChemistry(flowTs, flow, secondHalfTimeStep, PETSC_TRUE);
+        CHKERRQ(ierr);
+        ierr = TSRestartStep(flowTs);
+        CHKERRQ(ierr);
+    }
+
+    // the aux fields (temperature, velocity, etc.) were computed from the solution before the chemistry
+    if (auto fvFlow = dynamic_cast<ablate::flow::FVFlow*>(&flow)) {
+        fvFlow->UpdateAuxFieldsFromSolution(time, flow.GetSolutionVector());
+    }
+    PetscFunctionReturn(0);
+}
+
+PetscErrorCode ablate::flow::processes::TChemReactions::IntegrateChemistry(TS flowTs, ablate::flow::Flow& flow, PetscReal dt, PetscBool updateSolution) {
     PetscInt stepNumber;
     TSGetStepNumber(flowTs, &stepNumber);
     PetscReal time;
@@ -182,6 +476,8 @@ PetscErrorCode ablate::flow::processes::TChemReactions::ChemistryFlowPreStep(TS
     PetscErrorCode ierr;
 
     PetscFunctionBegin;
+    ierr = PetscLogEventBegin(integrateLogEvent, 0, 0, 0, 0);
+    CHKERRQ(ierr);
     IS cellIS;
     DM plex;
     PetscInt depth;
@@ -207,11 +503,6 @@ PetscErrorCode ablate::flow::processes::TChemReactions::ChemistryFlowPreStep(TS
     ierr = DMGetDimension(flow.GetDM(), &dim);
     CHKERRQ(ierr);
 
-    // store the current dt
-    PetscReal dt;
-    ierr = TSGetTimeStep(flowTs, &dt);
-    CHKERRQ(ierr);
-
     // get access to the underlying data for the flow
     PetscInt flowEulerId = flow.GetFieldId("euler").value();
     PetscInt flowDensityYiId = flow.GetFieldId("densityYi").value();
@@ -221,18 +512,27 @@ PetscErrorCode ablate::flow::processes::TChemReactions::ChemistryFlowPreStep(TS
     ierr = TSGetSolution(flowTs, &globFlowVec);
     CHKERRQ(ierr);
     const PetscScalar* flowArray;
-    ierr = VecGetArrayRead(globFlowVec, &flowArray);
-    CHKERRQ(ierr);
-
-    // Get access to the chemistry source.  This is sized for euler + nspec
-    PetscScalar* sourceArray;
-    ierr = VecGetArray(sourceVec, &sourceArray);
-    CHKERRQ(ierr);
+    PetscScalar* updateFlowArray = NULL;
+    if (updateSolution) {
+        ierr = VecGetArray(globFlowVec, &updateFlowArray);
+        CHKERRQ(ierr);
+        flowArray = updateFlowArray;
+    } else {
+        ierr = VecGetArrayRead(globFlowVec, &flowArray);
+        CHKERRQ(ierr);
+    }
 
     // store the eos temperature functions
     eos::ComputeTemperatureFunction temperatureFunction = eos->GetComputeTemperatureFunction();
     void* temperatureContext = eos->GetComputeTemperatureContext();
 
+    // Store the chemistry state (T, Yi..., p, dt) for each real cell so that it can be integrated locally or on another rank
+    const std::size_t stateSize = GetStateSize();
+    std::vector<PetscInt> chemistryCells;
+    chemistryCells.reserve(cEnd - cStart);
+    std::vector<PetscReal> states;
+    states.reserve((cEnd - cStart) * stateSize);
+
     // March over each cell
     for (PetscInt c = cStart; c < cEnd; ++c) {
         // if there is a cell array, use it, otherwise it is just c
@@ -259,86 +559,409 @@ PetscErrorCode ablate::flow::processes::TChemReactions::ChemistryFlowPreStep(TS
                                        temperatureContext);
             CHKERRQ(ierr);
 
-            // get access to the point ode solver
-            PetscScalar* pointArray;
-            ierr = VecGetArray(pointData, &pointArray);
-            CHKERRQ(ierr);
-            pointArray[0] = temperature;
+            const std::size_t offset = states.size();
+            states.resize(offset + stateSize);
+            PetscReal* state = &states[offset];
+            state[0] = temperature;
             for (std::size_t s = 0; s < numberSpecies; s++) {
-                pointArray[s + 1] = densityYi[s] / euler[ablate::flow::processes::EulerAdvection::RHO];
+                state[s + 1] = densityYi[s] / euler[ablate::flow::processes::EulerAdvection::RHO];
             }
 
-            // precompute some values with the point array
-            double mwMix;  // This is kinda of a hack, just pass in the tempYi working array while skipping the first index
-            int err = TC_getMs2Wmix(pointArray + 1, numberSpecies, &mwMix);
+            // precompute some values with the state.  Skip the first index (T) to get the yi
+            double mwMix;
+            int err = TC_getMs2Wmix(state + 1, numberSpecies, &mwMix);
             TCCHKERRQ(err);
-            ierr = VecRestoreArray(pointData, &pointArray);
-            CHKERRQ(ierr);
 
             // compute the pressure as this node from T, Yi
             double R = 1000.0 * RUNIV / mwMix;
-            PetscReal pressure = euler[ablate::flow::processes::EulerAdvection::RHO] * temperature * R;
-            TC_setThermoPres(pressure);
+            state[numberSpecies + 1] = euler[ablate::flow::processes::EulerAdvection::RHO] * temperature * R;
+            state[numberSpecies + 2] = dt;
 
-            // Do a soft reset on the ode solver
-            ierr = TSSetTime(ts, time);
-            CHKERRQ(ierr);
-            ierr = TSSetMaxTime(ts, time + dt);
-            CHKERRQ(ierr);
+            chemistryCells.push_back(cell);
+        }
+    }
 
-            // solver for this point
-            ierr = TSSolve(ts, pointData);
-            CHKERRQ(ierr);
+    // the measured cost of each cell is kept with the cell so that it can be checkpointed
+    if (!restoredCellCost.empty()) {
+        cellCost.assign(chemistryCells.size(), 1.0);
+        for (std::size_t i = 0; i < chemistryCells.size(); i++) {
+            auto restored = restoredCellCost.find(chemistryCells[i]);
+            if (restored != restoredCellCost.end()) {
+                cellCost[i] = restored->second;
+            }
+        }
+        restoredCellCost.clear();
+    }
+    costCells = chemistryCells;
 
-            // Use the updated values to compute the source terms for euler and species transport
-            PetscScalar* fieldSource;
-            ierr = DMPlexPointLocalRef(fieldDm, cell, sourceArray, &fieldSource);
+    // Integrate each state, sharing the work between ranks if requested
+    SolveChemistry(PetscObjectComm((PetscObject)flowTs), time, states);
+
+    // record the measured cost with each cell (both halves are added when split)
+    if (auto fvFlow = dynamic_cast<ablate::flow::FVFlow*>(&flow)) {
+        fvFlow->AddCellCost(FVFlow::CHEMISTRY_COST, costCells, cellCost);
+    }
+
+    // report the average reduced mechanism size over all ranks for this step
+    if (adaptiveChemistry && adaptiveChemistryMonitor) {
+        PetscReal globalStatistics[3];
+        ierr = MPIU_Allreduce(stepReducedStatistics, globalStatistics, 3, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject)flowTs));
+        CHKERRQ(ierr);
+        if (globalStatistics[0] > 0) {
+            ierr = PetscPrintf(PetscObjectComm((PetscObject)flowTs),
+                               "Timestep: %04d adaptive chemistry: %d cells with an average of %g/%d species and %g/%d reactions\n",
+                               (int)stepNumber,
+                               (int)globalStatistics[0],
+                               (double)(globalStatistics[1] / globalStatistics[0]),
+                               (int)numberSpecies,
+                               (double)(globalStatistics[2] / globalStatistics[0]),
+                               (int)kinetics->GetNumberReactions());
             CHKERRQ(ierr);
+        }
+    }
+    std::fill(std::begin(stepReducedStatistics), std::end(stepReducedStatistics), 0.0);
+
+    // Get access to the chemistry source.  This is sized for euler + nspec
+    PetscScalar* sourceArray = NULL;
+    if (!updateSolution) {
+        ierr = VecGetArray(sourceVec, &sourceArray);
+        CHKERRQ(ierr);
+    }
 
-            // get the array data again
-            VecGetArray(pointData, &pointArray) >> checkError;
+    // Use the updated values to compute the source terms for euler and species transport (or update the flow directly)
+    for (std::size_t i = 0; i < chemistryCells.size(); i++) {
+        const PetscInt cell = chemistryCells[i];
+        PetscReal* state = &states[i * stateSize];
 
-            // Use the point array to compute the updatedInternalEnergy
-            err = TC_getMs2Wmix(pointArray + 1, numberSpecies, &mwMix);
-            TCCHKERRQ(err);
-            PetscReal updatedInternalEnergy;
-            ierr = eos::TChem::ComputeSensibleInternalEnergy(numberSpecies, pointArray, mwMix, updatedInternalEnergy);
+        const PetscScalar* euler;
+        const PetscScalar* densityYi;
+        ierr = DMPlexPointGlobalFieldRead(flow.GetDM(), cell, flowEulerId, flowArray, &euler);
+        CHKERRQ(ierr);
+        ierr = DMPlexPointGlobalFieldRead(flow.GetDM(), cell, flowDensityYiId, flowArray, &densityYi);
+        CHKERRQ(ierr);
+
+        // Use the updated state to compute the updatedInternalEnergy
+        double mwMix;
+        int err = TC_getMs2Wmix(state + 1, numberSpecies, &mwMix);
+        TCCHKERRQ(err);
+        PetscReal updatedInternalEnergy;
+        ierr = eos::TChem::ComputeSensibleInternalEnergy(numberSpecies, state, mwMix, updatedInternalEnergy);
+        CHKERRQ(ierr);
+
+        // compute the ke
+        PetscReal ke = 0.0;
+        for (PetscInt d = 0; d < dim; d++) {
+            ke += PetscSqr(euler[ablate::flow::processes::EulerAdvection::RHOU + d] / euler[ablate::flow::processes::EulerAdvection::RHO]);
+        }
+        ke *= 0.5;
+
+        if (updateSolution) {
+            // the density and momentum are unchanged by the chemistry, so only update the energy and species
+            PetscScalar* updateEuler;
+            PetscScalar* updateDensityYi;
+            ierr = DMPlexPointGlobalFieldRef(flow.GetDM(), cell, flowEulerId, updateFlowArray, &updateEuler);
+            CHKERRQ(ierr);
+            ierr = DMPlexPointGlobalFieldRef(flow.GetDM(), cell, flowDensityYiId, updateFlowArray, &updateDensityYi);
             CHKERRQ(ierr);
 
-            // compute the ke
-            PetscReal ke = 0.0;
-            for (PetscInt d = 0; d < dim; d++) {
-                ke += PetscSqr(euler[ablate::flow::processes::EulerAdvection::RHOU + d] / euler[ablate::flow::processes::EulerAdvection::RHO]);
-            }
-            ke *= 0.5;
-
-            // store the computed source terms
-            fieldSource[ablate::flow::processes::EulerAdvection::RHO] = 0.0;
-            fieldSource[ablate::flow::processes::EulerAdvection::RHOE] =
-                (euler[ablate::flow::processes::EulerAdvection::RHO] * (updatedInternalEnergy + ke) - euler[ablate::flow::processes::EulerAdvection::RHOE]) / dt;
-            for (PetscInt d = 0; d < dim; d++) {
-                fieldSource[ablate::flow::processes::EulerAdvection::RHOU + d] = 0.0;
-            }
+            const PetscReal density = updateEuler[ablate::flow::processes::EulerAdvection::RHO];
+            updateEuler[ablate::flow::processes::EulerAdvection::RHOE] = density * (updatedInternalEnergy + ke);
             for (std::size_t sp = 0; sp < numberSpecies; sp++) {
-                // for constant density problem, d Yi rho/dt = rho * d Yi/dt + Yi*d rho/dt = rho*dYi/dt ~~ rho*(Yi+1 - Y1)/dt
-                fieldSource[ablate::flow::processes::EulerAdvection::RHOU + dim + sp] = (euler[ablate::flow::processes::EulerAdvection::RHO] * pointArray[sp + 1] - densityYi[sp]) / dt;
+                updateDensityYi[sp] = density * state[sp + 1];
             }
-            VecRestoreArray(pointData, &pointArray);
+            continue;
+        }
+
+        PetscScalar* fieldSource;
+        ierr = DMPlexPointLocalRef(fieldDm, cell, sourceArray, &fieldSource);
+        CHKERRQ(ierr);
+
+        // store the computed source terms
+        fieldSource[ablate::flow::processes::EulerAdvection::RHO] = 0.0;
+        fieldSource[ablate::flow::processes::EulerAdvection::RHOE] =
+            (euler[ablate::flow::processes::EulerAdvection::RHO] * (updatedInternalEnergy + ke) - euler[ablate::flow::processes::EulerAdvection::RHOE]) / dt;
+        for (PetscInt d = 0; d < dim; d++) {
+            fieldSource[ablate::flow::processes::EulerAdvection::RHOU + d] = 0.0;
+        }
+        for (std::size_t sp = 0; sp < numberSpecies; sp++) {
+            // for constant density problem, d Yi rho/dt = rho * d Yi/dt + Yi*d rho/dt = rho*dYi/dt ~~ rho*(Yi+1 - Y1)/dt
+            fieldSource[ablate::flow::processes::EulerAdvection::RHOU + dim + sp] = (euler[ablate::flow::processes::EulerAdvection::RHO] * state[sp + 1] - densityYi[sp]) / dt;
         }
     }
 
     // cleanup
-    ierr = VecRestoreArray(sourceVec, &sourceArray);
-    CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(globFlowVec, &flowArray);
-    CHKERRQ(ierr);
+    if (updateSolution) {
+        ierr = VecRestoreArray(globFlowVec, &updateFlowArray);
+        CHKERRQ(ierr);
+    } else {
+        ierr = VecRestoreArray(sourceVec, &sourceArray);
+        CHKERRQ(ierr);
+        ierr = VecRestoreArrayRead(globFlowVec, &flowArray);
+        CHKERRQ(ierr);
+    }
     ierr = DMDestroy(&plex);
     CHKERRQ(ierr);
     ierr = ISDestroy(&cellIS);
     CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(integrateLogEvent, 0, 0, 0, 0);
+    CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+}
+
+PetscErrorCode ablate::flow::processes::TChemReactions::SolvePointChemistry(PetscReal time, PetscReal* state, PetscReal& cost) {
+    PetscErrorCode ierr;
+    PetscLogDouble startTime, endTime;
+
+    PetscFunctionBegin;
+    ierr = PetscTime(&startTime);
+    CHKERRQ(ierr);
+
+    // use the full TChem solver unless the mechanism is reduced in this cell
+    TS pointTs = ts;
+    Vec pointVec = pointData;
+    if (adaptiveChemistry) {
+        try {
+            ReduceMechanism(state);
+        } catch (std::exception& exception) {
+            SETERRQ(PETSC_COMM_SELF, PETSC_ERR_LIB, exception.what());
+        }
+        std::copy(state, state + numberSpecies + 1, fullState.begin());
+
+        // get (or create) the point solver for this size
+        const PetscInt reducedSize = (PetscInt)reducedIndices.size();
+        if (reducedSolvers.count(reducedSize) == 0) {
+            ReducedSolver reducedSolver;
+            try {
+                CreatePointSolver(reducedSize, ReducedPointChemistryRHS, ReducedPointChemistryJacobian, this, reducedSolver.ts, reducedSolver.pointData, reducedSolver.jacobian);
+            } catch (std::exception& exception) {
+                SETERRQ(PETSC_COMM_SELF, PETSC_ERR_LIB, exception.what());
+            }
+            reducedSolvers[reducedSize] = reducedSolver;
+        }
+        pointTs = reducedSolvers[reducedSize].ts;
+        pointVec = reducedSolvers[reducedSize].pointData;
+    } else {
+        // set the pressure for this point
+        TC_setThermoPres(state[numberSpecies + 1]);
+    }
+
+    // copy the T, Yi (or reduced T, Yi) into the point ode solver
+    PetscScalar* pointArray;
+    ierr = VecGetArray(pointVec, &pointArray);
+    CHKERRQ(ierr);
+    if (adaptiveChemistry) {
+        for (std::size_t i = 0; i < reducedIndices.size(); i++) {
+            pointArray[i] = state[reducedIndices[i]];
+        }
+    } else {
+        ierr = PetscArraycpy(pointArray, state, numberSpecies + 1);
+        CHKERRQ(ierr);
+    }
+    ierr = VecRestoreArray(pointVec, &pointArray);
+    CHKERRQ(ierr);
+
+    // Do a soft reset on the ode solver
+    ierr = TSSetTime(pointTs, time);
+    CHKERRQ(ierr);
+    ierr = TSSetMaxTime(pointTs, time + state[numberSpecies + 2]);
+    CHKERRQ(ierr);
+
+    // solver for this point
+    ierr = TSSolve(pointTs, pointVec);
+    CHKERRQ(ierr);
+
+    // copy back the updated T, Yi.  Frozen species are unchanged
+    ierr = VecGetArray(pointVec, &pointArray);
+    CHKERRQ(ierr);
+    if (adaptiveChemistry) {
+        for (std::size_t i = 0; i < reducedIndices.size(); i++) {
+            state[reducedIndices[i]] = pointArray[i];
+        }
+    } else {
+        ierr = PetscArraycpy(state, pointArray, numberSpecies + 1);
+        CHKERRQ(ierr);
+    }
+    ierr = VecRestoreArray(pointVec, &pointArray);
+    CHKERRQ(ierr);
+
+    ierr = PetscTime(&endTime);
+    CHKERRQ(ierr);
+    cost = (PetscReal)(endTime - startTime);
     PetscFunctionReturn(0);
 }
 
+std::vector<ablate::flow::processes::TChemReactions::ChemistryTransfer> ablate::flow::processes::TChemReactions::PlanChemistryTransfers(const std::vector<PetscReal>& rankLoad,
+                                                                                                                                       PetscReal tolerance) {
+    std::vector<ChemistryTransfer> transfers;
+    if (rankLoad.empty()) {
+        return transfers;
+    }
+
+    // determine if the load is out of balance
+    PetscReal averageLoad = std::accumulate(rankLoad.begin(), rankLoad.end(), 0.0) / rankLoad.size();
+    PetscReal maxLoad = *std::max_element(rankLoad.begin(), rankLoad.end());
+    if (averageLoad <= 0.0 || maxLoad <= (1.0 + tolerance) * averageLoad) {
+        return transfers;
+    }
+
+    // split the ranks into donors (above average) and receivers (below average)
+    std::vector<std::pair<PetscMPIInt, PetscReal>> donors;
+    std::vector<std::pair<PetscMPIInt, PetscReal>> receivers;
+    for (std::size_t r = 0; r < rankLoad.size(); r++) {
+        if (rankLoad[r] > averageLoad) {
+            donors.emplace_back((PetscMPIInt)r, rankLoad[r] - averageLoad);
+        } else if (rankLoad[r] < averageLoad) {
+            receivers.emplace_back((PetscMPIInt)r, averageLoad - rankLoad[r]);
+        }
+    }
+
+    // match the excess work to the available capacity in rank order so that every rank computes the same plan
+    std::size_t d = 0, r = 0;
+    while (d < donors.size() && r < receivers.size()) {
+        PetscReal amount = PetscMin(donors[d].second, receivers[r].second);
+        transfers.push_back({.from = donors[d].first, .to = receivers[r].first, .cost = amount});
+        donors[d].second -= amount;
+        receivers[r].second -= amount;
+        if (donors[d].second <= 0.0) {
+            d++;
+        }
+        if (receivers[r].second <= 0.0) {
+            r++;
+        }
+    }
+    return transfers;
+}
+
+void ablate::flow::processes::TChemReactions::SolveChemistry(MPI_Comm comm, PetscReal time, std::vector<PetscReal>& states) {
+    const std::size_t stateSize = GetStateSize();
+    // the results returned from another rank are T, Yi..., cost
+    const std::size_t resultSize = numberSpecies + 2;
+    const std::size_t numberStates = states.size() / stateSize;
+    const int stateTag = 0, countTag = 1, resultTag = 2;
+
+    // if the local cells have changed, assume a uniform cost until it can be measured
+    if (cellCost.size() != numberStates) {
+        cellCost.assign(numberStates, 1.0);
+    }
+
+    PetscMPIInt size, rank;
+    MPI_Comm_size(comm, &size) >> checkMpiError;
+    MPI_Comm_rank(comm, &rank) >> checkMpiError;
+
+    // determine which transfers this rank sends or receives
+    std::vector<ChemistryTransfer> sendTransfers;
+    std::vector<ChemistryTransfer> receiveTransfers;
+    if (loadBalance && size > 1) {
+        PetscReal localLoad = std::accumulate(cellCost.begin(), cellCost.end(), 0.0);
+        std::vector<PetscReal> rankLoad(size);
+        MPI_Allgather(&localLoad, 1, MPIU_REAL, &rankLoad[0], 1, MPIU_REAL, comm) >> checkMpiError;
+
+        for (const auto& transfer : PlanChemistryTransfers(rankLoad, loadBalanceTolerance)) {
+            if (transfer.from == rank) {
+                sendTransfers.push_back(transfer);
+            } else if (transfer.to == rank) {
+                receiveTransfers.push_back(transfer);
+            }
+        }
+    }
+
+    // assign the most expensive local states to each outgoing transfer until the transfer cost is met
+    std::vector<std::vector<std::size_t>> sendIndices(sendTransfers.size());
+    std::vector<bool> integrateLocally(numberStates, true);
+    if (!sendTransfers.empty()) {
+        std::vector<std::size_t> order(numberStates);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) { return cellCost[a] > cellCost[b]; });
+
+        for (std::size_t t = 0; t < sendTransfers.size(); t++) {
+            PetscReal remainingCost = sendTransfers[t].cost;
+            for (auto i : order) {
+                if (integrateLocally[i] && cellCost[i] <= remainingCost) {
+                    integrateLocally[i] = false;
+                    sendIndices[t].push_back(i);
+                    remainingCost -= cellCost[i];
+                }
+            }
+        }
+    }
+
+    // exchange the number of states in each transfer
+    std::vector<PetscMPIInt> sendCounts(sendTransfers.size());
+    std::vector<PetscMPIInt> receiveCounts(receiveTransfers.size());
+    std::vector<MPI_Request> requests;
+    for (std::size_t t = 0; t < receiveTransfers.size(); t++) {
+        requests.emplace_back();
+        MPI_Irecv(&receiveCounts[t], 1, MPI_INT, receiveTransfers[t].from, countTag, comm, &requests.back()) >> checkMpiError;
+    }
+    for (std::size_t t = 0; t < sendTransfers.size(); t++) {
+        sendCounts[t] = (PetscMPIInt)sendIndices[t].size();
+        requests.emplace_back();
+        MPI_Isend(&sendCounts[t], 1, MPI_INT, sendTransfers[t].to, countTag, comm, &requests.back()) >> checkMpiError;
+    }
+    MPI_Waitall((PetscMPIInt)requests.size(), requests.data(), MPI_STATUSES_IGNORE) >> checkMpiError;
+    requests.clear();
+
+    // send the states and post the receives for the returned results
+    std::vector<std::vector<PetscReal>> sendBuffers(sendTransfers.size());
+    std::vector<std::vector<PetscReal>> resultBuffers(sendTransfers.size());
+    std::vector<MPI_Request> resultRequests;
+    for (std::size_t t = 0; t < sendTransfers.size(); t++) {
+        sendBuffers[t].reserve(sendIndices[t].size() * stateSize);
+        for (auto i : sendIndices[t]) {
+            sendBuffers[t].insert(sendBuffers[t].end(), states.begin() + i * stateSize, states.begin() + (i + 1) * stateSize);
+        }
+        resultBuffers[t].resize(sendIndices[t].size() * resultSize);
+
+        requests.emplace_back();
+        MPI_Isend(sendBuffers[t].data(), (PetscMPIInt)sendBuffers[t].size(), MPIU_REAL, sendTransfers[t].to, stateTag, comm, &requests.back()) >> checkMpiError;
+        resultRequests.emplace_back();
+        MPI_Irecv(resultBuffers[t].data(), (PetscMPIInt)resultBuffers[t].size(), MPIU_REAL, sendTransfers[t].to, resultTag, comm, &resultRequests.back()) >> checkMpiError;
+    }
+
+    // post the receives for the incoming states
+    std::vector<std::vector<PetscReal>> receiveBuffers(receiveTransfers.size());
+    std::vector<MPI_Request> receiveRequests;
+    for (std::size_t t = 0; t < receiveTransfers.size(); t++) {
+        receiveBuffers[t].resize(receiveCounts[t] * stateSize);
+        receiveRequests.emplace_back();
+        MPI_Irecv(receiveBuffers[t].data(), (PetscMPIInt)receiveBuffers[t].size(), MPIU_REAL, receiveTransfers[t].from, stateTag, comm, &receiveRequests.back()) >> checkMpiError;
+    }
+
+    // integrate the states that stay on this rank while the messages are in flight
+    for (std::size_t i = 0; i < numberStates; i++) {
+        if (integrateLocally[i]) {
+            SolvePointChemistry(time, &states[i * stateSize], cellCost[i]) >> checkError;
+        }
+    }
+
+    // integrate the states received from other ranks and return the results
+    MPI_Waitall((PetscMPIInt)receiveRequests.size(), receiveRequests.data(), MPI_STATUSES_IGNORE) >> checkMpiError;
+    std::vector<std::vector<PetscReal>> returnBuffers(receiveTransfers.size());
+    for (std::size_t t = 0; t < receiveTransfers.size(); t++) {
+        returnBuffers[t].resize(receiveCounts[t] * resultSize);
+        for (PetscMPIInt i = 0; i < receiveCounts[t]; i++) {
+            PetscReal* state = &receiveBuffers[t][i * stateSize];
+            PetscReal* result = &returnBuffers[t][i * resultSize];
+            SolvePointChemistry(time, state, result[numberSpecies + 1]) >> checkError;
+            std::copy(state, state + numberSpecies + 1, result);
+        }
+        requests.emplace_back();
+        MPI_Isend(returnBuffers[t].data(), (PetscMPIInt)returnBuffers[t].size(), MPIU_REAL, receiveTransfers[t].from, resultTag, comm, &requests.back()) >> checkMpiError;
+    }
+
+    // copy back the results computed on other ranks
+    MPI_Waitall((PetscMPIInt)resultRequests.size(), resultRequests.data(), MPI_STATUSES_IGNORE) >> checkMpiError;
+    for (std::size_t t = 0; t < sendTransfers.size(); t++) {
+        for (std::size_t j = 0; j < sendIndices[t].size(); j++) {
+            const PetscReal* result = &resultBuffers[t][j * resultSize];
+            const std::size_t i = sendIndices[t][j];
+            std::copy(result, result + numberSpecies + 1, states.begin() + i * stateSize);
+            cellCost[i] = result[numberSpecies + 1];
+        }
+    }
+    MPI_Waitall((PetscMPIInt)requests.size(), requests.data(), MPI_STATUSES_IGNORE) >> checkMpiError;
+}
+
 PetscErrorCode ablate::flow::processes::TChemReactions::AddChemistrySourceToFlow(DM dm, PetscReal time, Vec locX, Vec fVec, void* ctx) {
     IS cellIS;
     DM plex;
@@ -411,7 +1034,7 @@ PetscErrorCode ablate::flow::processes::TChemReactions::AddChemistrySourceToFlow
 
     ierr = VecRestoreArray(fVec, &fArray);
     CHKERRQ(ierr);
-    ierr = VecGetArrayRead(solver->sourceVec, &sourceArray);
+    ierr = VecRestoreArrayRead(solver->sourceVec, &sourceArray);
     CHKERRQ(ierr);
     ierr = ISDestroy(&cellIS);
     CHKERRQ(ierr);
@@ -421,4 +1044,7 @@ PetscErrorCode ablate::flow::processes::TChemReactions::AddChemistrySourceToFlow
 }
 
 #include "parser/registrar.hpp"
-REGISTER(ablate::flow::processes::FlowProcess, ablate::flow::processes::TChemReactions, "reactions using the TChem v1 library", OPT(eos::TChem, "eos", "the tChem v1 eos"));
+REGISTER(ablate::flow::processes::FlowProcess, ablate::flow::processes::TChemReactions, "reactions using the TChem v1 library", OPT(eos::TChem, "eos", "the tChem v1 eos"),
+         OPT(ablate::parameters::Parameters, "options",
+             "the chemistry options (loadBalance, loadBalanceTolerance, adaptiveChemistry, adaptiveChemistryTargets, adaptiveChemistryThreshold, adaptiveChemistryTolerance, "
+             "adaptiveChemistryMonitor, splitting)"));
@@ -1,18 +1,96 @@
 #ifndef ABLATELIBRARY_TCHEMREACTIONS_HPP
 #define ABLATELIBRARY_TCHEMREACTIONS_HPP
 
+#include <eos/kinetics/directedRelationGraph.hpp>
+#include <eos/kinetics/kinetics.hpp>
 #include <eos/tChem.hpp>
+#include <map>
+#include <memory>
+#include <parameters/parameters.hpp>
 #include "flowProcess.hpp"
 
 namespace ablate::flow::processes {
 
 class TChemReactions : public FlowProcess {
+   public:
+    /**
+     * Describes an amount of chemistry work (measured in seconds) moved from one rank to another
+     */
+    struct ChemistryTransfer {
+        PetscMPIInt from;
+        PetscMPIInt to;
+        PetscReal cost;
+    };
+
+    /**
+     * Summarizes the size of the reduced mechanisms integrated with dynamic adaptive chemistry
+     */
+    struct AdaptiveChemistryStatistics {
+        PetscInt numberCells;
+        PetscReal averageSpecies;
+        PetscReal averageReactions;
+    };
+
    private:
     DM fieldDm;
     Vec sourceVec;
     std::shared_ptr<eos::TChem> eos;
     const size_t numberSpecies;
 
+    // chemistry load balancing options
+    const bool loadBalance;
+    const PetscReal loadBalanceTolerance;
+
+    // the measured cost (s) to integrate each local chemistry cell (costCells) over the last step
+    std::vector<PetscReal> cellCost;
+    std::vector<PetscInt> costCells;
+
+    // the cost of each cell restored from a checkpoint, used for the next step
+    std::map<PetscInt, PetscReal> restoredCellCost;
+
+    // profiles each chemistry integration
+    PetscLogEvent integrateLogEvent;
+
+    // dynamic adaptive chemistry options
+    const bool adaptiveChemistry;
+    const PetscReal adaptiveChemistryThreshold;
+    const PetscReal adaptiveChemistryTolerance;
+    const bool adaptiveChemistryMonitor;
+    std::vector<int> adaptiveChemistryTargets;
+
+    // when true, the chemistry is Strang split (half dt, transport, half dt) and applied directly to the flow instead of as a lagged source
+    const bool strangSplitting;
+    // the chemistry dt applied before the transport in the current split step
+    PetscReal firstHalfTimeStep;
+
+    // the native kinetics used to reduce and integrate the mechanism in each cell
+    std::shared_ptr<eos::kinetics::Kinetics> kinetics;
+    std::unique_ptr<eos::kinetics::DirectedRelationGraph> relationGraph;
+
+    // a point solver for each reduced mechanism size
+    struct ReducedSolver {
+        TS ts;
+        Vec pointData;
+        Mat jacobian;
+    };
+    std::map<PetscInt, ReducedSolver> reducedSolvers;
+
+    // the reduced point being integrated.  The reduced state is (T, Yi...) for the active species only
+    PetscReal reducedPressure;
+    std::vector<PetscInt> reducedIndices;
+    std::vector<unsigned char> activeSpecies;
+    std::vector<unsigned char> activeReactions;
+    std::vector<double> fullState;
+    std::vector<double> fullSource;
+    std::vector<double> fullJacobian;
+    std::vector<double> reducedJacobian;
+
+    // the reduced size statistics (cells, species, reactions) since the start and for the current step
+    PetscInt reducedCells;
+    PetscReal reducedSpeciesSum;
+    PetscReal reducedReactionsSum;
+    PetscReal stepReducedStatistics[3];
+
     // Hold the single point TS
     TS ts;
     Vec pointData;
@@ -46,6 +124,41 @@ class TChemReactions : public FlowProcess {
      */
     static PetscErrorCode SinglePointChemistryJacobian(TS ts, PetscReal t, Vec X, Mat aMat, Mat pMat, void *ptr);
 
+    /**
+     * Private function to integrate the reduced single point chemistry in time using the native kinetics.  The frozen species keep their values.
+     * @param ts
+     * @param t
+     * @param X
+     * @param F
+     * @param ptr
+     * @return
+     */
+    static PetscErrorCode ReducedPointChemistryRHS(TS ts, PetscReal t, Vec X, Vec F, void *ptr);
+
+    /**
+     * Private function to compute the Jacobian of the reduced single point chemistry using the native kinetics
+     * @param ts
+     * @param t
+     * @param X
+     * @param aMat
+     * @param pMat
+     * @param ptr
+     * @return
+     */
+    static PetscErrorCode ReducedPointChemistryJacobian(TS ts, PetscReal t, Vec X, Mat aMat, Mat pMat, void *ptr);
+
+    /**
+     * Creates a single point ode solver of the given size
+     */
+    static void CreatePointSolver(PetscInt size, TSRHSFunction rhsFunction, TSRHSJacobian rhsJacobian, void *ctx, TS &pointTs, Vec &pointVec, Mat &pointJacobian);
+
+    /**
+     * Selects the active species and reactions for this state using the directed relation graph.  The threshold is reduced until the error in the
+     * temperature source is within the tolerance, otherwise the full mechanism is used.
+     * @param state (T, Yi..., p)
+     */
+    void ReduceMechanism(const PetscReal *state);
+
     /**
      * private function to compute the energy and densityYi source terms over the next dt
      * @param ts
@@ -54,16 +167,95 @@ class TChemReactions : public FlowProcess {
      */
     PetscErrorCode ChemistryFlowPreStep(TS ts, ablate::flow::Flow &flow);
 
+    /**
+     * private function to advance the chemistry over the remainder of the step actually taken when using Strang splitting
+     * @param ts
+     * @param flow
+     * @return
+     */
+    PetscErrorCode ChemistryFlowPostStep(TS ts, ablate::flow::Flow &flow);
+
+    /**
+     * Integrates the chemistry in every cell over dt.  The result is either stored as a source over dt or applied directly to the flow solution.
+     * @param ts
+     * @param flow
+     * @param dt
+     * @param updateSolution
+     * @return
+     */
+    PetscErrorCode IntegrateChemistry(TS ts, ablate::flow::Flow &flow, PetscReal dt, PetscBool updateSolution);
+
+    /**
+     * Estimates the local bytes held by the chemistry (source vector, point solvers, and scratch arrays)
+     * @return
+     */
+    PetscLogDouble GetMemoryBytes() const;
+
+    /**
+     * Converts the splitting option (source or strang) to true if Strang splitting
+     */
+    static bool ParseSplitting(const std::string &splitting);
+
+    /**
+     * Integrates a single chemistry state (T, Yi..., p, dt) from time to time + dt.  The T and Yi values are updated in place and the wall time is returned in cost
+     * @param time
+     * @param state
+     * @param cost
+     * @return
+     */
+    PetscErrorCode SolvePointChemistry(PetscReal time, PetscReal *state, PetscReal &cost);
+
     static PetscErrorCode AddChemistrySourceToFlow(DM dm, PetscReal time, Vec locX, Vec fVec, void *ctx);
 
    public:
-    explicit TChemReactions(std::shared_ptr<eos::TChem> eos);
+    /**
+     * The number of values used to describe the chemistry state of each cell (T, Yi..., p, dt)
+     */
+    inline std::size_t GetStateSize() const { return numberSpecies + 3; }
+
+    /**
+     * The average size of the reduced mechanisms integrated on this rank since the start of the simulation
+     */
+    AdaptiveChemistryStatistics GetAdaptiveChemistryStatistics() const;
+
+    /**
+     * Integrates each local chemistry state (T, Yi..., p, dt).  When load balancing is enabled, states are sent to under loaded ranks
+     * based upon the cost measured in the previous step and the results are returned.  This is collective over comm.
+     * @param comm
+     * @param time
+     * @param states
+     */
+    void SolveChemistry(MPI_Comm comm, PetscReal time, std::vector<PetscReal> &states);
+
+    explicit TChemReactions(std::shared_ptr<eos::TChem> eos, std::shared_ptr<parameters::Parameters> options = {});
     ~TChemReactions() override;
     /**
      * public function to link this process with the flow
      * @param flow
      */
     void Initialize(ablate::flow::FVFlow &flow) override;
+
+    /**
+     * Writes the measured chemistry cost of each cell so that a restart is load balanced from the first step.  The chemistry sources are recomputed before each
+     * step, so they are not stored.
+     * @param checkpoint
+     */
+    void Save(monitors::Checkpoint &checkpoint) override;
+
+    /**
+     * Restores the measured chemistry cost of each cell
+     * @param checkpoint
+     */
+    void Restore(monitors::Checkpoint &checkpoint) override;
+
+    /**
+     * Computes the chemistry work that must be moved between ranks so that each rank is within the tolerance of the average load.
+     * Every rank computes the same plan from the same loads.
+     * @param rankLoad the cost on each rank
+     * @param tolerance the allowed fractional imbalance before any work is moved
+     * @return
+     */
+    static std::vector<ChemistryTransfer> PlanChemistryTransfers(const std::vector<PetscReal> &rankLoad, PetscReal tolerance);
 };
 }  // namespace ablate::flow::processes
 #endif  // ABLATELIBRARY_TCHEMREACTIONS_HPP
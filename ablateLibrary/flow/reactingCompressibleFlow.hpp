@@ -16,7 +16,7 @@ class ReactingCompressibleFlow : public FVFlow {
                              std::shared_ptr<fluxCalculator::FluxCalculator> = {}, std::shared_ptr<parameters::Parameters> options = {},
                              std::vector<std::shared_ptr<mathFunctions::FieldSolution>> initialization = {},
                              std::vector<std::shared_ptr<boundaryConditions::BoundaryCondition>> boundaryConditions = {},
-                             std::vector<std::shared_ptr<mathFunctions::FieldSolution>> exactSolutions = {});
+                             std::vector<std::shared_ptr<mathFunctions::FieldSolution>> exactSolutions = {}, std::shared_ptr<parameters::Parameters> chemistryOptions = {});
     ~ReactingCompressibleFlow() override = default;
 };
 }  // namespace ablate::flow
@@ -28,6 +28,8 @@ class ConstantValue : public MathFunction {
     PetscFunction GetPetscFunction() override { return ConstantValuePetscFunction; }
 
     void* GetContext() override { return (void*)&value; }
+
+    bool IsTimeDependent() const override { return false; }
 };
 
 }  // namespace ablate::mathFunctions
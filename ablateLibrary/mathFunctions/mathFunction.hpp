@@ -23,6 +23,12 @@ class MathFunction {
     virtual void* GetContext() = 0;
 
     virtual PetscFunction GetPetscFunction() = 0;
+
+    /**
+     * Returns false when the function is known not to depend upon time, allowing its evaluation to be reused between time steps
+     * @return
+     */
+    virtual bool IsTimeDependent() const { return true; }
 };
 }  // namespace ablate::mathFunctions
 #endif  // ABLATELIBRARY_MATHFUNCTION_HPP
@@ -20,6 +20,10 @@ ablate::mathFunctions::ParsedFunction::ParsedFunction(std::string functionString
 
     // Test the function
     parser.Eval();
+
+    // check if the formula uses time
+    const auto& usedVariables = parser.GetUsedVar();
+    timeDependent = usedVariables.find("t") != usedVariables.end();
 }
 double ablate::mathFunctions::ParsedFunction::Eval(const double& x, const double& y, const double& z, const double& t) const {
     coordinate[0] = x;
@@ -16,6 +16,9 @@ class ParsedFunction : public MathFunction {
     mu::Parser parser;
     const std::string formula;
 
+    // true if the formula uses the t variable
+    bool timeDependent;
+
    private:
     static PetscErrorCode ParsedPetscFunction(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nf, PetscScalar* u, void* ctx);
 
@@ -36,6 +39,8 @@ class ParsedFunction : public MathFunction {
     void* GetContext() override { return this; }
 
     PetscFunction GetPetscFunction() override { return ParsedPetscFunction; }
+
+    bool IsTimeDependent() const override { return timeDependent; }
 };
 }  // namespace ablate::mathFunctions
 
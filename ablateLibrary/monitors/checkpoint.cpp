@@ -0,0 +1,388 @@
+#include "checkpoint.hpp"
+#include <petscviewerhdf5.h>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include "utilities/mpiError.hpp"
+#include "utilities/petscError.hpp"
+
+namespace {
+/**
+ * Hashes the bits of the key, so the same key is sent to the same rendezvous rank from every rank
+ */
+struct KeyHash {
+    std::size_t operator()(const ablate::monitors::Checkpoint::Key& key) const {
+        uint64_t hash = 0x9E3779B97F4A7C15ULL;
+        for (const auto& value : key) {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            hash ^= bits + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+            hash ^= hash >> 31;
+            hash *= 0xBF58476D1CE4E5B9ULL;
+        }
+        return (std::size_t)(hash ^ (hash >> 29));
+    }
+};
+
+/**
+ * Exchanges the packed messages to each rank.  The messages received from rank r are [receiveOffsets[r], receiveOffsets[r+1]) in the result.
+ */
+std::vector<PetscReal> ExchangeMessages(MPI_Comm comm, std::vector<std::vector<PetscReal>>& messages, std::vector<PetscMPIInt>& receiveOffsets) {
+    const auto size = (PetscMPIInt)messages.size();
+    std::vector<PetscMPIInt> sendCounts(size), sendOffsets(size + 1, 0), receiveCounts(size);
+    receiveOffsets.assign(size + 1, 0);
+    for (PetscMPIInt r = 0; r < size; ++r) {
+        sendCounts[r] = (PetscMPIInt)messages[r].size();
+        sendOffsets[r + 1] = sendOffsets[r] + sendCounts[r];
+    }
+    MPI_Alltoall(sendCounts.data(), 1, MPI_INT, receiveCounts.data(), 1, MPI_INT, comm) >> ablate::checkMpiError;
+    for (PetscMPIInt r = 0; r < size; ++r) {
+        receiveOffsets[r + 1] = receiveOffsets[r] + receiveCounts[r];
+    }
+
+    std::vector<PetscReal> sendBuffer(sendOffsets[size]);
+    for (PetscMPIInt r = 0; r < size; ++r) {
+        std::copy(messages[r].begin(), messages[r].end(), sendBuffer.begin() + sendOffsets[r]);
+        messages[r].clear();
+    }
+    std::vector<PetscReal> receiveBuffer(receiveOffsets[size]);
+    MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendOffsets.data(), MPIU_REAL, receiveBuffer.data(), receiveCounts.data(), receiveOffsets.data(), MPIU_REAL, comm) >>
+        ablate::checkMpiError;
+    return receiveBuffer;
+}
+}  // namespace
+
+ablate::monitors::Checkpoint::Checkpoint(MPI_Comm comm, const std::filesystem::path& path, PetscFileMode mode) : comm(comm) { Open(path, mode); }
+
+ablate::monitors::Checkpoint::~Checkpoint() { Close(); }
+
+void ablate::monitors::Checkpoint::Open(const std::filesystem::path& path, PetscFileMode mode) {
+    Close();
+    PetscViewerHDF5Open(comm, path.string().c_str(), mode, &viewer) >> checkError;
+
+    // every rank reads and writes its block of each dataset in a single collective call
+    PetscViewerHDF5SetCollective(viewer, PETSC_TRUE) >> checkError;
+}
+
+void ablate::monitors::Checkpoint::Close() {
+    if (viewer) {
+        PetscViewerDestroy(&viewer) >> checkError;
+    }
+}
+
+void ablate::monitors::Checkpoint::PushGroup(const std::string& group) { PetscViewerHDF5PushGroup(viewer, group.c_str()) >> checkError; }
+
+void ablate::monitors::Checkpoint::PopGroup() { PetscViewerHDF5PopGroup(viewer) >> checkError; }
+
+void ablate::monitors::Checkpoint::WriteArray(const std::string& name, PetscInt blockSize, PetscInt localSize, const PetscReal* values) {
+    Vec vec;
+    VecCreateMPIWithArray(comm, blockSize, localSize, PETSC_DETERMINE, values, &vec) >> checkError;
+    PetscObjectSetName((PetscObject)vec, name.c_str()) >> checkError;
+    VecView(vec, viewer) >> checkError;
+    VecDestroy(&vec) >> checkError;
+}
+
+std::vector<PetscReal> ablate::monitors::Checkpoint::ReadArray(const std::string& name, PetscInt blockSize, PetscInt localSize) {
+    Vec vec;
+    VecCreate(comm, &vec) >> checkError;
+    VecSetBlockSize(vec, blockSize) >> checkError;
+    if (localSize != PETSC_DECIDE) {
+        VecSetSizes(vec, localSize, PETSC_DETERMINE) >> checkError;
+    }
+    PetscObjectSetName((PetscObject)vec, name.c_str()) >> checkError;
+    VecLoad(vec, viewer) >> checkError;
+
+    PetscInt size;
+    const PetscReal* array;
+    VecGetLocalSize(vec, &size) >> checkError;
+    VecGetArrayRead(vec, &array) >> checkError;
+    std::vector<PetscReal> values(array, array + size);
+    VecRestoreArrayRead(vec, &array) >> checkError;
+    VecDestroy(&vec) >> checkError;
+    return values;
+}
+
+void ablate::monitors::Checkpoint::WriteValues(const std::string& name, const std::vector<PetscReal>& values) {
+    PetscMPIInt rank;
+    MPI_Comm_rank(comm, &rank) >> checkMpiError;
+    WriteArray(name, 1, rank ? 0 : (PetscInt)values.size(), values.data());
+}
+
+std::vector<PetscReal> ablate::monitors::Checkpoint::ReadValues(const std::string& name) {
+    auto localValues = ReadArray(name, 1);
+
+    // share the values with every rank
+    PetscMPIInt size;
+    MPI_Comm_size(comm, &size) >> checkMpiError;
+    auto localSize = (PetscMPIInt)localValues.size();
+    std::vector<PetscMPIInt> sizes(size), offsets(size + 1, 0);
+    MPI_Allgather(&localSize, 1, MPI_INT, sizes.data(), 1, MPI_INT, comm) >> checkMpiError;
+    std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+    std::vector<PetscReal> values(offsets[size]);
+    MPI_Allgatherv(localValues.data(), localSize, MPIU_REAL, values.data(), sizes.data(), offsets.data(), MPIU_REAL, comm) >> checkMpiError;
+    return values;
+}
+
+const std::vector<ablate::monitors::Checkpoint::Key>& ablate::monitors::Checkpoint::GetPointKeys(DM dm, const std::vector<PetscInt>& points) {
+    PetscInt pStart, pEnd;
+    DMPlexGetChart(dm, &pStart, &pEnd) >> checkError;
+    auto& cache = pointKeys[dm];
+    if (cache.keys.empty()) {
+        cache.keys.assign(pEnd - pStart, Key{0.0, 0.0, 0.0});
+        cache.computed.assign(pEnd - pStart, false);
+    }
+
+    // only the keys that have not been computed before are computed
+    std::vector<PetscInt> newPoints;
+    for (const auto point : points) {
+        if (!cache.computed[point - pStart]) {
+            cache.computed[point - pStart] = true;
+            newPoints.push_back(point);
+        }
+    }
+    if (newPoints.empty()) {
+        return cache.keys;
+    }
+
+    PetscInt coordinateDim;
+    DMGetCoordinateDim(dm, &coordinateDim) >> checkError;
+    Vec coordinates;
+    PetscSection coordinateSection;
+    const PetscReal* coordinateArray;
+    DMGetCoordinatesLocal(dm, &coordinates) >> checkError;
+    DMGetCoordinateSection(dm, &coordinateSection) >> checkError;
+    VecGetArrayRead(coordinates, &coordinateArray) >> checkError;
+    for (const auto point : newPoints) {
+        PetscInt depth;
+        DMPlexGetPointDepth(dm, point, &depth) >> checkError;
+        PetscReal centroid[3] = {0.0, 0.0, 0.0};
+        if (depth == 0) {
+            PetscInt offset;
+            PetscSectionGetOffset(coordinateSection, point, &offset) >> checkError;
+            PetscArraycpy(centroid, coordinateArray + offset, coordinateDim) >> checkError;
+        } else {
+            PetscReal volume;
+            DMPlexComputeCellGeometryFVM(dm, point, &volume, centroid, NULL) >> checkError;
+        }
+
+        // adding zero removes negative zeros so the bits of equal keys match
+        for (PetscInt d = 0; d < 3; ++d) {
+            cache.keys[point - pStart][d] = centroid[d] + 0.0;
+        }
+    }
+    VecRestoreArrayRead(coordinates, &coordinateArray) >> checkError;
+    return cache.keys;
+}
+
+void ablate::monitors::Checkpoint::WritePointRecords(const std::string& name, DM dm, const std::vector<PetscInt>& points, const std::vector<PetscInt>& offsets, const PetscReal* values) {
+    const auto& keys = GetPointKeys(dm, points);
+    PetscInt pStart;
+    DMPlexGetChart(dm, &pStart, NULL) >> checkError;
+
+    const auto numberRecords = (PetscInt)points.size();
+    std::vector<PetscReal> recordKeys(3 * numberRecords);
+    std::vector<PetscReal> recordSizes(numberRecords);
+    for (PetscInt r = 0; r < numberRecords; ++r) {
+        std::copy(keys[points[r] - pStart].begin(), keys[points[r] - pStart].end(), recordKeys.begin() + 3 * r);
+        recordSizes[r] = (PetscReal)(offsets[r + 1] - offsets[r]);
+    }
+
+    // the number of records is stored so that empty datasets are never written
+    PetscInt totalRecords;
+    MPIU_Allreduce(&numberRecords, &totalRecords, 1, MPIU_INT, MPI_SUM, comm) >> checkMpiError;
+    WriteValues(name + "_records", {(PetscReal)totalRecords});
+    if (totalRecords == 0) {
+        return;
+    }
+    WriteArray(name + "_keys", 3, 3 * numberRecords, recordKeys.data());
+    WriteArray(name + "_sizes", 1, numberRecords, recordSizes.data());
+    WriteArray(name, 1, offsets[numberRecords], values);
+}
+
+void ablate::monitors::Checkpoint::ReadPointRecords(const std::string& name, DM dm, const std::vector<PetscInt>& ownedPoints, std::vector<PetscInt>& points,
+                                                    std::vector<PetscInt>& offsets, std::vector<PetscReal>& values) {
+    points.clear();
+    offsets.assign(1, 0);
+    values.clear();
+    const auto totalRecords = (PetscInt)ReadValues(name + "_records").front();
+    if (totalRecords == 0) {
+        return;
+    }
+
+    // read a contiguous block of the records
+    auto recordSizes = ReadArray(name + "_sizes", 1);
+    const auto numberRecords = (PetscInt)recordSizes.size();
+    auto recordKeys = ReadArray(name + "_keys", 3, 3 * numberRecords);
+    const auto numberValues = (PetscInt)std::accumulate(recordSizes.begin(), recordSizes.end(), 0.0);
+    auto recordValues = ReadArray(name, 1, numberValues);
+
+    PetscMPIInt size;
+    MPI_Comm_size(comm, &size) >> checkMpiError;
+    KeyHash hash;
+
+    // register each owned point (key, local index) with the rendezvous rank for its key
+    const auto& keys = GetPointKeys(dm, ownedPoints);
+    PetscInt pStart;
+    DMPlexGetChart(dm, &pStart, NULL) >> checkError;
+    std::vector<std::vector<PetscReal>> messages(size);
+    for (std::size_t i = 0; i < ownedPoints.size(); ++i) {
+        const auto& key = keys[ownedPoints[i] - pStart];
+        auto& message = messages[hash(key) % size];
+        message.insert(message.end(), key.begin(), key.end());
+        message.push_back((PetscReal)i);
+    }
+    std::vector<PetscMPIInt> registrationOffsets, receiveOffsets;
+    auto registrations = ExchangeMessages(comm, messages, registrationOffsets);
+
+    // send each record (key, size, values...) to the rendezvous rank for its key
+    PetscInt valueOffset = 0;
+    for (PetscInt r = 0; r < numberRecords; ++r) {
+        const Key key{recordKeys[3 * r], recordKeys[3 * r + 1], recordKeys[3 * r + 2]};
+        const auto recordSize = (PetscInt)recordSizes[r];
+        auto& message = messages[hash(key) % size];
+        message.insert(message.end(), key.begin(), key.end());
+        message.push_back(recordSizes[r]);
+        message.insert(message.end(), recordValues.begin() + valueOffset, recordValues.begin() + valueOffset + recordSize);
+        valueOffset += recordSize;
+    }
+    auto records = ExchangeMessages(comm, messages, receiveOffsets);
+
+    // match the records to the owning rank and local index, a key registered twice is an error
+    std::unordered_map<Key, std::pair<PetscMPIInt, PetscReal>, KeyHash> owners;
+    PetscInt errors = 0;
+    std::size_t position;
+    for (PetscMPIInt r = 0; r < size; ++r) {
+        for (position = registrationOffsets[r]; position < (std::size_t)registrationOffsets[r + 1]; position += 4) {
+            const Key key{registrations[position], registrations[position + 1], registrations[position + 2]};
+            if (!owners.emplace(key, std::make_pair(r, registrations[position + 3])).second) {
+                errors++;
+            }
+        }
+    }
+    for (position = 0; position < records.size();) {
+        const Key key{records[position], records[position + 1], records[position + 2]};
+        const auto recordSize = (std::size_t)records[position + 3];
+        auto owner = owners.find(key);
+        if (owner == owners.end()) {
+            errors++;
+        } else {
+            auto& message = messages[owner->second.first];
+            message.push_back(owner->second.second);
+            message.push_back(records[position + 3]);
+            message.insert(message.end(), records.begin() + position + 4, records.begin() + position + 4 + recordSize);
+        }
+        position += 4 + recordSize;
+    }
+    auto matched = ExchangeMessages(comm, messages, receiveOffsets);
+
+    PetscInt globalErrors;
+    MPIU_Allreduce(&errors, &globalErrors, 1, MPIU_INT, MPI_SUM, comm) >> checkMpiError;
+    if (globalErrors) {
+        throw std::runtime_error("Unable to match " + std::to_string(globalErrors) + " records of " + name + " in the checkpoint to the mesh. The restart mesh must match the checkpoint mesh.");
+    }
+
+    // unpack the records for the owned points (local index, size, values...)
+    for (position = 0; position < matched.size();) {
+        const auto recordSize = (std::size_t)matched[position + 1];
+        points.push_back(ownedPoints[(std::size_t)matched[position]]);
+        values.insert(values.end(), matched.begin() + position + 2, matched.begin() + position + 2 + recordSize);
+        offsets.push_back((PetscInt)values.size());
+        position += 2 + recordSize;
+    }
+}
+
+std::vector<PetscInt> ablate::monitors::Checkpoint::GetOwnedPoints(DM dm) {
+    PetscSection globalSection;
+    DMGetGlobalSection(dm, &globalSection) >> checkError;
+    PetscInt pStart, pEnd;
+    PetscSectionGetChart(globalSection, &pStart, &pEnd) >> checkError;
+    DMLabel ghostLabel;
+    DMGetLabel(dm, "ghost", &ghostLabel) >> checkError;
+
+    std::vector<PetscInt> points;
+    for (PetscInt p = pStart; p < pEnd; ++p) {
+        PetscInt dof, constrainedDof, offset;
+        PetscSectionGetDof(globalSection, p, &dof) >> checkError;
+        PetscSectionGetConstraintDof(globalSection, p, &constrainedDof) >> checkError;
+        PetscSectionGetOffset(globalSection, p, &offset) >> checkError;
+        if (offset < 0 || dof - constrainedDof <= 0) {
+            continue;
+        }
+        PetscInt ghost = -1;
+        if (ghostLabel) {
+            DMLabelGetValue(ghostLabel, p, &ghost) >> checkError;
+        }
+        if (ghost < 0) {
+            points.push_back(p);
+        }
+    }
+    return points;
+}
+
+void ablate::monitors::Checkpoint::WriteVector(const std::string& name, Vec vec) {
+    DM dm;
+    VecGetDM(vec, &dm) >> checkError;
+    PetscSection globalSection;
+    DMGetGlobalSection(dm, &globalSection) >> checkError;
+    PetscInt rStart;
+    VecGetOwnershipRange(vec, &rStart, NULL) >> checkError;
+
+    auto points = GetOwnedPoints(dm);
+    std::vector<PetscInt> offsets(1, 0);
+    std::vector<PetscReal> values;
+    const PetscScalar* array;
+    VecGetArrayRead(vec, &array) >> checkError;
+    for (const auto point : points) {
+        PetscInt dof, constrainedDof, offset;
+        PetscSectionGetDof(globalSection, point, &dof) >> checkError;
+        PetscSectionGetConstraintDof(globalSection, point, &constrainedDof) >> checkError;
+        PetscSectionGetOffset(globalSection, point, &offset) >> checkError;
+        values.insert(values.end(), array + offset - rStart, array + offset - rStart + dof - constrainedDof);
+        offsets.push_back((PetscInt)values.size());
+    }
+    VecRestoreArrayRead(vec, &array) >> checkError;
+
+    WritePointRecords(name, dm, points, offsets, values.data());
+}
+
+void ablate::monitors::Checkpoint::ReadVector(const std::string& name, Vec vec) {
+    DM dm;
+    VecGetDM(vec, &dm) >> checkError;
+    PetscSection globalSection;
+    DMGetGlobalSection(dm, &globalSection) >> checkError;
+    PetscInt rStart, pStart, pEnd;
+    VecGetOwnershipRange(vec, &rStart, NULL) >> checkError;
+    PetscSectionGetChart(globalSection, &pStart, &pEnd) >> checkError;
+
+    auto ownedPoints = GetOwnedPoints(dm);
+    std::vector<PetscInt> points, offsets;
+    std::vector<PetscReal> values;
+    ReadPointRecords(name, dm, ownedPoints, points, offsets, values);
+
+    // every owned point must receive exactly one record with its number of values
+    PetscInt errors = (PetscInt)ownedPoints.size() - (PetscInt)points.size();
+    std::vector<bool> received(pEnd - pStart, false);
+    PetscScalar* array;
+    VecGetArray(vec, &array) >> checkError;
+    for (std::size_t r = 0; r < points.size(); ++r) {
+        PetscInt dof, constrainedDof, offset;
+        PetscSectionGetDof(globalSection, points[r], &dof) >> checkError;
+        PetscSectionGetConstraintDof(globalSection, points[r], &constrainedDof) >> checkError;
+        PetscSectionGetOffset(globalSection, points[r], &offset) >> checkError;
+        if (received[points[r] - pStart] || offsets[r + 1] - offsets[r] != dof - constrainedDof) {
+            errors++;
+            continue;
+        }
+        received[points[r] - pStart] = true;
+        std::copy(values.begin() + offsets[r], values.begin() + offsets[r + 1], array + offset - rStart);
+    }
+    VecRestoreArray(vec, &array) >> checkError;
+
+    PetscInt globalErrors;
+    MPIU_Allreduce(&errors, &globalErrors, 1, MPIU_INT, MPI_SUM, comm) >> checkMpiError;
+    if (globalErrors) {
+        throw std::runtime_error("The " + name + " in the checkpoint does not match the layout of the vector");
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef ABLATELIBRARY_CHECKPOINT_HPP
+#define ABLATELIBRARY_CHECKPOINT_HPP
+#include <petsc.h>
+#include <array>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ablate::monitors {
+
+/**
+ * Reads and writes the restart state in an hdf5 file with collective io.  Values that belong to a mesh point (cell, face, or vertex) are stored as records keyed
+ * by the point's centroid instead of its number, so they can be reloaded with the same mesh at a different rank count (or partition).  On read, each rank reads a
+ * contiguous block of the records and the records are sent through a rendezvous rank (chosen by a hash of the key) to the rank owning the point.
+ */
+class Checkpoint {
+   public:
+    // the centroid of a point, padded with zeros to three dimensions
+    using Key = std::array<PetscReal, 3>;
+
+   private:
+    PetscViewer viewer = nullptr;
+    MPI_Comm comm;
+
+    // the key of each point in the chart of each dm, computed the first time the point is used
+    struct PointKeys {
+        std::vector<Key> keys;
+        std::vector<bool> computed;
+    };
+    std::map<DM, PointKeys> pointKeys;
+
+    /**
+     * Computes the keys of the points (if needed) and returns the keys for the chart of the dm
+     */
+    const std::vector<Key>& GetPointKeys(DM dm, const std::vector<PetscInt>& points);
+
+    /**
+     * Writes the local values as a contiguous block of the named dataset
+     */
+    void WriteArray(const std::string& name, PetscInt blockSize, PetscInt localSize, const PetscReal* values);
+
+    /**
+     * Reads a contiguous block of the named dataset.  When the local size is PETSC_DECIDE the dataset is split evenly between the ranks.
+     */
+    std::vector<PetscReal> ReadArray(const std::string& name, PetscInt blockSize, PetscInt localSize = PETSC_DECIDE);
+
+   public:
+    /**
+     * Opens the checkpoint file (collective)
+     * @param path
+     * @param mode FILE_MODE_WRITE or FILE_MODE_READ
+     */
+    Checkpoint(MPI_Comm comm, const std::filesystem::path& path, PetscFileMode mode);
+    ~Checkpoint();
+
+    Checkpoint(const Checkpoint&) = delete;
+    Checkpoint& operator=(const Checkpoint&) = delete;
+
+    /**
+     * Opens a new file, the point keys computed for the last file are reused
+     * @param path
+     * @param mode
+     */
+    void Open(const std::filesystem::path& path, PetscFileMode mode);
+
+    /**
+     * Closes the file (collective)
+     */
+    void Close();
+
+    /**
+     * The datasets are read and written relative to the current group
+     */
+    void PushGroup(const std::string& group);
+    void PopGroup();
+
+    /**
+     * Writes a small set of values that are the same on every rank (only the root rank's values are written)
+     * @param name
+     * @param values
+     */
+    void WriteValues(const std::string& name, const std::vector<PetscReal>& values);
+
+    /**
+     * Reads a set of values written with WriteValues onto every rank
+     * @param name
+     * @return
+     */
+    std::vector<PetscReal> ReadValues(const std::string& name);
+
+    /**
+     * Writes records that each belong to a local point in the dm.  More than one record may belong to the same point.
+     * @param name
+     * @param dm the dm holding the points
+     * @param points the point of each record
+     * @param offsets the values of record r are values[offsets[r], offsets[r+1])
+     * @param values
+     */
+    void WritePointRecords(const std::string& name, DM dm, const std::vector<PetscInt>& points, const std::vector<PetscInt>& offsets, const PetscReal* values);
+
+    /**
+     * Reads the records written with WritePointRecords and returns them on the rank that owns each point
+     * @param name
+     * @param dm the dm holding the points
+     * @param ownedPoints the points owned by this rank, every record must belong to exactly one owned point on one rank
+     * @param points the local point of each record returned on this rank
+     * @param offsets the values of record r are values[offsets[r], offsets[r+1])
+     * @param values
+     */
+    void ReadPointRecords(const std::string& name, DM dm, const std::vector<PetscInt>& ownedPoints, std::vector<PetscInt>& points, std::vector<PetscInt>& offsets,
+                          std::vector<PetscReal>& values);
+
+    /**
+     * Writes the values of each point owned in the global vector.  The vector must have a dm.
+     * @param name
+     * @param vec
+     */
+    void WriteVector(const std::string& name, Vec vec);
+
+    /**
+     * Reads the values of each point owned in the global vector.  Points without a global dof (e.g. boundary ghost cells) are not changed.
+     * @param name
+     * @param vec
+     */
+    void ReadVector(const std::string& name, Vec vec);
+
+    /**
+     * Returns the local points that own values in the global section of the dm (excluding finite volume ghost cells)
+     * @param dm
+     * @return
+     */
+    static std::vector<PetscInt> GetOwnedPoints(DM dm);
+};
+
+}  // namespace ablate::monitors
+#endif  // ABLATELIBRARY_CHECKPOINT_HPP
@@ -0,0 +1,119 @@
+#include "checkpointMonitor.hpp"
+#include <environment/runEnvironment.hpp>
+#include "hdf5Monitor.hpp"
+#include "utilities/logEvents.hpp"
+#include "utilities/mpiError.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::monitors::CheckpointMonitor::CheckpointMonitor(int interval, double wallTimeInterval) : interval(interval), wallTimeInterval(wallTimeInterval) {
+    if (interval <= 0 && wallTimeInterval <= 0) {
+        throw std::invalid_argument("The CheckpointMonitor requires a step interval and/or a wallTimeInterval");
+    }
+    saveLogEvent = utilities::LogEvents::Register("CheckpointSave");
+}
+
+void ablate::monitors::CheckpointMonitor::Register(std::shared_ptr<Monitorable> object) {
+    if (!std::dynamic_pointer_cast<Checkpointable>(object)) {
+        throw std::invalid_argument("The object " + object->GetName() + " cannot be written to a checkpoint");
+    }
+    objects.push_back(object);
+}
+
+PetscErrorCode ablate::monitors::CheckpointMonitor::CheckpointState(TS ts, PetscInt steps, PetscReal time, Vec u, void* mctx) {
+    PetscFunctionBeginUser;
+    auto monitor = (ablate::monitors::CheckpointMonitor*)mctx;
+
+    try {
+        if (!monitor->started) {
+            monitor->started = true;
+            monitor->lastCheckpointWallTime = MPI_Wtime();
+            PetscFunctionReturn(0);
+        }
+
+        PetscInt writeCheckpoint = monitor->interval > 0 && steps % monitor->interval == 0;
+
+        // the root rank's clock decides so that every rank writes the same checkpoints
+        if (monitor->wallTimeInterval > 0) {
+            PetscInt wallTimeElapsed = (MPI_Wtime() - monitor->lastCheckpointWallTime) >= monitor->wallTimeInterval;
+            MPI_Bcast(&wallTimeElapsed, 1, MPIU_INT, 0, PETSC_COMM_WORLD) >> checkMpiError;
+            writeCheckpoint = writeCheckpoint || wallTimeElapsed;
+        }
+
+        if (writeCheckpoint) {
+            monitor->Save(ts, steps, time);
+            monitor->lastCheckpointWallTime = MPI_Wtime();
+        }
+    } catch (std::exception& e) {
+        SETERRQ(PETSC_COMM_SELF, PETSC_ERR_LIB, e.what());
+    }
+    PetscFunctionReturn(0);
+}
+
+void ablate::monitors::CheckpointMonitor::Save(TS ts, PetscInt steps, PetscReal time) {
+    const auto outputDirectory = environment::RunEnvironment::Get().GetOutputDirectory();
+    const auto checkpointPath = outputDirectory / fileName;
+    auto temporaryPath = checkpointPath;
+    temporaryPath += ".tmp";
+    utilities::LogEvents::Scope saveScope(saveLogEvent);
+
+    // the checkpoint is not written while an asynchronous hdf5 monitor is writing
+    Hdf5Monitor::FlushAsynchronousMonitors();
+    if (checkpoint) {
+        checkpoint->Open(temporaryPath, FILE_MODE_WRITE);
+    } else {
+        checkpoint = std::make_unique<Checkpoint>(PETSC_COMM_WORLD, temporaryPath, FILE_MODE_WRITE);
+    }
+
+    // the dt is the next step proposed by the adaptor
+    PetscReal dt;
+    TSGetTimeStep(ts, &dt) >> checkError;
+    checkpoint->PushGroup(timeStepperGroup);
+    checkpoint->WriteValues("state", {time, (PetscReal)steps, dt});
+    checkpoint->PopGroup();
+
+    for (auto& object : objects) {
+        checkpoint->PushGroup("/" + object->GetName());
+        std::dynamic_pointer_cast<Checkpointable>(object)->Save(*checkpoint);
+        checkpoint->PopGroup();
+    }
+    checkpoint->Close();
+
+    // replace the last checkpoint once every rank has closed the file
+    MPI_Barrier(PETSC_COMM_WORLD) >> checkMpiError;
+    int rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD, &rank) >> checkMpiError;
+    if (rank == 0) {
+        std::filesystem::rename(temporaryPath, checkpointPath);
+    }
+    PetscPrintf(PETSC_COMM_WORLD, "Checkpoint: %04d time = %-8.4g written to %s\n", (int)steps, (double)time, checkpointPath.string().c_str()) >> checkError;
+}
+
+ablate::monitors::CheckpointMonitor::TimeStepperState ablate::monitors::CheckpointMonitor::Restore(const std::filesystem::path& path,
+                                                                                                   const std::vector<std::shared_ptr<Monitorable>>& objects) {
+    Hdf5Monitor::FlushAsynchronousMonitors();
+    Checkpoint checkpoint(PETSC_COMM_WORLD, path, FILE_MODE_READ);
+
+    checkpoint.PushGroup(timeStepperGroup);
+    auto values = checkpoint.ReadValues("state");
+    checkpoint.PopGroup();
+    if (values.size() != 3) {
+        throw std::runtime_error("The time stepper state in the checkpoint " + path.string() + " is not valid");
+    }
+    TimeStepperState state{.time = values[0], .steps = (PetscInt)values[1], .dt = values[2]};
+
+    for (auto& object : objects) {
+        auto checkpointable = std::dynamic_pointer_cast<Checkpointable>(object);
+        if (!checkpointable) {
+            throw std::invalid_argument("The object " + object->GetName() + " cannot be restored from a checkpoint");
+        }
+        checkpoint.PushGroup("/" + object->GetName());
+        checkpointable->Restore(checkpoint, state.time);
+        checkpoint.PopGroup();
+    }
+    return state;
+}
+
+#include "parser/registrar.hpp"
+REGISTERDEFAULT(ablate::monitors::CheckpointMonitor, ablate::monitors::CheckpointMonitor, "periodically writes the flow, particle, and time stepper state to checkpoint.hdf5 for a restart",
+                OPT(int, "interval", "write a checkpoint every interval steps"),
+                OPT(double, "wallTimeInterval", "write a checkpoint when this many seconds (wall clock) have passed since the last checkpoint"));
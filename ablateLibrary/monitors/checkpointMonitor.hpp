@@ -0,0 +1,76 @@
+#ifndef ABLATELIBRARY_CHECKPOINTMONITOR_HPP
+#define ABLATELIBRARY_CHECKPOINTMONITOR_HPP
+#include <petsc.h>
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include "checkpoint.hpp"
+#include "checkpointable.hpp"
+#include "monitor.hpp"
+
+namespace ablate::monitors {
+/**
+ * Periodically writes the state of every registered object and the time stepper to a single checkpoint file (checkpoint.hdf5 in the output directory).  Each
+ * checkpoint is written to a temporary file that replaces the previous checkpoint once complete, so an interrupted write never corrupts the last checkpoint.
+ */
+class CheckpointMonitor : public Monitor {
+   public:
+    /**
+     * The time stepper state stored with each checkpoint
+     */
+    struct TimeStepperState {
+        PetscReal time;
+        PetscInt steps;
+        PetscReal dt;
+    };
+
+   private:
+    // write a checkpoint every interval steps (0 disables)
+    const int interval;
+
+    // write a checkpoint when this many seconds have passed since the last checkpoint (0 disables)
+    const double wallTimeInterval;
+
+    // the objects in the checkpoint
+    std::vector<std::shared_ptr<Monitorable>> objects;
+
+    // the checkpoint is reused between writes so the point keys are only computed once
+    std::unique_ptr<Checkpoint> checkpoint;
+
+    // the first call is the initial (or restarted) state and is not written
+    bool started = false;
+    double lastCheckpointWallTime = 0.0;
+
+    // profiles each checkpoint write
+    PetscLogEvent saveLogEvent;
+
+    inline static const char fileName[] = "checkpoint.hdf5";
+    inline static const char timeStepperGroup[] = "/timeStepper";
+
+    static PetscErrorCode CheckpointState(TS ts, PetscInt steps, PetscReal time, Vec u, void* mctx);
+
+    /**
+     * Writes the time stepper state and every object to the checkpoint
+     */
+    void Save(TS ts, PetscInt steps, PetscReal time);
+
+   public:
+    explicit CheckpointMonitor(int interval = {}, double wallTimeInterval = {});
+
+    /**
+     * Adds a checkpointable object to the checkpoint.  This may be called for more than one object.
+     */
+    void Register(std::shared_ptr<Monitorable>) override;
+    PetscMonitorFunction GetPetscFunction() override { return CheckpointState; }
+
+    /**
+     * Restores each object from the checkpoint file.  Each object must be setup before the restore.
+     * @param path the checkpoint file
+     * @param objects the objects to restore, each must have been in the checkpoint
+     * @return the time stepper state in the checkpoint
+     */
+    static TimeStepperState Restore(const std::filesystem::path& path, const std::vector<std::shared_ptr<Monitorable>>& objects);
+};
+}  // namespace ablate::monitors
+
+#endif  // ABLATELIBRARY_CHECKPOINTMONITOR_HPP
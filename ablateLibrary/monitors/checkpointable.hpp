@@ -0,0 +1,28 @@
+#ifndef ABLATELIBRARY_CHECKPOINTABLE_HPP
+#define ABLATELIBRARY_CHECKPOINTABLE_HPP
+#include "checkpoint.hpp"
+
+namespace ablate::monitors {
+/**
+ * Objects that can save their state to a checkpoint and restart from it.  The object's datasets are read and written in a group with the object's name.
+ */
+class Checkpointable {
+   public:
+    virtual ~Checkpointable() = default;
+
+    /**
+     * Writes the state needed to restart (collective)
+     * @param checkpoint
+     */
+    virtual void Save(Checkpoint& checkpoint) = 0;
+
+    /**
+     * Replaces the current state with the state in the checkpoint (collective).  This is called after the object is setup and before the solve.
+     * @param checkpoint
+     * @param time the time of the checkpoint
+     */
+    virtual void Restore(Checkpoint& checkpoint, PetscReal time) = 0;
+};
+}  // namespace ablate::monitors
+
+#endif  // ABLATELIBRARY_CHECKPOINTABLE_HPP
@@ -0,0 +1,171 @@
+#include "convergenceMonitor.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::monitors::ConvergenceMonitor::ConvergenceMonitor(double tolerance, NormType normType, std::vector<std::string> fields, double smoothing, int interval)
+    : tolerance(tolerance), normType(normType), fieldNames(fields), smoothing(smoothing), interval(interval) {
+    if (tolerance <= 0) {
+        throw std::invalid_argument("The ConvergenceMonitor requires a positive tolerance");
+    }
+    if (smoothing < 0 || smoothing >= 1) {
+        throw std::invalid_argument("The ConvergenceMonitor smoothing must be in [0, 1)");
+    }
+}
+
+ablate::monitors::ConvergenceMonitor::~ConvergenceMonitor() {
+    for (auto& is : fieldIndices) {
+        ISDestroy(&is) >> checkError;
+    }
+    if (work) {
+        VecDestroy(&work) >> checkError;
+    }
+}
+
+void ablate::monitors::ConvergenceMonitor::Register(std::shared_ptr<Monitorable> object) {
+    auto flowObject = std::dynamic_pointer_cast<flow::Flow>(object);
+    if (!flowObject) {
+        throw std::invalid_argument("The ConvergenceMonitor can only check a flow");
+    }
+    if (flow) {
+        throw std::invalid_argument("The ConvergenceMonitor is already registered with the flow " + flow->GetName());
+    }
+    flow = flowObject;
+
+    // store the global indices of each field (all solution fields by default)
+    checkedFieldNames = fieldNames;
+    if (checkedFieldNames.empty()) {
+        for (const auto& descriptor : flow->GetFieldDescriptors()) {
+            checkedFieldNames.push_back(descriptor.fieldName);
+        }
+    }
+    for (const auto& name : checkedFieldNames) {
+        auto fieldId = flow->GetFieldId(name);
+        if (!fieldId) {
+            throw std::invalid_argument("Cannot locate field " + name + " in flow " + flow->GetName() + " for the ConvergenceMonitor");
+        }
+        PetscInt field = fieldId.value();
+        IS is;
+        DM subDm;
+        DMCreateSubDM(flow->GetDM(), 1, &field, &is, &subDm) >> checkError;
+        DMDestroy(&subDm) >> checkError;
+        fieldIndices.push_back(is);
+    }
+    smoothedNorms.resize(fieldIndices.size(), 0.0);
+    referenceNorms.resize(fieldIndices.size(), 0.0);
+    VecDuplicate(flow->GetSolutionVector(), &work) >> checkError;
+
+    flow->RegisterPostStep([this](TS ts, flow::Flow&) { CheckConvergence(ts); });
+}
+
+void ablate::monitors::ConvergenceMonitor::CheckConvergence(TS ts) {
+    Vec u;
+    PetscReal time;
+    TSGetSolution(ts, &u) >> checkError;
+    TSGetTime(ts, &time) >> checkError;
+
+    // the change is computed from the solution after the last step, so the first step only stores the solution
+    std::vector<PetscReal> norms(fieldIndices.size());
+    switch (normType) {
+        case NormType::CHANGE: {
+            if (first) {
+                VecCopy(u, work) >> checkError;
+                first = false;
+                return;
+            }
+            // work = u_n - u_n-1 until the norms are computed, then u_n
+            VecAYPX(work, -1.0, u) >> checkError;
+            for (std::size_t f = 0; f < fieldIndices.size(); ++f) {
+                Vec change, solution;
+                PetscReal changeNorm, solutionNorm;
+                VecGetSubVector(work, fieldIndices[f], &change) >> checkError;
+                VecGetSubVector(u, fieldIndices[f], &solution) >> checkError;
+                VecNorm(change, NORM_2, &changeNorm) >> checkError;
+                VecNorm(solution, NORM_2, &solutionNorm) >> checkError;
+                VecRestoreSubVector(u, fieldIndices[f], &solution) >> checkError;
+                VecRestoreSubVector(work, fieldIndices[f], &change) >> checkError;
+                norms[f] = solutionNorm > 0 ? changeNorm / solutionNorm : changeNorm;
+            }
+            VecCopy(u, work) >> checkError;
+        } break;
+        case NormType::RHS: {
+            TSComputeRHSFunction(ts, time, u, work) >> checkError;
+            for (std::size_t f = 0; f < fieldIndices.size(); ++f) {
+                Vec rhs;
+                PetscReal rhsNorm;
+                VecGetSubVector(work, fieldIndices[f], &rhs) >> checkError;
+                VecNorm(rhs, NORM_2, &rhsNorm) >> checkError;
+                VecRestoreSubVector(work, fieldIndices[f], &rhs) >> checkError;
+                if (first) {
+                    referenceNorms[f] = rhsNorm;
+                }
+                norms[f] = referenceNorms[f] > 0 ? rhsNorm / referenceNorms[f] : rhsNorm;
+            }
+        } break;
+    }
+
+    // the first norms start the exponential smoothing
+    bool converged = true;
+    for (std::size_t f = 0; f < fieldIndices.size(); ++f) {
+        smoothedNorms[f] = smoothed ? smoothing * smoothedNorms[f] + (1.0 - smoothing) * norms[f] : norms[f];
+        converged = converged && smoothedNorms[f] < tolerance;
+    }
+    first = false;
+    smoothed = true;
+
+    if (converged) {
+        PetscInt steps;
+        TSGetStepNumber(ts, &steps) >> checkError;
+        PetscPrintf(PETSC_COMM_WORLD, "Converged: %04d time = %-8.4g all field norms are below %g\n", (int)steps, (double)time, tolerance) >> checkError;
+        TSSetConvergedReason(ts, TS_CONVERGED_USER) >> checkError;
+    }
+}
+
+PetscErrorCode ablate::monitors::ConvergenceMonitor::ReportConvergence(TS ts, PetscInt steps, PetscReal time, Vec u, void* mctx) {
+    PetscFunctionBeginUser;
+    auto monitor = (ablate::monitors::ConvergenceMonitor*)mctx;
+    PetscErrorCode ierr;
+
+    if (monitor->interval > 0 && steps % monitor->interval == 0 && monitor->smoothed) {
+        ierr = PetscPrintf(PETSC_COMM_WORLD, "Convergence: %04d", (int)steps);
+        CHKERRQ(ierr);
+        for (std::size_t f = 0; f < monitor->smoothedNorms.size(); ++f) {
+            ierr = PetscPrintf(PETSC_COMM_WORLD, " %s = %g", monitor->checkedFieldNames[f].c_str(), (double)monitor->smoothedNorms[f]);
+            CHKERRQ(ierr);
+        }
+        ierr = PetscPrintf(PETSC_COMM_WORLD, "\n");
+        CHKERRQ(ierr);
+    }
+    PetscFunctionReturn(0);
+}
+
+std::ostream& ablate::monitors::operator<<(std::ostream& os, const ablate::monitors::ConvergenceMonitor::NormType& v) {
+    switch (v) {
+        case ConvergenceMonitor::NormType::CHANGE:
+            return os << "change";
+        case ConvergenceMonitor::NormType::RHS:
+            return os << "rhs";
+        default:
+            return os;
+    }
+}
+
+std::istream& ablate::monitors::operator>>(std::istream& is, ablate::monitors::ConvergenceMonitor::NormType& v) {
+    std::string enumString;
+    is >> enumString;
+
+    if (enumString == "change") {
+        v = ConvergenceMonitor::NormType::CHANGE;
+    } else if (enumString == "rhs") {
+        v = ConvergenceMonitor::NormType::RHS;
+    } else {
+        throw std::invalid_argument("Unknown norm type " + enumString);
+    }
+    return is;
+}
+
+#include "parser/registrar.hpp"
+REGISTER(ablate::monitors::Monitor, ablate::monitors::ConvergenceMonitor, "stops the solve when the flow is steady",
+         ARG(double, "tolerance", "stop when the smoothed norm of every field is below the tolerance"),
+         ENUM(ablate::monitors::ConvergenceMonitor::NormType, "norm", "the relative solution change over each step ('change') or the rhs norm relative to the first step ('rhs')"),
+         OPT(std::vector<std::string>, "fields", "the solution fields to check (defaults to all)"),
+         OPT(double, "smoothing", "the exponential smoothing factor in [0, 1) applied to the norms, larger values smooth more (default 0)"),
+         OPT(int, "interval", "print the smoothed norms every interval steps (default never)"));
@@ -0,0 +1,81 @@
+#ifndef ABLATELIBRARY_CONVERGENCEMONITOR_HPP
+#define ABLATELIBRARY_CONVERGENCEMONITOR_HPP
+#include <petsc.h>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "flow/flow.hpp"
+#include "monitor.hpp"
+
+namespace ablate::monitors {
+/**
+ * Stops the solve once the flow is steady.  After each step the norm of each field is computed and smoothed, and the solve is stopped (TS_CONVERGED_USER) when
+ * every smoothed norm is below the tolerance.  The norm is either the relative solution change over the step, |u_n - u_n-1| / |u_n|, or the rhs norm relative to
+ * the rhs norm after the first step (only for flows with an explicit rhs, e.g. the finite volume flows).  The monitors are called for the final step as usual and
+ * the hdf5 monitors write the final state even when it is not on their interval.
+ */
+class ConvergenceMonitor : public Monitor {
+   public:
+    enum class NormType { CHANGE, RHS };
+
+   private:
+    const double tolerance;
+    const NormType normType;
+    const std::vector<std::string> fieldNames;
+    const double smoothing;
+    const int interval;
+
+    std::shared_ptr<flow::Flow> flow;
+
+    // the name and global indices of each checked field
+    std::vector<std::string> checkedFieldNames;
+    std::vector<IS> fieldIndices;
+
+    // the solution after the last step (change) or the rhs work vector (rhs)
+    Vec work = nullptr;
+    bool first = true;
+
+    // the rhs norm of each field after the first step
+    std::vector<PetscReal> referenceNorms;
+
+    // the smoothed norm of each field
+    std::vector<PetscReal> smoothedNorms;
+    bool smoothed = false;
+
+    /**
+     * Updates the norms and stops the ts if converged, called after each flow step
+     */
+    void CheckConvergence(TS ts);
+
+    static PetscErrorCode ReportConvergence(TS ts, PetscInt steps, PetscReal time, Vec u, void* mctx);
+
+   public:
+    ConvergenceMonitor(double tolerance, NormType normType, std::vector<std::string> fields = {}, double smoothing = {}, int interval = {});
+    ~ConvergenceMonitor() override;
+
+    /**
+     * Checks the convergence of the flow after each step.  Only one flow can be registered.
+     */
+    void Register(std::shared_ptr<Monitorable>) override;
+    PetscMonitorFunction GetPetscFunction() override { return ReportConvergence; }
+};
+
+/**
+ * Support function for the NormType Enum
+ * @param os
+ * @param v
+ * @return
+ */
+std::ostream& operator<<(std::ostream& os, const ConvergenceMonitor::NormType& v);
+/**
+ * Support function for the NormType Enum
+ * @param is
+ * @param v
+ * @return
+ */
+std::istream& operator>>(std::istream& is, ConvergenceMonitor::NormType& v);
+
+}  // namespace ablate::monitors
+
+#endif  // ABLATELIBRARY_CONVERGENCEMONITOR_HPP
@@ -1,5 +1,16 @@
 #include "fieldErrorMonitor.hpp"
 #include "mathFunctions/mathFunction.hpp"
+#include "utilities/mpiError.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::monitors::FieldErrorMonitor::FieldErrorMonitor(int interval, bool cellCenters) : interval(interval), cellCenters(cellCenters) {}
+
+void ablate::monitors::FieldErrorMonitor::Register(std::shared_ptr<Monitorable> monitorable) {
+    flow = std::dynamic_pointer_cast<ablate::flow::Flow>(monitorable);
+    if (cellCenters && !flow) {
+        throw std::invalid_argument("The cell center errors require the FieldErrorMonitor to be registered with a flow");
+    }
+}
 
 PetscErrorCode ablate::monitors::FieldErrorMonitor::MonitorError(TS ts, PetscInt step, PetscReal crtime, Vec u, void *ctx) {
     DM dm;
@@ -7,6 +18,16 @@ PetscErrorCode ablate::monitors::FieldErrorMonitor::MonitorError(TS ts, PetscInt
 
     PetscFunctionBeginUser;
     PetscErrorCode ierr;
+    auto errorMonitor = (FieldErrorMonitor *)ctx;
+
+    // only compute the error every interval steps and at the end of the solve (however it ended)
+    TSConvergedReason reason;
+    ierr = TSGetConvergedReason(ts, &reason);
+    CHKERRQ(ierr);
+    if (step != 0 && errorMonitor->interval != 0 && (step % errorMonitor->interval != 0) && reason == TS_CONVERGED_ITERATING) {
+        PetscFunctionReturn(0);
+    }
+
     ierr = TSGetDM(ts, &dm);
     CHKERRQ(ierr);
     ierr = DMGetDS(dm, &ds);
@@ -28,10 +49,29 @@ PetscErrorCode ablate::monitors::FieldErrorMonitor::MonitorError(TS ts, PetscInt
         }
     }
 
-    // Store the errors
+    // Store the errors, the quadrature is only needed for the non finite volume fields when using the cell centers
     std::vector<PetscReal> ferrors(numberOfFields);
-    ierr = DMComputeL2FieldDiff(dm, crtime, &exactFuncs[0], &ctxs[0], u, &ferrors[0]);
-    CHKERRQ(ierr);
+    PetscBool allFiniteVolume = PETSC_TRUE;
+    for (auto f = 0; f < numberOfFields; ++f) {
+        PetscObject field;
+        PetscClassId id;
+        ierr = DMGetField(dm, f, NULL, &field);
+        CHKERRQ(ierr);
+        ierr = PetscObjectGetClassId(field, &id);
+        CHKERRQ(ierr);
+        allFiniteVolume = id == PETSCFV_CLASSID ? allFiniteVolume : PETSC_FALSE;
+    }
+    if (!errorMonitor->cellCenters || !allFiniteVolume) {
+        ierr = DMComputeL2FieldDiff(dm, crtime, &exactFuncs[0], &ctxs[0], u, &ferrors[0]);
+        CHKERRQ(ierr);
+    }
+    if (errorMonitor->cellCenters) {
+        try {
+            errorMonitor->ComputeCellCenterErrors(dm, crtime, u, ferrors);
+        } catch (std::exception &exception) {
+            SETERRQ(PetscObjectComm((PetscObject)dm), PETSC_ERR_LIB, exception.what());
+        }
+    }
 
     ierr = PetscPrintf(PETSC_COMM_WORLD, "Timestep: %04d time = %-8.4g \t L_2 Error: [%2.3g", (int)step, (double)crtime, (double)ferrors[0]);
     CHKERRQ(ierr);
@@ -47,5 +87,69 @@ PetscErrorCode ablate::monitors::FieldErrorMonitor::MonitorError(TS ts, PetscInt
     PetscFunctionReturn(0);
 }
 
+void ablate::monitors::FieldErrorMonitor::ComputeCellCenterErrors(DM dm, PetscReal time, Vec u, std::vector<PetscReal> &ferrors) const {
+    // compute the difference from the exact solution at the cell centroids (reused when the exact solution does not depend upon time)
+    Vec errorVec;
+    VecDuplicate(u, &errorVec) >> checkError;
+    flow->ProjectExactSolution(time, errorVec, true);
+    VecAXPY(errorVec, -1.0, u) >> checkError;
+
+    // the cell volumes are stored with the dm
+    Vec cellGeometry;
+    DM cellDm;
+    const PetscScalar *cellGeometryArray;
+    DMPlexGetGeometryFVM(dm, NULL, &cellGeometry, NULL) >> checkError;
+    VecGetDM(cellGeometry, &cellDm) >> checkError;
+    VecGetArrayRead(cellGeometry, &cellGeometryArray) >> checkError;
+
+    PetscInt cStart, cEnd;
+    DMPlexGetSimplexOrBoxCells(dm, 0, &cStart, &cEnd) >> checkError;
+    PetscDS ds;
+    DMGetDS(dm, &ds) >> checkError;
+    PetscInt *numberComponentsPerField;
+    PetscDSGetComponents(ds, &numberComponentsPerField) >> checkError;
+
+    // sum the volume weighted squared error of each finite volume field
+    std::vector<PetscInt> fvFields;
+    for (PetscInt f = 0; f < (PetscInt)ferrors.size(); f++) {
+        PetscObject field;
+        PetscClassId id;
+        DMGetField(dm, f, NULL, &field) >> checkError;
+        PetscObjectGetClassId(field, &id) >> checkError;
+        if (id == PETSCFV_CLASSID) {
+            fvFields.push_back(f);
+        }
+    }
+    std::vector<PetscReal> localErrors(fvFields.size(), 0.0);
+
+    const PetscScalar *errorArray;
+    VecGetArrayRead(errorVec, &errorArray) >> checkError;
+    for (PetscInt c = cStart; c < cEnd; ++c) {
+        PetscFVCellGeom *cellGeom;
+        DMPlexPointLocalRead(cellDm, c, cellGeometryArray, &cellGeom) >> checkError;
+        for (std::size_t i = 0; i < fvFields.size(); i++) {
+            // cells not owned by this rank are not in the global vector
+            const PetscScalar *values = nullptr;
+            DMPlexPointGlobalFieldRead(dm, c, fvFields[i], errorArray, &values) >> checkError;
+            if (values) {
+                for (PetscInt d = 0; d < numberComponentsPerField[fvFields[i]]; d++) {
+                    localErrors[i] += cellGeom->volume * PetscSqr(PetscRealPart(values[d]));
+                }
+            }
+        }
+    }
+    VecRestoreArrayRead(errorVec, &errorArray) >> checkError;
+    VecRestoreArrayRead(cellGeometry, &cellGeometryArray) >> checkError;
+    VecDestroy(&errorVec) >> checkError;
+
+    std::vector<PetscReal> globalErrors(fvFields.size(), 0.0);
+    MPI_Allreduce(localErrors.data(), globalErrors.data(), (PetscMPIInt)fvFields.size(), MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject)dm)) >> checkMpiError;
+    for (std::size_t i = 0; i < fvFields.size(); i++) {
+        ferrors[fvFields[i]] = PetscSqrtReal(globalErrors[i]);
+    }
+}
+
 #include "parser/registrar.hpp"
-REGISTER_WITHOUT_ARGUMENTS(ablate::monitors::Monitor, ablate::monitors::FieldErrorMonitor, "Computes and reports the error every time step");
\ No newline at end of file
+REGISTER(ablate::monitors::Monitor, ablate::monitors::FieldErrorMonitor, "Computes and reports the error every time step",
+         OPT(int, "interval", "how often to compute the error (default is every timestep)"),
+         OPT(bool, "cellCenters", "compute the error of finite volume fields from the exact solution at the cell centroids without quadrature (default is false)"));
\ No newline at end of file
@@ -1,14 +1,33 @@
 #ifndef ABLATELIBRARY_FIELDERRORMONITOR_HPP
 #define ABLATELIBRARY_FIELDERRORMONITOR_HPP
+#include <memory>
+#include <vector>
+#include "flow/flow.hpp"
 #include "monitor.hpp"
 namespace ablate::monitors {
 
 class FieldErrorMonitor : public Monitor {
    private:
+    // compute the error every interval steps (0 computes every step)
+    const int interval;
+
+    // compute the error of finite volume fields from the exact solution at the cell centroids instead of with quadrature
+    const bool cellCenters;
+
+    // the flow provides the (cached) exact solution projection when registered
+    std::shared_ptr<flow::Flow> flow;
+
     static PetscErrorCode MonitorError(TS ts, PetscInt step, PetscReal crtime, Vec u, void *ctx);
 
+    /**
+     * Replaces the error of each finite volume field with the volume weighted L2 error of the cell centroid values
+     */
+    void ComputeCellCenterErrors(DM dm, PetscReal time, Vec u, std::vector<PetscReal> &ferrors) const;
+
    public:
-    void Register(std::shared_ptr<Monitorable>) override {}
+    explicit FieldErrorMonitor(int interval = {}, bool cellCenters = false);
+
+    void Register(std::shared_ptr<Monitorable>) override;
     PetscMonitorFunction GetPetscFunction() override { return MonitorError; }
 };
 }  // namespace ablate::monitors
@@ -0,0 +1,208 @@
+#include "flowStatistics.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::monitors::FlowStatistics::FlowStatistics(std::string name, std::shared_ptr<flow::Flow> flow, const std::vector<std::string>& fields) : name(name), flow(flow) {
+    if (fields.empty()) {
+        throw std::invalid_argument("The statistics " + name + " require at least one field");
+    }
+
+    PetscInt dim;
+    DMGetDimension(flow->GetDM(), &dim) >> checkError;
+    DMClone(flow->GetDM(), &statisticsDm) >> checkError;
+
+    for (const auto& field : fields) {
+        const auto separator = field.find('.');
+        const std::string fieldName = field.substr(0, separator);
+        const std::string componentName = separator == std::string::npos ? "" : field.substr(separator + 1);
+
+        Quantity quantity{.name = fieldName + (componentName.empty() ? "" : "_" + componentName), .auxField = false, .fieldId = -1, .components = {}};
+        const flow::FlowFieldDescriptor* descriptor;
+        if (auto id = flow->GetFieldId(fieldName)) {
+            quantity.fieldId = id.value();
+            descriptor = &flow->GetFieldDescriptors()[quantity.fieldId];
+        } else if (auto auxId = flow->GetAuxFieldId(fieldName)) {
+            quantity.auxField = true;
+            quantity.fieldId = auxId.value();
+            descriptor = &flow->GetAuxFieldDescriptors()[quantity.fieldId];
+        } else {
+            throw std::invalid_argument("Cannot locate field " + fieldName + " in flow " + flow->GetName() + " for the statistics");
+        }
+        if (descriptor->fieldType != flow::FieldType::FV) {
+            throw std::invalid_argument("The statistics of " + fieldName + " require a finite volume field");
+        }
+
+        std::vector<std::string> componentNames;
+        for (PetscInt c = 0; c < descriptor->components; c++) {
+            const std::string fieldComponentName = (std::size_t)c < descriptor->componentNames.size() ? descriptor->componentNames[c] : "";
+            if (componentName.empty() || componentName == fieldComponentName || componentName == std::to_string(c)) {
+                quantity.components.push_back(c);
+                componentNames.push_back(fieldComponentName);
+            }
+        }
+        if (quantity.components.empty()) {
+            throw std::invalid_argument("Cannot locate the component " + componentName + " in the field " + fieldName);
+        }
+
+        // add the mean and rms fields for the quantity
+        for (const auto& suffix : {"_mean", "_rms"}) {
+            PetscFV fvm;
+            PetscFVCreate(PetscObjectComm((PetscObject)statisticsDm), &fvm) >> checkError;
+            PetscObjectSetName((PetscObject)fvm, (quantity.name + suffix).c_str()) >> checkError;
+            PetscFVSetNumComponents(fvm, (PetscInt)quantity.components.size()) >> checkError;
+            PetscFVSetSpatialDimension(fvm, dim) >> checkError;
+            for (std::size_t c = 0; c < componentNames.size(); c++) {
+                if (!componentNames[c].empty()) {
+                    PetscFVSetComponentName(fvm, (PetscInt)c, componentNames[c].c_str()) >> checkError;
+                }
+            }
+            DMAddField(statisticsDm, NULL, (PetscObject)fvm) >> checkError;
+            PetscFVDestroy(&fvm) >> checkError;
+        }
+        quantities.push_back(quantity);
+    }
+    DMCreateDS(statisticsDm) >> checkError;
+
+    DMCreateGlobalVector(statisticsDm, &moments) >> checkError;
+    VecSet(moments, 0.0) >> checkError;
+    DMCreateGlobalVector(statisticsDm, &statistics) >> checkError;
+    PetscObjectSetName((PetscObject)statistics, name.c_str()) >> checkError;
+
+    // the finite volume ghost cells are not sampled
+    PetscInt cStart, cEnd;
+    DMPlexGetSimplexOrBoxCells(statisticsDm, 0, &cStart, &cEnd) >> checkError;
+    PetscSection globalSection;
+    DMGetGlobalSection(statisticsDm, &globalSection) >> checkError;
+    for (PetscInt c = cStart; c < cEnd; ++c) {
+        PetscInt offset;
+        PetscSectionGetOffset(globalSection, c, &offset) >> checkError;
+        if (offset >= 0) {
+            cells.push_back(c);
+        }
+    }
+}
+
+ablate::monitors::FlowStatistics::~FlowStatistics() {
+    if (statistics) {
+        VecDestroy(&statistics) >> checkError;
+    }
+    if (moments) {
+        VecDestroy(&moments) >> checkError;
+    }
+    if (statisticsDm) {
+        DMDestroy(&statisticsDm) >> checkError;
+    }
+}
+
+void ablate::monitors::FlowStatistics::Accumulate(Vec u, PetscReal sampleWeight) {
+    if (sampleWeight <= 0.0) {
+        throw std::invalid_argument("The statistics " + name + " require a positive sample weight");
+    }
+
+    DM dm = flow->GetDM();
+    Vec localSolution;
+    DMGetLocalVector(dm, &localSolution) >> checkError;
+    DMGlobalToLocalBegin(dm, u, INSERT_VALUES, localSolution) >> checkError;
+    DMGlobalToLocalEnd(dm, u, INSERT_VALUES, localSolution) >> checkError;
+
+    const PetscScalar* solutionArray;
+    const PetscScalar* auxArray = nullptr;
+    VecGetArrayRead(localSolution, &solutionArray) >> checkError;
+    Vec auxField = flow->GetAuxField();
+    if (auxField) {
+        VecGetArrayRead(auxField, &auxArray) >> checkError;
+    }
+    PetscScalar* momentsArray;
+    VecGetArray(moments, &momentsArray) >> checkError;
+
+    // West's weighted update: W += w, delta = x - mean, mean += delta*w/W, M2 += w*delta*(x - mean)
+    samples++;
+    weight += sampleWeight;
+    const PetscReal weightFraction = sampleWeight / weight;
+    PetscInt numberValues = 0;
+    for (const auto cell : cells) {
+        for (std::size_t q = 0; q < quantities.size(); ++q) {
+            const auto& quantity = quantities[q];
+            const PetscScalar* values = nullptr;
+            if (quantity.auxField) {
+                DMPlexPointLocalFieldRead(flow->GetAuxDM(), cell, quantity.fieldId, auxArray, &values) >> checkError;
+            } else {
+                DMPlexPointLocalFieldRead(dm, cell, quantity.fieldId, solutionArray, &values) >> checkError;
+            }
+            PetscScalar* mean = nullptr;
+            PetscScalar* m2 = nullptr;
+            DMPlexPointGlobalFieldRef(statisticsDm, cell, 2 * q, momentsArray, &mean) >> checkError;
+            DMPlexPointGlobalFieldRef(statisticsDm, cell, 2 * q + 1, momentsArray, &m2) >> checkError;
+
+            for (std::size_t i = 0; i < quantity.components.size(); ++i) {
+                const PetscScalar x = values[quantity.components[i]];
+                const PetscScalar delta = x - mean[i];
+                mean[i] += delta * weightFraction;
+                m2[i] += sampleWeight * delta * (x - mean[i]);
+            }
+            numberValues += (PetscInt)quantity.components.size();
+        }
+    }
+    PetscLogFlops(6.0 * numberValues) >> checkError;
+
+    VecRestoreArray(moments, &momentsArray) >> checkError;
+    if (auxField) {
+        VecRestoreArrayRead(auxField, &auxArray) >> checkError;
+    }
+    VecRestoreArrayRead(localSolution, &solutionArray) >> checkError;
+    DMRestoreLocalVector(dm, &localSolution) >> checkError;
+}
+
+void ablate::monitors::FlowStatistics::UpdateStatistics() const {
+    // the means are copied and the M2 values are replaced with the rms
+    VecCopy(moments, statistics) >> checkError;
+    if (samples == 0 || weight <= 0.0) {
+        return;
+    }
+    PetscScalar* statisticsArray;
+    VecGetArray(statistics, &statisticsArray) >> checkError;
+    for (const auto cell : cells) {
+        for (std::size_t q = 0; q < quantities.size(); ++q) {
+            PetscScalar* rms = nullptr;
+            DMPlexPointGlobalFieldRef(statisticsDm, cell, 2 * q + 1, statisticsArray, &rms) >> checkError;
+            for (std::size_t i = 0; i < quantities[q].components.size(); ++i) {
+                rms[i] = PetscSqrtReal(PetscRealPart(rms[i]) / weight);
+            }
+        }
+    }
+    VecRestoreArray(statistics, &statisticsArray) >> checkError;
+}
+
+void ablate::monitors::FlowStatistics::View(PetscViewer viewer, PetscInt steps, PetscReal time, Vec u) const {
+    if (!meshViewed) {
+        ViewSetup(viewer);
+    }
+    UpdateStatistics();
+    DMSetOutputSequenceNumber(statisticsDm, steps, time) >> checkError;
+    VecView(statistics, viewer) >> checkError;
+}
+
+void ablate::monitors::FlowStatistics::ViewSetup(PetscViewer viewer) const {
+    DMView(statisticsDm, viewer) >> checkError;
+    meshViewed = true;
+}
+
+bool ablate::monitors::FlowStatistics::GetViewVectors(PetscInt steps, PetscReal time, Vec u, std::vector<Vec>& vectors) const {
+    UpdateStatistics();
+    vectors = {statistics};
+    return true;
+}
+
+void ablate::monitors::FlowStatistics::Save(Checkpoint& checkpoint) {
+    checkpoint.WriteValues("samples", {(PetscReal)samples, weight});
+    checkpoint.WriteVector("moments", moments);
+}
+
+void ablate::monitors::FlowStatistics::Restore(Checkpoint& checkpoint, PetscReal time) {
+    auto values = checkpoint.ReadValues("samples");
+    if (values.size() != 2) {
+        throw std::runtime_error("The number of samples and weight for the statistics " + name + " are not valid");
+    }
+    samples = (PetscInt)values[0];
+    weight = values[1];
+    checkpoint.ReadVector("moments", moments);
+}
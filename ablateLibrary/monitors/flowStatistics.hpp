@@ -0,0 +1,94 @@
+#ifndef ABLATELIBRARY_FLOWSTATISTICS_HPP
+#define ABLATELIBRARY_FLOWSTATISTICS_HPP
+#include <petsc.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "checkpointable.hpp"
+#include "flow/flow.hpp"
+#include "viewable.hpp"
+
+namespace ablate::monitors {
+/**
+ * Accumulates the running time weighted mean and second moment of selected finite volume flow fields (or field components) with West's weighted form of
+ * Welford's algorithm.  Each sample is weighted by its time step so that the statistics are time averages when the time step changes.  The moments are stored
+ * in place on a clone of the flow dm, with a mean and an rms field for each selected quantity, so they are distributed and written the same way as the flow.
+ * The rms is the root mean square of the fluctuations about the mean.
+ */
+class FlowStatistics : public Viewable, public Checkpointable {
+   private:
+    /**
+     * A selected field (or component of a field) from the solution or aux vector
+     */
+    struct Quantity {
+        std::string name;
+        bool auxField;
+        PetscInt fieldId;
+        std::vector<PetscInt> components;
+    };
+
+    const std::string name;
+    const std::shared_ptr<flow::Flow> flow;
+    std::vector<Quantity> quantities;
+
+    // the clone of the flow dm with a mean and rms field for each quantity
+    DM statisticsDm = nullptr;
+
+    // the running mean and the weighted sum of the squared differences from the mean (M2) in the mean and rms fields
+    Vec moments = nullptr;
+
+    // the mean and rms written to the output
+    Vec statistics = nullptr;
+
+    // the owned (non ghost) cells
+    std::vector<PetscInt> cells;
+
+    // the number of samples and their total weight (time) in the moments
+    PetscInt samples = 0;
+    PetscReal weight = 0.0;
+
+    // the mesh is written with the first output
+    mutable bool meshViewed = false;
+
+    /**
+     * Computes the rms from the moments into the statistics vector
+     */
+    void UpdateStatistics() const;
+
+   public:
+    /**
+     * @param name the name of the statistics and its output file
+     * @param flow the flow to sample
+     * @param fields the solution or aux fields, a single component is selected with field.component (by component name or index)
+     */
+    FlowStatistics(std::string name, std::shared_ptr<flow::Flow> flow, const std::vector<std::string>& fields);
+    ~FlowStatistics();
+
+    FlowStatistics(const FlowStatistics&) = delete;
+    FlowStatistics& operator=(const FlowStatistics&) = delete;
+
+    /**
+     * Adds the current flow state as a sample (collective)
+     * @param u the flow solution
+     * @param sampleWeight the weight of the sample, i.e. the time step it represents
+     */
+    void Accumulate(Vec u, PetscReal sampleWeight);
+
+    PetscInt GetSamples() const { return samples; }
+    PetscReal GetWeight() const { return weight; }
+
+    const std::string& GetName() const override { return name; }
+
+    void View(PetscViewer viewer, PetscInt steps, PetscReal time, Vec u) const override;
+    void ViewSetup(PetscViewer viewer) const override;
+    bool GetViewVectors(PetscInt steps, PetscReal time, Vec u, std::vector<Vec>& vectors) const override;
+
+    /**
+     * Writes the moments, the number of samples, and their total weight
+     */
+    void Save(Checkpoint& checkpoint) override;
+    void Restore(Checkpoint& checkpoint, PetscReal time) override;
+};
+}  // namespace ablate::monitors
+
+#endif  // ABLATELIBRARY_FLOWSTATISTICS_HPP
@@ -1,13 +1,39 @@
 #include "hdf5Monitor.hpp"
 #include <petscviewerhdf5.h>
 #include <environment/runEnvironment.hpp>
+#include <numeric>
+#include <stdexcept>
 #include "generators.hpp"
+#include "utilities/hdf5Error.hpp"
+#include "utilities/logEvents.hpp"
+#include "utilities/mpiError.hpp"
 #include "utilities/petscError.hpp"
+#include "utilities/workingDirectory.hpp"
 
 ablate::monitors::Hdf5Monitor::~Hdf5Monitor() {
+    // write any remaining snapshots
+    if (writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopWriter = true;
+        }
+        queueCondition.notify_all();
+        writer.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(asynchronousMonitorsMutex);
+        asynchronousMonitors.erase(this);
+    }
+    if (timeStamp) {
+        VecDestroy(&timeStamp) >> checkError;
+    }
+
     if (petscViewer) {
         PetscViewerDestroy(&petscViewer) >> checkError;
     }
+    if (ioComm != MPI_COMM_NULL) {
+        MPI_Comm_free(&ioComm) >> checkMpiError;
+    }
 
     // If this is the root process generate the xdmf file
     int rank;
@@ -23,22 +49,474 @@ void ablate::monitors::Hdf5Monitor::Register(std::shared_ptr<Monitorable> object
     // build the file name
     outputFilePath = environment::RunEnvironment::Get().GetOutputDirectory() / (viewableObject->GetName() + extension);
 
+    // the writer thread makes mpi and petsc calls at the same time as the time loop
+    if (asynchronous) {
+        int threadLevel;
+        MPI_Query_thread(&threadLevel) >> checkMpiError;
+#if defined(PETSC_HAVE_THREADSAFETY)
+        const bool threadSafePetsc = true;
+#else
+        const bool threadSafePetsc = false;
+#endif
+        if (threadLevel < MPI_THREAD_MULTIPLE || !threadSafePetsc) {
+            PetscPrintf(PETSC_COMM_WORLD, "WARNING: asynchronous hdf5 output requires MPI_THREAD_MULTIPLE and a thread safe PETSc, %s will be written synchronously\n",
+                        viewableObject->GetName().c_str()) >> checkError;
+            asynchronous = false;
+        }
+    }
+
     // setup the petsc viewer
-    PetscViewerHDF5Open(PETSC_COMM_WORLD, outputFilePath.string().c_str(), FILE_MODE_WRITE, &petscViewer) >> checkError;
+    if (asynchronous) {
+        MPI_Comm_dup(PETSC_COMM_WORLD, &ioComm) >> checkMpiError;
+        PetscViewerHDF5Open(ioComm, outputFilePath.string().c_str(), FILE_MODE_WRITE, &petscViewer) >> checkError;
+        {
+            std::lock_guard<std::mutex> lock(asynchronousMonitorsMutex);
+            asynchronousMonitors.insert(this);
+        }
+        writer = std::thread(&Hdf5Monitor::WriteSnapshots, this);
+    } else {
+        PetscViewerHDF5Open(PETSC_COMM_WORLD, outputFilePath.string().c_str(), FILE_MODE_WRITE, &petscViewer) >> checkError;
+    }
+    PetscViewerHDF5SetSPOutput(petscViewer, singlePrecision ? PETSC_TRUE : PETSC_FALSE) >> checkError;
 }
 PetscErrorCode ablate::monitors::Hdf5Monitor::OutputHdf5(TS ts, PetscInt steps, PetscReal time, Vec u, void *mctx) {
     PetscFunctionBeginUser;
     auto monitor = (ablate::monitors::Hdf5Monitor *)mctx;
     auto monitorObject = monitor->viewableObject;
 
-    if (steps == 0 || monitor->interval == 0 || (steps % monitor->interval == 0)) try {
-            monitorObject->View(monitor->petscViewer, steps, time, u);
+    // the final state is always written at the end of the solve, including when it is stopped early (e.g. by the ConvergenceMonitor)
+    TSConvergedReason reason;
+    PetscErrorCode ierr = TSGetConvergedReason(ts, &reason);
+    CHKERRQ(ierr);
+
+    if (steps == 0 || monitor->interval == 0 || (steps % monitor->interval == 0) || reason != TS_CONVERGED_ITERATING) try {
+            utilities::LogEvents::Scope outputScope(monitor->outputLogEvent);
+            std::vector<Vec> vectors;
+            if (monitor->IsStaged() && monitorObject->GetViewVectors(steps, time, u, vectors)) {
+                // the shared data (mesh) is written with the first output
+                if (!monitor->setupViewed) {
+                    FlushAsynchronousMonitors();
+                    monitorObject->ViewSetup(monitor->petscViewer);
+                    monitor->setupViewed = true;
+                }
+                if (monitor->numberViewVectors == 0) {
+                    monitor->BuildDatasets(vectors);
+                } else if (vectors.size() != monitor->numberViewVectors) {
+                    throw std::invalid_argument("The vectors viewed by " + monitorObject->GetName() + " changed between outputs");
+                }
+
+                if (monitor->asynchronous) {
+                    monitor->StageSnapshot(steps, time, vectors);
+                    monitorObject->RestoreViewVectors(vectors);
+                } else {
+                    Snapshot snapshot{.steps = steps, .time = time, .values = {}};
+                    monitor->CopyToSnapshot(vectors, snapshot);
+                    monitorObject->RestoreViewVectors(vectors);
+
+                    // hdf5 is only used by one thread at a time
+                    FlushAsynchronousMonitors();
+                    monitor->WriteSnapshot(snapshot);
+                }
+            } else if (!monitor->fields.empty() || monitor->compression > 0) {
+                throw std::invalid_argument("The field selection and compression are not supported when viewing " + monitorObject->GetName());
+            } else {
+                FlushAsynchronousMonitors();
+                monitorObject->View(monitor->petscViewer, steps, time, u);
+            }
         } catch (std::exception &e) {
             SETERRQ(PETSC_COMM_SELF, PETSC_ERR_LIB, e.what());
         }
     PetscFunctionReturn(0);
 }
-ablate::monitors::Hdf5Monitor::Hdf5Monitor(int interval) : interval(interval) {}
+
+void ablate::monitors::Hdf5Monitor::BuildDatasets(const std::vector<Vec> &vectors) {
+    numberViewVectors = vectors.size();
+    std::vector<bool> selectionFound(fields.size(), false);
+
+    for (std::size_t v = 0; v < vectors.size(); ++v) {
+        const char *vectorName;
+        PetscObjectGetName((PetscObject)vectors[v], &vectorName) >> checkError;
+
+        // without a selection the entire vector is written in the same layout as VecView
+        if (fields.empty()) {
+            PetscInt size, blockSize;
+            VecGetLocalSize(vectors[v], &size) >> checkError;
+            VecGetBlockSize(vectors[v], &blockSize) >> checkError;
+            datasets.push_back(Dataset{.name = vectorName, .vector = v, .components = blockSize, .localRows = size / blockSize, .globalRows = 0, .rowOffset = 0, .indices = {}});
+            continue;
+        }
+
+        // the selected values are located with the vector's sections
+        DM dm;
+        VecGetDM(vectors[v], &dm) >> checkError;
+        if (!dm) {
+            throw std::invalid_argument(std::string("The field selection requires a dm for the vector ") + vectorName);
+        }
+        PetscSection section, globalSection;
+        DMGetLocalSection(dm, &section) >> checkError;
+        DMGetGlobalSection(dm, &globalSection) >> checkError;
+        PetscInt numberFields, pStart, pEnd, rStart;
+        DMGetNumFields(dm, &numberFields) >> checkError;
+        PetscSectionGetChart(section, &pStart, &pEnd) >> checkError;
+        VecGetOwnershipRange(vectors[v], &rStart, NULL) >> checkError;
+
+        for (std::size_t s = 0; s < fields.size(); ++s) {
+            // each selection is a field or field.component
+            const auto separator = fields[s].find('.');
+            const std::string fieldName = fields[s].substr(0, separator);
+            const std::string componentName = separator == std::string::npos ? "" : fields[s].substr(separator + 1);
+
+            for (PetscInt f = 0; f < numberFields; ++f) {
+                PetscObject fieldObject;
+                const char *name;
+                DMGetField(dm, f, NULL, &fieldObject) >> checkError;
+                PetscObjectGetName(fieldObject, &name) >> checkError;
+                if (fieldName != name) {
+                    continue;
+                }
+
+                PetscInt components;
+                PetscSectionGetFieldComponents(section, f, &components) >> checkError;
+                std::vector<PetscInt> selectedComponents;
+                if (componentName.empty()) {
+                    selectedComponents.resize(components);
+                    std::iota(selectedComponents.begin(), selectedComponents.end(), 0);
+                } else {
+                    // components are selected by name (finite volume fields) or index
+                    PetscClassId classId;
+                    PetscObjectGetClassId(fieldObject, &classId) >> checkError;
+                    for (PetscInt c = 0; c < components; ++c) {
+                        const char *fvComponentName = NULL;
+                        if (classId == PETSCFV_CLASSID) {
+                            PetscFVGetComponentName((PetscFV)fieldObject, c, &fvComponentName) >> checkError;
+                        }
+                        if ((fvComponentName && componentName == fvComponentName) || componentName == std::to_string(c)) {
+                            selectedComponents.push_back(c);
+                        }
+                    }
+                    if (selectedComponents.empty()) {
+                        throw std::invalid_argument("Cannot locate the component " + componentName + " in the field " + fieldName);
+                    }
+                }
+
+                Dataset dataset{.name = std::string(vectorName) + "_" + fieldName + (componentName.empty() ? "" : "_" + componentName),
+                                .vector = v,
+                                .components = (PetscInt)selectedComponents.size(),
+                                .localRows = 0,
+                                .globalRows = 0,
+                                .rowOffset = 0,
+                                .indices = {}};
+                for (PetscInt p = pStart; p < pEnd; ++p) {
+                    // only the points owned by this rank are written
+                    PetscInt globalDof, fieldDof, constraintDof;
+                    PetscSectionGetDof(globalSection, p, &globalDof) >> checkError;
+                    PetscSectionGetFieldDof(section, p, f, &fieldDof) >> checkError;
+                    if (globalDof <= 0 || fieldDof == 0) {
+                        continue;
+                    }
+                    PetscSectionGetConstraintDof(section, p, &constraintDof) >> checkError;
+                    if (constraintDof) {
+                        throw std::invalid_argument("The field selection does not support constrained values in the field " + fieldName);
+                    }
+
+                    PetscInt offset, fieldOffset, globalOffset;
+                    PetscSectionGetOffset(section, p, &offset) >> checkError;
+                    PetscSectionGetFieldOffset(section, p, f, &fieldOffset) >> checkError;
+                    PetscSectionGetOffset(globalSection, p, &globalOffset) >> checkError;
+                    const PetscInt start = globalOffset - rStart + fieldOffset - offset;
+                    for (PetscInt node = 0; node < fieldDof / components; ++node, ++dataset.localRows) {
+                        for (auto c : selectedComponents) {
+                            dataset.indices.push_back(start + node * components + c);
+                        }
+                    }
+                }
+                datasets.push_back(std::move(dataset));
+                selectionFound[s] = true;
+            }
+        }
+    }
+    for (std::size_t s = 0; s < fields.size(); ++s) {
+        if (!selectionFound[s]) {
+            throw std::invalid_argument("Cannot locate the output field " + fields[s] + " in " + viewableObject->GetName());
+        }
+    }
+
+    // the rows on each rank follow the rows on the previous ranks
+    MPI_Comm comm = PetscObjectComm((PetscObject)vectors.front());
+    PetscMPIInt rank;
+    MPI_Comm_rank(comm, &rank) >> checkMpiError;
+    std::vector<PetscInt> localRows(datasets.size()), rowOffsets(datasets.size(), 0), globalRows(datasets.size());
+    for (std::size_t d = 0; d < datasets.size(); ++d) {
+        localRows[d] = datasets[d].localRows;
+    }
+    MPI_Exscan(localRows.data(), rowOffsets.data(), (PetscMPIInt)datasets.size(), MPIU_INT, MPI_SUM, comm) >> checkMpiError;
+    MPI_Allreduce(localRows.data(), globalRows.data(), (PetscMPIInt)datasets.size(), MPIU_INT, MPI_SUM, comm) >> checkMpiError;
+    for (std::size_t d = 0; d < datasets.size(); ++d) {
+        datasets[d].rowOffset = rank ? rowOffsets[d] : 0;
+        datasets[d].globalRows = globalRows[d];
+    }
+}
+
+void ablate::monitors::Hdf5Monitor::CopyToSnapshot(const std::vector<Vec> &vectors, Snapshot &snapshot) const {
+    // copy the local values, this does not communicate
+    std::vector<const PetscScalar *> arrays(vectors.size());
+    for (std::size_t v = 0; v < vectors.size(); ++v) {
+        VecGetArrayRead(vectors[v], &arrays[v]) >> checkError;
+    }
+    snapshot.values.resize(datasets.size());
+    for (std::size_t d = 0; d < datasets.size(); ++d) {
+        const auto &dataset = datasets[d];
+        const PetscScalar *array = arrays[dataset.vector];
+        auto &values = snapshot.values[d];
+        if (dataset.indices.empty()) {
+            values.assign(array, array + dataset.localRows * dataset.components);
+        } else {
+            values.resize(dataset.indices.size());
+            for (std::size_t i = 0; i < dataset.indices.size(); ++i) {
+                values[i] = array[dataset.indices[i]];
+            }
+        }
+    }
+    for (std::size_t v = 0; v < vectors.size(); ++v) {
+        VecRestoreArrayRead(vectors[v], &arrays[v]) >> checkError;
+    }
+}
+
+void ablate::monitors::Hdf5Monitor::StageSnapshot(PetscInt steps, PetscReal time, const std::vector<Vec> &vectors) {
+    // the staging snapshots are allocated the first time
+    if (snapshots.empty()) {
+        snapshots.resize(queueSize);
+        std::lock_guard<std::mutex> lock(queueMutex);
+        for (auto &snapshot : snapshots) {
+            freeSnapshots.push_back(&snapshot);
+        }
+    }
+
+    // every rank stops at the same output when a writer has failed, so that no rank is left waiting in the time loop collectives
+    int localFailed, anyFailed;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        localFailed = writerError ? 1 : 0;
+    }
+    MPI_Allreduce(&localFailed, &anyFailed, 1, MPI_INT, MPI_LOR, PETSC_COMM_WORLD) >> checkMpiError;
+    if (anyFailed) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (writerError) {
+            std::rethrow_exception(writerError);
+        }
+        throw std::runtime_error("The asynchronous hdf5 output of " + viewableObject->GetName() + " failed on another rank");
+    }
+
+    // wait for a free snapshot (back pressure from the writer), the writer returns every snapshot even after a failure
+    Snapshot *snapshot;
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        queueCondition.wait(lock, [this] { return !freeSnapshots.empty(); });
+        snapshot = freeSnapshots.front();
+        freeSnapshots.pop_front();
+    }
+
+    CopyToSnapshot(vectors, *snapshot);
+    snapshot->steps = steps;
+    snapshot->time = time;
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        writeQueue.push_back(snapshot);
+    }
+    queueCondition.notify_all();
+}
+
+void ablate::monitors::Hdf5Monitor::WriteSnapshot(const Snapshot &snapshot) {
+    // the same layout as the viewable object's View: the time is written to /time and each vector to /fields
+    MPI_Comm comm = PetscObjectComm((PetscObject)petscViewer);
+    PetscMPIInt rank;
+    MPI_Comm_rank(comm, &rank) >> checkMpiError;
+    if (!timeStamp) {
+        VecCreateMPI(comm, rank ? 0 : 1, 1, &timeStamp) >> checkError;
+        VecSetBlockSize(timeStamp, 1) >> checkError;
+        PetscObjectSetName((PetscObject)timeStamp, "time") >> checkError;
+    }
+    if (!rank) {
+        VecSetValue(timeStamp, 0, snapshot.time, INSERT_VALUES) >> checkError;
+    }
+    VecAssemblyBegin(timeStamp) >> checkError;
+    VecAssemblyEnd(timeStamp) >> checkError;
+
+    PetscViewerHDF5PushGroup(petscViewer, "/") >> checkError;
+    PetscViewerHDF5SetTimestep(petscViewer, snapshot.steps) >> checkError;
+    VecView(timeStamp, petscViewer) >> checkError;
+    PetscViewerHDF5PopGroup(petscViewer) >> checkError;
+
+    for (std::size_t d = 0; d < datasets.size(); ++d) {
+        WriteDataset(datasets[d], snapshot.values[d], snapshot.steps);
+    }
+}
+
+void ablate::monitors::Hdf5Monitor::WriteDataset(const Dataset &dataset, const std::vector<PetscReal> &values, PetscInt steps) {
+    PetscViewerHDF5PushGroup(petscViewer, "/fields") >> checkError;
+    hid_t fileId, groupId;
+    PetscViewerHDF5OpenGroup(petscViewer, &fileId, &groupId) >> checkError;
+
+    // the dataset is indexed by the step like VecView ([step, row] or [step, row, component])
+    const int rank = dataset.components > 1 ? 3 : 2;
+    hsize_t dims[3] = {(hsize_t)steps + 1, (hsize_t)dataset.globalRows, (hsize_t)dataset.components};
+    hid_t datasetId;
+    bool created = false;
+    if (H5Lexists(groupId, dataset.name.c_str(), H5P_DEFAULT) > 0) {
+        datasetId = H5Dopen2(groupId, dataset.name.c_str(), H5P_DEFAULT);
+        datasetId >> checkHdf5Error;
+        hid_t space = H5Dget_space(datasetId);
+        space >> checkHdf5Error;
+        hsize_t currentDims[3];
+        H5Sget_simple_extent_dims(space, currentDims, NULL) >> checkHdf5Error;
+        H5Sclose(space) >> checkHdf5Error;
+        if (currentDims[0] < dims[0]) {
+            H5Dset_extent(datasetId, dims) >> checkHdf5Error;
+        }
+    } else {
+        // the dataset is chunked along the rows so that it can be extended and compressed.  A chunk cannot be larger than a fixed dimension, so an empty dataset
+        // (e.g. no particles) has unlimited rows and is not compressed
+        const bool empty = dataset.globalRows == 0;
+        const hsize_t maxDims[3] = {H5S_UNLIMITED, empty ? H5S_UNLIMITED : (hsize_t)dataset.globalRows, (hsize_t)dataset.components};
+        const hsize_t chunkDims[3] = {1, (hsize_t)PetscMax(1, PetscMin(dataset.globalRows, chunkValues / dataset.components)), (hsize_t)dataset.components};
+        hid_t space = H5Screate_simple(rank, dims, maxDims);
+        space >> checkHdf5Error;
+        hid_t createProperties = H5Pcreate(H5P_DATASET_CREATE);
+        createProperties >> checkHdf5Error;
+        H5Pset_chunk(createProperties, rank, chunkDims) >> checkHdf5Error;
+        if (compression > 0 && !empty) {
+            H5Pset_shuffle(createProperties) >> checkHdf5Error;
+            H5Pset_deflate(createProperties, (unsigned)PetscMin(compression, 9)) >> checkHdf5Error;
+        }
+        datasetId = H5Dcreate2(groupId, dataset.name.c_str(), singlePrecision ? H5T_NATIVE_FLOAT : H5T_NATIVE_DOUBLE, space, H5P_DEFAULT, createProperties, H5P_DEFAULT);
+        datasetId >> checkHdf5Error;
+        H5Pclose(createProperties) >> checkHdf5Error;
+        H5Sclose(space) >> checkHdf5Error;
+        created = true;
+    }
+
+    // each rank writes its rows of this step
+    hid_t fileSpace = H5Dget_space(datasetId);
+    fileSpace >> checkHdf5Error;
+    const hsize_t start[3] = {(hsize_t)steps, (hsize_t)dataset.rowOffset, 0};
+    const hsize_t count[3] = {1, (hsize_t)dataset.localRows, (hsize_t)dataset.components};
+    hid_t memorySpace;
+    if (dataset.localRows) {
+        H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, NULL, count, NULL) >> checkHdf5Error;
+        memorySpace = H5Screate_simple(rank, count, NULL);
+        memorySpace >> checkHdf5Error;
+    } else {
+        const hsize_t one = 1;
+        H5Sselect_none(fileSpace) >> checkHdf5Error;
+        memorySpace = H5Screate_simple(1, &one, NULL);
+        memorySpace >> checkHdf5Error;
+        H5Sselect_none(memorySpace) >> checkHdf5Error;
+    }
+
+    // compressed datasets must be written collectively
+    hid_t transferProperties = H5Pcreate(H5P_DATASET_XFER);
+    transferProperties >> checkHdf5Error;
+#if defined(H5_HAVE_PARALLEL)
+    H5Pset_dxpl_mpio(transferProperties, H5FD_MPIO_COLLECTIVE) >> checkHdf5Error;
+#endif
+#if defined(PETSC_USE_REAL_SINGLE)
+    const hid_t memoryType = H5T_NATIVE_FLOAT;
+#else
+    const hid_t memoryType = H5T_NATIVE_DOUBLE;
+#endif
+    H5Dwrite(datasetId, memoryType, memorySpace, fileSpace, transferProperties, values.data()) >> checkHdf5Error;
+
+    H5Pclose(transferProperties) >> checkHdf5Error;
+    H5Sclose(memorySpace) >> checkHdf5Error;
+    H5Sclose(fileSpace) >> checkHdf5Error;
+    H5Dclose(datasetId) >> checkHdf5Error;
+    H5Gclose(groupId) >> checkHdf5Error;
+
+    // the same attributes that VecView writes, these are used by the xdmf generator
+    if (created) {
+        const std::string datasetPath = "/fields/" + dataset.name;
+        PetscViewerHDF5WriteAttribute(petscViewer, datasetPath.c_str(), "vector_field_type", PETSC_STRING, dataset.components > 1 ? "vector" : "scalar") >> checkError;
+        const PetscBool timestepping = PETSC_TRUE;
+        PetscViewerHDF5WriteAttribute(petscViewer, datasetPath.c_str(), "timestepping", PETSC_BOOL, &timestepping) >> checkError;
+    }
+    PetscViewerHDF5PopGroup(petscViewer) >> checkError;
+}
+
+void ablate::monitors::Hdf5Monitor::WriteSnapshots() {
+    while (true) {
+        Snapshot *snapshot;
+        bool failed;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return !writeQueue.empty() || stopWriter; });
+            // the remaining snapshots are written before stopping
+            if (writeQueue.empty()) {
+                return;
+            }
+            snapshot = writeQueue.front();
+            writeQueue.pop_front();
+            writing = true;
+            failed = (bool)writerError;
+        }
+
+        std::exception_ptr error;
+        if (!failed) {
+            try {
+                // the working directory is not changed (e.g. by the TChem initialization) while the file is in use
+                auto workingDirectoryLock = utilities::WorkingDirectory::Use();
+                WriteSnapshot(*snapshot);
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+
+        // the ranks agree on a failure before the next snapshot, so every rank skips the remaining collective writes together
+        int localFailed = failed || error ? 1 : 0;
+        int anyFailed = localFailed;
+        if (MPI_Allreduce(&localFailed, &anyFailed, 1, MPI_INT, MPI_LOR, ioComm) != MPI_SUCCESS) {
+            anyFailed = 1;
+        }
+        if (anyFailed && !failed && !error) {
+            error = std::make_exception_ptr(std::runtime_error("The asynchronous hdf5 output of " + viewableObject->GetName() + " failed on another rank"));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (error) {
+                writerError = error;
+            }
+            writing = false;
+            freeSnapshots.push_back(snapshot);
+        }
+        queueCondition.notify_all();
+    }
+}
+
+void ablate::monitors::Hdf5Monitor::Flush() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueCondition.wait(lock, [this] { return writeQueue.empty() && !writing; });
+    if (writerError) {
+        std::rethrow_exception(writerError);
+    }
+}
+
+void ablate::monitors::Hdf5Monitor::FlushAsynchronousMonitors() {
+    std::lock_guard<std::mutex> lock(asynchronousMonitorsMutex);
+    for (auto monitor : asynchronousMonitors) {
+        monitor->Flush();
+    }
+}
+
+ablate::monitors::Hdf5Monitor::Hdf5Monitor(int interval, bool asynchronous, int queueSize, std::vector<std::string> fields, bool singlePrecision, int compression)
+    : interval(interval), fields(fields), singlePrecision(singlePrecision), compression(compression), asynchronous(asynchronous), queueSize(queueSize > 0 ? queueSize : 2) {
+    outputLogEvent = utilities::LogEvents::Register("Hdf5Output");
+}
 
 #include "parser/registrar.hpp"
-REGISTER(ablate::monitors::Monitor, ablate::monitors::Hdf5Monitor, "writes the viewable object to an hdf5", ARG(int, "interval", "how often to write the HDF5 file (default is every timestep)"));
+REGISTER(ablate::monitors::Monitor, ablate::monitors::Hdf5Monitor, "writes the viewable object to an hdf5", ARG(int, "interval", "how often to write the HDF5 file (default is every timestep)"),
+         OPT(bool, "asynchronous", "copy the output into staging buffers and write them on a background thread (requires MPI_THREAD_MULTIPLE and a thread safe PETSc)"),
+         OPT(int, "queueSize", "the number of staged outputs before the time loop waits for the writer (default is 2)"),
+         OPT(std::vector<std::string>, "fields", "the fields (or field.component) to write (default is all fields)"),
+         OPT(bool, "singlePrecision", "write the values in single precision"),
+         OPT(int, "compression", "the deflate level (1-9, with shuffle) for each field, 0 disables compression"));
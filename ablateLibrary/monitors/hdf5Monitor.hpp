@@ -1,7 +1,14 @@
 #ifndef ABLATELIBRARY_HDF5MONITOR_HPP
 #define ABLATELIBRARY_HDF5MONITOR_HPP
 #include <petsc.h>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <filesystem>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 #include "monitor.hpp"
 #include "viewable.hpp"
 namespace ablate::monitors {
@@ -17,10 +24,126 @@ class Hdf5Monitor : public Monitor {
 
     const int interval;
 
+   private:
+    /**
+     * A dataset in the /fields group written from one of the viewed vectors.  Each local row holds the components of one node, in the order of the vector.
+     */
+    struct Dataset {
+        std::string name;
+        std::size_t vector;
+        PetscInt components;
+        PetscInt localRows;
+        PetscInt globalRows;
+        PetscInt rowOffset;
+        // the local vector index of each value, empty to copy the entire vector
+        std::vector<PetscInt> indices;
+    };
+    std::vector<Dataset> datasets;
+    std::size_t numberViewVectors = 0;
+
+    /**
+     * The values of every dataset viewed at a step
+     */
+    struct Snapshot {
+        PetscInt steps;
+        PetscReal time;
+        std::vector<std::vector<PetscReal>> values;
+    };
+
+    // the fields (or field.component) written, all fields if empty
+    const std::vector<std::string> fields;
+
+    // write the values in single precision
+    const bool singlePrecision;
+
+    // the deflate level (with shuffle) applied to each dataset, 0 disables compression
+    const int compression;
+
+    // the number of values in each dataset chunk
+    inline static const PetscInt chunkValues = 131072;
+
+    // the shared data (mesh) is written before the first staged output
+    bool setupViewed = false;
+
+    // profiles the time the time loop spends in each output (the background writes are not included)
+    PetscLogEvent outputLogEvent;
+
+    // write the snapshots on a background thread
+    bool asynchronous;
+
+    // the maximum number of snapshots staged at once, the time loop waits for the writer when every snapshot is staged
+    const int queueSize;
+
+    // the asynchronous viewer is on a duplicate communicator so the writer collectives do not interleave with the time loop collectives
+    MPI_Comm ioComm = MPI_COMM_NULL;
+
+    // the staging snapshots are allocated once and recycled between the free list and the write queue
+    std::vector<Snapshot> snapshots;
+    std::deque<Snapshot *> freeSnapshots;
+    std::deque<Snapshot *> writeQueue;
+    bool writing = false;
+    bool stopWriter = false;
+    std::exception_ptr writerError;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::thread writer;
+
+    // the time of each snapshot is written with a single value vector
+    Vec timeStamp = nullptr;
+
+    // every asynchronous monitor is flushed before a synchronous hdf5 write
+    inline static std::mutex asynchronousMonitorsMutex;
+    inline static std::set<Hdf5Monitor *> asynchronousMonitors;
+
+    /**
+     * true if the output is written from the selected values (field selection, compression, or asynchronous) instead of the viewable object's View
+     */
+    bool IsStaged() const { return asynchronous || !fields.empty() || compression > 0; }
+
+    /**
+     * Builds the datasets from the selected fields in the vectors (collective)
+     */
+    void BuildDatasets(const std::vector<Vec> &vectors);
+
+    /**
+     * Copies the selected values of the vectors into the snapshot
+     */
+    void CopyToSnapshot(const std::vector<Vec> &vectors, Snapshot &snapshot) const;
+
+    /**
+     * Copies the vectors into a free snapshot and queues it for the writer, waiting for a free snapshot if needed
+     */
+    void StageSnapshot(PetscInt steps, PetscReal time, const std::vector<Vec> &vectors);
+
+    /**
+     * Writes the snapshot time and datasets to the viewer
+     */
+    void WriteSnapshot(const Snapshot &snapshot);
+
+    /**
+     * Writes a single step of a dataset (collective on the viewer)
+     */
+    void WriteDataset(const Dataset &dataset, const std::vector<PetscReal> &values, PetscInt steps);
+
+    /**
+     * The writer thread loop
+     */
+    void WriteSnapshots();
+
+    /**
+     * Waits until every queued snapshot is written and rethrows any error from the writer
+     */
+    void Flush();
+
    public:
-    Hdf5Monitor(int interval = {});
+    explicit Hdf5Monitor(int interval = {}, bool asynchronous = false, int queueSize = {}, std::vector<std::string> fields = {}, bool singlePrecision = false, int compression = {});
     ~Hdf5Monitor() override;
 
+    /**
+     * Flushes every asynchronous monitor so that another hdf5 write (e.g. a checkpoint) does not overlap with a writer (collective)
+     */
+    static void FlushAsynchronousMonitors();
+
     void Register(std::shared_ptr<Monitorable>) override;
     PetscMonitorFunction GetPetscFunction() override { return OutputHdf5; }
 };
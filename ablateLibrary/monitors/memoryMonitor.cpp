@@ -0,0 +1,86 @@
+#include "memoryMonitor.hpp"
+#include <string>
+#include <vector>
+#include "utilities/memoryTracker.hpp"
+#include "utilities/mpiError.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::monitors::MemoryMonitor::MemoryMonitor(int interval) : interval(interval > 0 ? interval : 1) {
+    // the resident high-water is only recorded once requested
+    PetscMemorySetGetMaximumUsage() >> checkError;
+
+    // PETSc only counts the PetscMalloc memory when it traces the mallocs, otherwise both values are always zero
+    PetscBool mallocDebug;
+    PetscMallocGetDebug(&mallocDebug, NULL, NULL) >> checkError;
+    mallocTraced = mallocDebug;
+}
+
+PetscErrorCode ablate::monitors::MemoryMonitor::ReportMemory(TS ts, PetscInt steps, PetscReal time, Vec u, void* mctx) {
+    PetscFunctionBeginUser;
+    auto monitor = (ablate::monitors::MemoryMonitor*)mctx;
+
+    try {
+        if (steps % monitor->interval == 0) {
+            monitor->Report(steps);
+        }
+    } catch (std::exception& e) {
+        SETERRQ(PETSC_COMM_SELF, PETSC_ERR_LIB, e.what());
+    }
+    PetscFunctionReturn(0);
+}
+
+void ablate::monitors::MemoryMonitor::Report(PetscInt steps) {
+    // the process values followed by each subsystem
+    std::vector<std::string> names = {"resident", "resident high-water", "PetscMalloc", "PetscMalloc high-water"};
+    std::vector<PetscLogDouble> localBytes(4);
+    PetscMemoryGetCurrentUsage(&localBytes[0]) >> checkError;
+    PetscMemoryGetMaximumUsage(&localBytes[1]) >> checkError;
+    PetscMallocGetCurrentUsage(&localBytes[2]) >> checkError;
+    PetscMallocGetMaximumUsage(&localBytes[3]) >> checkError;
+    const std::size_t numberProcessValues = localBytes.size();
+    for (const auto& usage : utilities::MemoryTracker::GetUsage()) {
+        names.push_back(usage.subsystem);
+        localBytes.push_back(usage.bytes);
+    }
+
+    // every rank must report the same subsystems
+    const int numberValues = (int)localBytes.size();
+    int minNumberValues;
+    MPI_Allreduce(&numberValues, &minNumberValues, 1, MPI_INT, MPI_MIN, PETSC_COMM_WORLD) >> checkMpiError;
+    if (minNumberValues != numberValues) {
+        throw std::runtime_error("The MemoryMonitor requires the same subsystems on every rank");
+    }
+
+    int size;
+    MPI_Comm_size(PETSC_COMM_WORLD, &size) >> checkMpiError;
+    std::vector<PetscLogDouble> sums(numberValues);
+    std::vector<PetscLogDouble> maxes(numberValues);
+    MPI_Reduce(localBytes.data(), sums.data(), numberValues, MPIU_PETSCLOGDOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD) >> checkMpiError;
+    MPI_Reduce(localBytes.data(), maxes.data(), numberValues, MPIU_PETSCLOGDOUBLE, MPI_MAX, 0, PETSC_COMM_WORLD) >> checkMpiError;
+
+    // the values are only reduced on the root rank, which is the only rank that prints
+    const PetscLogDouble megabyte = 1.0 / (1024.0 * 1024.0);
+    PetscPrintf(PETSC_COMM_WORLD, "Memory: %04d over %d ranks\n", (int)steps, size) >> checkError;
+    PetscPrintf(PETSC_COMM_WORLD, "  %-24s %12s %12s %12s\n", "", "Total (MB)", "Avg (MB)", "Max (MB)") >> checkError;
+    for (int v = 0; v < numberValues; v++) {
+        if ((std::size_t)v == numberProcessValues) {
+            PetscPrintf(PETSC_COMM_WORLD, "  subsystems (estimated)\n") >> checkError;
+        }
+        if (!mallocTraced && (v == 2 || v == 3)) {
+            PetscPrintf(PETSC_COMM_WORLD, "  %-24s %12s %12s %12s\n", names[v].c_str(), "n/a", "n/a", "n/a") >> checkError;
+            continue;
+        }
+        PetscPrintf(PETSC_COMM_WORLD,
+                    "  %-24s %12.2f %12.2f %12.2f\n",
+                    names[v].c_str(),
+                    (double)(sums[v] * megabyte),
+                    (double)(sums[v] * megabyte / size),
+                    (double)(maxes[v] * megabyte)) >>
+            checkError;
+    }
+}
+
+#include "parser/registrar.hpp"
+REGISTER(ablate::monitors::Monitor, ablate::monitors::MemoryMonitor,
+         "reports the resident and PetscMalloc memory (and high-water) and the estimated memory of each subsystem (total, average, and max over the ranks)",
+         OPT(int, "interval", "report every interval steps (default is every step)"));
@@ -0,0 +1,36 @@
+#ifndef ABLATELIBRARY_MEMORYMONITOR_HPP
+#define ABLATELIBRARY_MEMORYMONITOR_HPP
+#include <petsc.h>
+#include "monitor.hpp"
+
+namespace ablate::monitors {
+/**
+ * Reports the memory used on each rank every interval steps: the resident set size and its high-water, the memory allocated with PetscMalloc and its high-water,
+ * and the (estimated) memory held by each subsystem (mesh/DM, solution and aux vectors, gradients, residual work arrays, chemistry, and particles).  For each
+ * value the total and average over the ranks and the max rank value are reported.  PETSc only counts the PetscMalloc memory when it traces the mallocs
+ * (-malloc_debug, the default for debug builds), otherwise the PetscMalloc values are reported as n/a.
+ */
+class MemoryMonitor : public Monitor {
+   private:
+    // report every interval steps
+    const int interval;
+
+    // true when PETSc traces the mallocs, so the PetscMalloc usage is counted
+    bool mallocTraced;
+
+    static PetscErrorCode ReportMemory(TS ts, PetscInt steps, PetscReal time, Vec u, void* mctx);
+
+    /**
+     * Reduces and prints the memory usage (collective)
+     */
+    void Report(PetscInt steps);
+
+   public:
+    explicit MemoryMonitor(int interval = {});
+
+    void Register(std::shared_ptr<Monitorable>) override {}
+    PetscMonitorFunction GetPetscFunction() override { return ReportMemory; }
+};
+}  // namespace ablate::monitors
+
+#endif  // ABLATELIBRARY_MEMORYMONITOR_HPP
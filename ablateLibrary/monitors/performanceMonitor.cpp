@@ -0,0 +1,96 @@
+#include "performanceMonitor.hpp"
+#include "utilities/logEvents.hpp"
+#include "utilities/mpiError.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::monitors::PerformanceMonitor::PerformanceMonitor(int interval) : interval(interval > 0 ? interval : 1) {
+    // the event performance is only recorded with the default logging (this is already active with -log_view)
+    PetscLogDefaultBegin() >> checkError;
+}
+
+PetscErrorCode ablate::monitors::PerformanceMonitor::ReportPerformance(TS ts, PetscInt steps, PetscReal time, Vec u, void* mctx) {
+    PetscFunctionBeginUser;
+    auto monitor = (ablate::monitors::PerformanceMonitor*)mctx;
+
+    try {
+        // the first call records the starting point of the first report
+        if (!monitor->started || steps - monitor->lastSteps >= monitor->interval) {
+            monitor->Report(steps);
+            monitor->started = true;
+        }
+    } catch (std::exception& e) {
+        SETERRQ(PETSC_COMM_SELF, PETSC_ERR_LIB, e.what());
+    }
+    PetscFunctionReturn(0);
+}
+
+void ablate::monitors::PerformanceMonitor::Report(PetscInt steps) {
+    const auto& events = utilities::LogEvents::GetEvents();
+    const std::size_t numberEvents = events.size();
+
+    // events registered since the last report start from zero
+    lastPerfInfo.resize(numberEvents, PetscEventPerfInfo{});
+
+    // the local change in each event since the last report: sums = {time, count, flops, bytes} and maxes = {time} for each event followed by the wall time
+    std::vector<PetscLogDouble> localSums(4 * numberEvents + 1);
+    std::vector<PetscLogDouble> localMaxes(numberEvents + 1);
+    for (std::size_t e = 0; e < numberEvents; e++) {
+        PetscEventPerfInfo perfInfo;
+        PetscLogEventGetPerfInfo(PETSC_DETERMINE, events[e].event, &perfInfo) >> checkError;
+
+        localSums[4 * e] = localMaxes[e] = perfInfo.time - lastPerfInfo[e].time;
+        localSums[4 * e + 1] = perfInfo.count - lastPerfInfo[e].count;
+        localSums[4 * e + 2] = perfInfo.flops - lastPerfInfo[e].flops;
+        localSums[4 * e + 3] = perfInfo.messageLength - lastPerfInfo[e].messageLength;
+        lastPerfInfo[e] = perfInfo;
+    }
+    PetscLogDouble wallTime;
+    PetscTime(&wallTime) >> checkError;
+    localSums.back() = localMaxes.back() = wallTime - lastWallTime;
+    lastWallTime = wallTime;
+
+    const PetscInt numberSteps = steps - lastSteps;
+    lastSteps = steps;
+    if (!started || numberSteps <= 0) {
+        return;
+    }
+
+    int size;
+    MPI_Comm_size(PETSC_COMM_WORLD, &size) >> checkMpiError;
+    std::vector<PetscLogDouble> sums(localSums.size());
+    std::vector<PetscLogDouble> maxes(localMaxes.size());
+    MPI_Reduce(localSums.data(), sums.data(), (int)localSums.size(), MPIU_PETSCLOGDOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD) >> checkMpiError;
+    MPI_Reduce(localMaxes.data(), maxes.data(), (int)localMaxes.size(), MPIU_PETSCLOGDOUBLE, MPI_MAX, 0, PETSC_COMM_WORLD) >> checkMpiError;
+
+    // the values are only reduced on the root rank, which is the only rank that prints
+    const PetscLogDouble stepTime = maxes.back() / numberSteps;
+    PetscPrintf(PETSC_COMM_WORLD, "Performance: steps %d-%d, %g s/step (max over %d ranks)\n", (int)(steps - numberSteps), (int)steps, (double)stepTime, size) >> checkError;
+    PetscPrintf(PETSC_COMM_WORLD, "  %-24s %12s %12s %9s %8s %10s %12s\n", "Event", "Max (s/step)", "Avg (s/step)", "Max/Avg", "% Step", "GFlop/s", "MB sent/step") >> checkError;
+    for (std::size_t e = 0; e < numberEvents; e++) {
+        if (sums[4 * e + 1] <= 0) {
+            continue;
+        }
+        const PetscLogDouble maxTime = maxes[e] / numberSteps;
+        const PetscLogDouble avgTime = sums[4 * e] / (size * numberSteps);
+        const PetscLogDouble imbalance = avgTime > 0 ? maxTime / avgTime : 1.0;
+        const PetscLogDouble percentStep = stepTime > 0 ? 100.0 * maxTime / stepTime : 0.0;
+        const PetscLogDouble flopRate = maxes[e] > 0 ? sums[4 * e + 2] / maxes[e] * 1.0e-9 : 0.0;
+        const PetscLogDouble bytesSent = sums[4 * e + 3] / numberSteps * 1.0e-6;
+        PetscPrintf(PETSC_COMM_WORLD,
+                    "  %-24s %12.4e %12.4e %9.2f %8.1f %10.3f %12.3f\n",
+                    events[e].name.c_str(),
+                    (double)maxTime,
+                    (double)avgTime,
+                    (double)imbalance,
+                    (double)percentStep,
+                    (double)flopRate,
+                    (double)bytesSent) >>
+            checkError;
+    }
+}
+
+#include "parser/registrar.hpp"
+REGISTER(ablate::monitors::Monitor, ablate::monitors::PerformanceMonitor,
+         "reports the per step time, load imbalance (max/avg across ranks), flop rate, and MPI bytes sent for each flow process, residual phase, chemistry integration, particle operation, and "
+         "output",
+         OPT(int, "interval", "report every interval steps (default is every step)"));
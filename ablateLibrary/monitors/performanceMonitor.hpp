@@ -0,0 +1,39 @@
+#ifndef ABLATELIBRARY_PERFORMANCEMONITOR_HPP
+#define ABLATELIBRARY_PERFORMANCEMONITOR_HPP
+#include <petsc.h>
+#include <vector>
+#include "monitor.hpp"
+
+namespace ablate::monitors {
+/**
+ * Reports the time spent in each ablate log event (flow processes, residual phases, chemistry, particles, and output) every interval steps.  For each event the
+ * max and average time per step across the ranks, the load imbalance (max/avg), the percent of the step, the flop rate, and the MPI bytes sent are reported.
+ * Nested events (e.g. the flow processes inside FVFlux) are included in the time of their parent.
+ */
+class PerformanceMonitor : public Monitor {
+   private:
+    // report every interval steps
+    const int interval;
+
+    // the event performance and wall time at the last report
+    std::vector<PetscEventPerfInfo> lastPerfInfo;
+    PetscLogDouble lastWallTime = 0.0;
+    PetscInt lastSteps = 0;
+    bool started = false;
+
+    static PetscErrorCode ReportPerformance(TS ts, PetscInt steps, PetscReal time, Vec u, void* mctx);
+
+    /**
+     * Reduces and prints the performance of each event since the last report (collective)
+     */
+    void Report(PetscInt steps);
+
+   public:
+    explicit PerformanceMonitor(int interval = {});
+
+    void Register(std::shared_ptr<Monitorable>) override {}
+    PetscMonitorFunction GetPetscFunction() override { return ReportPerformance; }
+};
+}  // namespace ablate::monitors
+
+#endif  // ABLATELIBRARY_PERFORMANCEMONITOR_HPP
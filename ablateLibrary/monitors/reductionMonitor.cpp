@@ -0,0 +1,133 @@
+#include "reductionMonitor.hpp"
+#include <environment/runEnvironment.hpp>
+#include <iomanip>
+#include "utilities/logEvents.hpp"
+#include "utilities/mpiError.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::monitors::ReductionMonitor::ReductionMonitor(std::vector<std::shared_ptr<reductions::Reduction>> reductions, std::string name, int interval)
+    : flowReductions(reductions), name(name.empty() ? "reductions" : name), interval(interval > 0 ? interval : 1) {
+    reduceLogEvent = utilities::LogEvents::Register("ReductionMonitor");
+}
+
+void ablate::monitors::ReductionMonitor::Register(std::shared_ptr<Monitorable> object) {
+    auto flowObject = std::dynamic_pointer_cast<flow::Flow>(object);
+    if (!flowObject) {
+        throw std::invalid_argument("The ReductionMonitor can only reduce a flow");
+    }
+    if (flow) {
+        throw std::invalid_argument("The ReductionMonitor " + name + " is already registered with the flow " + flow->GetName());
+    }
+    flow = flowObject;
+}
+
+PetscErrorCode ablate::monitors::ReductionMonitor::ReduceFlow(TS ts, PetscInt steps, PetscReal time, Vec u, void* mctx) {
+    PetscFunctionBeginUser;
+    auto monitor = (ablate::monitors::ReductionMonitor*)mctx;
+
+    try {
+        if (steps % monitor->interval == 0) {
+            if (!monitor->setup) {
+                monitor->Setup(steps);
+            }
+            monitor->Reduce(steps, time, u);
+        }
+    } catch (std::exception& e) {
+        SETERRQ(PETSC_COMM_SELF, PETSC_ERR_LIB, e.what());
+    }
+    PetscFunctionReturn(0);
+}
+
+void ablate::monitors::ReductionMonitor::Setup(PetscInt steps) {
+    if (!flow) {
+        throw std::runtime_error("The ReductionMonitor " + name + " has not been registered with a flow");
+    }
+    for (auto& reduction : flowReductions) {
+        reduction->Setup(*flow);
+        columnOffsets.push_back(columns.size());
+        const auto reductionColumns = reduction->GetColumns();
+        columns.insert(columns.end(), reductionColumns.begin(), reductionColumns.end());
+    }
+
+    // a restarted run appends to the existing time series
+    int rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD, &rank) >> checkMpiError;
+    if (rank == 0) {
+        const auto filePath = environment::RunEnvironment::Get().GetOutputDirectory() / (name + ".csv");
+        const bool append = steps > 0 && std::filesystem::exists(filePath);
+        file.open(filePath, append ? std::ios::app : std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open the reduction output file " + filePath.string());
+        }
+        if (!append) {
+            file << "step,time";
+            for (const auto& column : columns) {
+                file << "," << column.name;
+            }
+            file << std::endl;
+        }
+        file << std::setprecision(12);
+    }
+    setup = true;
+}
+
+void ablate::monitors::ReductionMonitor::Reduce(PetscInt steps, PetscReal time, Vec u) {
+    utilities::LogEvents::Scope reduceScope(reduceLogEvent);
+
+    // the cell values are read from local vectors so the interior cell of an owned boundary face is always available
+    DM dm = flow->GetDM();
+    Vec localSolution;
+    DMGetLocalVector(dm, &localSolution) >> checkError;
+    DMGlobalToLocalBegin(dm, u, INSERT_VALUES, localSolution) >> checkError;
+    DMGlobalToLocalEnd(dm, u, INSERT_VALUES, localSolution) >> checkError;
+
+    const PetscScalar* solutionArray;
+    const PetscScalar* auxArray = nullptr;
+    VecGetArrayRead(localSolution, &solutionArray) >> checkError;
+    Vec auxField = flow->GetAuxField();
+    if (auxField) {
+        VecGetArrayRead(auxField, &auxArray) >> checkError;
+    }
+
+    std::vector<PetscReal> localValues(columns.size());
+    for (std::size_t r = 0; r < flowReductions.size(); ++r) {
+        flowReductions[r]->Compute(solutionArray, auxArray, localValues.data() + columnOffsets[r]);
+    }
+
+    if (auxField) {
+        VecRestoreArrayRead(auxField, &auxArray) >> checkError;
+    }
+    VecRestoreArrayRead(localSolution, &solutionArray) >> checkError;
+    DMRestoreLocalVector(dm, &localSolution) >> checkError;
+
+    // each column is taken from the reduction with its operation
+    const auto size = (int)localValues.size();
+    std::vector<PetscReal> sums(size), mins(size), maxes(size);
+    MPI_Reduce(localValues.data(), sums.data(), size, MPIU_REAL, MPIU_SUM, 0, PETSC_COMM_WORLD) >> checkMpiError;
+    MPI_Reduce(localValues.data(), mins.data(), size, MPIU_REAL, MPIU_MIN, 0, PETSC_COMM_WORLD) >> checkMpiError;
+    MPI_Reduce(localValues.data(), maxes.data(), size, MPIU_REAL, MPIU_MAX, 0, PETSC_COMM_WORLD) >> checkMpiError;
+
+    if (file.is_open()) {
+        file << steps << "," << time;
+        for (std::size_t c = 0; c < columns.size(); ++c) {
+            switch (columns[c].operation) {
+                case reductions::Reduction::Operation::SUM:
+                    file << "," << sums[c];
+                    break;
+                case reductions::Reduction::Operation::MIN:
+                    file << "," << mins[c];
+                    break;
+                case reductions::Reduction::Operation::MAX:
+                    file << "," << maxes[c];
+                    break;
+            }
+        }
+        file << std::endl;
+    }
+}
+
+#include "parser/registrar.hpp"
+REGISTER(ablate::monitors::Monitor, ablate::monitors::ReductionMonitor, "writes volume and boundary integrals, extrema, and point probes of the flow to a csv time series",
+         ARG(std::vector<ablate::monitors::reductions::Reduction>, "reductions", "the values to compute"),
+         OPT(std::string, "name", "the name of the csv file in the output directory (defaults to reductions)"),
+         OPT(int, "interval", "evaluate every interval steps (default is every step)"));
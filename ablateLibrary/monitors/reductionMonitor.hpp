@@ -0,0 +1,58 @@
+#ifndef ABLATELIBRARY_REDUCTIONMONITOR_HPP
+#define ABLATELIBRARY_REDUCTIONMONITOR_HPP
+#include <petsc.h>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "flow/flow.hpp"
+#include "monitor.hpp"
+#include "reductions/reduction.hpp"
+
+namespace ablate::monitors {
+/**
+ * Evaluates a set of reductions (volume and boundary integrals, extrema, and point probes) of the flow every interval steps and appends them as a row of a csv
+ * time series (name.csv in the output directory) written by the root rank.  The reductions cache their cells, faces, and geometry on the first call, so each
+ * evaluation is a single pass over the cells and three small reductions across the ranks.
+ */
+class ReductionMonitor : public Monitor {
+   private:
+    const std::vector<std::shared_ptr<reductions::Reduction>> flowReductions;
+    const std::string name;
+    const int interval;
+
+    std::shared_ptr<flow::Flow> flow;
+
+    // set up on the first call
+    bool setup = false;
+    std::vector<reductions::Reduction::Column> columns;
+    std::vector<std::size_t> columnOffsets;
+    std::ofstream file;
+
+    // profiles each evaluation
+    PetscLogEvent reduceLogEvent;
+
+    static PetscErrorCode ReduceFlow(TS ts, PetscInt steps, PetscReal time, Vec u, void* mctx);
+
+    /**
+     * Sets up the reductions and opens the time series (collective)
+     */
+    void Setup(PetscInt steps);
+
+    /**
+     * Computes each reduction and writes the row (collective)
+     */
+    void Reduce(PetscInt steps, PetscReal time, Vec u);
+
+   public:
+    explicit ReductionMonitor(std::vector<std::shared_ptr<reductions::Reduction>> reductions, std::string name = {}, int interval = {});
+
+    /**
+     * Sets the flow to reduce.  Only one flow can be registered.
+     */
+    void Register(std::shared_ptr<Monitorable>) override;
+    PetscMonitorFunction GetPetscFunction() override { return ReduceFlow; }
+};
+}  // namespace ablate::monitors
+
+#endif  // ABLATELIBRARY_REDUCTIONMONITOR_HPP
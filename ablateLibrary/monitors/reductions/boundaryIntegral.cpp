@@ -0,0 +1,116 @@
+#include "boundaryIntegral.hpp"
+#include <algorithm>
+#include "utilities/petscError.hpp"
+
+ablate::monitors::reductions::BoundaryIntegral::BoundaryIntegral(std::string field, std::vector<int> labelIds, std::string labelName, std::vector<int> components, bool normal)
+    : Reduction(field, components), labelName(labelName.empty() ? "Face Sets" : labelName), labelIds(labelIds), normal(normal) {}
+
+void ablate::monitors::reductions::BoundaryIntegral::Setup(flow::Flow& flow) {
+    Reduction::Setup(flow);
+
+    DM dm = flow.GetDM();
+    DMGetDimension(dm, &dim) >> checkError;
+    if (normal && (PetscInt)components.size() != dim) {
+        throw std::invalid_argument("The normal boundary integral of " + GetFieldName() + " requires one component per dimension");
+    }
+
+    DMLabel label;
+    DMGetLabel(dm, labelName.c_str(), &label) >> checkError;
+    if (!label) {
+        throw std::invalid_argument("Cannot locate label " + labelName + " for the boundary integral");
+    }
+
+    // only the rank owning the interior cell includes the face
+    const auto ownedCells = GetOwnedCells(dm);
+
+    faceCells.clear();
+    faceAreas.clear();
+    faceNormals.clear();
+    for (const auto labelId : labelIds) {
+        IS faceIS;
+        DMLabelGetStratumIS(label, labelId, &faceIS) >> checkError;
+        if (!faceIS) {
+            continue;
+        }
+        PetscInt numberFaces;
+        const PetscInt* faces;
+        ISGetLocalSize(faceIS, &numberFaces) >> checkError;
+        ISGetIndices(faceIS, &faces) >> checkError;
+        for (PetscInt f = 0; f < numberFaces; ++f) {
+            const PetscInt face = faces[f];
+            PetscInt height;
+            DMPlexGetPointHeight(dm, face, &height) >> checkError;
+            if (height != 1) {
+                continue;
+            }
+
+            PetscInt supportSize;
+            const PetscInt* support;
+            DMPlexGetSupportSize(dm, face, &supportSize) >> checkError;
+            DMPlexGetSupport(dm, face, &support) >> checkError;
+            PetscInt cell = -1;
+            for (PetscInt s = 0; s < supportSize; ++s) {
+                if (std::binary_search(ownedCells.begin(), ownedCells.end(), support[s])) {
+                    cell = support[s];
+                }
+            }
+            if (cell < 0) {
+                continue;
+            }
+
+            // orient the normal out of the interior cell
+            PetscReal area, faceCentroid[3], faceNormal[3], cellCentroid[3];
+            DMPlexComputeCellGeometryFVM(dm, face, &area, faceCentroid, faceNormal) >> checkError;
+            DMPlexComputeCellGeometryFVM(dm, cell, NULL, cellCentroid, NULL) >> checkError;
+            PetscReal direction = 0.0;
+            for (PetscInt d = 0; d < dim; ++d) {
+                direction += faceNormal[d] * (faceCentroid[d] - cellCentroid[d]);
+            }
+            const PetscReal sign = direction < 0.0 ? -1.0 : 1.0;
+
+            faceCells.push_back(cell);
+            faceAreas.push_back(area);
+            for (PetscInt d = 0; d < dim; ++d) {
+                faceNormals.push_back(sign * area * faceNormal[d]);
+            }
+        }
+        ISRestoreIndices(faceIS, &faces) >> checkError;
+        ISDestroy(&faceIS) >> checkError;
+    }
+}
+
+std::vector<ablate::monitors::reductions::Reduction::Column> ablate::monitors::reductions::BoundaryIntegral::GetColumns() const {
+    if (normal) {
+        return {Column{.name = "normalIntegral_" + GetFieldName(), .operation = Operation::SUM}};
+    }
+    std::vector<Column> columns;
+    for (const auto& name : GetComponentColumnNames("boundaryIntegral")) {
+        columns.push_back(Column{.name = name, .operation = Operation::SUM});
+    }
+    return columns;
+}
+
+void ablate::monitors::reductions::BoundaryIntegral::Compute(const PetscScalar* solution, const PetscScalar* aux, PetscReal* values) const {
+    const std::size_t numberColumns = normal ? 1 : components.size();
+    for (std::size_t i = 0; i < numberColumns; ++i) {
+        values[i] = 0.0;
+    }
+    for (std::size_t f = 0; f < faceCells.size(); ++f) {
+        const PetscScalar* cellValues = GetPointValues(faceCells[f], solution, aux);
+        if (normal) {
+            for (PetscInt d = 0; d < dim; ++d) {
+                values[0] += PetscRealPart(cellValues[components[d]]) * faceNormals[f * dim + d];
+            }
+        } else {
+            for (std::size_t i = 0; i < components.size(); ++i) {
+                values[i] += PetscRealPart(cellValues[components[i]]) * faceAreas[f];
+            }
+        }
+    }
+}
+
+#include "parser/registrar.hpp"
+REGISTER(ablate::monitors::reductions::Reduction, ablate::monitors::reductions::BoundaryIntegral, "integrates a flow or aux field over labeled boundary faces",
+         ARG(std::string, "field", "the solution or aux field"), ARG(std::vector<int>, "labelIds", "the label values of the boundary faces"),
+         OPT(std::string, "labelName", "the face label (defaults to Face Sets)"), OPT(std::vector<int>, "components", "the components to integrate (defaults to all)"),
+         OPT(bool, "normal", "integrate the outward normal component of the vector formed by the components (one per dimension) instead of each component (default false)"));
@@ -0,0 +1,32 @@
+#ifndef ABLATELIBRARY_BOUNDARYINTEGRAL_HPP
+#define ABLATELIBRARY_BOUNDARYINTEGRAL_HPP
+#include "reduction.hpp"
+
+namespace ablate::monitors::reductions {
+/**
+ * Integrates the field over the labeled boundary faces using the value in the interior cell of each face.  By default each component is integrated over the
+ * face area.  When normal is set the components (one per dimension) are treated as a vector and its outward normal component is integrated, e.g. the mass flow
+ * rate through an outlet from the momentum components of the euler field.
+ */
+class BoundaryIntegral : public Reduction {
+   private:
+    const std::string labelName;
+    const std::vector<int> labelIds;
+    const bool normal;
+
+    // the boundary faces with an owned interior cell, the interior cell, and the face area times the outward unit normal (dim values per face)
+    std::vector<PetscInt> faceCells;
+    std::vector<PetscReal> faceAreas;
+    std::vector<PetscReal> faceNormals;
+    PetscInt dim = 0;
+
+   public:
+    BoundaryIntegral(std::string field, std::vector<int> labelIds, std::string labelName = {}, std::vector<int> components = {}, bool normal = false);
+
+    void Setup(flow::Flow& flow) override;
+    std::vector<Column> GetColumns() const override;
+    void Compute(const PetscScalar* solution, const PetscScalar* aux, PetscReal* values) const override;
+};
+}  // namespace ablate::monitors::reductions
+
+#endif  // ABLATELIBRARY_BOUNDARYINTEGRAL_HPP
@@ -0,0 +1,41 @@
+#include "extrema.hpp"
+#include <algorithm>
+
+ablate::monitors::reductions::Extrema::Extrema(std::string field, std::vector<int> components) : Reduction(field, components) {}
+
+void ablate::monitors::reductions::Extrema::Setup(flow::Flow& flow) {
+    Reduction::Setup(flow);
+    cells = GetOwnedCells(flow.GetDM());
+}
+
+std::vector<ablate::monitors::reductions::Reduction::Column> ablate::monitors::reductions::Extrema::GetColumns() const {
+    // the min of each component followed by the max of each component
+    std::vector<Column> columns;
+    for (const auto& name : GetComponentColumnNames("min")) {
+        columns.push_back(Column{.name = name, .operation = Operation::MIN});
+    }
+    for (const auto& name : GetComponentColumnNames("max")) {
+        columns.push_back(Column{.name = name, .operation = Operation::MAX});
+    }
+    return columns;
+}
+
+void ablate::monitors::reductions::Extrema::Compute(const PetscScalar* solution, const PetscScalar* aux, PetscReal* values) const {
+    const std::size_t numberComponents = components.size();
+    for (std::size_t i = 0; i < numberComponents; ++i) {
+        values[i] = PETSC_MAX_REAL;
+        values[numberComponents + i] = PETSC_MIN_REAL;
+    }
+    for (const auto cell : cells) {
+        const PetscScalar* cellValues = GetPointValues(cell, solution, aux);
+        for (std::size_t i = 0; i < numberComponents; ++i) {
+            const PetscReal value = PetscRealPart(cellValues[components[i]]);
+            values[i] = std::min(values[i], value);
+            values[numberComponents + i] = std::max(values[numberComponents + i], value);
+        }
+    }
+}
+
+#include "parser/registrar.hpp"
+REGISTER(ablate::monitors::reductions::Reduction, ablate::monitors::reductions::Extrema, "reports the min and max cell value of each component of a flow or aux field",
+         ARG(std::string, "field", "the solution or aux field"), OPT(std::vector<int>, "components", "the components to report (defaults to all)"));
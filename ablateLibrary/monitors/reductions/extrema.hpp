@@ -0,0 +1,22 @@
+#ifndef ABLATELIBRARY_EXTREMA_HPP
+#define ABLATELIBRARY_EXTREMA_HPP
+#include "reduction.hpp"
+
+namespace ablate::monitors::reductions {
+/**
+ * Reports the minimum and maximum cell value of each component of the field, e.g. the min/max temperature
+ */
+class Extrema : public Reduction {
+   private:
+    std::vector<PetscInt> cells;
+
+   public:
+    explicit Extrema(std::string field, std::vector<int> components = {});
+
+    void Setup(flow::Flow& flow) override;
+    std::vector<Column> GetColumns() const override;
+    void Compute(const PetscScalar* solution, const PetscScalar* aux, PetscReal* values) const override;
+};
+}  // namespace ablate::monitors::reductions
+
+#endif  // ABLATELIBRARY_EXTREMA_HPP
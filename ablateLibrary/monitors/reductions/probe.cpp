@@ -0,0 +1,68 @@
+#include "probe.hpp"
+#include <algorithm>
+#include "utilities/mpiError.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::monitors::reductions::Probe::Probe(std::string name, std::vector<double> location, std::string field, std::vector<int> components)
+    : Reduction(field, components), name(name), location(location) {}
+
+void ablate::monitors::reductions::Probe::Setup(flow::Flow& flow) {
+    Reduction::Setup(flow);
+
+    DM dm = flow.GetDM();
+    PetscInt dim;
+    DMGetDimension(dm, &dim) >> checkError;
+    if ((PetscInt)location.size() != dim) {
+        throw std::invalid_argument("The location of probe " + name + " must have " + std::to_string(dim) + " values");
+    }
+
+    // locate the cell holding the point on each rank
+    std::vector<PetscScalar> coordinates(location.begin(), location.end());
+    Vec pointVec;
+    VecCreateSeqWithArray(PETSC_COMM_SELF, dim, dim, coordinates.data(), &pointVec) >> checkError;
+    PetscSF cellSF = NULL;
+    DMLocatePoints(dm, pointVec, DM_POINTLOCATION_NONE, &cellSF) >> checkError;
+    const PetscSFNode* foundCells;
+    PetscSFGetGraph(cellSF, NULL, NULL, NULL, &foundCells) >> checkError;
+    const PetscInt foundCell = foundCells[0].index;
+    PetscSFDestroy(&cellSF) >> checkError;
+    VecDestroy(&pointVec) >> checkError;
+
+    // a point on a shared face (or in an overlap cell) may be found by more than one rank, so only owned cells are kept
+    const auto ownedCells = GetOwnedCells(dm);
+    const bool owned = foundCell >= 0 && std::binary_search(ownedCells.begin(), ownedCells.end(), foundCell);
+
+    // the lowest rank owning a cell holding the point reports the probe
+    MPI_Comm comm = PetscObjectComm((PetscObject)dm);
+    int rank, size;
+    MPI_Comm_rank(comm, &rank) >> checkMpiError;
+    MPI_Comm_size(comm, &size) >> checkMpiError;
+    int localOwner = owned ? rank : size;
+    int owner;
+    MPI_Allreduce(&localOwner, &owner, 1, MPI_INT, MPI_MIN, comm) >> checkMpiError;
+    if (owner == size) {
+        throw std::invalid_argument("The location of probe " + name + " is not inside the flow domain");
+    }
+    cell = owner == rank ? foundCell : -1;
+}
+
+std::vector<ablate::monitors::reductions::Reduction::Column> ablate::monitors::reductions::Probe::GetColumns() const {
+    std::vector<Column> columns;
+    for (const auto& columnName : GetComponentColumnNames(name)) {
+        columns.push_back(Column{.name = columnName, .operation = Operation::SUM});
+    }
+    return columns;
+}
+
+void ablate::monitors::reductions::Probe::Compute(const PetscScalar* solution, const PetscScalar* aux, PetscReal* values) const {
+    // only the rank owning the cell contributes to the sum
+    const PetscScalar* cellValues = cell >= 0 ? GetPointValues(cell, solution, aux) : nullptr;
+    for (std::size_t i = 0; i < components.size(); ++i) {
+        values[i] = cellValues ? PetscRealPart(cellValues[components[i]]) : 0.0;
+    }
+}
+
+#include "parser/registrar.hpp"
+REGISTER(ablate::monitors::reductions::Reduction, ablate::monitors::reductions::Probe, "reports a flow or aux field at a point (the value in the cell holding the point)",
+         ARG(std::string, "name", "the probe name used in the column names"), ARG(std::vector<double>, "location", "the probe location"),
+         ARG(std::string, "field", "the solution or aux field"), OPT(std::vector<int>, "components", "the components to report (defaults to all)"));
@@ -0,0 +1,26 @@
+#ifndef ABLATELIBRARY_PROBE_HPP
+#define ABLATELIBRARY_PROBE_HPP
+#include "reduction.hpp"
+
+namespace ablate::monitors::reductions {
+/**
+ * Reports the field at a point using the value of the cell holding the point.  The cell (and its owning rank) is located once during setup with DMLocatePoints.
+ */
+class Probe : public Reduction {
+   private:
+    const std::string name;
+    const std::vector<double> location;
+
+    // the local cell holding the point, or -1 when another rank owns the cell
+    PetscInt cell = -1;
+
+   public:
+    Probe(std::string name, std::vector<double> location, std::string field, std::vector<int> components = {});
+
+    void Setup(flow::Flow& flow) override;
+    std::vector<Column> GetColumns() const override;
+    void Compute(const PetscScalar* solution, const PetscScalar* aux, PetscReal* values) const override;
+};
+}  // namespace ablate::monitors::reductions
+
+#endif  // ABLATELIBRARY_PROBE_HPP
@@ -0,0 +1,80 @@
+#include "reduction.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::monitors::reductions::Reduction::Reduction(std::string fieldName, std::vector<int> components) : fieldName(fieldName), requestedComponents(components) {}
+
+void ablate::monitors::reductions::Reduction::Setup(flow::Flow& flow) {
+    const flow::FlowFieldDescriptor* descriptor;
+    if (auto id = flow.GetFieldId(fieldName)) {
+        auxField = false;
+        fieldId = id.value();
+        fieldDm = flow.GetDM();
+        descriptor = &flow.GetFieldDescriptors()[fieldId];
+    } else if (auto auxId = flow.GetAuxFieldId(fieldName)) {
+        auxField = true;
+        fieldId = auxId.value();
+        fieldDm = flow.GetAuxDM();
+        descriptor = &flow.GetAuxFieldDescriptors()[fieldId];
+    } else {
+        throw std::invalid_argument("Cannot locate field " + fieldName + " in flow " + flow.GetName() + " for the reduction");
+    }
+    if (descriptor->fieldType != flow::FieldType::FV) {
+        throw std::invalid_argument("The reduction of " + fieldName + " requires a finite volume field");
+    }
+
+    components.clear();
+    if (requestedComponents.empty()) {
+        for (PetscInt c = 0; c < descriptor->components; c++) {
+            components.push_back(c);
+        }
+    } else {
+        for (const auto c : requestedComponents) {
+            if (c < 0 || c >= descriptor->components) {
+                throw std::invalid_argument("The component " + std::to_string(c) + " is not valid for the field " + fieldName);
+            }
+            components.push_back(c);
+        }
+    }
+
+    // name the components by index when the field does not name them
+    componentNames.clear();
+    for (const auto c : components) {
+        if ((std::size_t)c < descriptor->componentNames.size()) {
+            componentNames.push_back(descriptor->componentNames[c]);
+        } else {
+            componentNames.push_back(descriptor->components > 1 ? std::to_string(c) : "");
+        }
+    }
+}
+
+const PetscScalar* ablate::monitors::reductions::Reduction::GetPointValues(PetscInt point, const PetscScalar* solution, const PetscScalar* aux) const {
+    const PetscScalar* values = nullptr;
+    DMPlexPointLocalFieldRead(fieldDm, point, fieldId, auxField ? aux : solution, &values) >> checkError;
+    return values;
+}
+
+std::vector<std::string> ablate::monitors::reductions::Reduction::GetComponentColumnNames(const std::string& prefix) const {
+    std::vector<std::string> names;
+    for (const auto& componentName : componentNames) {
+        names.push_back(prefix + "_" + fieldName + (componentName.empty() ? "" : "_" + componentName));
+    }
+    return names;
+}
+
+std::vector<PetscInt> ablate::monitors::reductions::Reduction::GetOwnedCells(DM dm) {
+    PetscInt cStart, cEnd;
+    DMPlexGetSimplexOrBoxCells(dm, 0, &cStart, &cEnd) >> checkError;
+    IS globalCellNumbers;
+    const PetscInt* globalCellNumber;
+    DMPlexGetCellNumbering(dm, &globalCellNumbers) >> checkError;
+    ISGetIndices(globalCellNumbers, &globalCellNumber) >> checkError;
+
+    std::vector<PetscInt> cells;
+    for (PetscInt c = cStart; c < cEnd; ++c) {
+        if (globalCellNumber[c - cStart] >= 0) {
+            cells.push_back(c);
+        }
+    }
+    ISRestoreIndices(globalCellNumbers, &globalCellNumber) >> checkError;
+    return cells;
+}
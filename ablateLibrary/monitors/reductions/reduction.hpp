@@ -0,0 +1,80 @@
+#ifndef ABLATELIBRARY_REDUCTION_HPP
+#define ABLATELIBRARY_REDUCTION_HPP
+#include <petsc.h>
+#include <string>
+#include <vector>
+#include "flow/flow.hpp"
+
+namespace ablate::monitors::reductions {
+/**
+ * A set of values (columns) reduced over a finite volume flow field each time the ReductionMonitor reports.  Each rank computes the contribution of the cells (or faces) it
+ * owns and the contributions are combined across the ranks with each column's operation.  The field may be a solution or an aux field.
+ */
+class Reduction {
+   public:
+    enum class Operation { SUM, MIN, MAX };
+
+    struct Column {
+        std::string name;
+        Operation operation;
+    };
+
+   private:
+    const std::string fieldName;
+    const std::vector<int> requestedComponents;
+
+   protected:
+    // the located field (set during setup)
+    bool auxField = false;
+    PetscInt fieldId = -1;
+    DM fieldDm = nullptr;
+    std::vector<PetscInt> components;
+    std::vector<std::string> componentNames;
+
+    /**
+     * Returns the field values at a local point from the local solution or aux array
+     */
+    const PetscScalar* GetPointValues(PetscInt point, const PetscScalar* solution, const PetscScalar* aux) const;
+
+    /**
+     * Returns the column name for each selected component, i.e. prefix_field_component
+     */
+    std::vector<std::string> GetComponentColumnNames(const std::string& prefix) const;
+
+    /**
+     * Returns the local cells owned by this rank (excluding finite volume ghost cells)
+     */
+    static std::vector<PetscInt> GetOwnedCells(DM dm);
+
+    const std::string& GetFieldName() const { return fieldName; }
+
+   public:
+    /**
+     * @param fieldName the solution or aux field
+     * @param components the components to reduce (defaults to all components)
+     */
+    Reduction(std::string fieldName, std::vector<int> components);
+    virtual ~Reduction() = default;
+
+    /**
+     * Locates the field and caches any geometry needed to compute the values (collective).  This is called once before the first compute.
+     * @param flow
+     */
+    virtual void Setup(flow::Flow& flow);
+
+    /**
+     * The columns computed by this reduction
+     */
+    virtual std::vector<Column> GetColumns() const = 0;
+
+    /**
+     * Computes the local contribution to each column
+     * @param solution the local solution array
+     * @param aux the local aux array (may be null)
+     * @param values the local value of each column
+     */
+    virtual void Compute(const PetscScalar* solution, const PetscScalar* aux, PetscReal* values) const = 0;
+};
+}  // namespace ablate::monitors::reductions
+
+#endif  // ABLATELIBRARY_REDUCTION_HPP
@@ -0,0 +1,39 @@
+#include "volumeIntegral.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::monitors::reductions::VolumeIntegral::VolumeIntegral(std::string field, std::vector<int> components) : Reduction(field, components) {}
+
+void ablate::monitors::reductions::VolumeIntegral::Setup(flow::Flow& flow) {
+    Reduction::Setup(flow);
+
+    cells = GetOwnedCells(flow.GetDM());
+    volumes.resize(cells.size());
+    for (std::size_t c = 0; c < cells.size(); ++c) {
+        DMPlexComputeCellGeometryFVM(flow.GetDM(), cells[c], &volumes[c], NULL, NULL) >> checkError;
+    }
+}
+
+std::vector<ablate::monitors::reductions::Reduction::Column> ablate::monitors::reductions::VolumeIntegral::GetColumns() const {
+    std::vector<Column> columns;
+    for (const auto& name : GetComponentColumnNames("integral")) {
+        columns.push_back(Column{.name = name, .operation = Operation::SUM});
+    }
+    return columns;
+}
+
+void ablate::monitors::reductions::VolumeIntegral::Compute(const PetscScalar* solution, const PetscScalar* aux, PetscReal* values) const {
+    for (std::size_t i = 0; i < components.size(); ++i) {
+        values[i] = 0.0;
+    }
+    for (std::size_t c = 0; c < cells.size(); ++c) {
+        const PetscScalar* cellValues = GetPointValues(cells[c], solution, aux);
+        for (std::size_t i = 0; i < components.size(); ++i) {
+            values[i] += PetscRealPart(cellValues[components[i]]) * volumes[c];
+        }
+    }
+    PetscLogFlops(2.0 * cells.size() * components.size()) >> checkError;
+}
+
+#include "parser/registrar.hpp"
+REGISTER(ablate::monitors::reductions::Reduction, ablate::monitors::reductions::VolumeIntegral, "integrates each component of a flow or aux field over the domain",
+         ARG(std::string, "field", "the solution or aux field"), OPT(std::vector<int>, "components", "the components to integrate (defaults to all)"));
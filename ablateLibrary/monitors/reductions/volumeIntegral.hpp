@@ -0,0 +1,24 @@
+#ifndef ABLATELIBRARY_VOLUMEINTEGRAL_HPP
+#define ABLATELIBRARY_VOLUMEINTEGRAL_HPP
+#include "reduction.hpp"
+
+namespace ablate::monitors::reductions {
+/**
+ * Integrates each component of the field over the domain using the cell averages, e.g. the total mass, energy, or species inventory
+ */
+class VolumeIntegral : public Reduction {
+   private:
+    // the owned cells and their volumes
+    std::vector<PetscInt> cells;
+    std::vector<PetscReal> volumes;
+
+   public:
+    explicit VolumeIntegral(std::string field, std::vector<int> components = {});
+
+    void Setup(flow::Flow& flow) override;
+    std::vector<Column> GetColumns() const override;
+    void Compute(const PetscScalar* solution, const PetscScalar* aux, PetscReal* values) const override;
+};
+}  // namespace ablate::monitors::reductions
+
+#endif  // ABLATELIBRARY_VOLUMEINTEGRAL_HPP
@@ -2,8 +2,11 @@
 #include <utilities/petscError.hpp>
 #include "mathFunctions/mathFunction.hpp"
 
-ablate::monitors::SolutionErrorMonitor::SolutionErrorMonitor(ablate::monitors::SolutionErrorMonitor::Scope errorScope, ablate::monitors::SolutionErrorMonitor::Norm normType)
-    : errorScope(errorScope), normType(normType) {}
+ablate::monitors::SolutionErrorMonitor::SolutionErrorMonitor(ablate::monitors::SolutionErrorMonitor::Scope errorScope, ablate::monitors::SolutionErrorMonitor::Norm normType, int interval,
+                                                             bool cellCenters)
+    : interval(interval), cellCenters(cellCenters), errorScope(errorScope), normType(normType) {}
+
+void ablate::monitors::SolutionErrorMonitor::Register(std::shared_ptr<Monitorable> monitorable) { flow = std::dynamic_pointer_cast<ablate::flow::Flow>(monitorable); }
 
 PetscErrorCode ablate::monitors::SolutionErrorMonitor::MonitorError(TS ts, PetscInt step, PetscReal crtime, Vec u, void* ctx) {
     PetscFunctionBeginUser;
@@ -25,6 +28,14 @@ PetscErrorCode ablate::monitors::SolutionErrorMonitor::MonitorError(TS ts, Petsc
 
     SolutionErrorMonitor* errorMonitor = (SolutionErrorMonitor*)ctx;
 
+    // only compute the error every interval steps and at the end of the solve (however it ended)
+    TSConvergedReason reason;
+    ierr = TSGetConvergedReason(ts, &reason);
+    CHKERRQ(ierr);
+    if (step != 0 && errorMonitor->interval != 0 && (step % errorMonitor->interval != 0) && reason == TS_CONVERGED_ITERATING) {
+        PetscFunctionReturn(0);
+    }
+
     std::vector<PetscReal> ferrors;
     try {
         ferrors = errorMonitor->ComputeError(ts, crtime, u);
@@ -97,10 +108,16 @@ std::vector<PetscReal> ablate::monitors::SolutionErrorMonitor::ComputeError(TS t
         totalComponents += numberComponentsPerField[f];
     }
 
-    // Create an vector to hold the exact solution
+    // Create an vector to hold the exact solution, the flow reuses the projection of a time independent exact solution
     Vec exactVec;
     VecDuplicate(u, &exactVec) >> checkError;
-    DMProjectFunction(dm, time, &exactFuncs[0], &exactCtxs[0], INSERT_ALL_VALUES, exactVec) >> checkError;
+    if (flow) {
+        flow->ProjectExactSolution(time, exactVec, cellCenters);
+    } else if (cellCenters) {
+        throw std::invalid_argument("The cell center exact solution requires the SolutionErrorMonitor to be registered with a flow");
+    } else {
+        DMProjectFunction(dm, time, &exactFuncs[0], &exactCtxs[0], INSERT_ALL_VALUES, exactVec) >> checkError;
+    }
 
     // Compute the error
     VecAXPY(exactVec, -1.0, u) >> checkError;
@@ -202,4 +219,6 @@ std::istream& ablate::monitors::operator>>(std::istream& is, ablate::monitors::S
 #include "parser/registrar.hpp"
 REGISTER(ablate::monitors::Monitor, ablate::monitors::SolutionErrorMonitor, "Computes and reports the error every time step",
          ENUM(ablate::monitors::SolutionErrorMonitor::Scope, "scope", "how the error should be calculated ('vector', 'component')"),
-         ENUM(ablate::monitors::SolutionErrorMonitor::Norm, "type", "norm type ('l2', 'linf', 'l2_norm')"));
+         ENUM(ablate::monitors::SolutionErrorMonitor::Norm, "type", "norm type ('l2', 'linf', 'l2_norm')"),
+         OPT(int, "interval", "how often to compute the error (default is every timestep)"),
+         OPT(bool, "cellCenters", "evaluate the exact solution of finite volume fields at the cell centroids without quadrature (default is false)"));
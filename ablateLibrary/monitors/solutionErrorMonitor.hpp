@@ -1,7 +1,9 @@
 #ifndef ABLATELIBRARY_SOLUTIONERRORMONITOR_HPP
 #define ABLATELIBRARY_SOLUTIONERRORMONITOR_HPP
 #include <iostream>
+#include <memory>
 #include <vector>
+#include "flow/flow.hpp"
 #include "monitor.hpp"
 namespace ablate::monitors {
 
@@ -9,15 +11,24 @@ class SolutionErrorMonitor : public Monitor {
    private:
     static PetscErrorCode MonitorError(TS ts, PetscInt step, PetscReal crtime, Vec u, void* ctx);
 
+    // compute the error every interval steps (0 computes every step)
+    const int interval;
+
+    // evaluate the exact solution of finite volume fields at the cell centroids
+    const bool cellCenters;
+
+    // the flow provides the (cached) exact solution projection when registered
+    std::shared_ptr<flow::Flow> flow;
+
    public:
     enum class Scope { VECTOR, COMPONENT };
     Scope errorScope;
     enum class Norm { L2, LINF, L2_NORM };
     Norm normType;
 
-    SolutionErrorMonitor(Scope errorScope, Norm normType);
+    SolutionErrorMonitor(Scope errorScope, Norm normType, int interval = {}, bool cellCenters = false);
 
-    void Register(std::shared_ptr<Monitorable>) override {}
+    void Register(std::shared_ptr<Monitorable>) override;
     PetscMonitorFunction GetPetscFunction() override { return MonitorError; }
 
     std::vector<PetscReal> ComputeError(TS ts, PetscReal time, Vec u);
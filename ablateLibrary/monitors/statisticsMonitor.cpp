@@ -0,0 +1,80 @@
+#include "statisticsMonitor.hpp"
+#include "utilities/logEvents.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::monitors::StatisticsMonitor::StatisticsMonitor(std::vector<std::string> fields, int interval, std::string name, double startTime)
+    : fields(fields), name(name.empty() ? "statistics" : name), interval(interval), startTime(startTime) {
+    if (interval <= 0) {
+        throw std::invalid_argument("The StatisticsMonitor requires a positive output interval");
+    }
+    accumulateLogEvent = utilities::LogEvents::Register("StatisticsAccumulate");
+}
+
+void ablate::monitors::StatisticsMonitor::Register(std::shared_ptr<Monitorable> object) {
+    auto flow = std::dynamic_pointer_cast<flow::Flow>(object);
+    if (!flow) {
+        throw std::invalid_argument("The StatisticsMonitor can only sample a flow");
+    }
+    if (statistics) {
+        throw std::invalid_argument("The StatisticsMonitor " + name + " is already registered");
+    }
+    statistics = std::make_shared<FlowStatistics>(name, flow, fields);
+    outputMonitor = std::make_shared<Hdf5Monitor>();
+    outputMonitor->Register(statistics);
+}
+
+PetscErrorCode ablate::monitors::StatisticsMonitor::AccumulateStatistics(TS ts, PetscInt steps, PetscReal time, Vec u, void* mctx) {
+    PetscFunctionBeginUser;
+    auto monitor = (ablate::monitors::StatisticsMonitor*)mctx;
+    PetscErrorCode ierr;
+
+    try {
+        if (!monitor->statistics) {
+            throw std::runtime_error("The StatisticsMonitor " + monitor->name + " has not been registered with a flow");
+        }
+        if (!monitor->started) {
+            monitor->started = true;
+            monitor->previousTime = time;
+            PetscFunctionReturn(0);
+        }
+
+        // the part of the step after the start time is the weight of the sample
+        const PetscReal sampleWeight = time - PetscMax(monitor->previousTime, (PetscReal)monitor->startTime);
+        monitor->previousTime = time;
+        if (sampleWeight > 0.0) {
+            utilities::LogEvents::Scope accumulateScope(monitor->accumulateLogEvent);
+            monitor->statistics->Accumulate(u, sampleWeight);
+        }
+    } catch (std::exception& e) {
+        SETERRQ(PETSC_COMM_SELF, PETSC_ERR_LIB, e.what());
+    }
+
+    // the output monitor writes every time it is called, the final statistics are written at the end of the solve
+    TSConvergedReason reason;
+    ierr = TSGetConvergedReason(ts, &reason);
+    CHKERRQ(ierr);
+    if ((steps % monitor->interval == 0 || reason != TS_CONVERGED_ITERATING) && monitor->statistics->GetSamples() > 0) {
+        ierr = monitor->outputMonitor->GetPetscFunction()(ts, steps, time, u, monitor->outputMonitor->GetContext());
+        CHKERRQ(ierr);
+    }
+    PetscFunctionReturn(0);
+}
+
+void ablate::monitors::StatisticsMonitor::Save(Checkpoint& checkpoint) {
+    if (statistics) {
+        statistics->Save(checkpoint);
+    }
+}
+
+void ablate::monitors::StatisticsMonitor::Restore(Checkpoint& checkpoint, PetscReal time) {
+    if (!statistics) {
+        throw std::runtime_error("The StatisticsMonitor " + name + " must be registered before it is restored");
+    }
+    statistics->Restore(checkpoint, time);
+}
+
+#include "parser/registrar.hpp"
+REGISTER(ablate::monitors::Monitor, ablate::monitors::StatisticsMonitor, "accumulates the running time weighted mean and rms of flow fields and writes only the statistics",
+         ARG(std::vector<std::string>, "fields", "the solution or aux fields to sample, a single component is selected with field.component"),
+         ARG(int, "interval", "write the statistics every interval steps"), OPT(std::string, "name", "the name of the statistics output file (defaults to statistics)"),
+         OPT(double, "startTime", "only sample after this time (default 0)"));
@@ -0,0 +1,57 @@
+#ifndef ABLATELIBRARY_STATISTICSMONITOR_HPP
+#define ABLATELIBRARY_STATISTICSMONITOR_HPP
+#include <petsc.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "checkpointable.hpp"
+#include "flowStatistics.hpp"
+#include "hdf5Monitor.hpp"
+#include "monitor.hpp"
+
+namespace ablate::monitors {
+/**
+ * Accumulates the running time weighted mean and rms of selected flow fields after every step (starting at startTime) and writes only the statistics (name.hdf5 in the output
+ * directory) every interval steps.  Derived quantities such as the velocity and temperature are sampled from the aux fields.  The statistics are saved with each
+ * checkpoint and restored on a restart.
+ */
+class StatisticsMonitor : public Monitor, public Monitorable, public Checkpointable {
+   private:
+    const std::vector<std::string> fields;
+    const std::string name;
+    const int interval;
+    const double startTime;
+
+    std::shared_ptr<FlowStatistics> statistics;
+
+    // writes the statistics
+    std::shared_ptr<Hdf5Monitor> outputMonitor;
+
+    // the first call is the initial (or restarted) state and is not sampled
+    bool started = false;
+
+    // the time of the last call, each sample is weighted by the time since the last call (or startTime)
+    PetscReal previousTime = 0.0;
+
+    // profiles each sample
+    PetscLogEvent accumulateLogEvent;
+
+    static PetscErrorCode AccumulateStatistics(TS ts, PetscInt steps, PetscReal time, Vec u, void* mctx);
+
+   public:
+    StatisticsMonitor(std::vector<std::string> fields, int interval, std::string name = {}, double startTime = {});
+
+    /**
+     * Sets up the statistics for the flow.  Only one flow can be registered.
+     */
+    void Register(std::shared_ptr<Monitorable>) override;
+    PetscMonitorFunction GetPetscFunction() override { return AccumulateStatistics; }
+
+    const std::string& GetName() const override { return name; }
+
+    void Save(Checkpoint& checkpoint) override;
+    void Restore(Checkpoint& checkpoint, PetscReal time) override;
+};
+}  // namespace ablate::monitors
+
+#endif  // ABLATELIBRARY_STATISTICSMONITOR_HPP
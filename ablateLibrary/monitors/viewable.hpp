@@ -1,11 +1,35 @@
 #ifndef ABLATELIBRARY_VIEWABLE_HPP
 #define ABLATELIBRARY_VIEWABLE_HPP
+#include <vector>
 #include "monitorable.hpp"
 
 namespace ablate::monitors {
 class Viewable : public Monitorable {
    public:
     virtual void View(PetscViewer viewer, PetscInt steps, PetscReal time, Vec u) const = 0;
+
+    /**
+     * Writes the data shared by every output (e.g. the mesh).  This is called once before the first output written with GetViewVectors.
+     * @param viewer
+     */
+    virtual void ViewSetup(PetscViewer viewer) const {}
+
+    /**
+     * Gets the named global vectors that View writes to the /fields group for this step, so that they can be copied, selected, and written later.  Objects that
+     * cannot be viewed this way return false and are always viewed with View.
+     * @param steps
+     * @param time
+     * @param u
+     * @param vectors the vectors to write, these must be returned with RestoreViewVectors
+     * @return
+     */
+    virtual bool GetViewVectors(PetscInt steps, PetscReal time, Vec u, std::vector<Vec>& vectors) const { return false; }
+
+    /**
+     * Returns the vectors from GetViewVectors
+     * @param vectors
+     */
+    virtual void RestoreViewVectors(std::vector<Vec>& vectors) const {}
 };
 }  // namespace ablate::monitors
 
@@ -1,12 +1,31 @@
 #include "inertial.hpp"
+#include <flow/processes/eulerAdvection.hpp>
 #include <utilities/petscError.hpp>
 
 enum InertialParticleFields { Position, Velocity, TotalParticleField };
 
+/**
+ * The inverse of the particle relaxation time with the Schiller-Naumann correction for finite particle Reynolds numbers
+ */
+static inline PetscReal InverseRelaxationTime(PetscInt dim, const PetscReal *fluidVel, const PetscReal *partVel, PetscReal partDiam, PetscReal partDens, PetscReal rhoF, PetscReal muF) {
+    PetscReal Rep = 0.0;
+    for (PetscInt n = 0; n < dim; n++) {
+        Rep += rhoF * PetscSqr(fluidVel[n] - partVel[n]) * partDiam / muF;
+    }
+    // Correction factor to account for finite Rep on Stokes drag (see Schiller-Naumann drag closure)
+    PetscReal corFactor = 1.0 + 0.15 * PetscPowReal(PetscSqrtReal(Rep), 0.687);
+    if (Rep < 0.1) {
+        corFactor = 1.0;  // returns Stokes drag for low speed particles
+    }
+    const PetscReal tauP = partDens * PetscSqr(partDiam) / (18.0 * muF);  // particle relaxation time
+    return corFactor / tauP;
+}
+
 ablate::particles::Inertial::Inertial(std::string name, int ndims, std::shared_ptr<parameters::Parameters> parameters, std::shared_ptr<particles::initializers::Initializer> initializer,
                                       std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization, std::shared_ptr<mathFunctions::MathFunction> exactSolution,
-                                      std::shared_ptr<parameters::Parameters> options)
-    : Particles(name, ndims, initializer, fieldInitialization, exactSolution, options) {
+                                      std::shared_ptr<parameters::Parameters> options, int sortInterval, std::string sortOrder,
+                                      std::vector<std::shared_ptr<injectors::Injector>> injectors, bool removeOutflow)
+    : Particles(name, ndims, initializer, fieldInitialization, exactSolution, options, sortInterval, sortOrder, injectors, removeOutflow) {
     RegisterSolutionField(ParticleFieldDescriptor{.fieldName = ParticleVelocity, .components = ndims, .type = PETSC_REAL});
     RegisterField(ParticleFieldDescriptor{.fieldName = FluidVelocity, .components = ndims, .type = PETSC_REAL});
     RegisterField(ParticleFieldDescriptor{.fieldName = ParticleDiameter, .components = 1, .type = PETSC_REAL});
@@ -19,6 +38,14 @@ ablate::particles::Inertial::Inertial(std::string name, int ndims, std::shared_p
     for (std::size_t i = 0; i < PetscMin(gravityVector.size(), 3); i++) {
         gravityField[i] = gravityVector[i];
     }
+
+    exponentialIntegrator = parameters->Get<bool>("exponentialIntegrator", false);
+
+    // the drag on the particles is returned to the flow momentum and energy
+    if (parameters->Get<bool>("twoWayCoupling", false)) {
+        RegisterSourceDeposition(DragMomentumSource, ndims, "euler", ablate::flow::processes::EulerAdvection::RHOU);
+        RegisterSourceDeposition(DragEnergySource, 1, "euler", ablate::flow::processes::EulerAdvection::RHOE);
+    }
 }
 ablate::particles::Inertial::~Inertial() {}
 void ablate::particles::Inertial::InitializeFlow(std::shared_ptr<flow::Flow> flow) {
@@ -34,200 +61,179 @@ void ablate::particles::Inertial::InitializeFlow(std::shared_ptr<flow::Flow> flo
     flow->RegisterPostStep([this](TS flowTs, ablate::flow::Flow &) { this->AdvectParticles(flowTs); });
 }
 
-PetscErrorCode ablate::particles::Inertial::UnpackKinematics(TS ts, Vec kinematics, Vec position, Vec velocity) {
-    PetscScalar *pos, *vel;
-    const PetscScalar *kin;
-    PetscInt Np, p, dim, n;
-    PetscErrorCode ierr;
-    DM dm;
-
-    PetscFunctionBeginUser;
-    ierr = TSGetDM(ts, &dm);
-    CHKERRQ(ierr);
-    ierr = DMGetDimension(dm, &dim);
-    CHKERRQ(ierr);
-    ierr = VecGetArrayRead(kinematics, &kin);
-    CHKERRQ(ierr);
-    ierr = VecGetArray(position, &pos);
-    CHKERRQ(ierr);
-    ierr = VecGetArray(velocity, &vel);
-    CHKERRQ(ierr);
-    ierr = VecGetLocalSize(position, &Np);
-    CHKERRQ(ierr);
-
-    Np /= dim;
-    for (p = 0; p < Np; ++p) {
-        for (n = 0; n < dim; n++) {
-            pos[p * dim + n] = kin[p * TotalParticleField * dim + n];
-            vel[p * dim + n] = kin[p * TotalParticleField * dim + dim + n];
-        }
-    }
-    ierr = VecRestoreArrayRead(kinematics, &kin);
-    CHKERRQ(ierr);
-    ierr = VecRestoreArray(position, &pos);
-    CHKERRQ(ierr);
-    ierr = VecRestoreArray(velocity, &vel);
-    CHKERRQ(ierr);
-    PetscFunctionReturn(0);
-}
-
 PetscErrorCode ablate::particles::Inertial::RHSFunction(TS ts, PetscReal t, Vec X, Vec F, void *ctx) {
     PetscFunctionBeginUser;
 
     ablate::particles::Inertial *particles = (ablate::particles::Inertial *)ctx;
-
-    Vec u = particles->flowFinal;
-    DM sdm, dm, vdm;
-    Vec vel, locvel, fluidVelocity;
-    IS vis;
-    DMInterpolationInfo ictx;
-    const PetscScalar *coords;
-    PetscScalar *f;
-    PetscInt vf[1] = {particles->flowVelocityFieldIndex};
+    DM sdm;
+    const PetscScalar *kinematics;
+    PetscScalar *f, *fluidVel;
+    const PetscScalar *partDiam, *partDens;
     PetscInt dim, Np;
     PetscErrorCode ierr;
 
-    PetscFunctionBeginUser;
     ierr = TSGetDM(ts, &sdm);
     CHKERRQ(ierr);
-    ierr = DMSwarmGetCellDM(sdm, &dm);
-    CHKERRQ(ierr);
-    // fluidVelocity is at particle location.
-    ierr = DMSwarmCreateGlobalVectorFromField(sdm, FluidVelocity, &fluidVelocity);
-    CHKERRQ(ierr);
-
     ierr = DMSwarmGetLocalSize(sdm, &Np);
     CHKERRQ(ierr);
-    ierr = DMGetDimension(dm, &dim);
-    CHKERRQ(ierr);
-
-    /* Get local fluid velocity */
-    ierr = DMCreateSubDM(dm, 1, vf, &vis, &vdm);
-    CHKERRQ(ierr);
-    ierr = VecGetSubVector(u, vis, &vel);
-    CHKERRQ(ierr);
-    ierr = DMGetLocalVector(vdm, &locvel);
-    CHKERRQ(ierr);
-    ierr = DMPlexInsertBoundaryValues(vdm, PETSC_TRUE, locvel, particles->timeInitial, NULL, NULL, NULL);
-    CHKERRQ(ierr);
-    ierr = DMGlobalToLocalBegin(vdm, vel, INSERT_VALUES, locvel);
-    CHKERRQ(ierr);
-    ierr = DMGlobalToLocalEnd(vdm, vel, INSERT_VALUES, locvel);
-    CHKERRQ(ierr);
-    ierr = VecRestoreSubVector(u, vis, &vel);
-    CHKERRQ(ierr);
-    ierr = ISDestroy(&vis);
+    ierr = DMGetDimension(sdm, &dim);
     CHKERRQ(ierr);
 
-    /* Interpolate velocity */
-    ierr = DMInterpolationCreate(PETSC_COMM_SELF, &ictx);
-    CHKERRQ(ierr);
-    ierr = DMInterpolationSetDim(ictx, dim);
-    CHKERRQ(ierr);
-    ierr = DMInterpolationSetDof(ictx, dim);
+    // the kinematics (position, velocity) are interleaved for each particle and are read in place
+    const PetscInt kinematicsStride = TotalParticleField * dim;
+    ierr = VecGetArrayRead(X, &kinematics);
     CHKERRQ(ierr);
 
-    // Get particle position, velocity, diameter and density
-    Vec particlePosition, particleVelocity, particleDiameter, particleDensity;
-    ierr = DMSwarmCreateGlobalVectorFromField(sdm, DMSwarmPICField_coor, &particlePosition);
-    CHKERRQ(ierr);
-    ierr = DMSwarmCreateGlobalVectorFromField(sdm, ParticleVelocity, &particleVelocity);
-    CHKERRQ(ierr);
-    ierr = DMSwarmCreateGlobalVectorFromField(sdm, ParticleDiameter, &particleDiameter);
-    CHKERRQ(ierr);
-    ierr = DMSwarmCreateGlobalVectorFromField(sdm, ParticleDensity, &particleDensity);
+    /* Interpolate the fluid velocity to the particle location using the persistent interpolator.
+     Particles that lie outside the domain get a zero velocity, whereas particles that move to another partition should trigger a migration */
+    ierr = DMSwarmGetField(sdm, FluidVelocity, NULL, NULL, (void **)&fluidVel);
     CHKERRQ(ierr);
+    particles->InterpolateFlowVelocity(t, Np, kinematics + Position * dim, kinematicsStride, fluidVel);
 
-    // Unpack kinematics to get updated position and velocity
-    ierr = UnpackKinematics(ts, X, particlePosition, particleVelocity);
-    CHKERRQ(ierr);
-    ierr = VecGetArrayRead(particlePosition, &coords);
+    // Get particle diameter and density
+    ierr = DMSwarmGetField(sdm, ParticleDiameter, NULL, NULL, (void **)&partDiam);
     CHKERRQ(ierr);
-    ierr = DMInterpolationAddPoints(ictx, Np, (PetscReal *)coords);
-    CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(particlePosition, &coords);
-    CHKERRQ(ierr);
-
-    /* Particles that lie outside the domain should be dropped,
-     whereas particles that move to another partition should trigger a migration */
-    ierr = DMInterpolationSetUp(ictx, vdm, PETSC_FALSE, PETSC_TRUE);
-    CHKERRQ(ierr);
-    ierr = VecSet(fluidVelocity, 0.);
-    CHKERRQ(ierr);
-
-    ierr = DMInterpolationEvaluate(ictx, vdm, locvel, fluidVelocity);
-    CHKERRQ(ierr);
-    ierr = DMInterpolationDestroy(&ictx);
-    CHKERRQ(ierr);
-    ierr = DMRestoreLocalVector(vdm, &locvel);
-    CHKERRQ(ierr);
-    ierr = DMDestroy(&vdm);
+    ierr = DMSwarmGetField(sdm, ParticleDensity, NULL, NULL, (void **)&partDens);
     CHKERRQ(ierr);
 
     // Calculate RHS of particle position and velocity equations
     PetscInt p, n;
-    const PetscScalar *partVel, *fluidVel, *partDiam, *partDens;
     PetscReal g[3] = {particles->gravityField[0], particles->gravityField[1], particles->gravityField[2]};  // gravity field
     PetscScalar muF = particles->fluidViscosity;
     PetscScalar rhoF = particles->fluidDensity;
 
-    PetscReal Rep, corFactor;
-    PetscScalar tauP;  // particle Stokes relaxation time
-
     ierr = VecGetArray(F, &f);
     CHKERRQ(ierr);
-    ierr = VecGetArrayRead(particleVelocity, &partVel);
-    CHKERRQ(ierr);
-    ierr = VecGetArrayRead(fluidVelocity, &fluidVel);
-    CHKERRQ(ierr);
-    ierr = VecGetArrayRead(particleDensity, &partDens);
-    CHKERRQ(ierr);
-    ierr = VecGetArrayRead(particleDiameter, &partDiam);
-    CHKERRQ(ierr);
 
     for (p = 0; p < Np; ++p) {
-        Rep = 0.0;
-        for (n = 0; n < dim; n++) {
-            Rep += rhoF * PetscSqr(fluidVel[p * dim + n] - partVel[p * dim + n]) * partDiam[p] / muF;
-        }
-        // Correction factor to account for finite Rep on Stokes drag (see Schiller-Naumann drag closure)
-        corFactor = 1.0 + 0.15 * PetscPowReal(PetscSqrtReal(Rep), 0.687);
-        if (Rep < 0.1) {
-            corFactor = 1.0;  // returns Stokes drag for low speed particles
-        }
         // Note: this function assumed that the solution vector order is correct
-        tauP = partDens[p] * PetscSqr(partDiam[p]) / (18.0 * muF);  // particle relaxation time
+        const PetscScalar *partVel = kinematics + p * kinematicsStride + Velocity * dim;
+        const PetscReal inverseTauP = InverseRelaxationTime(dim, fluidVel + p * dim, partVel, partDiam[p], partDens[p], rhoF, muF);
         for (n = 0; n < dim; n++) {
-            f[p * TotalParticleField * dim + n] = partVel[p * dim + n];
-            f[p * TotalParticleField * dim + dim + n] = corFactor * (fluidVel[p * dim + n] - partVel[p * dim + n]) / tauP + g[n] * (1.0 - rhoF / partDens[p]);
+            f[p * kinematicsStride + Position * dim + n] = partVel[n];
+            f[p * kinematicsStride + Velocity * dim + n] = inverseTauP * (fluidVel[p * dim + n] - partVel[n]) + g[n] * (1.0 - rhoF / partDens[p]);
         }
     }
     ierr = VecRestoreArray(F, &f);
     CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(particleVelocity, &partVel);
-    CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(fluidVelocity, &fluidVel);
-    CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(particleDensity, &partDens);
-    CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(particleDiameter, &partDiam);
+    ierr = VecRestoreArrayRead(X, &kinematics);
     CHKERRQ(ierr);
-    ierr = DMSwarmDestroyGlobalVectorFromField(sdm, FluidVelocity, &fluidVelocity);
+    ierr = DMSwarmRestoreField(sdm, FluidVelocity, NULL, NULL, (void **)&fluidVel);
     CHKERRQ(ierr);
-    ierr = DMSwarmDestroyGlobalVectorFromField(sdm, DMSwarmPICField_coor, &particlePosition);
+    ierr = DMSwarmRestoreField(sdm, ParticleDiameter, NULL, NULL, (void **)&partDiam);
     CHKERRQ(ierr);
-    ierr = DMSwarmDestroyGlobalVectorFromField(sdm, ParticleVelocity, &particleVelocity);
-    CHKERRQ(ierr);
-    ierr = DMSwarmDestroyGlobalVectorFromField(sdm, ParticleDiameter, &particleDiameter);
-    CHKERRQ(ierr);
-    ierr = DMSwarmDestroyGlobalVectorFromField(sdm, ParticleDensity, &particleDensity);
+    ierr = DMSwarmRestoreField(sdm, ParticleDensity, NULL, NULL, (void **)&partDens);
     CHKERRQ(ierr);
     PetscFunctionReturn(0);
 }
 
+void ablate::particles::Inertial::Integrate(Vec solution) {
+    if (!exponentialIntegrator) {
+        Particles::Integrate(solution);
+        return;
+    }
+
+    PetscInt np;
+    DMSwarmGetLocalSize(dm, &np) >> checkError;
+    const PetscInt dim = ndims;
+    const PetscInt kinematicsStride = TotalParticleField * dim;
+
+    // the step and time are shared with the particle ts so that the ts monitors and error computation still apply
+    PetscReal time, dt;
+    PetscInt step;
+    TSGetTime(particleTs, &time) >> checkError;
+    TSGetTimeStep(particleTs, &dt) >> checkError;
+    TSGetStepNumber(particleTs, &step) >> checkError;
+
+    while (timeFinal - time > PETSC_SMALL * PetscMax(1.0, PetscAbsReal(timeFinal))) {
+        const PetscReal h = PetscMin(dt, timeFinal - time);
+
+        PetscReal *kinematics;
+        const PetscReal *partDiam, *partDens;
+        PetscReal *fluidVel;
+        VecGetArray(solution, &kinematics) >> checkError;
+        DMSwarmGetField(dm, FluidVelocity, NULL, NULL, (void **)&fluidVel) >> checkError;
+        DMSwarmGetField(dm, ParticleDiameter, NULL, NULL, (void **)&partDiam) >> checkError;
+        DMSwarmGetField(dm, ParticleDensity, NULL, NULL, (void **)&partDens) >> checkError;
+
+        // the fluid velocity at the start position and mid step time
+        InterpolateFlowVelocity(time + 0.5 * h, np, kinematics + Position * dim, kinematicsStride, fluidVel);
+
+        for (PetscInt p = 0; p < np; ++p) {
+            PetscReal *partPos = kinematics + p * kinematicsStride + Position * dim;
+            PetscReal *partVel = kinematics + p * kinematicsStride + Velocity * dim;
+            const PetscReal tauP = 1.0 / InverseRelaxationTime(dim, fluidVel + p * dim, partVel, partDiam[p], partDens[p], fluidDensity, fluidViscosity);
+            const PetscReal decay = PetscExpReal(-h / tauP);
+
+            // the particle relaxes toward the terminal velocity (fluid velocity plus the settling velocity)
+            for (PetscInt n = 0; n < dim; n++) {
+                const PetscReal terminalVel = fluidVel[p * dim + n] + tauP * gravityField[n] * (1.0 - fluidDensity / partDens[p]);
+                const PetscReal relativeVel = partVel[n] - terminalVel;
+                partPos[n] += terminalVel * h + relativeVel * tauP * (1.0 - decay);
+                partVel[n] = terminalVel + relativeVel * decay;
+            }
+        }
+
+        DMSwarmRestoreField(dm, ParticleDensity, NULL, NULL, (void **)&partDens) >> checkError;
+        DMSwarmRestoreField(dm, ParticleDiameter, NULL, NULL, (void **)&partDiam) >> checkError;
+        DMSwarmRestoreField(dm, FluidVelocity, NULL, NULL, (void **)&fluidVel) >> checkError;
+        VecRestoreArray(solution, &kinematics) >> checkError;
+
+        time += h;
+        step++;
+        TSSetTime(particleTs, time) >> checkError;
+        TSSetStepNumber(particleTs, step) >> checkError;
+        TSMonitor(particleTs, step, time, solution) >> checkError;
+    }
+}
+
+void ablate::particles::Inertial::ComputeParticleSources() {
+    PetscInt np;
+    DMSwarmGetLocalSize(dm, &np) >> checkError;
+    const PetscInt dim = ndims;
+    const PetscInt kinematicsStride = TotalParticleField * dim;
+
+    // interpolate the fluid velocity to the final particle locations
+    const PetscReal *kinematics;
+    PetscReal *fluidVel;
+    DMSwarmGetField(dm, GetSolutionVectorName(), NULL, NULL, (void **)&kinematics) >> checkError;
+    DMSwarmGetField(dm, FluidVelocity, NULL, NULL, (void **)&fluidVel) >> checkError;
+    InterpolateFlowVelocity(timeFinal, np, kinematics + Position * dim, kinematicsStride, fluidVel);
+
+    const PetscReal *partDiam, *partDens;
+    PetscReal *momentumSource, *energySource;
+    DMSwarmGetField(dm, ParticleDiameter, NULL, NULL, (void **)&partDiam) >> checkError;
+    DMSwarmGetField(dm, ParticleDensity, NULL, NULL, (void **)&partDens) >> checkError;
+    DMSwarmGetField(dm, DragMomentumSource, NULL, NULL, (void **)&momentumSource) >> checkError;
+    DMSwarmGetField(dm, DragEnergySource, NULL, NULL, (void **)&energySource) >> checkError;
+
+    // the drag force on the flow is opposite to the drag on the particle, and does work at the particle velocity
+    for (PetscInt p = 0; p < np; ++p) {
+        const PetscReal *partVel = kinematics + p * kinematicsStride + Velocity * dim;
+        const PetscReal mass = partDens[p] * PETSC_PI * PetscPowRealInt(partDiam[p], 3) / 6.0;
+        const PetscReal dragCoefficient = mass * InverseRelaxationTime(dim, fluidVel + p * dim, partVel, partDiam[p], partDens[p], fluidDensity, fluidViscosity);
+        energySource[p] = 0.0;
+        for (PetscInt n = 0; n < dim; n++) {
+            momentumSource[p * dim + n] = -dragCoefficient * (fluidVel[p * dim + n] - partVel[n]);
+            energySource[p] += momentumSource[p * dim + n] * partVel[n];
+        }
+    }
+
+    DMSwarmRestoreField(dm, DragEnergySource, NULL, NULL, (void **)&energySource) >> checkError;
+    DMSwarmRestoreField(dm, DragMomentumSource, NULL, NULL, (void **)&momentumSource) >> checkError;
+    DMSwarmRestoreField(dm, ParticleDensity, NULL, NULL, (void **)&partDens) >> checkError;
+    DMSwarmRestoreField(dm, ParticleDiameter, NULL, NULL, (void **)&partDiam) >> checkError;
+    DMSwarmRestoreField(dm, FluidVelocity, NULL, NULL, (void **)&fluidVel) >> checkError;
+    DMSwarmRestoreField(dm, GetSolutionVectorName(), NULL, NULL, (void **)&kinematics) >> checkError;
+}
+
 #include "parser/registrar.hpp"
 REGISTER(ablate::particles::Particles, ablate::particles::Inertial, "particles (with mass) that advect with the flow", ARG(std::string, "name", "the name of the particle group"),
-         ARG(int, "ndims", "the number of dimensions for the particle"), ARG(parameters::Parameters, "parameters", "fluid parameters for the particles (fluidDensity, fluidViscosity, gravityField)"),
+         ARG(int, "ndims", "the number of dimensions for the particle"), ARG(parameters::Parameters, "parameters", "fluid parameters for the particles (fluidDensity, fluidViscosity, gravityField, twoWayCoupling, exponentialIntegrator)"),
          ARG(particles::initializers::Initializer, "initializer", "the initial particle setup methods"),
          ARG(std::vector<mathFunctions::FieldSolution>, "fieldInitialization", "the initial particle fields setup methods"),
-         OPT(mathFunctions::MathFunction, "exactSolution", "the particle location/velocity exact solution"), ARG(parameters::Parameters, "options", "options to be passed to petsc"));
\ No newline at end of file
+         OPT(mathFunctions::MathFunction, "exactSolution", "the particle location/velocity exact solution"), ARG(parameters::Parameters, "options", "options to be passed to petsc"),
+         OPT(int, "sortInterval", "reorder the local particles by cell every sortInterval flow steps (default 0, never)"),
+         OPT(std::string, "sortOrder", "the order of the cells when sorting, 'cell' (default) or 'morton' for a space filling curve"),
+         OPT(std::vector<particles::injectors::Injector>, "injectors", "particles added during the simulation"),
+         OPT(bool, "removeOutflow", "remove the particles that leave the domain (default false)"));
\ No newline at end of file
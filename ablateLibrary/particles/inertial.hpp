@@ -13,32 +13,41 @@ class Inertial : public Particles {
     // gravity field
     PetscReal gravityField[3] = {0, 0, 0};
 
-    /*
-     * Kinematics vector is a combination of particle velocity and position
-     * in order to pass into TSSolve.
-     */
-    static PetscErrorCode PackKinematics(TS ts, Vec position, Vec velocity, Vec kinematics);
-
-    /*
-     * Unpack kinematics to get particle position and velocity
-     */
-    static PetscErrorCode UnpackKinematics(TS ts, Vec kinematics, Vec position, Vec velocity);
+    // integrate the drag with the semi-analytic exponential integrator instead of the particle ts
+    bool exponentialIntegrator;
 
-    /* calculating RHS of the following equations
+    /* calculating RHS of the following equations directly from the interleaved kinematics (position, velocity) for each particle
      * x_t = vp
      * u_t = f(vf-vp)/tau_p + g(1-\rho_f/\rho_p)
      */
     static PetscErrorCode RHSFunction(TS ts, PetscReal t, Vec X, Vec F, void *ctx);
 
+   protected:
+    /**
+     * Computes the drag momentum and energy returned to the flow when twoWayCoupling is enabled
+     */
+    void ComputeParticleSources() override;
+
+    /**
+     * When exponentialIntegrator is enabled each particle ts step is taken with the exact solution of the linear drag, holding the fluid velocity (at the mid step
+     * time) and the drag correction constant over the step.  This is stable for any step relative to the particle relaxation time, so the particles take far
+     * fewer steps than with an explicit ts.  Otherwise the particle ts is used.
+     * @param solution
+     */
+    void Integrate(Vec solution) override;
+
    public:
     Inertial(std::string name, int ndims, std::shared_ptr<parameters::Parameters> parameters, std::shared_ptr<particles::initializers::Initializer> initializer,
              std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization, std::shared_ptr<mathFunctions::MathFunction> exactSolution = {},
-             std::shared_ptr<parameters::Parameters> options = {});
+             std::shared_ptr<parameters::Parameters> options = {}, int sortInterval = 0, std::string sortOrder = {},
+             std::vector<std::shared_ptr<injectors::Injector>> injectors = {}, bool removeOutflow = false);
     ~Inertial() override;
 
     void InitializeFlow(std::shared_ptr<flow::Flow> flow) override;
 
     inline static const char FluidVelocity[] = "FluidVelocity";
+    inline static const char DragMomentumSource[] = "DragMomentumSource";
+    inline static const char DragEnergySource[] = "DragEnergySource";
 };
 
 }  // namespace ablate::particles
@@ -1,4 +1,5 @@
 #include "boxInitializer.hpp"
+#include <algorithm>
 #include "utilities/petscError.hpp"
 
 ablate::particles::initializers::BoxInitializer::BoxInitializer(std::vector<double> lowerBound, std::vector<double> upperBound, int particlesPerDim)
@@ -24,11 +25,12 @@ void ablate::particles::initializers::BoxInitializer::Initialize(ablate::flow::F
 
     PetscInt dim;
     DMGetDimension(particleDm, &dim) >> checkError;
+    if (dim != 2 && dim != 3) {
+        throw std::runtime_error("Do not support particle layout in dimension " + std::to_string(dim));
+    }
 
-    PetscInt Np = 1;
-    PetscInt *cellid, n[3];
-    PetscReal x[3], dx[3];
-    PetscScalar *coords;
+    PetscInt n[3] = {1, 1, 1};
+    PetscReal dx[3] = {0.0, 0.0, 0.0};
     PetscMPIInt rank;
 
     DMSetFromOptions(particleDm) >> checkError;
@@ -37,57 +39,106 @@ void ablate::particles::initializers::BoxInitializer::Initialize(ablate::flow::F
     for (PetscInt d = 0; d < dim; ++d) {
         n[d] = Npb;
         dx[d] = (partUpper[d] - partLower[d]) / PetscMax(1, n[d] - 1);
-        Np *= n[d];
     }
 
-    // Initialize all particles on rank 0 and then distribute
-    if (rank != 0) {
-        Np = 0;
+    // Only generate the box points that can be inside of this rank's local domain
+    DM cellDm = flow.GetDM();
+    PetscReal localLower[3], localUpper[3], globalLower[3], globalUpper[3];
+    DMGetLocalBoundingBox(cellDm, localLower, localUpper) >> checkError;
+    DMGetBoundingBox(cellDm, globalLower, globalUpper) >> checkError;
+
+    PetscInt start[3] = {0, 0, 0};
+    PetscInt end[3] = {1, 1, 1};
+    PetscReal nudge[3] = {0.0, 0.0, 0.0};
+    for (PetscInt d = 0; d < dim; ++d) {
+        const PetscReal tolerance = PETSC_SMALL * PetscMax(1.0, globalUpper[d] - globalLower[d]);
+        if (dx[d] > 0) {
+            start[d] = (PetscInt)PetscMax(0.0, PetscCeilReal((localLower[d] - tolerance - partLower[d]) / dx[d]));
+            end[d] = (PetscInt)PetscMin((PetscReal)n[d], PetscFloorReal((localUpper[d] + tolerance - partLower[d]) / dx[d]) + 1.0);
+        } else {
+            end[d] = partLower[d] >= localLower[d] - tolerance && partLower[d] <= localUpper[d] + tolerance ? n[d] : 0;
+        }
+        end[d] = PetscMax(start[d], end[d]);
+
+        // points are located after a small nudge in a generic direction so that points on shared faces are claimed by exactly one rank
+        nudge[d] = 1E-8 * (globalUpper[d] - globalLower[d]) / (PetscReal)(1 << d);
     }
 
-    DMSwarmSetLocalSizes(particleDm, Np, 0) >> checkError;
-    DMSetFromOptions(particleDm) >> checkError;
-    DMSwarmGetField(particleDm, DMSwarmPICField_coor, NULL, NULL, (void **)&coords) >> checkError;
-    if (rank == 0) {
-        switch (dim) {
-            case 2:
-                x[0] = partLower[0];
-                for (PetscInt i = 0; i < n[0]; ++i, x[0] += dx[0]) {
-                    x[1] = partLower[1];
-                    for (PetscInt j = 0; j < n[1]; ++j, x[1] += dx[1]) {
-                        const PetscInt p = j * n[0] + i;
-                        for (PetscInt d = 0; d < dim; ++d) {
-                            coords[p * dim + d] = x[d];
-                        }
-                    }
+    // compute the serial index and coordinates of each candidate point
+    std::vector<PetscInt64> candidateIds;
+    std::vector<PetscReal> candidateCoordinates;
+    std::vector<PetscReal> nudgedCoordinates;
+    for (PetscInt k = start[2]; k < end[2]; ++k) {
+        for (PetscInt j = start[1]; j < end[1]; ++j) {
+            for (PetscInt i = start[0]; i < end[0]; ++i) {
+                const PetscInt index[3] = {i, j, k};
+                candidateIds.push_back(((PetscInt64)k * n[1] + j) * n[0] + i);
+                for (PetscInt d = 0; d < dim; ++d) {
+                    const PetscReal x = partLower[d] + index[d] * dx[d];
+                    candidateCoordinates.push_back(x);
+                    nudgedCoordinates.push_back(x + nudge[d] > globalUpper[d] ? x - nudge[d] : x + nudge[d]);
                 }
-                break;
-            case 3:
-                x[0] = partLower[0];
-                for (PetscInt i = 0; i < n[0]; ++i, x[0] += dx[0]) {
-                    x[1] = partLower[1];
-                    for (PetscInt j = 0; j < n[1]; ++j, x[1] += dx[1]) {
-                        x[2] = partLower[2];
-                        for (PetscInt k = 0; k < n[2]; ++k, x[2] += dx[2]) {
-                            const PetscInt p = (k * n[1] + j) * n[0] + i;
-                            for (PetscInt d = 0; d < dim; ++d) {
-                                coords[p * dim + d] = x[d];
-                            }
-                        }
-                    }
-                }
-                break;
-            default:
-                throw std::runtime_error("Do not support particle layout in dimension " + std::to_string(dim));
+            }
         }
     }
-    DMSwarmRestoreField(particleDm, DMSwarmPICField_coor, NULL, NULL, (void **)&coords) >> checkError;
+
+    // locate each candidate and keep the ones in cells owned by this rank
+    std::vector<PetscInt> candidateCells(candidateIds.size(), -1);
+    if (!candidateIds.empty()) {
+        Vec pointVec;
+        VecCreateSeqWithArray(PETSC_COMM_SELF, dim, (PetscInt)nudgedCoordinates.size(), nudgedCoordinates.data(), &pointVec) >> checkError;
+        PetscSF cellSF = NULL;
+        DMLocatePoints(cellDm, pointVec, DM_POINTLOCATION_NONE, &cellSF) >> checkError;
+        const PetscSFNode *cells;
+        PetscSFGetGraph(cellSF, NULL, NULL, NULL, &cells) >> checkError;
+
+        PetscInt cStart, cEnd;
+        DMPlexGetSimplexOrBoxCells(cellDm, 0, &cStart, &cEnd) >> checkError;
+        IS globalCellNumbers;
+        const PetscInt *globalCellNumber;
+        DMPlexGetCellNumbering(cellDm, &globalCellNumbers) >> checkError;
+        ISGetIndices(globalCellNumbers, &globalCellNumber) >> checkError;
+        for (std::size_t p = 0; p < candidateIds.size(); ++p) {
+            const PetscInt cell = cells[p].index;
+            if (cell >= cStart && cell < cEnd && globalCellNumber[cell - cStart] >= 0) {
+                candidateCells[p] = cell;
+            }
+        }
+        ISRestoreIndices(globalCellNumbers, &globalCellNumber) >> checkError;
+        PetscSFDestroy(&cellSF) >> checkError;
+        VecDestroy(&pointVec) >> checkError;
+    }
+    const auto Np = (PetscInt)std::count_if(candidateCells.begin(), candidateCells.end(), [](PetscInt cell) { return cell >= 0; });
+
+    DMSwarmSetLocalSizes(particleDm, Np, 0) >> checkError;
+    DMSetFromOptions(particleDm) >> checkError;
+
+    // copy over the owned particles, the particle id is the index in the serial layout
+    PetscScalar *coords;
+    PetscInt *cellid;
+    PetscInt *rankid;
+    PetscInt64 *pid;
+    DMSwarmGetField(particleDm, DMSwarmPICField_coor, NULL, NULL, (void **)&coords) >> checkError;
     DMSwarmGetField(particleDm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid) >> checkError;
-    for (PetscInt p = 0; p < Np; ++p) {
-        cellid[p] = 0;
+    DMSwarmGetField(particleDm, DMSwarmField_rank, NULL, NULL, (void **)&rankid) >> checkError;
+    DMSwarmGetField(particleDm, DMSwarmField_pid, NULL, NULL, (void **)&pid) >> checkError;
+    PetscInt p = 0;
+    for (std::size_t c = 0; c < candidateIds.size(); ++c) {
+        if (candidateCells[c] < 0) {
+            continue;
+        }
+        for (PetscInt d = 0; d < dim; ++d) {
+            coords[p * dim + d] = candidateCoordinates[c * dim + d];
+        }
+        cellid[p] = candidateCells[c];
+        rankid[p] = rank;
+        pid[p] = candidateIds[c];
+        p++;
     }
+    DMSwarmRestoreField(particleDm, DMSwarmField_pid, NULL, NULL, (void **)&pid) >> checkError;
+    DMSwarmRestoreField(particleDm, DMSwarmField_rank, NULL, NULL, (void **)&rankid) >> checkError;
     DMSwarmRestoreField(particleDm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid) >> checkError;
-    DMSwarmMigrate(particleDm, PETSC_TRUE) >> checkError;
+    DMSwarmRestoreField(particleDm, DMSwarmPICField_coor, NULL, NULL, (void **)&coords) >> checkError;
 }
 
 #include "parser/registrar.hpp"
@@ -1,29 +1,100 @@
 #include "cellInitializer.hpp"
+#include <algorithm>
 #include "parser/registrar.hpp"
+#include "utilities/hashRandom.hpp"
+#include "utilities/mpiError.hpp"
 #include "utilities/petscError.hpp"
 
 ablate::particles::initializers::CellInitializer::CellInitializer(int particlesPerCellPerDim) : particlesPerCell(particlesPerCellPerDim) {}
 
 void ablate::particles::initializers::CellInitializer::Initialize(ablate::flow::Flow &flow, DM particleDm) {
     PetscInt particlesPerCell = (PetscInt)this->particlesPerCell;
+    DM cellDm = flow.GetDM();
 
+    PetscInt dim;
+    DMGetDimension(cellDm, &dim) >> checkError;
+    PetscMPIInt rank;
+    MPI_Comm_rank(PetscObjectComm((PetscObject)particleDm), &rank) >> checkMpiError;
+
+    // only create particles in the cells owned by this rank (no overlap or boundary ghost cells)
     PetscInt cStart, cEnd;
-    DMPlexGetHeightStratum(flow.GetDM(), 0, &cStart, &cEnd) >> checkError;
-    DMSwarmSetLocalSizes(particleDm, (cEnd - cStart) * particlesPerCell, 0) >> checkError;
+    DMPlexGetSimplexOrBoxCells(cellDm, 0, &cStart, &cEnd) >> checkError;
+    IS globalCellNumbers;
+    const PetscInt *globalCellNumber;
+    DMPlexGetCellNumbering(cellDm, &globalCellNumbers) >> checkError;
+    ISGetIndices(globalCellNumbers, &globalCellNumber) >> checkError;
 
-    // set the cell ids
+    PetscInt numberOwnedCells = 0;
+    for (PetscInt c = cStart; c < cEnd; ++c) {
+        if (globalCellNumber[c - cStart] >= 0) {
+            numberOwnedCells++;
+        }
+    }
+    DMSwarmSetLocalSizes(particleDm, numberOwnedCells * particlesPerCell, 0) >> checkError;
+
+    PetscScalar *coords;
     PetscInt *cellid;
+    PetscInt *rankid;
+    PetscInt64 *pid;
+    DMSwarmGetField(particleDm, DMSwarmPICField_coor, NULL, NULL, (void **)&coords) >> checkError;
     DMSwarmGetField(particleDm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid) >> checkError;
+    DMSwarmGetField(particleDm, DMSwarmField_rank, NULL, NULL, (void **)&rankid) >> checkError;
+    DMSwarmGetField(particleDm, DMSwarmField_pid, NULL, NULL, (void **)&pid) >> checkError;
+
+    // the global cell number depends upon the partition, so the random positions are keyed by the location of the cell instead
+    PetscReal globalLower[3], globalUpper[3];
+    DMGetBoundingBox(cellDm, globalLower, globalUpper) >> checkError;
+
+    PetscInt n = 0;
     for (PetscInt c = cStart; c < cEnd; ++c) {
-        for (PetscInt p = 0; p < particlesPerCell; ++p) {
-            const PetscInt n = c * particlesPerCell + p;
+        if (globalCellNumber[c - cStart] < 0) {
+            continue;
+        }
+        DMPolytopeType cellType;
+        DMPlexGetCellType(cellDm, c, &cellType) >> checkError;
+        const bool simplex = cellType == DM_POLYTOPE_SEGMENT || cellType == DM_POLYTOPE_TRIANGLE || cellType == DM_POLYTOPE_TETRAHEDRON;
+
+        // quantize the centroid of the cell to 21 bits in each direction
+        PetscReal volume, centroid[3];
+        DMPlexComputeCellGeometryFVM(cellDm, c, &volume, centroid, NULL) >> checkError;
+        PetscInt64 cellKey = 0;
+        for (PetscInt d = 0; d < dim; ++d) {
+            const PetscReal fraction = (centroid[d] - globalLower[d]) / PetscMax(globalUpper[d] - globalLower[d], PETSC_SMALL);
+            cellKey |= (PetscInt64)PetscRoundReal(PetscMin(PetscMax(fraction, 0.0), 1.0) * cellKeyResolution) << (21 * d);
+        }
+
+        for (PetscInt p = 0; p < particlesPerCell; ++p, ++n) {
+            // the particle id is based upon the global cell number
+            pid[n] = (PetscInt64)globalCellNumber[c - cStart] * particlesPerCell + p;
             cellid[n] = c;
+            rankid[n] = rank;
+
+            // pick a random point in the unit cube, or in the unit simplex using the spacings of the sorted values
+            PetscReal reference[3];
+            for (PetscInt d = 0; d < dim; ++d) {
+                reference[d] = utilities::HashRandom::Uniform(cellKey, p * dim + d);
+            }
+            if (simplex) {
+                std::sort(reference, reference + dim);
+                for (PetscInt d = dim - 1; d > 0; --d) {
+                    reference[d] -= reference[d - 1];
+                }
+            }
+
+            // map to the reference cell ([-1, 1]^dim or the simplex with vertices at -1 and 1)
+            for (PetscInt d = 0; d < dim; ++d) {
+                reference[d] = 2.0 * reference[d] - 1.0;
+            }
+            DMPlexReferenceToCoordinates(cellDm, c, 1, reference, coords + n * dim) >> checkError;
         }
     }
 
+    DMSwarmRestoreField(particleDm, DMSwarmField_pid, NULL, NULL, (void **)&pid) >> checkError;
+    DMSwarmRestoreField(particleDm, DMSwarmField_rank, NULL, NULL, (void **)&rankid) >> checkError;
     DMSwarmRestoreField(particleDm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellid) >> checkError;
-    DMSwarmSetPointCoordinatesRandom(particleDm, particlesPerCell) >> checkError;
+    DMSwarmRestoreField(particleDm, DMSwarmPICField_coor, NULL, NULL, (void **)&coords) >> checkError;
+    ISRestoreIndices(globalCellNumbers, &globalCellNumber) >> checkError;
 }
 
 REGISTER(ablate::particles::initializers::Initializer, ablate::particles::initializers::CellInitializer, "simple cell initializer that puts particles in every element",
-         ARG(int, "particlesPerCellPerDim", "particles per cell per dimension"));
\ No newline at end of file
+         ARG(int, "particlesPerCellPerDim", "particles per cell per dimension"));
@@ -7,6 +7,9 @@ class CellInitializer : public Initializer {
    private:
     const int particlesPerCell;
 
+    // the largest quantized cell centroid coordinate (21 bits) used to key the random particle positions in each cell
+    inline static const PetscReal cellKeyResolution = (PetscReal)((1 << 21) - 1);
+
    public:
     explicit CellInitializer(int particlesPerCellPerDim = 1);
     ~CellInitializer() override = default;
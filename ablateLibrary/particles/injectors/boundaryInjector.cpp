@@ -0,0 +1,170 @@
+#include "boundaryInjector.hpp"
+#include <algorithm>
+#include "utilities/hashRandom.hpp"
+#include "utilities/mpiError.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::particles::injectors::BoundaryInjector::BoundaryInjector(double rate, std::vector<int> labelIds, std::string labelName,
+                                                                std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization)
+    : Injector(rate, fieldInitialization), labelName(labelName.empty() ? "Face Sets" : labelName), labelIds(labelIds) {}
+
+void ablate::particles::injectors::BoundaryInjector::Initialize(ablate::flow::Flow &flow, PetscInt64 streamIn) {
+    Injector::Initialize(flow, streamIn);
+
+    DMLabel label;
+    DMGetLabel(cellDm, labelName.c_str(), &label) >> checkError;
+    if (!label) {
+        throw std::invalid_argument("Cannot locate label " + labelName + " for the boundary injector");
+    }
+
+    PetscInt cStart, cEnd;
+    DMPlexGetSimplexOrBoxCells(cellDm, 0, &cStart, &cEnd) >> checkError;
+    IS globalCellNumbers;
+    const PetscInt *globalCellNumber;
+    DMPlexGetCellNumbering(cellDm, &globalCellNumbers) >> checkError;
+    ISGetIndices(globalCellNumbers, &globalCellNumber) >> checkError;
+
+    DM coordinateDm;
+    PetscSection coordinateSection;
+    Vec coordinates;
+    DMGetCoordinateDM(cellDm, &coordinateDm) >> checkError;
+    DMGetCoordinateSection(cellDm, &coordinateSection) >> checkError;
+    DMGetCoordinatesLocal(cellDm, &coordinates) >> checkError;
+
+    // store each labeled face with an owned interior cell
+    PetscReal localArea = 0.0;
+    faceVertexOffsets.push_back(0);
+    for (const auto labelId : labelIds) {
+        IS faceIS;
+        DMLabelGetStratumIS(label, labelId, &faceIS) >> checkError;
+        if (!faceIS) {
+            continue;
+        }
+        PetscInt numberFaces;
+        const PetscInt *faces;
+        ISGetLocalSize(faceIS, &numberFaces) >> checkError;
+        ISGetIndices(faceIS, &faces) >> checkError;
+        for (PetscInt f = 0; f < numberFaces; ++f) {
+            const PetscInt face = faces[f];
+            PetscInt height;
+            DMPlexGetPointHeight(cellDm, face, &height) >> checkError;
+            if (height != 1) {
+                continue;
+            }
+
+            PetscInt supportSize;
+            const PetscInt *support;
+            DMPlexGetSupportSize(cellDm, face, &supportSize) >> checkError;
+            DMPlexGetSupport(cellDm, face, &support) >> checkError;
+            PetscInt cell = -1;
+            for (PetscInt s = 0; s < supportSize; ++s) {
+                if (support[s] >= cStart && support[s] < cEnd && globalCellNumber[support[s]] >= 0) {
+                    cell = support[s];
+                }
+            }
+            if (cell < 0) {
+                continue;
+            }
+
+            PetscReal area, centroid[3];
+            DMPlexComputeCellGeometryFVM(cellDm, face, &area, NULL, NULL) >> checkError;
+            DMPlexComputeCellGeometryFVM(cellDm, cell, NULL, centroid, NULL) >> checkError;
+
+            PetscInt closureSize = 0;
+            PetscScalar *closure = NULL;
+            DMPlexVecGetClosure(coordinateDm, coordinateSection, coordinates, face, &closureSize, &closure) >> checkError;
+            if (closureSize / dim < 2 || closureSize / dim > 4) {
+                throw std::invalid_argument("The boundary injector only supports segment, triangle, and quadrilateral faces");
+            }
+            faceVertices.insert(faceVertices.end(), closure, closure + closureSize);
+            DMPlexVecRestoreClosure(coordinateDm, coordinateSection, coordinates, face, &closureSize, &closure) >> checkError;
+
+            localArea += area;
+            faceCells.push_back(cell);
+            cumulativeArea.push_back(localArea);
+            faceVertexOffsets.push_back((PetscInt)faceVertices.size());
+            cellCentroids.insert(cellCentroids.end(), centroid, centroid + dim);
+        }
+        ISRestoreIndices(faceIS, &faces) >> checkError;
+        ISDestroy(&faceIS) >> checkError;
+    }
+    ISRestoreIndices(globalCellNumbers, &globalCellNumber) >> checkError;
+
+    // each rank holds a contiguous section of the global area
+    MPI_Comm comm = PetscObjectComm((PetscObject)cellDm);
+    MPI_Exscan(&localArea, &areaOffset, 1, MPIU_REAL, MPIU_SUM, comm) >> checkMpiError;
+    PetscMPIInt rank;
+    MPI_Comm_rank(comm, &rank) >> checkMpiError;
+    if (rank == 0) {
+        areaOffset = 0.0;
+    }
+    MPIU_Allreduce(&localArea, &totalArea, 1, MPIU_REAL, MPIU_SUM, comm) >> checkMpiError;
+}
+
+/**
+ * The area of the triangle (a, b, c) in 2 or 3 dimensions
+ */
+static PetscReal TriangleArea(PetscInt dim, const PetscReal *a, const PetscReal *b, const PetscReal *c) {
+    PetscReal ab[3] = {0.0, 0.0, 0.0}, ac[3] = {0.0, 0.0, 0.0};
+    for (PetscInt d = 0; d < dim; ++d) {
+        ab[d] = b[d] - a[d];
+        ac[d] = c[d] - a[d];
+    }
+    const PetscReal cross[3] = {ab[1] * ac[2] - ab[2] * ac[1], ab[2] * ac[0] - ab[0] * ac[2], ab[0] * ac[1] - ab[1] * ac[0]};
+    return 0.5 * PetscSqrtReal(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+}
+
+void ablate::particles::injectors::BoundaryInjector::Generate(PetscInt64 start, PetscInt count, std::vector<PetscReal> &coordinates, std::vector<PetscInt> &cells) {
+    if (faceCells.empty() || totalArea <= 0.0) {
+        return;
+    }
+    const PetscReal localArea = cumulativeArea.back();
+
+    // particle i is placed in the i-th of count equal strata of the global area, so only the strata over this rank's faces are generated
+    const PetscReal strataArea = totalArea / count;
+    const auto first = (PetscInt)PetscMax(0.0, PetscFloorReal(areaOffset / strataArea));
+    const auto last = (PetscInt)PetscMin((PetscReal)count, PetscCeilReal((areaOffset + localArea) / strataArea));
+    for (PetscInt i = first; i < last; ++i) {
+        const PetscReal areaPosition = (i + utilities::HashRandom::Uniform(start + i, 0, stream)) * strataArea - areaOffset;
+        if (areaPosition < 0.0 || areaPosition >= localArea) {
+            continue;
+        }
+        const auto f = (std::size_t)(std::upper_bound(cumulativeArea.begin(), cumulativeArea.end(), areaPosition) - cumulativeArea.begin());
+        const PetscReal *vertices = &faceVertices[faceVertexOffsets[f]];
+        const PetscInt numberVertices = (faceVertexOffsets[f + 1] - faceVertexOffsets[f]) / dim;
+
+        // pick a point uniformly distributed over the face area, quadrilaterals are split into two triangles chosen by their area
+        PetscReal s = utilities::HashRandom::Uniform(start + i, 1, stream);
+        PetscReal t = utilities::HashRandom::Uniform(start + i, 2, stream);
+        const PetscReal *a = vertices, *b = vertices + dim, *c = numberVertices > 2 ? vertices + 2 * dim : vertices;
+        if (numberVertices == 4) {
+            const PetscReal firstArea = TriangleArea(dim, vertices, vertices + dim, vertices + 2 * dim);
+            const PetscReal secondArea = TriangleArea(dim, vertices, vertices + 2 * dim, vertices + 3 * dim);
+            if (utilities::HashRandom::Uniform(start + i, 3, stream) * (firstArea + secondArea) >= firstArea) {
+                b = vertices + 2 * dim;
+                c = vertices + 3 * dim;
+            }
+        }
+        if (numberVertices > 2 && s + t > 1.0) {
+            s = 1.0 - s;
+            t = 1.0 - t;
+        }
+        PetscReal x[3];
+        for (PetscInt d = 0; d < dim; ++d) {
+            x[d] = a[d] + s * (b[d] - a[d]) + t * (c[d] - a[d]);
+        }
+
+        // move the point just inside of the interior cell
+        for (PetscInt d = 0; d < dim; ++d) {
+            x[d] += 1E-6 * (cellCentroids[f * dim + d] - x[d]);
+        }
+        coordinates.insert(coordinates.end(), x, x + dim);
+        cells.push_back(faceCells[f]);
+    }
+}
+
+#include "parser/registrar.hpp"
+REGISTER(ablate::particles::injectors::Injector, ablate::particles::injectors::BoundaryInjector, "injects particles uniformly distributed over labeled boundary faces",
+         ARG(double, "rate", "the number of particles injected per unit time"), ARG(std::vector<int>, "labelIds", "the label values of the injection faces"),
+         OPT(std::string, "labelName", "the face label (defaults to Face Sets)"),
+         OPT(std::vector<mathFunctions::FieldSolution>, "fieldInitialization", "the injected particle fields (defaults to the particle fieldInitialization)"));
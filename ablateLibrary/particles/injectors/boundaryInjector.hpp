@@ -0,0 +1,37 @@
+#ifndef ABLATELIBRARY_BOUNDARYINJECTOR_HPP
+#define ABLATELIBRARY_BOUNDARYINJECTOR_HPP
+#include "injector.hpp"
+
+namespace ablate::particles::injectors {
+/**
+ * Injection uniformly distributed over the boundary faces with the label values.  The particles are placed just inside of the interior cell of each face.  The
+ * particles injected each step are stratified over the global face area, so each rank only generates the particles on its section of the area.
+ */
+class BoundaryInjector : public Injector {
+   private:
+    const std::string labelName;
+    const std::vector<int> labelIds;
+
+    // the interior cell, cumulative area, and vertex coordinates of each local face (owned interior cell)
+    std::vector<PetscInt> faceCells;
+    std::vector<PetscReal> cumulativeArea;
+    std::vector<PetscInt> faceVertexOffsets;
+    std::vector<PetscReal> faceVertices;
+    std::vector<PetscReal> cellCentroids;
+
+    // the start of this rank's faces in the global area, and the total area
+    PetscReal areaOffset = 0.0;
+    PetscReal totalArea = 0.0;
+
+   protected:
+    void Generate(PetscInt64 start, PetscInt count, std::vector<PetscReal>& coordinates, std::vector<PetscInt>& cells) override;
+
+   public:
+    BoundaryInjector(double rate, std::vector<int> labelIds, std::string labelName = {}, std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization = {});
+    ~BoundaryInjector() override = default;
+
+    void Initialize(ablate::flow::Flow& flow, PetscInt64 stream) override;
+};
+}  // namespace ablate::particles::injectors
+
+#endif  // ABLATELIBRARY_BOUNDARYINJECTOR_HPP
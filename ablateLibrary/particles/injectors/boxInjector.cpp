@@ -0,0 +1,37 @@
+#include "boxInjector.hpp"
+
+ablate::particles::injectors::BoxInjector::BoxInjector(double rate, std::vector<double> lowerBound, std::vector<double> upperBound,
+                                                      std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization)
+    : VolumeInjector(rate, fieldInitialization), lowerBound(lowerBound), upperBound(upperBound) {}
+
+void ablate::particles::injectors::BoxInjector::Map(const PetscReal u[], PetscReal x[]) const {
+    for (PetscInt d = 0; d < dim; ++d) {
+        const PetscReal lower = d < (PetscInt)lowerBound.size() ? lowerBound[d] : 0.0;
+        const PetscReal upper = d < (PetscInt)upperBound.size() ? upperBound[d] : 0.0;
+        x[d] = lower + (upper - lower) * u[d];
+    }
+}
+
+void ablate::particles::injectors::BoxInjector::MapBounds(const PetscReal uLower[], const PetscReal uUpper[], PetscReal xLower[], PetscReal xUpper[]) const {
+    PetscReal xa[3], xb[3];
+    Map(uLower, xa);
+    Map(uUpper, xb);
+    for (PetscInt d = 0; d < dim; ++d) {
+        xLower[d] = PetscMin(xa[d], xb[d]);
+        xUpper[d] = PetscMax(xa[d], xb[d]);
+    }
+}
+
+void ablate::particles::injectors::BoxInjector::GetNumberBins(PetscReal cellSize, PetscInt bins[]) const {
+    for (PetscInt d = 0; d < dim; ++d) {
+        const PetscReal lower = d < (PetscInt)lowerBound.size() ? lowerBound[d] : 0.0;
+        const PetscReal upper = d < (PetscInt)upperBound.size() ? upperBound[d] : 0.0;
+        bins[d] = (PetscInt)PetscCeilReal(PetscAbsReal(upper - lower) / cellSize);
+    }
+}
+
+#include "parser/registrar.hpp"
+REGISTER(ablate::particles::injectors::Injector, ablate::particles::injectors::BoxInjector, "injects particles uniformly distributed inside of a box",
+         ARG(double, "rate", "the number of particles injected per unit time"), ARG(std::vector<double>, "lower", "the lower bound of the box"),
+         ARG(std::vector<double>, "upper", "the upper bound of the box"),
+         OPT(std::vector<mathFunctions::FieldSolution>, "fieldInitialization", "the injected particle fields (defaults to the particle fieldInitialization)"));
@@ -0,0 +1,25 @@
+#ifndef ABLATELIBRARY_BOXINJECTOR_HPP
+#define ABLATELIBRARY_BOXINJECTOR_HPP
+#include "volumeInjector.hpp"
+
+namespace ablate::particles::injectors {
+/**
+ * Volumetric injection uniformly distributed inside of a box
+ */
+class BoxInjector : public VolumeInjector {
+   private:
+    const std::vector<double> lowerBound;
+    const std::vector<double> upperBound;
+
+   protected:
+    void Map(const PetscReal u[], PetscReal x[]) const override;
+    void MapBounds(const PetscReal uLower[], const PetscReal uUpper[], PetscReal xLower[], PetscReal xUpper[]) const override;
+    void GetNumberBins(PetscReal cellSize, PetscInt bins[]) const override;
+
+   public:
+    BoxInjector(double rate, std::vector<double> lowerBound, std::vector<double> upperBound, std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization = {});
+    ~BoxInjector() override = default;
+};
+}  // namespace ablate::particles::injectors
+
+#endif  // ABLATELIBRARY_BOXINJECTOR_HPP
@@ -0,0 +1,79 @@
+#include "injector.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::particles::injectors::Injector::Injector(double rate, std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization)
+    : rate(rate), fieldInitialization(fieldInitialization) {}
+
+void ablate::particles::injectors::Injector::Initialize(ablate::flow::Flow &flow, PetscInt64 streamIn) {
+    cellDm = flow.GetDM();
+    stream = streamIn;
+    DMGetDimension(cellDm, &dim) >> checkError;
+}
+
+void ablate::particles::injectors::Injector::Inject(PetscReal dt, std::vector<PetscReal> &coordinates, std::vector<PetscInt> &cells) {
+    const PetscReal expected = rate * dt + carry;
+    const auto count = (PetscInt)PetscFloorReal(expected);
+    carry = expected - count;
+    if (count > 0) {
+        Generate(injected, count, coordinates, cells);
+    }
+    injected += count;
+}
+
+void ablate::particles::injectors::Injector::KeepOwned(const std::vector<PetscReal> &candidates, std::vector<PetscReal> &coordinates, std::vector<PetscInt> &cells) const {
+    // only locate the candidates that can be inside of this rank's local domain
+    PetscReal localLower[3], localUpper[3], globalLower[3], globalUpper[3];
+    DMGetLocalBoundingBox(cellDm, localLower, localUpper) >> checkError;
+    DMGetBoundingBox(cellDm, globalLower, globalUpper) >> checkError;
+
+    // points are located after a small nudge in a generic direction so that points on shared faces are claimed by exactly one rank
+    PetscReal nudge[3] = {0.0, 0.0, 0.0};
+    for (PetscInt d = 0; d < dim; ++d) {
+        nudge[d] = 1E-8 * (globalUpper[d] - globalLower[d]) / (PetscReal)(1 << d);
+    }
+
+    std::vector<std::size_t> localCandidates;
+    std::vector<PetscReal> nudgedCoordinates;
+    const auto numberCandidates = candidates.size() / dim;
+    for (std::size_t c = 0; c < numberCandidates; ++c) {
+        const PetscReal *x = &candidates[c * dim];
+        bool inside = true;
+        for (PetscInt d = 0; d < dim; ++d) {
+            const PetscReal tolerance = PETSC_SMALL * PetscMax(1.0, globalUpper[d] - globalLower[d]);
+            inside = inside && x[d] >= localLower[d] - tolerance && x[d] <= localUpper[d] + tolerance;
+        }
+        if (inside) {
+            localCandidates.push_back(c);
+            for (PetscInt d = 0; d < dim; ++d) {
+                nudgedCoordinates.push_back(x[d] + nudge[d] > globalUpper[d] ? x[d] - nudge[d] : x[d] + nudge[d]);
+            }
+        }
+    }
+    if (localCandidates.empty()) {
+        return;
+    }
+
+    Vec pointVec;
+    VecCreateSeqWithArray(PETSC_COMM_SELF, dim, (PetscInt)nudgedCoordinates.size(), nudgedCoordinates.data(), &pointVec) >> checkError;
+    PetscSF cellSF = NULL;
+    DMLocatePoints(cellDm, pointVec, DM_POINTLOCATION_NONE, &cellSF) >> checkError;
+    const PetscSFNode *foundCells;
+    PetscSFGetGraph(cellSF, NULL, NULL, NULL, &foundCells) >> checkError;
+
+    PetscInt cStart, cEnd;
+    DMPlexGetSimplexOrBoxCells(cellDm, 0, &cStart, &cEnd) >> checkError;
+    IS globalCellNumbers;
+    const PetscInt *globalCellNumber;
+    DMPlexGetCellNumbering(cellDm, &globalCellNumbers) >> checkError;
+    ISGetIndices(globalCellNumbers, &globalCellNumber) >> checkError;
+    for (std::size_t i = 0; i < localCandidates.size(); ++i) {
+        const PetscInt cell = foundCells[i].index;
+        if (cell >= cStart && cell < cEnd && globalCellNumber[cell] >= 0) {
+            coordinates.insert(coordinates.end(), &candidates[localCandidates[i] * dim], &candidates[localCandidates[i] * dim] + dim);
+            cells.push_back(cell);
+        }
+    }
+    ISRestoreIndices(globalCellNumbers, &globalCellNumber) >> checkError;
+    PetscSFDestroy(&cellSF) >> checkError;
+    VecDestroy(&pointVec) >> checkError;
+}
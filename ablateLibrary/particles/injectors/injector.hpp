@@ -0,0 +1,90 @@
+#ifndef ABLATELIBRARY_INJECTOR_HPP
+#define ABLATELIBRARY_INJECTOR_HPP
+#include <memory>
+#include <vector>
+#include "flow/flow.hpp"
+#include "mathFunctions/fieldSolution.hpp"
+
+namespace ablate::particles::injectors {
+/**
+ * Adds particles to the domain at a constant rate.  The number of particles injected each step is the same on every rank (the fractional particles carry over
+ * to the next step) and each particle is generated from its global injection index.  Each rank only generates the particles that can be inside of its local
+ * domain and keeps the particles in the cells it owns, so no migration is needed.
+ */
+class Injector {
+   private:
+    // the number of particles injected per unit time
+    const PetscReal rate;
+
+    // the fractional particles not yet injected
+    PetscReal carry = 0.0;
+
+    // the total number of particles injected by this injector
+    PetscInt64 injected = 0;
+
+    // optional field initialization for the injected particles
+    const std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization;
+
+   protected:
+    DM cellDm = NULL;
+    PetscInt dim = 0;
+
+    // the random stream used by this injector
+    PetscInt64 stream = 0;
+
+    /**
+     * Locates the candidate particles and keeps the ones inside of the cells owned by this rank
+     * @param candidates the coordinates of the candidate particles
+     * @param coordinates the coordinates of the kept particles are added here
+     * @param cells the owned cell of each kept particle is added here
+     */
+    void KeepOwned(const std::vector<PetscReal>& candidates, std::vector<PetscReal>& coordinates, std::vector<PetscInt>& cells) const;
+
+    /**
+     * Adds the particles with a global injection index in [start, start + count) that are placed on this rank
+     * @param start the first global injection index
+     * @param count the number of particles injected on all ranks
+     * @param coordinates the coordinates of the particles placed on this rank are added here
+     * @param cells the owned cell of each particle is added here
+     */
+    virtual void Generate(PetscInt64 start, PetscInt count, std::vector<PetscReal>& coordinates, std::vector<PetscInt>& cells) = 0;
+
+   public:
+    Injector(double rate, std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization);
+    virtual ~Injector() = default;
+
+    /**
+     * Setup the injector with the flow domain
+     * @param flow
+     * @param stream the random stream used by this injector, so that injectors do not generate correlated particles
+     */
+    virtual void Initialize(ablate::flow::Flow& flow, PetscInt64 stream);
+
+    /**
+     * Adds the particles injected on this rank over the time step
+     * @param dt the time step
+     * @param coordinates the coordinates of the injected particles are added here
+     * @param cells the owned cell of each injected particle is added here
+     */
+    void Inject(PetscReal dt, std::vector<PetscReal>& coordinates, std::vector<PetscInt>& cells);
+
+    /**
+     * The injection state (the fractional particles and the total injected) kept between steps, used to checkpoint the injector
+     */
+    void GetState(PetscReal& carryOut, PetscInt64& injectedOut) const {
+        carryOut = carry;
+        injectedOut = injected;
+    }
+    void SetState(PetscReal carryIn, PetscInt64 injectedIn) {
+        carry = carryIn;
+        injected = injectedIn;
+    }
+
+    /**
+     * The field initialization for the injected particles.  If empty the field initialization of the particles is used.
+     */
+    const std::vector<std::shared_ptr<mathFunctions::FieldSolution>>& GetFieldInitialization() const { return fieldInitialization; }
+};
+}  // namespace ablate::particles::injectors
+
+#endif  // ABLATELIBRARY_INJECTOR_HPP
@@ -0,0 +1,111 @@
+#include "pointInjector.hpp"
+
+ablate::particles::injectors::PointInjector::PointInjector(double rate, std::vector<double> position, double radius,
+                                                          std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization)
+    : VolumeInjector(rate, fieldInitialization), position(position), radius(radius) {}
+
+void ablate::particles::injectors::PointInjector::Map(const PetscReal u[], PetscReal x[]) const {
+    // the offset from the point, uniformly distributed inside of the ball
+    PetscReal offset[3] = {0.0, 0.0, 0.0};
+    switch (dim) {
+        case 1:
+            offset[0] = radius * (2.0 * u[0] - 1.0);
+            break;
+        case 2: {
+            const PetscReal r = radius * PetscSqrtReal(u[0]);
+            offset[0] = r * PetscCosReal(2.0 * PETSC_PI * u[1]);
+            offset[1] = r * PetscSinReal(2.0 * PETSC_PI * u[1]);
+        } break;
+        default: {
+            const PetscReal r = radius * PetscCbrtReal(u[0]);
+            const PetscReal cosPhi = 2.0 * u[1] - 1.0;
+            const PetscReal sinPhi = PetscSqrtReal(1.0 - cosPhi * cosPhi);
+            offset[0] = r * sinPhi * PetscCosReal(2.0 * PETSC_PI * u[2]);
+            offset[1] = r * sinPhi * PetscSinReal(2.0 * PETSC_PI * u[2]);
+            offset[2] = r * cosPhi;
+        }
+    }
+
+    for (PetscInt d = 0; d < dim; ++d) {
+        x[d] = (d < (PetscInt)position.size() ? position[d] : 0.0) + offset[d];
+    }
+}
+
+/**
+ * Computes the bounding box of the annular sector with radius in [r0, r1] and angle in [theta0, theta1]
+ */
+static void SectorBounds(PetscReal r0, PetscReal r1, PetscReal theta0, PetscReal theta1, PetscReal lower[2], PetscReal upper[2]) {
+    // the extremes are at the corners or at the axis angles inside of the sector
+    std::vector<PetscReal> angles = {theta0, theta1};
+    for (PetscInt k = (PetscInt)PetscCeilReal(2.0 * theta0 / PETSC_PI); k * PETSC_PI / 2.0 <= theta1; ++k) {
+        angles.push_back(k * PETSC_PI / 2.0);
+    }
+    lower[0] = lower[1] = PETSC_MAX_REAL;
+    upper[0] = upper[1] = PETSC_MIN_REAL;
+    for (const auto angle : angles) {
+        for (const auto r : {r0, r1}) {
+            const PetscReal x[2] = {r * PetscCosReal(angle), r * PetscSinReal(angle)};
+            for (PetscInt d = 0; d < 2; ++d) {
+                lower[d] = PetscMin(lower[d], x[d]);
+                upper[d] = PetscMax(upper[d], x[d]);
+            }
+        }
+    }
+}
+
+void ablate::particles::injectors::PointInjector::MapBounds(const PetscReal uLower[], const PetscReal uUpper[], PetscReal xLower[], PetscReal xUpper[]) const {
+    PetscReal lower[3] = {0.0, 0.0, 0.0}, upper[3] = {0.0, 0.0, 0.0};
+    switch (dim) {
+        case 1:
+            lower[0] = radius * (2.0 * uLower[0] - 1.0);
+            upper[0] = radius * (2.0 * uUpper[0] - 1.0);
+            break;
+        case 2:
+            SectorBounds(radius * PetscSqrtReal(uLower[0]), radius * PetscSqrtReal(uUpper[0]), 2.0 * PETSC_PI * uLower[1], 2.0 * PETSC_PI * uUpper[1], lower, upper);
+            break;
+        default: {
+            const PetscReal r0 = radius * PetscCbrtReal(uLower[0]);
+            const PetscReal r1 = radius * PetscCbrtReal(uUpper[0]);
+            const PetscReal cos0 = 2.0 * uLower[1] - 1.0;
+            const PetscReal cos1 = 2.0 * uUpper[1] - 1.0;
+
+            // z = r cos(phi) is extreme at the corners
+            lower[2] = PetscMin(PetscMin(r0 * cos0, r0 * cos1), PetscMin(r1 * cos0, r1 * cos1));
+            upper[2] = PetscMax(PetscMax(r0 * cos0, r0 * cos1), PetscMax(r1 * cos0, r1 * cos1));
+
+            // the distance from the axis, r sin(phi), bounds the sector in x and y
+            const PetscReal sinMin = PetscSqrtReal(PetscMax(0.0, 1.0 - PetscMax(cos0 * cos0, cos1 * cos1)));
+            const PetscReal sinMax = cos0 <= 0.0 && cos1 >= 0.0 ? 1.0 : PetscSqrtReal(PetscMax(0.0, 1.0 - PetscMin(cos0 * cos0, cos1 * cos1)));
+            SectorBounds(r0 * sinMin, r1 * sinMax, 2.0 * PETSC_PI * uLower[2], 2.0 * PETSC_PI * uUpper[2], lower, upper);
+        }
+    }
+
+    for (PetscInt d = 0; d < dim; ++d) {
+        const PetscReal center = d < (PetscInt)position.size() ? position[d] : 0.0;
+        xLower[d] = center + lower[d];
+        xUpper[d] = center + upper[d];
+    }
+}
+
+void ablate::particles::injectors::PointInjector::GetNumberBins(PetscReal cellSize, PetscInt bins[]) const {
+    // the radial, polar, and azimuthal directions
+    switch (dim) {
+        case 1:
+            bins[0] = (PetscInt)PetscCeilReal(2.0 * radius / cellSize);
+            break;
+        case 2:
+            bins[0] = (PetscInt)PetscCeilReal(radius / cellSize);
+            bins[1] = (PetscInt)PetscCeilReal(2.0 * PETSC_PI * radius / cellSize);
+            break;
+        default:
+            bins[0] = (PetscInt)PetscCeilReal(radius / cellSize);
+            bins[1] = (PetscInt)PetscCeilReal(2.0 * radius / cellSize);
+            bins[2] = (PetscInt)PetscCeilReal(2.0 * PETSC_PI * radius / cellSize);
+    }
+}
+
+#include "parser/registrar.hpp"
+REGISTER(ablate::particles::injectors::Injector, ablate::particles::injectors::PointInjector, "injects particles at a point or uniformly distributed inside of a sphere around the point",
+         ARG(double, "rate", "the number of particles injected per unit time"), ARG(std::vector<double>, "position", "the injection point"),
+         OPT(double, "radius", "the radius of the injection sphere around the point (default 0)"),
+         OPT(std::vector<mathFunctions::FieldSolution>, "fieldInitialization", "the injected particle fields (defaults to the particle fieldInitialization)"));
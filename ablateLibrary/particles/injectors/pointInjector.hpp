@@ -0,0 +1,25 @@
+#ifndef ABLATELIBRARY_POINTINJECTOR_HPP
+#define ABLATELIBRARY_POINTINJECTOR_HPP
+#include "volumeInjector.hpp"
+
+namespace ablate::particles::injectors {
+/**
+ * Injection at a point, uniformly distributed inside of a sphere (3D) or disk (2D) around the point when the radius is non zero
+ */
+class PointInjector : public VolumeInjector {
+   private:
+    const std::vector<double> position;
+    const double radius;
+
+   protected:
+    void Map(const PetscReal u[], PetscReal x[]) const override;
+    void MapBounds(const PetscReal uLower[], const PetscReal uUpper[], PetscReal xLower[], PetscReal xUpper[]) const override;
+    void GetNumberBins(PetscReal cellSize, PetscInt bins[]) const override;
+
+   public:
+    PointInjector(double rate, std::vector<double> position, double radius = 0.0, std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization = {});
+    ~PointInjector() override = default;
+};
+}  // namespace ablate::particles::injectors
+
+#endif  // ABLATELIBRARY_POINTINJECTOR_HPP
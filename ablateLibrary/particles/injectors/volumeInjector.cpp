@@ -0,0 +1,98 @@
+#include "volumeInjector.hpp"
+#include <numeric>
+#include "utilities/hashRandom.hpp"
+#include "utilities/mpiError.hpp"
+#include "utilities/petscError.hpp"
+
+void ablate::particles::injectors::VolumeInjector::Initialize(ablate::flow::Flow &flow, PetscInt64 streamIn) {
+    Injector::Initialize(flow, streamIn);
+
+    // estimate the cell size from the global domain
+    PetscReal globalLower[3], globalUpper[3], localLower[3], localUpper[3];
+    DMGetBoundingBox(cellDm, globalLower, globalUpper) >> checkError;
+    DMGetLocalBoundingBox(cellDm, localLower, localUpper) >> checkError;
+
+    PetscInt cStart, cEnd;
+    DMPlexGetSimplexOrBoxCells(cellDm, 0, &cStart, &cEnd) >> checkError;
+    IS globalCellNumbers;
+    const PetscInt *globalCellNumber;
+    DMPlexGetCellNumbering(cellDm, &globalCellNumbers) >> checkError;
+    ISGetIndices(globalCellNumbers, &globalCellNumber) >> checkError;
+    PetscInt localCells = 0, globalCells;
+    for (PetscInt c = cStart; c < cEnd; ++c) {
+        localCells += globalCellNumber[c] >= 0 ? 1 : 0;
+    }
+    ISRestoreIndices(globalCellNumbers, &globalCellNumber) >> checkError;
+    MPIU_Allreduce(&localCells, &globalCells, 1, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject)cellDm)) >> checkMpiError;
+
+    PetscReal domainVolume = 1.0;
+    for (PetscInt d = 0; d < dim; ++d) {
+        domainVolume *= globalUpper[d] - globalLower[d];
+    }
+    GetNumberBins(PetscPowReal(domainVolume / PetscMax(globalCells, 1), 1.0 / dim), numberBins);
+    totalBins = 1;
+    for (PetscInt d = 0; d < dim; ++d) {
+        numberBins[d] = PetscMax(numberBins[d], 1);
+        totalBins *= numberBins[d];
+    }
+
+    // the golden ratio stride visits nearby bins far apart in the order
+    binStride = PetscMax((PetscInt64)(0.6180339887 * (PetscReal)totalBins), 1);
+    while (std::gcd(binStride, totalBins) != 1) {
+        binStride++;
+    }
+
+    // find the bins that overlap this rank's local domain once
+    localBins.clear();
+    for (PetscInt64 bin = 0; bin < totalBins; ++bin) {
+        PetscReal uLower[3] = {0.0, 0.0, 0.0}, uUpper[3] = {0.0, 0.0, 0.0};
+        PetscInt64 index = bin;
+        for (PetscInt d = 0; d < dim; ++d) {
+            uLower[d] = (PetscReal)(index % numberBins[d]) / numberBins[d];
+            uUpper[d] = (PetscReal)(index % numberBins[d] + 1) / numberBins[d];
+            index /= numberBins[d];
+        }
+        PetscReal xLower[3], xUpper[3];
+        MapBounds(uLower, uUpper, xLower, xUpper);
+
+        bool overlaps = true;
+        for (PetscInt d = 0; d < dim; ++d) {
+            const PetscReal tolerance = PETSC_SMALL * PetscMax(1.0, globalUpper[d] - globalLower[d]);
+            overlaps = overlaps && xUpper[d] >= localLower[d] - tolerance && xLower[d] <= localUpper[d] + tolerance;
+        }
+        if (overlaps) {
+            localBins.push_back(bin);
+        }
+    }
+}
+
+void ablate::particles::injectors::VolumeInjector::Generate(PetscInt64 start, PetscInt count, std::vector<PetscReal> &coordinates, std::vector<PetscInt> &cells) {
+    // each bin gets the same number of particles, and the remaining particles go to the first bins in the order (which is shifted every step)
+    const PetscInt64 binCountAll = count / totalBins;
+    const PetscInt64 remaining = count % totalBins;
+
+    std::vector<PetscReal> candidates;
+    for (const auto bin : localBins) {
+        // the global injection index of particle j in the bin is start + j * totalBins + order
+        const PetscInt64 order = ((bin * binStride) % totalBins - start % totalBins + totalBins) % totalBins;
+        const PetscInt64 binCount = binCountAll + (order < remaining ? 1 : 0);
+
+        PetscInt64 binIndex[3] = {0, 0, 0};
+        PetscInt64 index = bin;
+        for (PetscInt d = 0; d < dim; ++d) {
+            binIndex[d] = index % numberBins[d];
+            index /= numberBins[d];
+        }
+
+        for (PetscInt64 j = 0; j < binCount; ++j) {
+            const PetscInt64 injectionIndex = start + j * totalBins + order;
+            PetscReal u[3] = {0.0, 0.0, 0.0}, x[3];
+            for (PetscInt d = 0; d < dim; ++d) {
+                u[d] = ((PetscReal)binIndex[d] + utilities::HashRandom::Uniform(injectionIndex, d, stream)) / numberBins[d];
+            }
+            Map(u, x);
+            candidates.insert(candidates.end(), x, x + dim);
+        }
+    }
+    KeepOwned(candidates, coordinates, cells);
+}
@@ -0,0 +1,57 @@
+#ifndef ABLATELIBRARY_VOLUMEINJECTOR_HPP
+#define ABLATELIBRARY_VOLUMEINJECTOR_HPP
+#include "injector.hpp"
+
+namespace ablate::particles::injectors {
+/**
+ * Injection uniformly distributed inside of a volume mapped from the unit cube.  The unit cube is split into bins about the size of the mesh cells, and the
+ * particles injected each step are spread evenly over the bins (the remaining particles go to bins spread over the volume).  Each rank only generates the
+ * particles in the bins that overlap its local domain.  The particles only depend upon their global injection index, so they do not depend upon the partition.
+ */
+class VolumeInjector : public Injector {
+   private:
+    // the number of bins in each direction of the unit cube
+    PetscInt numberBins[3] = {1, 1, 1};
+    PetscInt64 totalBins = 1;
+
+    // the stride (coprime with the total bins) used to order the bins, so that the remaining particles each step are spread over the volume
+    PetscInt64 binStride = 1;
+
+    // the bins that overlap this rank's local domain
+    std::vector<PetscInt64> localBins;
+
+   protected:
+    /**
+     * Maps a point in the unit cube to the volume.  The map must preserve relative volumes so that uniform points in the unit cube are uniform in the volume.
+     * @param u the point in the unit cube
+     * @param x the point in the volume
+     */
+    virtual void Map(const PetscReal u[], PetscReal x[]) const = 0;
+
+    /**
+     * Computes a bounding box of the part of the volume mapped from a box in the unit cube
+     * @param uLower the lower corner of the box in the unit cube
+     * @param uUpper the upper corner of the box in the unit cube
+     * @param xLower the lower corner of the bounding box
+     * @param xUpper the upper corner of the bounding box
+     */
+    virtual void MapBounds(const PetscReal uLower[], const PetscReal uUpper[], PetscReal xLower[], PetscReal xUpper[]) const = 0;
+
+    /**
+     * Computes the number of bins in each direction of the unit cube so that each bin is about the cell size
+     * @param cellSize the approximate size of the mesh cells
+     * @param bins the number of bins in each direction
+     */
+    virtual void GetNumberBins(PetscReal cellSize, PetscInt bins[]) const = 0;
+
+    void Generate(PetscInt64 start, PetscInt count, std::vector<PetscReal>& coordinates, std::vector<PetscInt>& cells) override;
+
+   public:
+    using Injector::Injector;
+    ~VolumeInjector() override = default;
+
+    void Initialize(ablate::flow::Flow& flow, PetscInt64 stream) override;
+};
+}  // namespace ablate::particles::injectors
+
+#endif  // ABLATELIBRARY_VOLUMEINJECTOR_HPP
@@ -0,0 +1,354 @@
+#include "particleInterpolator.hpp"
+#include "utilities/petscError.hpp"
+
+ablate::particles::ParticleInterpolator::ParticleInterpolator(DM dm, PetscInt field, Vec sourceIn, bool localSource) : sourceDM(dm), source(sourceIn) {
+    DMGetDimension(dm, &dim) >> checkError;
+
+    // a local source is copied to a global vector for the scatter
+    if (localSource) {
+        sourceLocal = sourceIn;
+        DMCreateGlobalVector(dm, &source) >> checkError;
+    }
+
+    // create the sub dm, vectors, and scatter once
+    PetscInt fields[1] = {field};
+    DMCreateSubDM(dm, 1, fields, &subIS, &subDM) >> checkError;
+    DMCreateGlobalVector(subDM, &subGlobal) >> checkError;
+    DMCreateLocalVector(subDM, &initialLocal) >> checkError;
+    DMCreateLocalVector(subDM, &finalLocal) >> checkError;
+    DMCreateLocalVector(subDM, &blendedLocal) >> checkError;
+    VecScatterCreate(source, subIS, subGlobal, NULL, &subScatter) >> checkError;
+
+    // determine the number of components in the field
+    PetscSection section;
+    DMGetLocalSection(subDM, &section) >> checkError;
+    PetscSectionGetFieldComponents(section, 0, &dof) >> checkError;
+
+    // the field is evaluated directly from its discretization in each located cell
+    DMGetField(subDM, 0, NULL, &discretization) >> checkError;
+    PetscObjectGetClassId(discretization, &discretizationId) >> checkError;
+    if (discretizationId != PETSCFE_CLASSID && discretizationId != PETSCFV_CLASSID) {
+        throw std::invalid_argument("The particle interpolator requires a finite element or finite volume field");
+    }
+
+    // store the face neighbors and centroid of each local cell
+    DMPlexGetSimplexOrBoxCells(subDM, 0, &cStart, &cEnd) >> checkError;
+
+    // cells without a global number are owned by another rank
+    IS globalCellNumbers;
+    const PetscInt* globalCellNumber;
+    DMPlexGetCellNumbering(dm, &globalCellNumbers) >> checkError;
+    ISGetIndices(globalCellNumbers, &globalCellNumber) >> checkError;
+    ownedCells.resize(cEnd - cStart);
+    for (PetscInt c = cStart; c < cEnd; ++c) {
+        ownedCells[c - cStart] = globalCellNumber[c - cStart] >= 0;
+    }
+    ISRestoreIndices(globalCellNumbers, &globalCellNumber) >> checkError;
+
+    neighborOffsets.reserve(cEnd - cStart + 1);
+    centroids.resize((cEnd - cStart) * dim);
+    volumes.resize(cEnd - cStart);
+    for (PetscInt c = cStart; c < cEnd; ++c) {
+        neighborOffsets.push_back((PetscInt)neighbors.size());
+
+        PetscReal centroid[3];
+        DMPlexComputeCellGeometryFVM(subDM, c, &volumes[c - cStart], centroid, NULL) >> checkError;
+        for (PetscInt d = 0; d < dim; ++d) {
+            centroids[(c - cStart) * dim + d] = centroid[d];
+        }
+
+        PetscInt coneSize;
+        const PetscInt* cone;
+        DMPlexGetConeSize(subDM, c, &coneSize) >> checkError;
+        DMPlexGetCone(subDM, c, &cone) >> checkError;
+        for (PetscInt f = 0; f < coneSize; ++f) {
+            PetscInt supportSize;
+            const PetscInt* support;
+            DMPlexGetSupportSize(subDM, cone[f], &supportSize) >> checkError;
+            DMPlexGetSupport(subDM, cone[f], &support) >> checkError;
+            for (PetscInt s = 0; s < supportSize; ++s) {
+                if (support[s] != c && support[s] >= cStart && support[s] < cEnd) {
+                    neighbors.push_back(support[s]);
+                }
+            }
+        }
+    }
+    neighborOffsets.push_back((PetscInt)neighbors.size());
+}
+
+ablate::particles::ParticleInterpolator::~ParticleInterpolator() {
+    if (tabulation) {
+        PetscTabulationDestroy(&tabulation) >> checkError;
+    }
+    if (subScatter) {
+        VecScatterDestroy(&subScatter) >> checkError;
+    }
+    if (subGlobal) {
+        VecDestroy(&subGlobal) >> checkError;
+    }
+    if (initialLocal) {
+        VecDestroy(&initialLocal) >> checkError;
+    }
+    if (finalLocal) {
+        VecDestroy(&finalLocal) >> checkError;
+    }
+    if (blendedLocal) {
+        VecDestroy(&blendedLocal) >> checkError;
+    }
+    if (subIS) {
+        ISDestroy(&subIS) >> checkError;
+    }
+    if (subDM) {
+        DMDestroy(&subDM) >> checkError;
+    }
+    if (sourceLocal) {
+        VecDestroy(&source) >> checkError;
+    }
+}
+
+std::shared_ptr<ablate::particles::ParticleInterpolator> ablate::particles::ParticleInterpolator::GetFlowVelocityInterpolator(ablate::flow::Flow& flow) {
+    // reuse the interpolator if another particle group is still using it
+    PetscObject flowDm = (PetscObject)flow.GetDM();
+    PetscContainer referenceContainer = NULL;
+    PetscObjectQuery(flowDm, flowVelocityInterpolatorName, (PetscObject*)&referenceContainer) >> checkError;
+    if (referenceContainer) {
+        std::weak_ptr<ParticleInterpolator>* reference;
+        PetscContainerGetPointer(referenceContainer, (void**)&reference) >> checkError;
+        if (auto interpolator = reference->lock()) {
+            return interpolator;
+        }
+    }
+
+    std::shared_ptr<ParticleInterpolator> interpolator;
+    if (auto velocityField = flow.GetFieldId("velocity")) {
+        interpolator = std::make_shared<ParticleInterpolator>(flow.GetDM(), velocityField.value(), flow.GetSolutionVector());
+    } else if (auto velocityAuxField = flow.GetAuxFieldId("vel")) {
+        interpolator = std::make_shared<ParticleInterpolator>(flow.GetAuxDM(), velocityAuxField.value(), flow.GetAuxField(), true);
+    } else {
+        throw std::invalid_argument("The flow " + flow.GetName() + " does not have a velocity field or vel aux field for the particles");
+    }
+
+    // hold a weak reference with the flow dm so that it is removed with the dm and cannot be found from a reused dm address
+    PetscContainerCreate(PetscObjectComm(flowDm), &referenceContainer) >> checkError;
+    PetscContainerSetPointer(referenceContainer, new std::weak_ptr<ParticleInterpolator>(interpolator)) >> checkError;
+    PetscContainerSetUserDestroy(referenceContainer, DestroyFlowVelocityInterpolatorReference) >> checkError;
+    PetscObjectCompose(flowDm, flowVelocityInterpolatorName, (PetscObject)referenceContainer) >> checkError;
+    PetscContainerDestroy(&referenceContainer) >> checkError;
+    return interpolator;
+}
+
+PetscErrorCode ablate::particles::ParticleInterpolator::DestroyFlowVelocityInterpolatorReference(void* reference) {
+    PetscFunctionBeginUser;
+    delete (std::weak_ptr<ParticleInterpolator>*)reference;
+    PetscFunctionReturn(0);
+}
+
+void ablate::particles::ParticleInterpolator::Advance(PetscReal time) {
+    if (advanced && time == timeFinal) {
+        return;
+    }
+
+    // the aux field is updated in the flow rhs, so it holds the velocity from the last evaluation
+    if (sourceLocal) {
+        DMLocalToGlobal(sourceDM, sourceLocal, INSERT_VALUES, source) >> checkError;
+    }
+
+    if (advanced) {
+        // the previous end becomes the start of the window
+        std::swap(initialLocal, finalLocal);
+        timeInitial = timeFinal;
+        UpdateLocalField(finalLocal, time);
+    } else {
+        UpdateLocalField(finalLocal, time);
+        VecCopy(finalLocal, initialLocal) >> checkError;
+        timeInitial = time;
+        advanced = true;
+    }
+    timeFinal = time;
+    blendedAlpha = -1.0;
+}
+
+void ablate::particles::ParticleInterpolator::UpdateLocalField(Vec local, PetscReal time) {
+    VecScatterBegin(subScatter, source, subGlobal, INSERT_VALUES, SCATTER_FORWARD) >> checkError;
+    VecScatterEnd(subScatter, source, subGlobal, INSERT_VALUES, SCATTER_FORWARD) >> checkError;
+    DMPlexInsertBoundaryValues(subDM, PETSC_TRUE, local, time, NULL, NULL, NULL) >> checkError;
+    DMGlobalToLocalBegin(subDM, subGlobal, INSERT_VALUES, local) >> checkError;
+    DMGlobalToLocalEnd(subDM, subGlobal, INSERT_VALUES, local) >> checkError;
+}
+
+bool ablate::particles::ParticleInterpolator::InCell(PetscInt cell, const PetscReal* point) const {
+    DMPolytopeType cellType;
+    DMPlexGetCellType(subDM, cell, &cellType) >> checkError;
+
+    PetscReal reference[3];
+    DMPlexCoordinatesToReference(subDM, cell, 1, point, reference) >> checkError;
+
+    // the reference simplex has vertices at -1 and 1 (sum of coordinates <= 2 - dim), the reference tensor cell is [-1, 1]^dim
+    switch (cellType) {
+        case DM_POLYTOPE_SEGMENT:
+        case DM_POLYTOPE_TRIANGLE:
+        case DM_POLYTOPE_TETRAHEDRON: {
+            PetscReal sum = 0.0;
+            for (PetscInt d = 0; d < dim; ++d) {
+                if (reference[d] < -1.0 - PETSC_SMALL) {
+                    return false;
+                }
+                sum += reference[d];
+            }
+            return sum <= 2.0 - dim + PETSC_SMALL;
+        }
+        case DM_POLYTOPE_QUADRILATERAL:
+        case DM_POLYTOPE_HEXAHEDRON:
+            for (PetscInt d = 0; d < dim; ++d) {
+                if (PetscAbsReal(reference[d]) > 1.0 + PETSC_SMALL) {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            // other cell types always use the full search
+            return false;
+    }
+}
+
+PetscInt ablate::particles::ParticleInterpolator::Walk(PetscInt hint, const PetscReal* point) const {
+    if (hint < cStart || hint >= cEnd) {
+        return -1;
+    }
+    if (InCell(hint, point)) {
+        return hint;
+    }
+
+    // march through the face neighbors, always moving to the neighbor closest to the point
+    PetscInt cell = hint;
+    for (PetscInt step = 0; step < maxWalkSteps; ++step) {
+        PetscInt next = -1;
+        PetscReal nextDistance = PETSC_MAX_REAL;
+        for (PetscInt n = neighborOffsets[cell - cStart]; n < neighborOffsets[cell - cStart + 1]; ++n) {
+            const PetscInt neighbor = neighbors[n];
+            if (InCell(neighbor, point)) {
+                return neighbor;
+            }
+
+            PetscReal distance = 0.0;
+            for (PetscInt d = 0; d < dim; ++d) {
+                distance += PetscSqr(centroids[(neighbor - cStart) * dim + d] - point[d]);
+            }
+            if (distance < nextDistance) {
+                nextDistance = distance;
+                next = neighbor;
+            }
+        }
+        if (next < 0) {
+            return -1;
+        }
+        cell = next;
+    }
+    return -1;
+}
+
+void ablate::particles::ParticleInterpolator::Locate(PetscInt np, const PetscReal* coordinates, PetscInt stride, PetscInt* cells) {
+    // walk from the hint for each point, storing the points that need a full search
+    searchParticles.clear();
+    searchCoordinates.clear();
+    for (PetscInt p = 0; p < np; ++p) {
+        const PetscReal* point = coordinates + p * stride;
+        cells[p] = Walk(cells[p], point);
+        if (cells[p] < 0) {
+            searchParticles.push_back(p);
+            searchCoordinates.insert(searchCoordinates.end(), point, point + dim);
+        }
+    }
+
+    if (searchParticles.empty()) {
+        return;
+    }
+
+    // fall back to a full search for the remaining points
+    Vec pointVec;
+    VecCreateSeqWithArray(PETSC_COMM_SELF, dim, (PetscInt)searchCoordinates.size(), searchCoordinates.data(), &pointVec) >> checkError;
+    PetscSF cellSF = NULL;
+    DMLocatePoints(subDM, pointVec, DM_POINTLOCATION_NONE, &cellSF) >> checkError;
+    const PetscSFNode* foundCells;
+    PetscSFGetGraph(cellSF, NULL, NULL, NULL, &foundCells) >> checkError;
+
+    for (std::size_t i = 0; i < searchParticles.size(); ++i) {
+        const PetscInt cell = foundCells[i].index;
+        cells[searchParticles[i]] = cell >= cStart && cell < cEnd ? cell : -1;
+    }
+
+    PetscSFDestroy(&cellSF) >> checkError;
+    VecDestroy(&pointVec) >> checkError;
+}
+
+void ablate::particles::ParticleInterpolator::Interpolate(PetscReal time, PetscInt np, const PetscReal* coordinates, PetscInt stride, PetscInt* cells, PetscReal* values) {
+    // blend only the local sub field, and only when the time moved within the window
+    const PetscReal alpha = timeFinal > timeInitial ? PetscMin(PetscMax((time - timeInitial) / (timeFinal - timeInitial), 0.0), 1.0) : 1.0;
+    if (alpha != blendedAlpha) {
+        VecAXPBYPCZ(blendedLocal, 1.0 - alpha, alpha, 0.0, initialLocal, finalLocal) >> checkError;
+        blendedAlpha = alpha;
+    }
+    Evaluate(blendedLocal, np, coordinates, stride, cells, values);
+}
+
+void ablate::particles::ParticleInterpolator::Evaluate(Vec local, PetscInt np, const PetscReal* coordinates, PetscInt stride, PetscInt* cells, PetscReal* values) {
+    Locate(np, coordinates, stride, cells);
+
+    // tabulate the element basis at the reference coordinates of every located point at once
+    if (discretizationId == PETSCFE_CLASSID) {
+        tabulatedParticles.clear();
+        referenceCoordinates.resize(np * dim);
+        for (PetscInt p = 0; p < np; ++p) {
+            if (cells[p] >= 0) {
+                DMPlexCoordinatesToReference(subDM, cells[p], 1, coordinates + p * stride, &referenceCoordinates[tabulatedParticles.size() * dim]) >> checkError;
+                tabulatedParticles.push_back(p);
+            }
+        }
+
+        const auto numberTabulated = (PetscInt)tabulatedParticles.size();
+        if (numberTabulated > tabulationPoints) {
+            if (tabulation) {
+                PetscTabulationDestroy(&tabulation) >> checkError;
+            }
+            PetscFECreateTabulation((PetscFE)discretization, 1, numberTabulated, referenceCoordinates.data(), 0, &tabulation) >> checkError;
+            tabulationPoints = numberTabulated;
+        } else if (numberTabulated > 0) {
+            PetscFEComputeTabulation((PetscFE)discretization, numberTabulated, referenceCoordinates.data(), 0, tabulation) >> checkError;
+        }
+    }
+
+    PetscInt tabulated = 0;
+    for (PetscInt p = 0; p < np; ++p) {
+        PetscReal* pointValues = values + p * dof;
+
+        // points outside of the local domain are set to zero
+        if (cells[p] < 0) {
+            for (PetscInt c = 0; c < dof; ++c) {
+                pointValues[c] = 0.0;
+            }
+            continue;
+        }
+
+        PetscScalar* closure = NULL;
+        PetscInt closureSize;
+        DMPlexVecGetClosure(subDM, NULL, local, cells[p], &closureSize, &closure) >> checkError;
+        if (discretizationId == PETSCFE_CLASSID) {
+            // sum the element basis functions at the reference coordinates of the point
+            const PetscInt numberBasis = tabulation->Nb;
+            const PetscReal* basis = tabulation->T[0] + tabulated * numberBasis * dof;
+            for (PetscInt c = 0; c < dof; ++c) {
+                pointValues[c] = 0.0;
+                for (PetscInt b = 0; b < numberBasis; ++b) {
+                    pointValues[c] += PetscRealPart(closure[b]) * basis[b * dof + c];
+                }
+            }
+            ++tabulated;
+        } else {
+            // the finite volume field is constant in the cell
+            for (PetscInt c = 0; c < dof; ++c) {
+                pointValues[c] = PetscRealPart(closure[c]);
+            }
+        }
+        DMPlexVecRestoreClosure(subDM, NULL, local, cells[p], &closureSize, &closure) >> checkError;
+    }
+}
@@ -0,0 +1,193 @@
+#ifndef ABLATELIBRARY_PARTICLEINTERPOLATOR_HPP
+#define ABLATELIBRARY_PARTICLEINTERPOLATOR_HPP
+
+#include <petsc.h>
+#include <memory>
+#include <vector>
+#include "flow/flow.hpp"
+
+namespace ablate::particles {
+
+/**
+ * Persistent interpolation of a single flow field to particle locations.  The field sub dm, index set, and scatter are created once and reused for every
+ * evaluation.  Each particle is located starting from its previous cell (the hint), walking through face neighbors toward the particle, and only falls back to a
+ * full DMLocatePoints search for particles the walk could not find.  The field is interpolated linearly in time between the start and end of the flow step.
+ *
+ * The interpolator for the flow velocity is shared by every particle group in the flow (GetFlowVelocityInterpolator), so the sub field is only scattered once
+ * per flow step for all groups.  Each group still locates and evaluates its own particles.
+ */
+class ParticleInterpolator {
+   private:
+    // the sub dm/field holding only the interpolated field
+    DM subDM = NULL;
+    IS subIS = NULL;
+    VecScatter subScatter = NULL;
+    Vec subGlobal = NULL;
+    PetscInt dim;
+    PetscInt dof;
+
+    // the source holding the field.  A local source (e.g. an aux field) is copied to a global vector before the scatter.
+    DM sourceDM;
+    Vec source;
+    Vec sourceLocal = NULL;
+
+    // the local sub fields at the start and end of the flow step, and the linear blend of the two
+    bool advanced = false;
+    PetscReal timeInitial = 0.0;
+    PetscReal timeFinal = 0.0;
+    Vec initialLocal = NULL;
+    Vec finalLocal = NULL;
+    Vec blendedLocal = NULL;
+    PetscReal blendedAlpha = -1.0;
+
+    // the name used to compose the shared flow velocity interpolator with the flow dm, so the reference is destroyed with the dm
+    inline static const char flowVelocityInterpolatorName[] = "ablateParticleVelocityInterpolator";
+
+    // the discretization of the interpolated field (PetscFE or PetscFV)
+    PetscObject discretization = NULL;
+    PetscClassId discretizationId;
+
+    // local cell range (excluding fv boundary ghost cells)
+    PetscInt cStart, cEnd;
+
+    // flag for each local cell owned by this rank
+    std::vector<unsigned char> ownedCells;
+
+    // face neighbors (csr) and centroid of each local cell used to walk toward the particle
+    std::vector<PetscInt> neighborOffsets;
+    std::vector<PetscInt> neighbors;
+    std::vector<PetscReal> centroids;
+    std::vector<PetscReal> volumes;
+
+    // the maximum number of cells visited from the hint before a full search
+    inline static const PetscInt maxWalkSteps = 8;
+
+    // work arrays reused between calls
+    std::vector<PetscInt> searchParticles;
+    std::vector<PetscReal> searchCoordinates;
+
+    // the finite element basis at the reference coordinates of the located points.  The tabulation is only recreated when more points are evaluated than it holds.
+    PetscTabulation tabulation = NULL;
+    PetscInt tabulationPoints = 0;
+    std::vector<PetscInt> tabulatedParticles;
+    std::vector<PetscReal> referenceCoordinates;
+
+    /**
+     * Scatters the source into the local sub field
+     */
+    void UpdateLocalField(Vec local, PetscReal time);
+
+    /**
+     * Locates each point and evaluates the local sub field in the located cell.  Finite element fields are evaluated with the element basis at the reference
+     * coordinates of the point and finite volume fields use the cell value.
+     */
+    void Evaluate(Vec local, PetscInt np, const PetscReal* coordinates, PetscInt stride, PetscInt* cells, PetscReal* values);
+
+    /**
+     * Checks if the point is inside of the cell using the reference coordinates of the cell
+     */
+    bool InCell(PetscInt cell, const PetscReal* point) const;
+
+    /**
+     * Walks from the hint cell toward the point.  Returns -1 if the point was not found.
+     */
+    PetscInt Walk(PetscInt hint, const PetscReal* point) const;
+
+    /**
+     * Destroys the weak reference to the flow velocity interpolator held by the flow dm
+     */
+    static PetscErrorCode DestroyFlowVelocityInterpolatorReference(void* reference);
+
+   public:
+    /**
+     * Creates the persistent interpolator for the field in the dm
+     * @param dm the cell dm holding the field
+     * @param field the field index to interpolate
+     * @param source the vector holding the field
+     * @param localSource true if the source is a local vector
+     */
+    ParticleInterpolator(DM dm, PetscInt field, Vec source, bool localSource = false);
+    ~ParticleInterpolator();
+
+    ParticleInterpolator(const ParticleInterpolator&) = delete;
+    ParticleInterpolator& operator=(const ParticleInterpolator&) = delete;
+
+    /**
+     * Returns the flow velocity interpolator shared by every particle group in the flow.  The velocity is interpolated from the velocity solution field or, for
+     * finite volume flows, the vel aux field.  The interpolator is referenced from the flow dm, so a new flow (or dm) always gets a new interpolator.
+     * @param flow
+     * @return
+     */
+    static std::shared_ptr<ParticleInterpolator> GetFlowVelocityInterpolator(ablate::flow::Flow& flow);
+
+    /**
+     * Moves the interpolation window to end at the time, the previous end becomes the start.  This is collective and only updates the sub fields the first time it
+     * is called with a new time, so any number of particle groups can call it each flow step.
+     * @param time the time of the current source
+     */
+    void Advance(PetscReal time);
+
+    /**
+     * Restarts the interpolation window at the time, using the current source for both ends of the window.  This is used after the source is replaced (e.g. by a
+     * restart).  This is collective.
+     * @param time the time of the current source
+     */
+    void Reset(PetscReal time) {
+        advanced = false;
+        Advance(time);
+    }
+
+    /**
+     * Locates each point, using and updating the cell hints.  Points that cannot be found on this rank are marked with a cell of -1.
+     * @param np the number of points
+     * @param coordinates the start of the coordinates
+     * @param stride the distance between the start of each point's coordinates
+     * @param cells in/out the cell hint for each point
+     */
+    void Locate(PetscInt np, const PetscReal* coordinates, PetscInt stride, PetscInt* cells);
+
+    /**
+     * Locates each point and interpolates the field linearly in time inside of the interpolation window.  Points that cannot be found on this rank are set to zero.
+     * @param time the time of the evaluation, limited to the interpolation window
+     * @param np the number of points
+     * @param coordinates the start of the coordinates
+     * @param stride the distance between the start of each point's coordinates
+     * @param cells in/out the cell hint for each point
+     * @param values the interpolated values (np*dof)
+     */
+    void Interpolate(PetscReal time, PetscInt np, const PetscReal* coordinates, PetscInt stride, PetscInt* cells, PetscReal* values);
+
+    /**
+     * the number of components interpolated at each point
+     */
+    PetscInt GetDof() const { return dof; }
+
+    /**
+     * the dm holding only the interpolated field
+     */
+    DM GetDM() const { return subDM; }
+
+    /**
+     * the local cell range [cStart, cEnd) used for point location
+     */
+    PetscInt GetCellStart() const { return cStart; }
+    PetscInt GetCellEnd() const { return cEnd; }
+
+    /**
+     * check if the local cell is owned by this rank (false for -1)
+     */
+    bool IsOwnedCell(PetscInt cell) const { return cell >= cStart && cell < cEnd && ownedCells[cell - cStart]; }
+
+    /**
+     * the centroid of a local cell
+     */
+    const PetscReal* GetCentroid(PetscInt cell) const { return &centroids[(cell - cStart) * dim]; }
+
+    /**
+     * the volume of a local cell
+     */
+    PetscReal GetVolume(PetscInt cell) const { return volumes[cell - cStart]; }
+};
+
+}  // namespace ablate::particles
+#endif  // ABLATELIBRARY_PARTICLEINTERPOLATOR_HPP
@@ -0,0 +1,59 @@
+#include "particleNeighborSearch.hpp"
+#include <stdexcept>
+
+void ablate::particles::ParticleNeighborSearch::Build(PetscInt dimIn, PetscReal cutoffIn, PetscInt np, const PetscReal* coordinates, PetscInt stride, PetscInt nGhost,
+                                                      const PetscReal* ghostCoordinates) {
+    if (cutoffIn <= 0.0) {
+        throw std::invalid_argument("The particle neighbor search cutoff must be positive");
+    }
+    dim = dimIn;
+    cutoff = cutoffIn;
+    cutoffSquared = cutoff * cutoff;
+    numberLocal = np;
+    numberGhost = nGhost;
+    const PetscInt numberPoints = np + nGhost;
+
+    // copy the local and ghost coordinates into a single contiguous array
+    points.resize(numberPoints * dim);
+    for (PetscInt p = 0; p < np; ++p) {
+        for (PetscInt d = 0; d < dim; ++d) {
+            points[p * dim + d] = coordinates[p * stride + d];
+        }
+    }
+    std::copy(ghostCoordinates, ghostCoordinates + nGhost * dim, points.begin() + np * dim);
+
+    // the bins start at the lower corner of the points
+    for (PetscInt d = 0; d < dim; ++d) {
+        origin[d] = PETSC_MAX_REAL;
+    }
+    for (PetscInt p = 0; p < numberPoints; ++p) {
+        for (PetscInt d = 0; d < dim; ++d) {
+            origin[d] = PetscMin(origin[d], points[p * dim + d]);
+        }
+    }
+
+    // size the hash table to a power of two with at least two buckets per point
+    std::size_t numberBuckets = 1;
+    while (numberBuckets < 2 * (std::size_t)numberPoints) {
+        numberBuckets <<= 1;
+    }
+    bucketMask = numberBuckets - 1;
+
+    // counting sort of the points into the buckets
+    std::vector<std::size_t> pointBuckets(numberPoints);
+    bucketOffsets.assign(numberBuckets + 1, 0);
+    for (PetscInt p = 0; p < numberPoints; ++p) {
+        int64_t bin[3];
+        GetBin(&points[p * dim], bin);
+        pointBuckets[p] = GetBucket(bin);
+        bucketOffsets[pointBuckets[p] + 1]++;
+    }
+    for (std::size_t b = 0; b < numberBuckets; ++b) {
+        bucketOffsets[b + 1] += bucketOffsets[b];
+    }
+    bucketPoints.resize(numberPoints);
+    std::vector<PetscInt> bucketFill(bucketOffsets.begin(), bucketOffsets.end() - 1);
+    for (PetscInt p = 0; p < numberPoints; ++p) {
+        bucketPoints[bucketFill[pointBuckets[p]]++] = p;
+    }
+}
@@ -0,0 +1,160 @@
+#ifndef ABLATELIBRARY_PARTICLENEIGHBORSEARCH_HPP
+#define ABLATELIBRARY_PARTICLENEIGHBORSEARCH_HPP
+
+#include <petsc.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ablate::particles {
+
+/**
+ * Uniform grid (cell list) neighbor search over a set of local points and ghost points.  Each point is binned into a cube with an edge of the cutoff, so every
+ * neighbor of a point is inside of the 3^dim surrounding bins.  The bins are stored in a hash table (compressed row storage sorted by a counting sort), so the
+ * memory is proportional to the number of points instead of the size of the domain.
+ *
+ * The points are indexed with the local points first [0, np) followed by the ghost points [np, np + nGhost).
+ */
+class ParticleNeighborSearch {
+   private:
+    PetscInt dim = 0;
+    PetscReal cutoff = 0.0;
+    PetscReal cutoffSquared = 0.0;
+    PetscInt numberLocal = 0;
+    PetscInt numberGhost = 0;
+
+    // the origin of the bins and the coordinates of every point (local then ghost)
+    PetscReal origin[3] = {0.0, 0.0, 0.0};
+    std::vector<PetscReal> points;
+
+    // the points in hash bucket b are bucketPoints[bucketOffsets[b], bucketOffsets[b+1])
+    std::size_t bucketMask = 0;
+    std::vector<PetscInt> bucketOffsets;
+    std::vector<PetscInt> bucketPoints;
+
+    /**
+     * the integer bin of the coordinate in each direction
+     */
+    void GetBin(const PetscReal* point, int64_t bin[3]) const {
+        for (PetscInt d = 0; d < dim; ++d) {
+            bin[d] = (int64_t)PetscFloorReal((point[d] - origin[d]) / cutoff);
+        }
+        for (PetscInt d = dim; d < 3; ++d) {
+            bin[d] = 0;
+        }
+    }
+
+    /**
+     * the hash bucket of the integer bin
+     */
+    std::size_t GetBucket(const int64_t bin[3]) const {
+        auto hash = (uint64_t)bin[0] * 73856093ULL ^ (uint64_t)bin[1] * 19349663ULL ^ (uint64_t)bin[2] * 83492791ULL;
+        hash ^= hash >> 29;
+        return (std::size_t)hash & bucketMask;
+    }
+
+    /**
+     * Calls visit(j) for every point in the buckets surrounding the point.  Surrounding bins that hash to the same bucket are only visited once.
+     */
+    template <class Visitor>
+    void ForEachCandidate(const PetscReal* point, Visitor&& visit) const {
+        if (bucketPoints.empty()) {
+            return;
+        }
+        int64_t bin[3];
+        GetBin(point, bin);
+
+        std::size_t buckets[27];
+        PetscInt numberBuckets = 0;
+        const int64_t range[3] = {1, dim > 1 ? 1 : 0, dim > 2 ? 1 : 0};
+        for (int64_t i = -range[0]; i <= range[0]; ++i) {
+            for (int64_t j = -range[1]; j <= range[1]; ++j) {
+                for (int64_t k = -range[2]; k <= range[2]; ++k) {
+                    const int64_t neighborBin[3] = {bin[0] + i, bin[1] + j, bin[2] + k};
+                    buckets[numberBuckets++] = GetBucket(neighborBin);
+                }
+            }
+        }
+        std::sort(buckets, buckets + numberBuckets);
+        numberBuckets = (PetscInt)(std::unique(buckets, buckets + numberBuckets) - buckets);
+
+        for (PetscInt b = 0; b < numberBuckets; ++b) {
+            for (PetscInt n = bucketOffsets[buckets[b]]; n < bucketOffsets[buckets[b] + 1]; ++n) {
+                visit(bucketPoints[n]);
+            }
+        }
+    }
+
+    /**
+     * the squared distance between the point and the indexed point
+     */
+    PetscReal DistanceSquared(const PetscReal* point, PetscInt j) const {
+        PetscReal distanceSquared = 0.0;
+        for (PetscInt d = 0; d < dim; ++d) {
+            const PetscReal delta = points[j * dim + d] - point[d];
+            distanceSquared += delta * delta;
+        }
+        return distanceSquared;
+    }
+
+   public:
+    /**
+     * Bins the local and ghost points.  The coordinates are copied, so the search is a snapshot that must be rebuilt after the points move.
+     * @param dim the dimension of the points
+     * @param cutoff the maximum distance between neighbors
+     * @param np the number of local points
+     * @param coordinates the start of the local coordinates
+     * @param stride the distance between the start of each local point's coordinates
+     * @param nGhost the number of ghost points
+     * @param ghostCoordinates the ghost coordinates (nGhost*dim)
+     */
+    void Build(PetscInt dim, PetscReal cutoff, PetscInt np, const PetscReal* coordinates, PetscInt stride, PetscInt nGhost, const PetscReal* ghostCoordinates);
+
+    /**
+     * Calls kernel(i, j, distanceSquared) once for every pair of points closer than the cutoff where i is a local point and j is either a local point (j > i) or a
+     * ghost point (j >= np).  Pairs of two ghost points are not visited.
+     * @param kernel
+     */
+    template <class Kernel>
+    void ForEachPair(Kernel&& kernel) const {
+        for (PetscInt i = 0; i < numberLocal; ++i) {
+            const PetscReal* point = &points[i * dim];
+            ForEachCandidate(point, [&](PetscInt j) {
+                if (j < numberLocal && j <= i) {
+                    return;
+                }
+                const PetscReal distanceSquared = DistanceSquared(point, j);
+                if (distanceSquared < cutoffSquared) {
+                    kernel(i, j, distanceSquared);
+                }
+            });
+        }
+    }
+
+    /**
+     * Calls kernel(j, distanceSquared) for every local or ghost point closer than the cutoff to the point
+     * @param point
+     * @param kernel
+     */
+    template <class Kernel>
+    void ForEachNeighbor(const PetscReal* point, Kernel&& kernel) const {
+        ForEachCandidate(point, [&](PetscInt j) {
+            const PetscReal distanceSquared = DistanceSquared(point, j);
+            if (distanceSquared < cutoffSquared) {
+                kernel(j, distanceSquared);
+            }
+        });
+    }
+
+    /**
+     * the coordinates of the local (j < np) or ghost point (j >= np)
+     */
+    const PetscReal* GetCoordinates(PetscInt j) const { return &points[j * dim]; }
+
+    PetscInt GetNumberLocal() const { return numberLocal; }
+    PetscInt GetNumberGhost() const { return numberGhost; }
+    PetscReal GetCutoff() const { return cutoff; }
+};
+
+}  // namespace ablate::particles
+#endif  // ABLATELIBRARY_PARTICLENEIGHBORSEARCH_HPP
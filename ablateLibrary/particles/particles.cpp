@@ -1,11 +1,19 @@
 #include "particles.hpp"
 #include <petscviewerhdf5.h>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include "flow/fvFlow.hpp"
+#include "utilities/logEvents.hpp"
+#include "utilities/memoryTracker.hpp"
+#include "utilities/mpiError.hpp"
 #include "utilities/petscError.hpp"
 #include "utilities/petscOptions.hpp"
 
 ablate::particles::Particles::Particles(std::string name, int ndims, std::shared_ptr<particles::initializers::Initializer> initializer,
                                         std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization, std::shared_ptr<mathFunctions::MathFunction> exactSolution,
-                                        std::shared_ptr<parameters::Parameters> options)
+                                        std::shared_ptr<parameters::Parameters> options, int sortInterval, std::string sortOrder,
+                                        std::vector<std::shared_ptr<injectors::Injector>> injectors, bool removeOutflow)
     : ndims(ndims),
       name(name),
       timeInitial(0.0),
@@ -14,7 +22,15 @@ ablate::particles::Particles::Particles(std::string name, int ndims, std::shared
       petscOptions(NULL),
       dmChanged(false),
       initializer(initializer),
-      fieldInitialization(fieldInitialization) {
+      fieldInitialization(fieldInitialization),
+      sortInterval(sortInterval),
+      sortOrder(ParseSortOrder(sortOrder)),
+      injectors(injectors),
+      removeOutflow(removeOutflow) {
+    advectLogEvent = utilities::LogEvents::Register("ParticleAdvection");
+    interpolateLogEvent = utilities::LogEvents::Register("ParticleInterpolate");
+    migrateLogEvent = utilities::LogEvents::Register("ParticleMigrate");
+
     // create and associate the dm
     DMCreate(PETSC_COMM_WORLD, &dm) >> checkError;
     DMSetType(dm, DMSWARM) >> checkError;
@@ -67,11 +83,32 @@ void ablate::particles::Particles::InitializeFlow(std::shared_ptr<flow::Flow> fl
     // associate the swarm with the cell dm
     DMSwarmSetCellDM(dm, flow->GetDM()) >> checkError;
 
-    // Store the values in the particles from the ts and flow
-    flowFinal = flow->GetSolutionVector();
-    VecDuplicate(flowFinal, &(flowInitial)) >> checkError;
-    VecCopy(flow->GetSolutionVector(), flowInitial) >> checkError;
-    flowVelocityFieldIndex = flow->GetFieldId("velocity").value();
+    // the flow velocity interpolation is shared with the other particle groups
+    velocityInterpolator = ParticleInterpolator::GetFlowVelocityInterpolator(*flow);
+    velocityInterpolator->Advance(timeInitial);
+
+    // the number of particles in each cell is part of the flow cell cost
+    if (auto fvFlow = std::dynamic_pointer_cast<flow::FVFlow>(flow); fvFlow && fvFlow->GetAuxFieldId(flow::FVFlow::CellCostField)) {
+        costFlow = fvFlow;
+    }
+
+    // the particle sources are deposited onto the flow cells and added to the flow rhs (two way coupling)
+    if (!sourceDepositions.empty()) {
+        auto fvFlow = std::dynamic_pointer_cast<flow::FVFlow>(flow);
+        if (!fvFlow) {
+            throw std::invalid_argument("The particles " + name + " deposit sources onto the flow, which requires a FVFlow");
+        }
+        for (auto &deposition : sourceDepositions) {
+            auto flowField = flow->GetFieldId(deposition.flowFieldName);
+            if (!flowField) {
+                throw std::invalid_argument("Cannot locate flow field " + deposition.flowFieldName + " for the particle source " + deposition.particleField);
+            }
+            deposition.flowField = flowField.value();
+        }
+        DMCreateGlobalVector(flow->GetDM(), &flowSource) >> checkError;
+        VecZeroEntries(flowSource) >> checkError;
+        fvFlow->RegisterRHSFunction(AddParticleSources, this);
+    }
 
     // name the particle domain
     auto namePrefix = name + "_";
@@ -81,6 +118,26 @@ void ablate::particles::Particles::InitializeFlow(std::shared_ptr<flow::Flow> fl
 
     // initialize the particles
     initializer->Initialize(*flow, dm);
+    SyncPackedCoordinates(true);
+
+    // injected particles are numbered after the initial particles
+    if (!injectors.empty()) {
+        PetscInt np;
+        DMSwarmGetLocalSize(dm, &np) >> checkError;
+        const PetscInt64 *pid;
+        PetscInt64 localNextId = 0;
+        DMSwarmGetField(dm, DMSwarmField_pid, NULL, NULL, (void **)&pid) >> checkError;
+        for (PetscInt p = 0; p < np; ++p) {
+            localNextId = PetscMax(localNextId, pid[p] + 1);
+        }
+        DMSwarmRestoreField(dm, DMSwarmField_pid, NULL, NULL, (void **)&pid) >> checkError;
+        MPIU_Allreduce(&localNextId, &nextParticleId, 1, MPIU_INT64, MPI_MAX, PetscObjectComm((PetscObject)dm)) >> checkMpiError;
+
+        // the random stream 0 is used by the initializers
+        for (std::size_t i = 0; i < injectors.size(); ++i) {
+            injectors[i]->Initialize(*flow, (PetscInt64)i + 1);
+        }
+    }
 
     // Setup particle position integrator
     TSCreate(PetscObjectComm((PetscObject)flow->GetDM()), &particleTs) >> checkError;
@@ -106,17 +163,28 @@ void ablate::particles::Particles::InitializeFlow(std::shared_ptr<flow::Flow> fl
     for (auto &field : fieldInitialization) {
         this->ProjectFunction(field->GetName(), field->GetSolutionField());
     }
+
+    // group the initial particles by cell
+    if (sortInterval > 0) {
+        SortParticles();
+    }
+
+    utilities::MemoryTracker::Register(utilities::MemoryTracker::Particles, this, [this]() { return GetMemoryBytes(); });
 }
 
 ablate::particles::Particles::~Particles() {
+    utilities::MemoryTracker::Unregister(this);
     if (dm) {
         DMDestroy(&dm) >> checkError;
     }
     if (particleTs) {
         TSDestroy(&particleTs) >> checkError;
     }
-    if (flowInitial) {
-        VecDestroy(&flowInitial) >> checkError;
+    if (solutionVector) {
+        VecDestroy(&solutionVector) >> checkError;
+    }
+    if (flowSource) {
+        VecDestroy(&flowSource) >> checkError;
     }
     if (petscOptions) {
         ablate::utilities::PetscOptionsDestroyAndCheck(name, &petscOptions);
@@ -124,10 +192,26 @@ ablate::particles::Particles::~Particles() {
 }
 
 void ablate::particles::Particles::RegisterSolutionField(ParticleFieldDescriptor fieldDescriptor) {
+    // the field is also registered on its own so that it can be copied out for output
     RegisterField(fieldDescriptor);
     particleSolutionDescriptors.push_back(fieldDescriptor);
 }
 
+PetscInt ablate::particles::Particles::GetPackedSolutionOffset(const std::string &fieldName, PetscInt *components) const {
+    // the coordinates (first solution field) are stored in their own field
+    PetscInt offset = particleSolutionDescriptors.front().components;
+    for (std::size_t f = 1; f < particleSolutionDescriptors.size(); f++) {
+        if (particleSolutionDescriptors[f].fieldName == fieldName) {
+            if (components) {
+                *components = particleSolutionDescriptors[f].components;
+            }
+            return offset;
+        }
+        offset += particleSolutionDescriptors[f].components;
+    }
+    return -1;
+}
+
 void ablate::particles::Particles::RegisterField(ParticleFieldDescriptor fieldDescriptor) {
     // add the value to the field
     DMSwarmRegisterPetscDatatypeField(dm, fieldDescriptor.fieldName.c_str(), fieldDescriptor.components, fieldDescriptor.type) >> checkError;
@@ -136,7 +220,7 @@ void ablate::particles::Particles::RegisterField(ParticleFieldDescriptor fieldDe
     particleFieldDescriptors.push_back(fieldDescriptor);
 }
 
-void ablate::particles::Particles::StoreInitialParticleLocations() {
+void ablate::particles::Particles::StoreInitialParticleLocations(PetscInt start) {
     // copy over the initial location
     PetscReal *coord;
     PetscReal *initialLocation;
@@ -146,7 +230,7 @@ void ablate::particles::Particles::StoreInitialParticleLocations() {
     DMSwarmGetField(dm, ParticleInitialLocation, NULL, NULL, (void **)&initialLocation) >> checkError;
 
     // copy the raw data
-    for (int i = 0; i < numberParticles * ndims; ++i) {
+    for (PetscInt i = start * ndims; i < numberParticles * ndims; ++i) {
         initialLocation[i] = coord[i];
     }
     DMSwarmRestoreField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coord) >> checkError;
@@ -220,6 +304,7 @@ PetscErrorCode ablate::particles::Particles::ComputeParticleError(TS particleTS,
     // Create a vector of the current solution
     Vec exactSolutionVec;
     VecDuplicate(u, &exactSolutionVec) >> checkError;
+    VecZeroEntries(exactSolutionVec) >> checkError;
     PetscScalar *exactSolutionArray;
     VecGetArrayWrite(exactSolutionVec, &exactSolutionArray) >> checkError;
 
@@ -267,8 +352,7 @@ PetscErrorCode ablate::particles::Particles::ComputeParticleError(TS particleTS,
     VecRestoreArrayWrite(exactLocationVec, &exactLocationArray) >> checkError;
 
     // Get all points still in this mesh
-    DM flowDM;
-    VecGetDM(particles->flowFinal, &flowDM) >> checkError;
+    DM flowDM = particles->velocityInterpolator->GetDM();
     PetscSF cellSF = NULL;
     DMLocatePoints(flowDM, exactLocationVec, DM_POINTLOCATION_NONE, &cellSF) >> checkError;
     const PetscSFNode *cells;
@@ -300,32 +384,477 @@ PetscErrorCode ablate::particles::Particles::ComputeParticleError(TS particleTS,
 }
 
 void ablate::particles::Particles::SwarmMigrate() {
-    // current number of local/global particles
-    PetscInt numberLocal;
-    PetscInt numberGlobal;
+    PetscLogEventBegin(migrateLogEvent, dm, 0, 0, 0) >> checkError;
+
+    // check if any local particle has left the cells owned by this rank (the cell hints make this a short walk)
+    PetscInt np;
+    DMSwarmGetLocalSize(dm, &np) >> checkError;
+    PetscReal *coordinates;
+    PetscInt *cells;
+    DMSwarmGetField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
+    DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+    velocityInterpolator->Locate(np, coordinates, ndims, cells);
+    PetscInt particlesLeaving = PETSC_FALSE;
+    for (PetscInt p = 0; p < np && !particlesLeaving; ++p) {
+        particlesLeaving = !velocityInterpolator->IsOwnedCell(cells[p]);
+    }
+    DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+    DMSwarmRestoreField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
 
-    // Get the current size
-    DMSwarmGetLocalSize(dm, &numberLocal) >> checkError;
-    DMSwarmGetSize(dm, &numberGlobal) >> checkError;
+    // only migrate if particles left any rank
+    MPI_Comm comm;
+    PetscObjectGetComm((PetscObject)particleTs, &comm) >> checkError;
+    PetscInt particlesLeavingAll = PETSC_FALSE;
+    MPIU_Allreduce(&particlesLeaving, &particlesLeavingAll, 1, MPIU_INT, MPIU_MAX, comm) >> checkMpiError;
+    if (!particlesLeavingAll) {
+        PetscLogEventEnd(migrateLogEvent, dm, 0, 0, 0) >> checkError;
+        return;
+    }
 
     // Migrate any particles that have moved
     DMSwarmMigrate(dm, PETSC_TRUE) >> checkError;
 
-    // get the new sizes
-    PetscInt newNumberLocal;
-    PetscInt newNumberGlobal;
+    // migration removes/appends particles so the cell index is out of date
+    cellIndexValid = false;
+
+    if (removeOutflow) {
+        // particles that are not in this rank's cells after the migration are not inside of the domain
+        DMSwarmGetLocalSize(dm, &np) >> checkError;
+        std::vector<PetscInt> keep;
+        keep.reserve(np);
+        DMSwarmGetField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
+        DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+        velocityInterpolator->Locate(np, coordinates, ndims, cells);
+        for (PetscInt p = 0; p < np; ++p) {
+            if (velocityInterpolator->IsOwnedCell(cells[p])) {
+                keep.push_back(p);
+            }
+        }
+        DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+        DMSwarmRestoreField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
+
+        // compact the remaining particles, keeping their order, the freed storage is reused by later injections
+        if ((PetscInt)keep.size() < np) {
+            PermuteSwarmFields(keep);
+            DMSwarmSetLocalSizes(dm, (PetscInt)keep.size(), GetStorageBuffer((PetscInt)keep.size())) >> checkError;
+        }
+    }
+    PetscLogEventEnd(migrateLogEvent, dm, 0, 0, 0) >> checkError;
+}
 
-    // Get the updated size
-    DMSwarmGetLocalSize(dm, &newNumberLocal) >> checkError;
-    DMSwarmGetSize(dm, &newNumberGlobal) >> checkError;
+ablate::particles::Particles::SortOrder ablate::particles::Particles::ParseSortOrder(const std::string &sortOrder) {
+    if (sortOrder.empty() || sortOrder == "cell") {
+        return SortOrder::CELL;
+    } else if (sortOrder == "morton") {
+        return SortOrder::MORTON;
+    } else {
+        throw std::invalid_argument("Unknown particle sortOrder " + sortOrder + ". Valid options are 'cell' or 'morton'.");
+    }
+}
 
-    // Check to see if any of the ranks changed size after migration
-    PetscInt dmChanged = newNumberGlobal != numberGlobal || newNumberLocal != numberLocal;
-    MPI_Comm comm;
-    PetscObjectGetComm((PetscObject)particleTs, &comm) >> checkError;
-    PetscInt dmChangedAll = PETSC_FALSE;
-    MPIU_Allreduce(&dmChanged, &dmChangedAll, 1, MPIU_INT, MPIU_MAX, comm);
-    this->dmChanged = dmChangedAll == PETSC_TRUE;
+void ablate::particles::Particles::ComputeCellSortRank() {
+    const PetscInt cStart = velocityInterpolator->GetCellStart();
+    const PetscInt numberCells = velocityInterpolator->GetCellEnd() - cStart;
+
+    std::vector<PetscInt> sortedCells(numberCells);
+    std::iota(sortedCells.begin(), sortedCells.end(), 0);
+
+    if (sortOrder == SortOrder::MORTON) {
+        // compute the bounding box of the local cell centroids
+        PetscReal lower[3] = {PETSC_MAX_REAL, PETSC_MAX_REAL, PETSC_MAX_REAL};
+        PetscReal upper[3] = {PETSC_MIN_REAL, PETSC_MIN_REAL, PETSC_MIN_REAL};
+        for (PetscInt c = 0; c < numberCells; ++c) {
+            const PetscReal *centroid = velocityInterpolator->GetCentroid(c + cStart);
+            for (PetscInt d = 0; d < ndims; ++d) {
+                lower[d] = PetscMin(lower[d], centroid[d]);
+                upper[d] = PetscMax(upper[d], centroid[d]);
+            }
+        }
+
+        // interleave the bits of the quantized centroid in each direction
+        const PetscInt bits = PetscMin(63 / ndims, 31);
+        const auto maxQuantized = (PetscReal)((1ULL << bits) - 1);
+        std::vector<unsigned long long> codes(numberCells, 0);
+        for (PetscInt c = 0; c < numberCells; ++c) {
+            const PetscReal *centroid = velocityInterpolator->GetCentroid(c + cStart);
+            unsigned long long quantized[3] = {0, 0, 0};
+            for (PetscInt d = 0; d < ndims; ++d) {
+                if (upper[d] > lower[d]) {
+                    quantized[d] = (unsigned long long)((centroid[d] - lower[d]) / (upper[d] - lower[d]) * maxQuantized);
+                }
+            }
+            for (PetscInt b = bits - 1; b >= 0; --b) {
+                for (PetscInt d = 0; d < ndims; ++d) {
+                    codes[c] = (codes[c] << 1) | ((quantized[d] >> b) & 1ULL);
+                }
+            }
+        }
+        std::stable_sort(sortedCells.begin(), sortedCells.end(), [&codes](PetscInt a, PetscInt b) { return codes[a] < codes[b]; });
+    }
+
+    cellSortRank.resize(numberCells);
+    for (PetscInt r = 0; r < numberCells; ++r) {
+        cellSortRank[sortedCells[r]] = r;
+    }
+}
+
+std::vector<std::string> ablate::particles::Particles::GetSwarmFieldNames() const {
+    std::vector<std::string> fieldNames = {DMSwarmField_rank, DMSwarmPICField_cellid};
+    for (const auto &field : particleFieldDescriptors) {
+        if (std::find(fieldNames.begin(), fieldNames.end(), field.fieldName) == fieldNames.end()) {
+            fieldNames.push_back(field.fieldName);
+        }
+    }
+    return fieldNames;
+}
+
+PetscLogDouble ablate::particles::Particles::GetMemoryBytes() const {
+    PetscInt np;
+    DMSwarmGetLocalSize(dm, &np) >> checkError;
+
+    // the swarm fields (the swarm may allocate a buffer beyond the local particles)
+    PetscLogDouble bytes = 0.0;
+    for (const auto &fieldName : GetSwarmFieldNames()) {
+        PetscInt blockSize;
+        PetscDataType dataType;
+        void *data;
+        DMSwarmGetField(dm, fieldName.c_str(), &blockSize, &dataType, &data) >> checkError;
+        DMSwarmRestoreField(dm, fieldName.c_str(), NULL, NULL, &data) >> checkError;
+        size_t typeSize;
+        PetscDataTypeGetSize(dataType, &typeSize) >> checkError;
+        bytes += (PetscLogDouble)np * blockSize * typeSize;
+    }
+
+    // the flow source and the work arrays (the solution vector wraps a swarm field)
+    bytes += utilities::MemoryTracker::GetBytes(flowSource) + utilities::MemoryTracker::GetBytes(depositionWork) +
+             utilities::MemoryTracker::GetBytes(cellSortRank) + utilities::MemoryTracker::GetBytes(cellParticleOffsets) + utilities::MemoryTracker::GetBytes(injectionCoordinates) +
+             utilities::MemoryTracker::GetBytes(injectionCells) + utilities::MemoryTracker::GetBytes(ghostCoordinates) + utilities::MemoryTracker::GetBytes(ghostIds);
+    for (const auto &ghostField : ghostFields) {
+        bytes += utilities::MemoryTracker::GetBytes(ghostField.second.second);
+    }
+    return bytes;
+}
+
+void ablate::particles::Particles::PermuteSwarmFields(const std::vector<PetscInt> &order) {
+    PetscInt np;
+    DMSwarmGetLocalSize(dm, &np) >> checkError;
+
+    // every field in the swarm, including the fields registered by DMSwarm, must be permuted
+    std::vector<char> buffer;
+    for (const auto &fieldName : GetSwarmFieldNames()) {
+        PetscInt blockSize;
+        PetscDataType dataType;
+        char *data;
+        DMSwarmGetField(dm, fieldName.c_str(), &blockSize, &dataType, (void **)&data) >> checkError;
+        size_t typeSize;
+        PetscDataTypeGetSize(dataType, &typeSize) >> checkError;
+        const std::size_t particleSize = blockSize * typeSize;
+
+        buffer.assign(data, data + np * particleSize);
+        for (std::size_t p = 0; p < order.size(); ++p) {
+            std::memcpy(data + p * particleSize, buffer.data() + order[p] * particleSize, particleSize);
+        }
+        DMSwarmRestoreField(dm, fieldName.c_str(), NULL, NULL, (void **)&data) >> checkError;
+    }
+}
+
+void ablate::particles::Particles::SortParticles() {
+    if (cellSortRank.empty()) {
+        ComputeCellSortRank();
+    }
+    const PetscInt cStart = velocityInterpolator->GetCellStart();
+    const auto numberCells = (PetscInt)cellSortRank.size();
+
+    PetscInt np;
+    DMSwarmGetLocalSize(dm, &np) >> checkError;
+
+    // update the cell for each particle and compute its sort key (particles outside the local domain are last)
+    std::vector<PetscInt> keys(np);
+    PetscReal *coordinates;
+    PetscInt *cells;
+    DMSwarmGetField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
+    DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+    velocityInterpolator->Locate(np, coordinates, ndims, cells);
+    for (PetscInt p = 0; p < np; ++p) {
+        keys[p] = cells[p] >= 0 ? cellSortRank[cells[p] - cStart] : numberCells;
+    }
+    DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+    DMSwarmRestoreField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
+
+    // counting sort by key, the offsets become the cell index
+    cellParticleOffsets.assign(numberCells + 2, 0);
+    for (PetscInt p = 0; p < np; ++p) {
+        cellParticleOffsets[keys[p] + 1]++;
+    }
+    for (PetscInt r = 0; r <= numberCells; ++r) {
+        cellParticleOffsets[r + 1] += cellParticleOffsets[r];
+    }
+    std::vector<PetscInt> order(np);
+    std::vector<PetscInt> next(cellParticleOffsets.begin(), cellParticleOffsets.end() - 1);
+    for (PetscInt p = 0; p < np; ++p) {
+        order[next[keys[p]]++] = p;
+    }
+
+    // the local size is unchanged so the particle ts does not need to be reset
+    PermuteSwarmFields(order);
+    cellIndexValid = true;
+}
+
+bool ablate::particles::Particles::GetCellParticleRange(PetscInt cell, PetscInt &start, PetscInt &end) const {
+    const PetscInt cStart = velocityInterpolator->GetCellStart();
+    if (!cellIndexValid || cell < cStart || cell >= velocityInterpolator->GetCellEnd()) {
+        return false;
+    }
+    const PetscInt rank = cellSortRank[cell - cStart];
+    start = cellParticleOffsets[rank];
+    end = cellParticleOffsets[rank + 1];
+    return true;
+}
+
+void ablate::particles::Particles::UpdateNeighborSearch(PetscReal cutoff, const std::vector<std::string> &ghostFieldNames) {
+    MPI_Comm comm = PetscObjectComm((PetscObject)dm);
+    PetscMPIInt rank, size;
+    MPI_Comm_rank(comm, &rank) >> checkMpiError;
+    MPI_Comm_size(comm, &size) >> checkMpiError;
+
+    PetscInt np;
+    DMSwarmGetLocalSize(dm, &np) >> checkError;
+
+    // each field is read from its canonical storage (its own field or the packed solution), and each storage field is only gotten once
+    struct GhostFieldSource {
+        const PetscReal *data;
+        PetscInt stride;
+        PetscInt offset;
+        PetscInt components;
+    };
+    std::map<std::string, std::pair<PetscInt, PetscReal *>> storageFields;
+    PetscReal *coordinates;
+    DMSwarmGetField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
+    storageFields[DMSwarmPICField_coor] = {ndims, coordinates};
+
+    std::vector<GhostFieldSource> sources;
+    PetscInt recordSize = ndims;
+    for (const auto &fieldName : ghostFieldNames) {
+        PetscInt components;
+        const PetscInt packedOffset = GetPackedSolutionOffset(fieldName, &components);
+        const std::string storageField = packedOffset < 0 ? fieldName : PackedSolution;
+        if (!storageFields.count(storageField)) {
+            PetscInt stride;
+            PetscDataType type;
+            PetscReal *data;
+            DMSwarmGetField(dm, storageField.c_str(), &stride, &type, (void **)&data) >> checkError;
+            if (type != PETSC_REAL) {
+                throw std::invalid_argument("UpdateNeighborSearch only supports PETSC_REAL ghost fields");
+            }
+            storageFields[storageField] = {stride, data};
+        }
+        if (packedOffset < 0) {
+            components = storageFields[storageField].first;
+        }
+        const auto &[stride, data] = storageFields[storageField];
+        sources.push_back(GhostFieldSource{.data = data, .stride = stride, .offset = PetscMax(packedOffset, 0), .components = components});
+        recordSize += components;
+    }
+
+    // share the bounding box of the local particles on every rank (empty boxes have lower > upper)
+    std::vector<PetscReal> localBox(2 * ndims);
+    for (PetscInt d = 0; d < ndims; ++d) {
+        localBox[d] = PETSC_MAX_REAL;
+        localBox[ndims + d] = PETSC_MIN_REAL;
+    }
+    for (PetscInt p = 0; p < np; ++p) {
+        for (PetscInt d = 0; d < ndims; ++d) {
+            localBox[d] = PetscMin(localBox[d], coordinates[p * ndims + d]);
+            localBox[ndims + d] = PetscMax(localBox[ndims + d], coordinates[p * ndims + d]);
+        }
+    }
+    std::vector<PetscReal> boxes(2 * ndims * size);
+    MPI_Allgather(localBox.data(), 2 * ndims, MPIU_REAL, boxes.data(), 2 * ndims, MPIU_REAL, comm) >> checkMpiError;
+
+    // the distance from the point to a rank's box
+    auto boxDistanceSquared = [&](PetscMPIInt r, const PetscReal *lower, const PetscReal *upper) {
+        const PetscReal *box = &boxes[2 * ndims * r];
+        PetscReal distanceSquared = 0.0;
+        for (PetscInt d = 0; d < ndims; ++d) {
+            const PetscReal gap = PetscMax(0.0, PetscMax(box[d] - upper[d], lower[d] - box[ndims + d]));
+            distanceSquared += gap * gap;
+        }
+        return distanceSquared;
+    };
+
+    // the neighboring ranks are those with a box within the cutoff of this rank's box, this is symmetric so both ranks know to communicate
+    std::vector<PetscMPIInt> neighborRanks;
+    if (np > 0) {
+        for (PetscMPIInt r = 0; r < size; ++r) {
+            const PetscReal *box = &boxes[2 * ndims * r];
+            if (r != rank && box[0] <= box[ndims] && boxDistanceSquared(r, &localBox[0], &localBox[ndims]) < cutoff * cutoff) {
+                neighborRanks.push_back(r);
+            }
+        }
+    }
+    const auto numberNeighbors = neighborRanks.size();
+
+    // pack each particle within the cutoff of a neighboring rank's box
+    std::vector<std::vector<PetscReal>> sendValues(numberNeighbors);
+    std::vector<std::vector<PetscInt64>> sendIds(numberNeighbors);
+    if (numberNeighbors) {
+        PetscInt64 *pid;
+        DMSwarmGetField(dm, DMSwarmField_pid, NULL, NULL, (void **)&pid) >> checkError;
+        for (PetscInt p = 0; p < np; ++p) {
+            const PetscReal *point = &coordinates[p * ndims];
+            for (std::size_t n = 0; n < numberNeighbors; ++n) {
+                if (boxDistanceSquared(neighborRanks[n], point, point) >= cutoff * cutoff) {
+                    continue;
+                }
+                sendValues[n].insert(sendValues[n].end(), point, point + ndims);
+                for (const auto &source : sources) {
+                    const PetscReal *values = source.data + p * source.stride + source.offset;
+                    sendValues[n].insert(sendValues[n].end(), values, values + source.components);
+                }
+                sendIds[n].push_back(pid[p]);
+            }
+        }
+        DMSwarmRestoreField(dm, DMSwarmField_pid, NULL, NULL, (void **)&pid) >> checkError;
+    }
+
+    // exchange the number of ghost particles and then the ghost particles with each neighboring rank
+    PetscMPIInt countTag, valueTag, idTag;
+    PetscObjectGetNewTag((PetscObject)dm, &countTag) >> checkError;
+    PetscObjectGetNewTag((PetscObject)dm, &valueTag) >> checkError;
+    PetscObjectGetNewTag((PetscObject)dm, &idTag) >> checkError;
+
+    std::vector<PetscMPIInt> sendCounts(numberNeighbors), receiveCounts(numberNeighbors);
+    std::vector<MPI_Request> requests(4 * numberNeighbors);
+    for (std::size_t n = 0; n < numberNeighbors; ++n) {
+        sendCounts[n] = (PetscMPIInt)sendIds[n].size();
+        MPI_Irecv(&receiveCounts[n], 1, MPI_INT, neighborRanks[n], countTag, comm, &requests[n]) >> checkMpiError;
+        MPI_Isend(&sendCounts[n], 1, MPI_INT, neighborRanks[n], countTag, comm, &requests[numberNeighbors + n]) >> checkMpiError;
+    }
+    MPI_Waitall((PetscMPIInt)(2 * numberNeighbors), requests.data(), MPI_STATUSES_IGNORE) >> checkMpiError;
+
+    std::vector<PetscInt> receiveOffsets(numberNeighbors + 1, 0);
+    for (std::size_t n = 0; n < numberNeighbors; ++n) {
+        receiveOffsets[n + 1] = receiveOffsets[n] + receiveCounts[n];
+    }
+    const PetscInt nGhost = receiveOffsets[numberNeighbors];
+    std::vector<PetscReal> receiveValues(nGhost * recordSize);
+    ghostIds.resize(nGhost);
+    for (std::size_t n = 0; n < numberNeighbors; ++n) {
+        MPI_Irecv(receiveValues.data() + receiveOffsets[n] * recordSize, receiveCounts[n] * (PetscMPIInt)recordSize, MPIU_REAL, neighborRanks[n], valueTag, comm, &requests[4 * n]) >> checkMpiError;
+        MPI_Irecv(ghostIds.data() + receiveOffsets[n], receiveCounts[n], MPIU_INT64, neighborRanks[n], idTag, comm, &requests[4 * n + 1]) >> checkMpiError;
+        MPI_Isend(sendValues[n].data(), (PetscMPIInt)sendValues[n].size(), MPIU_REAL, neighborRanks[n], valueTag, comm, &requests[4 * n + 2]) >> checkMpiError;
+        MPI_Isend(sendIds[n].data(), sendCounts[n], MPIU_INT64, neighborRanks[n], idTag, comm, &requests[4 * n + 3]) >> checkMpiError;
+    }
+    MPI_Waitall((PetscMPIInt)(4 * numberNeighbors), requests.data(), MPI_STATUSES_IGNORE) >> checkMpiError;
+
+    // unpack the ghost coordinates and fields
+    ghostCoordinates.resize(nGhost * ndims);
+    ghostFields.clear();
+    for (std::size_t f = 0; f < sources.size(); ++f) {
+        ghostFields[ghostFieldNames[f]] = {sources[f].components, std::vector<PetscReal>(nGhost * sources[f].components)};
+    }
+    for (PetscInt g = 0; g < nGhost; ++g) {
+        const PetscReal *record = &receiveValues[g * recordSize];
+        std::copy(record, record + ndims, &ghostCoordinates[g * ndims]);
+        record += ndims;
+        for (std::size_t f = 0; f < sources.size(); ++f) {
+            const PetscInt components = sources[f].components;
+            std::copy(record, record + components, &ghostFields[ghostFieldNames[f]].second[g * components]);
+            record += components;
+        }
+    }
+
+    neighborSearch.Build(ndims, cutoff, np, coordinates, ndims, nGhost, ghostCoordinates.data());
+
+    for (auto &[storageField, storage] : storageFields) {
+        DMSwarmRestoreField(dm, storageField.c_str(), NULL, NULL, (void **)&storage.second) >> checkError;
+    }
+}
+
+const std::vector<PetscReal> &ablate::particles::Particles::GetGhostField(const std::string &fieldName, PetscInt *components) const {
+    auto ghostField = ghostFields.find(fieldName);
+    if (ghostField == ghostFields.end()) {
+        throw std::invalid_argument("The field " + fieldName + " was not copied with the ghost particles of " + name);
+    }
+    if (components) {
+        *components = ghostField->second.first;
+    }
+    return ghostField->second.second;
+}
+
+void ablate::particles::Particles::InterpolateFlowVelocity(PetscReal time, PetscInt np, const PetscReal *coordinates, PetscInt stride, PetscReal *velocity) {
+    PetscLogEventBegin(interpolateLogEvent, dm, 0, 0, 0) >> checkError;
+    // the cell id stored with each particle is used as the hint for point location
+    PetscInt *cellHints;
+    DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellHints) >> checkError;
+    velocityInterpolator->Interpolate(time, np, coordinates, stride, cellHints, velocity);
+    DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellHints) >> checkError;
+    PetscLogEventEnd(interpolateLogEvent, dm, 0, 0, 0) >> checkError;
+}
+
+void ablate::particles::Particles::RegisterSourceDeposition(const std::string &particleField, PetscInt components, const std::string &flowFieldName, PetscInt flowComponentOffset) {
+    RegisterField(ParticleFieldDescriptor{.fieldName = particleField, .components = components, .type = PETSC_REAL});
+    sourceDepositions.push_back(SourceDeposition{
+        .particleField = particleField, .components = components, .flowFieldName = flowFieldName, .flowComponentOffset = flowComponentOffset, .flowField = -1});
+}
+
+void ablate::particles::Particles::DepositParticleSources() {
+    VecZeroEntries(flowSource) >> checkError;
+
+    DM flowDM;
+    VecGetDM(flowSource, &flowDM) >> checkError;
+    PetscScalar *sourceArray;
+    VecGetArray(flowSource, &sourceArray) >> checkError;
+
+    PetscInt np;
+    DMSwarmGetLocalSize(dm, &np) >> checkError;
+    const PetscInt *cells;
+    DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+
+    for (const auto &deposition : sourceDepositions) {
+        const PetscReal *particleSource;
+        DMSwarmGetField(dm, deposition.particleField.c_str(), NULL, NULL, (void **)&particleSource) >> checkError;
+        depositionWork.resize(deposition.components);
+
+        // the particles are stored grouped by cell, so each run of particles in the same cell is summed before a single write to the cell
+        PetscInt p = 0;
+        while (p < np) {
+            const PetscInt cell = cells[p];
+            std::fill(depositionWork.begin(), depositionWork.end(), 0.0);
+            for (; p < np && cells[p] == cell; ++p) {
+                for (PetscInt c = 0; c < deposition.components; ++c) {
+                    depositionWork[c] += particleSource[p * deposition.components + c];
+                }
+            }
+
+            // particles outside of the owned cells (they left the domain) are dropped
+            if (!velocityInterpolator->IsOwnedCell(cell)) {
+                continue;
+            }
+            PetscScalar *cellSource = NULL;
+            DMPlexPointGlobalFieldRef(flowDM, cell, deposition.flowField, sourceArray, &cellSource) >> checkError;
+            if (!cellSource) {
+                continue;
+            }
+            const PetscReal volume = velocityInterpolator->GetVolume(cell);
+            for (PetscInt c = 0; c < deposition.components; ++c) {
+                cellSource[deposition.flowComponentOffset + c] += depositionWork[c] / volume;
+            }
+        }
+
+        DMSwarmRestoreField(dm, deposition.particleField.c_str(), NULL, NULL, (void **)&particleSource) >> checkError;
+    }
+
+    DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+    VecRestoreArray(flowSource, &sourceArray) >> checkError;
+}
+
+PetscErrorCode ablate::particles::Particles::AddParticleSources(DM dm, PetscReal time, Vec locXVec, Vec globFVec, void *ctx) {
+    PetscFunctionBeginUser;
+    ablate::particles::Particles *particles = (ablate::particles::Particles *)ctx;
+    PetscErrorCode ierr = VecAXPY(globFVec, 1.0, particles->flowSource);
+    CHKERRQ(ierr);
+    PetscFunctionReturn(0);
 }
 
 /**
@@ -333,20 +862,31 @@ void ablate::particles::Particles::SwarmMigrate() {
  * @param field
  * @param mathFunction
  */
-void ablate::particles::Particles::ProjectFunction(const std::string &field, ablate::mathFunctions::MathFunction &mathFunction) {
+void ablate::particles::Particles::ProjectFunction(const std::string &field, ablate::mathFunctions::MathFunction &mathFunction, PetscInt start, PetscInt end) {
     // Get the local number of particles
     PetscInt np;
     DMSwarmGetLocalSize(dm, &np) >> checkError;
+    if (end < 0) {
+        end = np;
+    }
 
     // Get the raw access to position and update field
     PetscInt dim;
     PetscReal *positionData;
     DMSwarmGetField(dm, DMSwarmPICField_coor, &dim, NULL, (void **)&positionData) >> checkError;
 
+    // solution fields may only be stored in the packed solution
     PetscInt fieldComponents;
+    const PetscInt packedOffset = GetPackedSolutionOffset(field, &fieldComponents);
+    const std::string storageField = packedOffset < 0 ? field : PackedSolution;
+
+    PetscInt fieldStride;
     PetscDataType fieldType;
     PetscReal *fieldData;
-    DMSwarmGetField(dm, field.c_str(), &fieldComponents, &fieldType, (void **)&fieldData) >> checkError;
+    DMSwarmGetField(dm, storageField.c_str(), &fieldStride, &fieldType, (void **)&fieldData) >> checkError;
+    if (packedOffset < 0) {
+        fieldComponents = fieldStride;
+    }
 
     if (fieldType != PETSC_REAL) {
         throw std::invalid_argument("ProjectFunction only supports PETSC_REAL");
@@ -356,121 +896,184 @@ void ablate::particles::Particles::ProjectFunction(const std::string &field, abl
     void *functionContext = mathFunction.GetContext();
     ablate::mathFunctions::PetscFunction functionPointer = mathFunction.GetPetscFunction();
 
-    // Iterate over each local particle
-    for (PetscInt p = 0; p < np; ++p) {
+    // Iterate over each local particle in the range
+    for (PetscInt p = start; p < end; ++p) {
         // compute the position offset
         const PetscInt positionOffset = p * dim;
 
         // Compute the field offset
-        const PetscInt fieldOffset = p * fieldComponents;
+        const PetscInt fieldOffset = p * fieldStride + PetscMax(packedOffset, 0);
 
         // Call the update function
         functionPointer(dim, 0.0, positionData + positionOffset, fieldComponents, fieldData + fieldOffset, functionContext) >> checkError;
     }
     DMSwarmRestoreField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&positionData);
-    DMSwarmRestoreField(dm, field.c_str(), NULL, NULL, (void **)&fieldData);
+    DMSwarmRestoreField(dm, storageField.c_str(), NULL, NULL, (void **)&fieldData);
 }
 
 Vec ablate::particles::Particles::GetPackedSolutionVector() {
-    const PetscInt nf = particleSolutionDescriptors.size();
-
-    // If there is more than one field, pack up the data
-    if (nf > 1) {
-        // Get the local number of particles
-        PetscInt np;
-        DMSwarmGetLocalSize(dm, &np) >> checkError;
+    PetscInt np;
+    DMSwarmGetLocalSize(dm, &np) >> checkError;
 
-        // Get a vector of pointers to the solution fields
-        std::vector<PetscReal *> fieldDatas(nf);
-        std::vector<PetscInt> fieldSizes(nf);
+    // the solution field is the canonical storage, so the vector wraps it directly
+    PetscInt components;
+    PetscReal *solutionFieldData;
+    DMSwarmGetField(dm, GetSolutionVectorName(), &components, NULL, (void **)&solutionFieldData) >> checkError;
 
-        // get raw access to each array
-        for (auto f = 0; f < nf; f++) {
-            DMSwarmGetField(dm, particleSolutionDescriptors[f].fieldName.c_str(), &fieldSizes[f], NULL, (void **)&fieldDatas[f]) >> checkError;
+    // the ts vectors only need to be rebuilt when the number of local particles on any rank changes
+    PetscInt solutionSize = -1;
+    if (solutionVector) {
+        VecGetLocalSize(solutionVector, &solutionSize) >> checkError;
+    }
+    PetscInt resized = solutionSize != np * components;
+    PetscInt resizedAll = PETSC_FALSE;
+    MPIU_Allreduce(&resized, &resizedAll, 1, MPIU_INT, MPIU_MAX, PetscObjectComm((PetscObject)dm)) >> checkMpiError;
+    if (resizedAll) {
+        if (solutionVector) {
+            VecDestroy(&solutionVector) >> checkError;
         }
+        VecCreateMPIWithArray(PetscObjectComm((PetscObject)dm), components, np * components, PETSC_DETERMINE, NULL, &solutionVector) >> checkError;
+        dmChanged = true;
+    }
+    VecPlaceArray(solutionVector, solutionFieldData) >> checkError;
 
-        // and raw access to the combined array
-        PetscInt solutionComponents;
-        PetscReal *solutionFieldData;
-        DMSwarmGetField(dm, PackedSolution, &solutionComponents, NULL, (void **)&solutionFieldData) >> checkError;
+    return solutionVector;
+}
 
-        for (PetscInt p = 0; p < np; ++p) {
-            PetscInt offset = 0;
-            // March over each field
-            for (PetscInt f = 0; f < nf; ++f) {
-                for (PetscInt c = 0; c < fieldSizes[f]; c++) {
-                    solutionFieldData[p * solutionComponents + offset++] = fieldDatas[f][p * fieldSizes[f] + c];
-                }
-            }
-        }
+void ablate::particles::Particles::RestorePackedSolutionVector(Vec solution) {
+    VecResetArray(solution) >> checkError;
+    DMSwarmRestoreField(dm, GetSolutionVectorName(), NULL, NULL, NULL) >> checkError;
 
-        // return raw access
-        for (auto f = 0; f < nf; f++) {
-            DMSwarmRestoreField(dm, particleSolutionDescriptors[f].fieldName.c_str(), NULL, NULL, (void **)&fieldDatas[f]) >> checkError;
+    // the coordinate field must be up to date for migration
+    SyncPackedCoordinates(false);
+}
+
+void ablate::particles::Particles::SyncPackedCoordinates(bool toPacked) {
+    if (particleSolutionDescriptors.size() < 2) {
+        return;
+    }
+
+    PetscInt np;
+    DMSwarmGetLocalSize(dm, &np) >> checkError;
+
+    PetscInt dim;
+    PetscReal *coordinates;
+    DMSwarmGetField(dm, DMSwarmPICField_coor, &dim, NULL, (void **)&coordinates) >> checkError;
+    PetscInt solutionComponents;
+    PetscReal *solutionFieldData;
+    DMSwarmGetField(dm, PackedSolution, &solutionComponents, NULL, (void **)&solutionFieldData) >> checkError;
+
+    for (PetscInt p = 0; p < np; ++p) {
+        for (PetscInt d = 0; d < dim; ++d) {
+            if (toPacked) {
+                solutionFieldData[p * solutionComponents + d] = coordinates[p * dim + d];
+            } else {
+                coordinates[p * dim + d] = solutionFieldData[p * solutionComponents + d];
+            }
         }
-        DMSwarmRestoreField(dm, PackedSolution, NULL, NULL, (void **)&solutionFieldData) >> checkError;
     }
 
-    // get the updated values as a vec
-    Vec packedVector;
-    DMSwarmCreateGlobalVectorFromField(dm, GetSolutionVectorName(), &packedVector) >> checkError;
-    return packedVector;
+    DMSwarmRestoreField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
+    DMSwarmRestoreField(dm, PackedSolution, NULL, NULL, (void **)&solutionFieldData) >> checkError;
 }
 
-void ablate::particles::Particles::RestorePackedSolutionVector(Vec solutionVector) {
-    const PetscInt nf = particleSolutionDescriptors.size();
-
-    DMSwarmDestroyGlobalVectorFromField(dm, GetSolutionVectorName(), &solutionVector) >> checkError;
-    // If there is more than one field, unpack the data
-    if (nf > 1) {
-        // Get the local number of particle
-        PetscInt np;
-        DMSwarmGetLocalSize(dm, &np) >> checkError;
+void ablate::particles::Particles::InjectParticles(PetscReal dt) {
+    injectionCoordinates.clear();
+    injectionCells.clear();
+    std::vector<std::size_t> injectorEnds;
+    for (auto &injector : injectors) {
+        injector->Inject(dt, injectionCoordinates, injectionCells);
+        injectorEnds.push_back(injectionCells.size());
+    }
 
-        // Get a vector of pointers to the solution fields
-        std::vector<PetscReal *> fieldDatas(nf);
-        std::vector<PetscInt> fieldSizes(nf);
+    // number the injected particles after every existing particle
+    MPI_Comm comm = PetscObjectComm((PetscObject)dm);
+    PetscInt64 localCount = (PetscInt64)injectionCells.size();
+    PetscInt64 idOffset = 0, totalCount = 0;
+    MPI_Exscan(&localCount, &idOffset, 1, MPIU_INT64, MPI_SUM, comm) >> checkMpiError;
+    PetscMPIInt rank;
+    MPI_Comm_rank(comm, &rank) >> checkMpiError;
+    if (rank == 0) {
+        idOffset = 0;
+    }
+    MPIU_Allreduce(&localCount, &totalCount, 1, MPIU_INT64, MPI_SUM, comm) >> checkMpiError;
+    const PetscInt64 firstId = nextParticleId + idOffset;
+    nextParticleId += totalCount;
+    if (localCount == 0) {
+        return;
+    }
 
-        // get raw access to each array
-        for (auto f = 0; f < nf; f++) {
-            DMSwarmGetField(dm, particleSolutionDescriptors[f].fieldName.c_str(), &fieldSizes[f], NULL, (void **)&fieldDatas[f]) >> checkError;
-        }
+    // the injected particles are appended, the storage only grows (in amortized blocks) when the unused storage is exhausted
+    PetscInt np;
+    DMSwarmGetLocalSize(dm, &np) >> checkError;
+    const PetscInt newNp = np + (PetscInt)localCount;
+    DMSwarmSetLocalSizes(dm, newNp, GetStorageBuffer(newNp)) >> checkError;
+
+    // start each injected particle with zero in every field
+    for (const auto &fieldName : GetSwarmFieldNames()) {
+        PetscInt blockSize;
+        PetscDataType dataType;
+        char *data;
+        DMSwarmGetField(dm, fieldName.c_str(), &blockSize, &dataType, (void **)&data) >> checkError;
+        size_t typeSize;
+        PetscDataTypeGetSize(dataType, &typeSize) >> checkError;
+        std::memset(data + np * blockSize * typeSize, 0, localCount * blockSize * typeSize);
+        DMSwarmRestoreField(dm, fieldName.c_str(), NULL, NULL, (void **)&data) >> checkError;
+    }
 
-        // and raw access to the combined array
-        PetscInt solutionComponents;
-        PetscReal *solutionFieldData;
-        DMSwarmGetField(dm, PackedSolution, &solutionComponents, NULL, (void **)&solutionFieldData) >> checkError;
+    PetscReal *coordinates;
+    PetscInt *cells;
+    PetscInt *rankId;
+    PetscInt64 *pid;
+    DMSwarmGetField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
+    DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+    DMSwarmGetField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankId) >> checkError;
+    DMSwarmGetField(dm, DMSwarmField_pid, NULL, NULL, (void **)&pid) >> checkError;
+    PetscArraycpy(coordinates + np * ndims, injectionCoordinates.data(), localCount * ndims) >> checkError;
+    for (PetscInt i = 0; i < (PetscInt)localCount; ++i) {
+        cells[np + i] = injectionCells[i];
+        rankId[np + i] = rank;
+        pid[np + i] = firstId + i;
+    }
+    DMSwarmRestoreField(dm, DMSwarmField_pid, NULL, NULL, (void **)&pid) >> checkError;
+    DMSwarmRestoreField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankId) >> checkError;
+    DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+    DMSwarmRestoreField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
 
-        for (PetscInt p = 0; p < np; ++p) {
-            PetscInt offset = 0;
-            // March over each field
-            for (PetscInt f = 0; f < nf; ++f) {
-                for (PetscInt c = 0; c < fieldSizes[f]; c++) {
-                    fieldDatas[f][p * fieldSizes[f] + c] = solutionFieldData[p * solutionComponents + offset++];
-                }
-            }
-        }
+    SyncPackedCoordinates(true);
+    if (exactSolution) {
+        StoreInitialParticleLocations(np);
+    }
 
-        // return raw access
-        for (auto f = 0; f < nf; f++) {
-            DMSwarmRestoreField(dm, particleSolutionDescriptors[f].fieldName.c_str(), NULL, NULL, (void **)&fieldDatas[f]) >> checkError;
+    // initialize the injected particle fields from each injector (or the particle field initialization)
+    PetscInt start = np;
+    for (std::size_t i = 0; i < injectors.size(); ++i) {
+        const PetscInt end = np + (PetscInt)injectorEnds[i];
+        const auto &injectorInitialization = injectors[i]->GetFieldInitialization().empty() ? fieldInitialization : injectors[i]->GetFieldInitialization();
+        for (auto &field : injectorInitialization) {
+            ProjectFunction(field->GetName(), field->GetSolutionField(), start, end);
         }
-        DMSwarmRestoreField(dm, PackedSolution, NULL, NULL, (void **)&solutionFieldData) >> checkError;
+        start = end;
     }
+
+    cellIndexValid = false;
 }
 
+void ablate::particles::Particles::Integrate(Vec solution) { TSSolve(particleTs, solution) >> checkError; }
+
 void ablate::particles::Particles::AdvectParticles(TS flowTS) {
+    PetscLogEventBegin(advectLogEvent, dm, 0, 0, 0) >> checkError;
     PetscReal time;
 
-    // if the dm has changed size (new particles, particles moved between ranks, particles deleted) reset the ts
+    // Get the position, velocity and Kinematics vector
+    Vec solution = GetPackedSolutionVector();
+
+    // if the solution vector was rebuilt (the number of particles changed) reset the ts
     if (dmChanged) {
         TSReset(particleTs) >> checkError;
         dmChanged = PETSC_FALSE;
     }
 
-    // Get the position, velocity and Kinematics vector
-    Vec solutionVector = GetPackedSolutionVector();
-
     // get the particle time step
     PetscReal dtInitial;
     TSGetTimeStep(particleTs, &dtInitial) >> checkError;
@@ -480,10 +1083,13 @@ void ablate::particles::Particles::AdvectParticles(TS flowTS) {
     TSSetMaxTime(particleTs, time) >> checkError;
     timeFinal = time;
 
+    // the first particle group each flow step moves the shared velocity interpolation window to [ti, tf]
+    velocityInterpolator->Advance(timeFinal);
+
     // take the needed timesteps to get to the flow time
-    TSSolve(particleTs, solutionVector) >> checkError;
+    Integrate(solution);
 
-    VecCopy(flowFinal, flowInitial) >> checkError;
+    const PetscReal flowDt = timeFinal - timeInitial;
     timeInitial = timeFinal;
 
     // get the updated time step, and reset if it has gone down
@@ -493,10 +1099,60 @@ void ablate::particles::Particles::AdvectParticles(TS flowTS) {
         TSSetTimeStep(particleTs, dtInitial) >> checkError;
     }
 
-    RestorePackedSolutionVector(solutionVector);
+    RestorePackedSolutionVector(solution);
 
     // Migrate any particles that have moved
     SwarmMigrate();
+
+    // add any new particles on their owning ranks
+    if (!injectors.empty()) {
+        InjectParticles(flowDt);
+    }
+
+    // periodically group the particles by cell
+    advectionCount++;
+    if (sortInterval > 0 && advectionCount % sortInterval == 0) {
+        SortParticles();
+    }
+
+    // deposit the particle sources onto the flow, these are applied over the next flow step
+    if (flowSource) {
+        ComputeParticleSources();
+        DepositParticleSources();
+    }
+
+    if (costFlow) {
+        RecordCellParticleCounts();
+    }
+    PetscLogEventEnd(advectLogEvent, dm, 0, 0, 0) >> checkError;
+}
+
+void ablate::particles::Particles::RecordCellParticleCounts() {
+    PetscInt np;
+    DMSwarmGetLocalSize(dm, &np) >> checkError;
+    PetscReal *coordinates;
+    PetscInt *cells;
+    DMSwarmGetField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
+    DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+    velocityInterpolator->Locate(np, coordinates, ndims, cells);
+
+    // each run of particles in the same cell is counted once
+    std::vector<PetscInt> countCells;
+    std::vector<PetscReal> counts;
+    for (PetscInt p = 0; p < np; ++p) {
+        if (!velocityInterpolator->IsOwnedCell(cells[p])) {
+            continue;
+        }
+        if (countCells.empty() || countCells.back() != cells[p]) {
+            countCells.push_back(cells[p]);
+            counts.push_back(0.0);
+        }
+        counts.back() += 1.0;
+    }
+    DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+    DMSwarmRestoreField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
+
+    costFlow->AddCellCost(flow::FVFlow::PARTICLE_COST, countCells, counts);
 }
 
 static PetscErrorCode DMSequenceViewTimeHDF5(DM dm, PetscViewer viewer) {
@@ -550,6 +1206,29 @@ void ablate::particles::Particles::View(PetscViewer viewer, PetscInt steps, Pets
     PetscFunctionBegin;
     Vec particleVector;
 
+    // the output fields for the packed solution are only updated for viewing
+    if (particleSolutionDescriptors.size() > 1) {
+        PetscInt np;
+        DMSwarmGetLocalSize(GetDM(), &np) >> checkError;
+        PetscInt solutionComponents;
+        const PetscReal *solutionFieldData;
+        DMSwarmGetField(GetDM(), PackedSolution, &solutionComponents, NULL, (void **)&solutionFieldData) >> checkError;
+
+        for (std::size_t f = 1; f < particleSolutionDescriptors.size(); f++) {
+            const auto &field = particleSolutionDescriptors[f];
+            const PetscInt offset = GetPackedSolutionOffset(field.fieldName);
+            PetscReal *fieldData;
+            DMSwarmGetField(GetDM(), field.fieldName.c_str(), NULL, NULL, (void **)&fieldData) >> checkError;
+            for (PetscInt p = 0; p < np; ++p) {
+                for (PetscInt c = 0; c < field.components; ++c) {
+                    fieldData[p * field.components + c] = solutionFieldData[p * solutionComponents + offset + c];
+                }
+            }
+            DMSwarmRestoreField(GetDM(), field.fieldName.c_str(), NULL, NULL, (void **)&fieldData) >> checkError;
+        }
+        DMSwarmRestoreField(GetDM(), PackedSolution, NULL, NULL, (void **)&solutionFieldData) >> checkError;
+    }
+
     for (auto const &field : particleFieldDescriptors) {
         if (field.type == PETSC_DOUBLE) {
             DMSwarmCreateGlobalVectorFromField(GetDM(), field.fieldName.c_str(), &particleVector) >> checkError;
@@ -566,3 +1245,192 @@ void ablate::particles::Particles::View(PetscViewer viewer, PetscInt steps, Pets
         DMSequenceViewTimeHDF5(GetDM(), viewer) >> checkError;
     }
 }
+
+namespace {
+/**
+ * Gets and sets the values of the (real or integer) swarm fields as reals for the checkpoint
+ */
+PetscReal GetFieldValue(const void *data, PetscDataType dataType, PetscInt index) {
+    switch (dataType) {
+        case PETSC_REAL:
+            return ((const PetscReal *)data)[index];
+        case PETSC_INT:
+            return (PetscReal)((const PetscInt *)data)[index];
+        case PETSC_INT64:
+            return (PetscReal)((const PetscInt64 *)data)[index];
+        default:
+            throw std::invalid_argument("Unable to checkpoint the particle field type " + std::string(PetscDataTypes[dataType]));
+    }
+}
+
+void SetFieldValue(void *data, PetscDataType dataType, PetscInt index, PetscReal value) {
+    switch (dataType) {
+        case PETSC_REAL:
+            ((PetscReal *)data)[index] = value;
+            break;
+        case PETSC_INT:
+            ((PetscInt *)data)[index] = (PetscInt)value;
+            break;
+        case PETSC_INT64:
+            ((PetscInt64 *)data)[index] = (PetscInt64)value;
+            break;
+        default:
+            throw std::invalid_argument("Unable to restore the particle field type " + std::string(PetscDataTypes[dataType]));
+    }
+}
+}  // namespace
+
+void ablate::particles::Particles::Save(monitors::Checkpoint &checkpoint) {
+    PetscInt np;
+    DMSwarmGetLocalSize(dm, &np) >> checkError;
+    DM cellDm;
+    DMSwarmGetCellDM(dm, &cellDm) >> checkError;
+
+    // each particle is stored with its flow cell, so make sure the cells are current
+    std::vector<PetscInt> particleCells(np);
+    {
+        PetscReal *coordinates;
+        PetscInt *cells;
+        DMSwarmGetField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
+        DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+        velocityInterpolator->Locate(np, coordinates, ndims, cells);
+        std::copy(cells, cells + np, particleCells.begin());
+        DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cells) >> checkError;
+        DMSwarmRestoreField(dm, DMSwarmPICField_coor, NULL, NULL, (void **)&coordinates) >> checkError;
+    }
+
+    // pack every field of each particle into a single record
+    PetscInt recordSize = 0;
+    std::vector<PetscReal> fieldComponents;
+    for (const auto &field : particleFieldDescriptors) {
+        recordSize += field.components;
+        fieldComponents.push_back(field.components);
+    }
+    std::vector<PetscReal> values(np * recordSize);
+    PetscInt fieldOffset = 0;
+    for (const auto &field : particleFieldDescriptors) {
+        PetscInt blockSize;
+        PetscDataType dataType;
+        void *data;
+        DMSwarmGetField(dm, field.fieldName.c_str(), &blockSize, &dataType, &data) >> checkError;
+        for (PetscInt p = 0; p < np; ++p) {
+            for (PetscInt c = 0; c < blockSize; ++c) {
+                values[p * recordSize + fieldOffset + c] = GetFieldValue(data, dataType, p * blockSize + c);
+            }
+        }
+        DMSwarmRestoreField(dm, field.fieldName.c_str(), NULL, NULL, &data) >> checkError;
+        fieldOffset += blockSize;
+    }
+
+    // particles that are not in a flow cell cannot be placed on restart
+    std::vector<PetscInt> points;
+    std::vector<PetscInt> offsets(1, 0);
+    for (PetscInt p = 0; p < np; ++p) {
+        if (particleCells[p] >= 0) {
+            std::copy(values.begin() + p * recordSize, values.begin() + (p + 1) * recordSize, values.begin() + offsets.back());
+            points.push_back(particleCells[p]);
+            offsets.push_back(offsets.back() + recordSize);
+        }
+    }
+    checkpoint.WriteValues("fieldComponents", fieldComponents);
+    checkpoint.WritePointRecords("particles", cellDm, points, offsets, values.data());
+
+    // the time stepping and injection state is the same on every rank
+    PetscReal dt;
+    TSGetTimeStep(particleTs, &dt) >> checkError;
+    std::vector<PetscReal> state = {timeInitial, (PetscReal)nextParticleId, (PetscReal)advectionCount, dt};
+    for (const auto &injector : injectors) {
+        PetscReal carry;
+        PetscInt64 injected;
+        injector->GetState(carry, injected);
+        state.push_back(carry);
+        state.push_back((PetscReal)injected);
+    }
+    checkpoint.WriteValues("state", state);
+
+    // the sources deposited after the last advection are applied over the next flow step
+    if (flowSource) {
+        checkpoint.WriteVector("flowSource", flowSource);
+    }
+}
+
+void ablate::particles::Particles::Restore(monitors::Checkpoint &checkpoint, PetscReal time) {
+    DM cellDm;
+    DMSwarmGetCellDM(dm, &cellDm) >> checkError;
+
+    // the particle fields must match the fields in the checkpoint
+    auto fieldComponents = checkpoint.ReadValues("fieldComponents");
+    PetscInt recordSize = 0;
+    bool fieldsMatch = fieldComponents.size() == particleFieldDescriptors.size();
+    for (std::size_t f = 0; f < particleFieldDescriptors.size(); ++f) {
+        recordSize += particleFieldDescriptors[f].components;
+        fieldsMatch = fieldsMatch && (PetscInt)fieldComponents[f] == particleFieldDescriptors[f].components;
+    }
+    auto state = checkpoint.ReadValues("state");
+    if (!fieldsMatch || state.size() != 4 + 2 * injectors.size()) {
+        throw std::invalid_argument("The particles " + name + " do not match the particles in the checkpoint");
+    }
+
+    // each particle is returned on the rank that owns its cell
+    std::vector<PetscInt> ownedCells;
+    for (PetscInt c = velocityInterpolator->GetCellStart(); c < velocityInterpolator->GetCellEnd(); ++c) {
+        if (velocityInterpolator->IsOwnedCell(c)) {
+            ownedCells.push_back(c);
+        }
+    }
+    std::vector<PetscInt> cells, offsets;
+    std::vector<PetscReal> values;
+    checkpoint.ReadPointRecords("particles", cellDm, ownedCells, cells, offsets, values);
+
+    // replace the local particles
+    const auto np = (PetscInt)cells.size();
+    DMSwarmSetLocalSizes(dm, np, GetStorageBuffer(np)) >> checkError;
+    PetscInt fieldOffset = 0;
+    for (const auto &field : particleFieldDescriptors) {
+        PetscInt blockSize;
+        PetscDataType dataType;
+        void *data;
+        DMSwarmGetField(dm, field.fieldName.c_str(), &blockSize, &dataType, &data) >> checkError;
+        for (PetscInt p = 0; p < np; ++p) {
+            for (PetscInt c = 0; c < blockSize; ++c) {
+                SetFieldValue(data, dataType, p * blockSize + c, values[offsets[p] + fieldOffset + c]);
+            }
+        }
+        DMSwarmRestoreField(dm, field.fieldName.c_str(), NULL, NULL, &data) >> checkError;
+        fieldOffset += blockSize;
+    }
+    PetscMPIInt rank;
+    MPI_Comm_rank(PetscObjectComm((PetscObject)dm), &rank) >> checkMpiError;
+    PetscInt *cellId;
+    PetscInt *rankId;
+    DMSwarmGetField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellId) >> checkError;
+    DMSwarmGetField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankId) >> checkError;
+    for (PetscInt p = 0; p < np; ++p) {
+        cellId[p] = cells[p];
+        rankId[p] = rank;
+    }
+    DMSwarmRestoreField(dm, DMSwarmField_rank, NULL, NULL, (void **)&rankId) >> checkError;
+    DMSwarmRestoreField(dm, DMSwarmPICField_cellid, NULL, NULL, (void **)&cellId) >> checkError;
+
+    // restore the time stepping and injection state
+    timeInitial = state[0];
+    timeFinal = state[0];
+    nextParticleId = (PetscInt64)state[1];
+    advectionCount = (PetscInt)state[2];
+    TSSetTime(particleTs, timeInitial) >> checkError;
+    TSSetTimeStep(particleTs, state[3]) >> checkError;
+    for (std::size_t i = 0; i < injectors.size(); ++i) {
+        injectors[i]->SetState(state[4 + 2 * i], (PetscInt64)state[5 + 2 * i]);
+    }
+    if (flowSource) {
+        checkpoint.ReadVector("flowSource", flowSource);
+    }
+
+    // the particles and the flow were replaced
+    dmChanged = true;
+    cellIndexValid = false;
+    velocityInterpolator->Reset(timeInitial);
+    if (sortInterval > 0) {
+        SortParticles();
+    }
+}
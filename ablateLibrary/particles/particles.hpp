@@ -1,18 +1,24 @@
 #ifndef ABLATELIBRARY_PARTICLES_HPP
 #define ABLATELIBRARY_PARTICLES_HPP
 
+#include <map>
 #include <memory>
 #include "flow/flow.hpp"
+#include "flow/fvFlow.hpp"
 #include "mathFunctions/fieldSolution.hpp"
 #include "mathFunctions/mathFunction.hpp"
+#include "monitors/checkpointable.hpp"
 #include "monitors/viewable.hpp"
 #include "particles/initializers/initializer.hpp"
+#include "particles/injectors/injector.hpp"
 #include "particles/particleFieldDescriptor.hpp"
+#include "particles/particleInterpolator.hpp"
+#include "particles/particleNeighborSearch.hpp"
 #include "solve/timeStepper.hpp"
 
 namespace ablate::particles {
 
-class Particles : public monitors::Viewable {
+class Particles : public monitors::Viewable, public monitors::Checkpointable {
    protected:
     // particle domain
     DM dm;
@@ -26,10 +32,53 @@ class Particles : public monitors::Viewable {
     PetscReal timeInitial; /* The time for ui, at the beginning of the advection solve */
     PetscReal timeFinal;   /* The time for uf, at the end of the advection solve */
 
-    // flow coupling data
-    PetscInt flowVelocityFieldIndex;
-    Vec flowInitial; /* The PDE solution field at ti */
-    Vec flowFinal;   /* The PDE solution field at tf */
+    // persistent interpolation of the flow velocity (between ti and tf) to the particle locations, shared with every particle group in the flow
+    std::shared_ptr<ParticleInterpolator> velocityInterpolator;
+
+    /**
+     * Interpolates the flow velocity to each local particle, linearly in time between the flow at ti and tf.  The particle cell (DMSwarmPICField_cellid) is used
+     * as the starting point for the location and is updated.  Particles outside the local domain receive a zero velocity.
+     * @param time the time of the evaluation
+     * @param np the number of local particles
+     * @param coordinates the particle coordinates
+     * @param stride the distance between the start of each particle's coordinates
+     * @param velocity the interpolated velocity (np*dim)
+     */
+    void InterpolateFlowVelocity(PetscReal time, PetscInt np, const PetscReal* coordinates, PetscInt stride, PetscReal* velocity);
+
+    /**
+     * Describes a per particle source field (the rate of change of the flow field components due to the particle) deposited onto the flow cells
+     */
+    struct SourceDeposition {
+        std::string particleField;
+        PetscInt components;
+        std::string flowFieldName;
+        PetscInt flowComponentOffset;
+        PetscInt flowField;
+    };
+    std::vector<SourceDeposition> sourceDepositions;
+
+    // the particle sources deposited onto the flow cells (per volume), in the layout of the flow solution
+    Vec flowSource = NULL;
+
+    /**
+     * Registers a particle field holding a source that is deposited onto the flow (two way coupling).  This requires a FVFlow.
+     * @param particleField the name of the new particle field
+     * @param components the number of components in the source
+     * @param flowFieldName the flow field receiving the source
+     * @param flowComponentOffset the first component in the flow field receiving the source
+     */
+    void RegisterSourceDeposition(const std::string& particleField, PetscInt components, const std::string& flowFieldName, PetscInt flowComponentOffset);
+
+    /**
+     * Computes the particle source fields at the end of the particle advection.  Called before the sources are deposited.
+     */
+    virtual void ComputeParticleSources() {}
+
+    /**
+     * Sums the particle sources in each owned cell into the flowSource
+     */
+    void DepositParticleSources();
 
     // all fields stored in the particle domain
     std::vector<particles::ParticleFieldDescriptor> particleFieldDescriptors;
@@ -45,38 +94,69 @@ class Particles : public monitors::Viewable {
     void RegisterField(ParticleFieldDescriptor fieldDescriptor);
 
     /**
-     * The register solution fields adds the field to the swarm and includes the value in the pack/unpack solution
+     * The register solution fields adds the field to the solution.  When there is more than one solution field, every solution field is stored interleaved in the
+     * PackedSolution swarm field, which is the canonical storage.  The coordinates are also kept in their own field (needed for migration), the other fields are
+     * only copied out of the packed solution for output.
      * @param fieldDescriptor
      */
     void RegisterSolutionField(ParticleFieldDescriptor fieldDescriptor);
 
+    /**
+     * Returns the offset of the solution field inside of each particle's packed solution, or -1 if the field's canonical storage is not the packed solution
+     * @param fieldName
+     * @param components optional number of components in the field
+     * @return
+     */
+    PetscInt GetPackedSolutionOffset(const std::string& fieldName, PetscInt* components = nullptr) const;
+
     // Petsc options specific to these particles. These may be null by default
     PetscOptions petscOptions;
 
-    // store a boolean to state if a dmChanged (number of particles local/global changed)
+    // store a boolean to state if the particle ts must be reset (the solution vector was rebuilt)
     bool dmChanged;
+
+    /**
+     * Migrates the particles only if a particle left the cells owned by any rank.  When removeOutflow is set particles that are not inside of any rank's cells are
+     * removed after the migration.
+     */
     void SwarmMigrate();
 
+    // the ts solution vector wraps the solution field and is only rebuilt when the number of local particles on any rank changes
+    Vec solutionVector = NULL;
+
     // Store the particle location and field initialization
     std::shared_ptr<particles::initializers::Initializer> initializer = nullptr;
     const std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization;
 
     /**
-     * Gets and packs the solution vector
+     * Places the solution field (no copy) in the solution vector.  The vector (and the ts) is only rebuilt when the number of local particles on any rank
+     * changes.
      * @return
      */
     Vec GetPackedSolutionVector();
     /**
-     * Unpacks and returns the solution vector
+     * Returns the solution field to the swarm and copies the packed coordinates back to the coordinate field
      */
     void RestorePackedSolutionVector(Vec);
 
+    /**
+     * Copies the coordinates between the coordinate field and the packed solution
+     * @param toPacked true to copy from the coordinate field into the packed solution
+     */
+    void SyncPackedCoordinates(bool toPacked);
+
     /**
      * Gets and packs the solution vector
      * @return
      */
     void UnpackSolutionVector(Vec, std::vector<Vec>);
 
+    /**
+     * Integrates the solution from the current particle ts time to timeFinal.  By default this is a TSSolve with the particle ts.
+     * @param solution
+     */
+    virtual void Integrate(Vec solution);
+
     /**
      * Function to be be called after each flow time step
      */
@@ -87,16 +167,109 @@ class Particles : public monitors::Viewable {
      */
     inline const char* GetSolutionVectorName() { return particleSolutionDescriptors.size() == 1 ? DMSwarmPICField_coor : PackedSolution; }
 
+   public:
+    /**
+     * The order in which the particles are stored, particles are always grouped by cell
+     * - cell: cells are in the local cell numbering
+     * - morton: cells are ordered along a morton (z-order) space filling curve through the cell centroids
+     */
+    enum class SortOrder { CELL, MORTON };
+
    private:
     inline static const char PackedSolution[] = "PackedSolution";
     inline static const char ParticleInitialLocation[] = "InitialLocation";
 
-    void StoreInitialParticleLocations();
+    void StoreInitialParticleLocations(PetscInt start = 0);
     static PetscErrorCode ComputeParticleError(TS particleTS, Vec u, Vec e);
 
+    /**
+     * Adds the deposited particle sources to the flow rhs (registered with the FVFlow)
+     */
+    static PetscErrorCode AddParticleSources(DM dm, PetscReal time, Vec locXVec, Vec globFVec, void* ctx);
+
+    // work array to sum the sources in each cell
+    std::vector<PetscReal> depositionWork;
+
+    // the flow receiving the number of particles in each cell when it records the cell cost
+    std::shared_ptr<flow::FVFlow> costFlow;
+
+    /**
+     * Adds the number of local particles in each owned cell to the flow cell cost
+     */
+    void RecordCellParticleCounts();
+
+    // profile the advection of the particles and the velocity interpolation and migration within it
+    PetscLogEvent advectLogEvent;
+    PetscLogEvent interpolateLogEvent;
+    PetscLogEvent migrateLogEvent;
+
+    // sort the particles every sortInterval advections (0 disables sorting)
+    const PetscInt sortInterval;
+    const SortOrder sortOrder;
+    PetscInt advectionCount = 0;
+
+    // the position of each local cell in the sort order
+    std::vector<PetscInt> cellSortRank;
+
+    // the local particles in the cell with sort rank r are [cellParticleOffsets[r], cellParticleOffsets[r+1]). Particles outside of the local domain are last.
+    std::vector<PetscInt> cellParticleOffsets;
+    bool cellIndexValid = false;
+
+    /**
+     * Computes the position of each local cell in the sort order
+     */
+    void ComputeCellSortRank();
+
+    /**
+     * The names of every field in the swarm, including the fields registered by DMSwarm
+     */
+    std::vector<std::string> GetSwarmFieldNames() const;
+
+    /**
+     * Reorders the data in every swarm field so that the new particle p is the old particle order[p].  The order may be shorter than the number of local particles
+     * when particles are being removed.
+     */
+    void PermuteSwarmFields(const std::vector<PetscInt>& order);
+
+    /**
+     * Estimates the local bytes held by the swarm fields, the particle vectors, and the work arrays
+     */
+    PetscLogDouble GetMemoryBytes() const;
+
+    // particles added during the simulation
+    const std::vector<std::shared_ptr<injectors::Injector>> injectors;
+
+    // remove the particles that leave the domain
+    const bool removeOutflow;
+
+    // the next unused (global) particle id
+    PetscInt64 nextParticleId = 0;
+
+    // the swarm storage is kept with unused space (at least minimumStorageBlock or storageGrowth times the particles) so most size changes do not reallocate
+    inline static const PetscInt minimumStorageBlock = 1024;
+    inline static const PetscReal storageGrowth = 0.5;
+    PetscInt GetStorageBuffer(PetscInt np) const { return PetscMax(minimumStorageBlock, (PetscInt)(storageGrowth * np)); }
+
+    // work arrays for the injection
+    std::vector<PetscReal> injectionCoordinates;
+    std::vector<PetscInt> injectionCells;
+
+    /**
+     * Adds the particles from each injector over the flow time step
+     * @param dt
+     */
+    void InjectParticles(PetscReal dt);
+
+    // the neighbor search over the local particles and the ghost particles (within the cutoff of this rank) copied from the other ranks
+    ParticleNeighborSearch neighborSearch;
+    std::vector<PetscReal> ghostCoordinates;
+    std::vector<PetscInt64> ghostIds;
+    std::map<std::string, std::pair<PetscInt, std::vector<PetscReal>>> ghostFields;
+
    public:
     explicit Particles(std::string name, int ndims, std::shared_ptr<particles::initializers::Initializer> initializer, std::vector<std::shared_ptr<mathFunctions::FieldSolution>> fieldInitialization,
-                       std::shared_ptr<mathFunctions::MathFunction> exactSolution, std::shared_ptr<parameters::Parameters> options);
+                       std::shared_ptr<mathFunctions::MathFunction> exactSolution, std::shared_ptr<parameters::Parameters> options, int sortInterval = 0, std::string sortOrder = {},
+                       std::vector<std::shared_ptr<injectors::Injector>> injectors = {}, bool removeOutflow = false);
     virtual ~Particles();
 
     const std::string& GetName() const override { return name; }
@@ -107,7 +280,74 @@ class Particles : public monitors::Viewable {
 
     virtual void InitializeFlow(std::shared_ptr<flow::Flow> flow);
 
-    void ProjectFunction(const std::string& field, ablate::mathFunctions::MathFunction& mathFunction);
+    /**
+     * Sets the particle field from the math function of the particle location
+     * @param field
+     * @param mathFunction
+     * @param start the first local particle to set
+     * @param end one past the last local particle to set (all local particles if negative)
+     */
+    void ProjectFunction(const std::string& field, ablate::mathFunctions::MathFunction& mathFunction, PetscInt start = 0, PetscInt end = -1);
+
+    /**
+     * Reorders the local particles so that the particles in each cell are contiguous and rebuilds the cell to particle index.  This is called automatically
+     * every sortInterval advections.
+     */
+    void SortParticles();
+
+    /**
+     * Returns the local particle range [start, end) in the cell as of the last sort.  Particles that moved since the last sort are still listed under their previous
+     * cell.
+     * @param cell the local cell
+     * @param start
+     * @param end
+     * @return false if the index is not available (the particles have not been sorted since they were last added, removed, or migrated)
+     */
+    bool GetCellParticleRange(PetscInt cell, PetscInt& start, PetscInt& end) const;
+
+    /**
+     * Rebuilds the neighbor search over the local particles.  The particles within the cutoff of another rank's particles are copied to that rank as ghost
+     * particles (along with the requested fields), so every pair closer than the cutoff is visited on the rank(s) owning its particles.  The neighbor search is a
+     * snapshot of the particle locations and must be rebuilt after the particles move or are reordered.  Periodic images are not included.  This is collective.
+     * @param cutoff the maximum distance between neighbors
+     * @param ghostFieldNames the (PETSC_REAL) particle fields copied with the ghost particles
+     */
+    void UpdateNeighborSearch(PetscReal cutoff, const std::vector<std::string>& ghostFieldNames = {});
+
+    /**
+     * Calls kernel(i, j, distanceSquared) once for every pair of particles closer than the cutoff, where i is a local particle and j is either a local particle
+     * (j > i) or the ghost particle j - np.  Pairs that span two ranks are visited on both ranks.
+     * @param kernel
+     */
+    template <class Kernel>
+    void ForEachParticlePair(Kernel&& kernel) const {
+        neighborSearch.ForEachPair(std::forward<Kernel>(kernel));
+    }
+
+    /**
+     * the neighbor search from the last UpdateNeighborSearch
+     */
+    const ParticleNeighborSearch& GetNeighborSearch() const { return neighborSearch; }
+
+    /**
+     * the particle id of each ghost particle from the last UpdateNeighborSearch
+     */
+    const std::vector<PetscInt64>& GetGhostParticleIds() const { return ghostIds; }
+
+    /**
+     * Returns the values of a field copied with the ghost particles in the last UpdateNeighborSearch
+     * @param fieldName
+     * @param components optional number of components in the field
+     * @return the ghost values (nGhost*components)
+     */
+    const std::vector<PetscReal>& GetGhostField(const std::string& fieldName, PetscInt* components = nullptr) const;
+
+    /**
+     * Converts the sort order string ('cell' (default) or 'morton') to a SortOrder
+     * @param sortOrder
+     * @return
+     */
+    static SortOrder ParseSortOrder(const std::string& sortOrder);
 
     /**
      * shared function to view all particles;
@@ -118,6 +358,20 @@ class Particles : public monitors::Viewable {
      */
     void View(PetscViewer viewer, PetscInt steps, PetscReal time, Vec u) const override;
 
+    /**
+     * Writes every particle field, keyed by the particle's flow cell, and the particle time stepping and injection state to the checkpoint.  Particles outside of
+     * the flow domain are not stored.
+     * @param checkpoint
+     */
+    void Save(monitors::Checkpoint& checkpoint) override;
+
+    /**
+     * Replaces the particles with the particles in the checkpoint.  Each particle is placed on the rank owning its cell, so the rank count may change.
+     * @param checkpoint
+     * @param time
+     */
+    void Restore(monitors::Checkpoint& checkpoint, PetscReal time) override;
+
     /** common field names for particles **/
     inline static const char ParticleVelocity[] = "ParticleVelocity";
     inline static const char ParticleDiameter[] = "ParticleDiameter";
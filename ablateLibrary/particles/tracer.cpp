@@ -3,8 +3,9 @@
 #include "utilities/petscError.hpp"
 
 ablate::particles::Tracer::Tracer(std::string name, int ndims, std::shared_ptr<particles::initializers::Initializer> initializer, std::shared_ptr<mathFunctions::MathFunction> exactSolution,
-                                  std::shared_ptr<parameters::Parameters> options)
-    : Particles(name, ndims, initializer, {}, exactSolution, options) {
+                                  std::shared_ptr<parameters::Parameters> options, int sortInterval, std::string sortOrder,
+                                  std::vector<std::shared_ptr<injectors::Injector>> injectors, bool removeOutflow)
+    : Particles(name, ndims, initializer, {}, exactSolution, options, sortInterval, sortOrder, injectors, removeOutflow) {
     RegisterField(ParticleFieldDescriptor{.fieldName = ParticleVelocity, .components = ndims, .type = PETSC_REAL});
 }
 
@@ -25,95 +26,43 @@ void ablate::particles::Tracer::InitializeFlow(std::shared_ptr<flow::Flow> flow)
 
 /* x_t = v
 
-   Note that here we use the velocity field at t_{n+1} to advect the particles from
-   t_n to t_{n+1}. If we use both of these fields, we could use Crank-Nicholson or
-   the method of characteristics.
+   Note that the velocity field is interpolated linearly in time between t_n and t_{n+1}
+   to advect the particles from t_n to t_{n+1}.
 */
 PetscErrorCode ablate::particles::Tracer::freeStreaming(TS ts, PetscReal t, Vec X, Vec F, void *ctx) {
     ablate::particles::Tracer *particles = (ablate::particles::Tracer *)ctx;
-    Vec u = particles->flowFinal;
-    DM sdm, dm, vdm;
-    Vec vel, locvel, pvel;
-    IS vis;
-    DMInterpolationInfo ictx;
-    const PetscScalar *coords, *v;
-    PetscScalar *f;
-    PetscInt vf[1] = {particles->flowVelocityFieldIndex};
+    DM sdm;
+    const PetscScalar *coords;
+    PetscScalar *f, *v;
     PetscInt dim, Np;
     PetscErrorCode ierr;
 
     PetscFunctionBeginUser;
     ierr = TSGetDM(ts, &sdm);
     CHKERRQ(ierr);
-    ierr = DMSwarmGetCellDM(sdm, &dm);
-    CHKERRQ(ierr);
-    ierr = DMSwarmCreateGlobalVectorFromField(sdm, ParticleVelocity, &pvel);
-    CHKERRQ(ierr);
     ierr = DMSwarmGetLocalSize(sdm, &Np);
     CHKERRQ(ierr);
-    ierr = DMGetDimension(dm, &dim);
+    ierr = DMGetDimension(sdm, &dim);
     CHKERRQ(ierr);
 
-    /* Get local velocity */
-    ierr = DMCreateSubDM(dm, 1, vf, &vis, &vdm);
-    CHKERRQ(ierr);
-    ierr = VecGetSubVector(u, vis, &vel);
-    CHKERRQ(ierr);
-    ierr = DMGetLocalVector(vdm, &locvel);
-    CHKERRQ(ierr);
-    ierr = DMPlexInsertBoundaryValues(vdm, PETSC_TRUE, locvel, particles->timeInitial, NULL, NULL, NULL);
-    CHKERRQ(ierr);
-    ierr = DMGlobalToLocalBegin(vdm, vel, INSERT_VALUES, locvel);
-    CHKERRQ(ierr);
-    ierr = DMGlobalToLocalEnd(vdm, vel, INSERT_VALUES, locvel);
-    CHKERRQ(ierr);
-    ierr = VecRestoreSubVector(u, vis, &vel);
-    CHKERRQ(ierr);
-    ierr = ISDestroy(&vis);
-    CHKERRQ(ierr);
-
-    /* Interpolate velocity */
-    ierr = DMInterpolationCreate(PETSC_COMM_SELF, &ictx);
-    CHKERRQ(ierr);
-    ierr = DMInterpolationSetDim(ictx, dim);
-    CHKERRQ(ierr);
-    ierr = DMInterpolationSetDof(ictx, dim);
-    CHKERRQ(ierr);
+    /* Interpolate velocity using the persistent interpolator.  Particles that lie outside the domain get a zero velocity,
+     whereas particles that move to another partition should trigger a migration */
     ierr = VecGetArrayRead(X, &coords);
     CHKERRQ(ierr);
-    ierr = DMInterpolationAddPoints(ictx, Np, (PetscReal *)coords);
+    ierr = DMSwarmGetField(sdm, ParticleVelocity, NULL, NULL, (void **)&v);
     CHKERRQ(ierr);
+    particles->InterpolateFlowVelocity(t, Np, coords, dim, v);
     ierr = VecRestoreArrayRead(X, &coords);
     CHKERRQ(ierr);
 
-    /* Particles that lie outside the domain should be dropped,
-     whereas particles that move to another partition should trigger a migration */
-    ierr = DMInterpolationSetUp(ictx, vdm, PETSC_FALSE, PETSC_TRUE);
-    CHKERRQ(ierr);
-    ierr = VecSet(pvel, 0.);
-    CHKERRQ(ierr);
-
-    ierr = DMInterpolationEvaluate(ictx, vdm, locvel, pvel);
-    CHKERRQ(ierr);
-    ierr = DMInterpolationDestroy(&ictx);
-    CHKERRQ(ierr);
-    ierr = DMRestoreLocalVector(vdm, &locvel);
-    CHKERRQ(ierr);
-    ierr = DMDestroy(&vdm);
-    CHKERRQ(ierr);
-
     // right hand side storing
     ierr = VecGetArray(F, &f);
     CHKERRQ(ierr);
-    ierr = VecGetArrayRead(pvel, &v);
-    CHKERRQ(ierr);
     ierr = PetscArraycpy(f, v, Np * dim);
     CHKERRQ(ierr);
-    ierr = VecRestoreArrayRead(pvel, &v);
-    CHKERRQ(ierr);
     ierr = VecRestoreArray(F, &f);
     CHKERRQ(ierr);
-    ierr = DMSwarmDestroyGlobalVectorFromField(sdm, ParticleVelocity, &pvel);
+    ierr = DMSwarmRestoreField(sdm, ParticleVelocity, NULL, NULL, (void **)&v);
     CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
@@ -122,4 +71,8 @@ PetscErrorCode ablate::particles::Tracer::freeStreaming(TS ts, PetscReal t, Vec
 #include "parser/registrar.hpp"
 REGISTER(ablate::particles::Particles, ablate::particles::Tracer, "massless particles that advect with the flow", ARG(std::string, "name", "the name of the particle group"),
          ARG(int, "ndims", "the number of dimensions for the particle"), ARG(particles::initializers::Initializer, "initializer", "the initial particle setup methods"),
-         OPT(mathFunctions::MathFunction, "exactSolution", "the particle location exact solution"), ARG(parameters::Parameters, "options", "options to be passed to petsc"));
\ No newline at end of file
+         OPT(mathFunctions::MathFunction, "exactSolution", "the particle location exact solution"), ARG(parameters::Parameters, "options", "options to be passed to petsc"),
+         OPT(int, "sortInterval", "reorder the local particles by cell every sortInterval flow steps (default 0, never)"),
+         OPT(std::string, "sortOrder", "the order of the cells when sorting, 'cell' (default) or 'morton' for a space filling curve"),
+         OPT(std::vector<particles::injectors::Injector>, "injectors", "particles added during the simulation"),
+         OPT(bool, "removeOutflow", "remove the particles that leave the domain (default false)"));
\ No newline at end of file
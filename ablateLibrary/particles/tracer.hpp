@@ -6,7 +6,8 @@ namespace ablate::particles {
 class Tracer : public Particles {
    public:
     Tracer(std::string name, int ndims, std::shared_ptr<particles::initializers::Initializer> initializer, std::shared_ptr<mathFunctions::MathFunction> exactSolution = {},
-           std::shared_ptr<parameters::Parameters> options = {});
+           std::shared_ptr<parameters::Parameters> options = {}, int sortInterval = 0, std::string sortOrder = {},
+           std::vector<std::shared_ptr<injectors::Injector>> injectors = {}, bool removeOutflow = false);
     ~Tracer() override;
 
     void InitializeFlow(std::shared_ptr<flow::Flow> flow) override;
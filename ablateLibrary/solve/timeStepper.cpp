@@ -32,6 +32,13 @@ void ablate::solve::TimeStepper::Solve(std::shared_ptr<Solvable> solvable) {
     // set the ts from options
     TSSetFromOptions(ts) >> checkError;
 
+    // the restart state replaces the initial time, step, and dt (including any set from the options)
+    if (restartState) {
+        TSSetTime(ts, restartState->time) >> checkError;
+        TSSetStepNumber(ts, restartState->steps) >> checkError;
+        TSSetTimeStep(ts, restartState->dt) >> checkError;
+    }
+
     // finish setting up the ts
     PetscReal time;
     TSGetTime(ts, &time) >> checkError;
@@ -3,6 +3,7 @@
 #include <petsc.h>
 #include <map>
 #include <memory>
+#include <optional>
 #include <vector>
 #include "monitors/monitor.hpp"
 #include "solvable.hpp"
@@ -14,6 +15,14 @@ class TimeStepper {
     std::string name;                                         /** the name for this time stepper **/
     std::vector<std::shared_ptr<monitors::Monitor>> monitors; /** the monitors **/
 
+    /** the time, step, and dt to restart from, applied after the ts is set from options **/
+    struct RestartState {
+        PetscReal time;
+        PetscInt steps;
+        PetscReal dt;
+    };
+    std::optional<RestartState> restartState;
+
    public:
     TimeStepper(std::string name, std::map<std::string, std::string> arguments);
     ~TimeStepper();
@@ -23,6 +32,14 @@ class TimeStepper {
     void Solve(std::shared_ptr<Solvable>);
 
     void AddMonitor(std::shared_ptr<monitors::Monitor>);
+
+    /**
+     * Starts the solve from the checkpointed time, step, and dt instead of the initial values
+     * @param time
+     * @param steps
+     * @param dt
+     */
+    void Restart(PetscReal time, PetscInt steps, PetscReal dt) { restartState = RestartState{.time = time, .steps = steps, .dt = dt}; }
 };
 }  // namespace ablate::solve
 
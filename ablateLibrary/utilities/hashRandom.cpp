@@ -0,0 +1,10 @@
+#include "hashRandom.hpp"
+
+PetscReal ablate::utilities::HashRandom::Uniform(PetscInt64 id, PetscInt component, PetscInt64 stream) {
+    // splitmix64 of the stream, id, and component
+    auto z = ((unsigned long long)stream * 0xD1B54A32D192ED03ULL) ^ ((unsigned long long)id * 0x9E3779B97F4A7C15ULL + (unsigned long long)component + 1ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    return (PetscReal)(z >> 11) * (1.0 / 9007199254740992.0);
+}
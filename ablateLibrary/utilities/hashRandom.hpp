@@ -0,0 +1,24 @@
+#ifndef ABLATELIBRARY_HASHRANDOM_HPP
+#define ABLATELIBRARY_HASHRANDOM_HPP
+
+#include <petsc.h>
+
+namespace ablate::utilities {
+/**
+ * Counter based random numbers.  Each value is a hash of an id and component, so the value does not depend upon the order or the rank it is generated on.
+ */
+class HashRandom {
+   private:
+    HashRandom() = delete;
+
+   public:
+    /**
+     * Returns a uniform random number in [0, 1) that depends only upon the id, component, and stream
+     * @param id the id of the object (such as the particle id)
+     * @param component the component of the random value for the object
+     * @param stream the independent stream of values (different users of the same ids should use different streams)
+     */
+    static PetscReal Uniform(PetscInt64 id, PetscInt component, PetscInt64 stream = 0);
+};
+}  // namespace ablate::utilities
+#endif  // ABLATELIBRARY_HASHRANDOM_HPP
@@ -0,0 +1,27 @@
+#ifndef ABLATELIBRARY_HDF5ERROR_HPP
+#define ABLATELIBRARY_HDF5ERROR_HPP
+#include <petscviewerhdf5.h>
+#include <stdexcept>
+#include <string>
+
+namespace ablate {
+namespace utilities {
+class Hdf5ErrorChecker {
+   public:
+    struct Hdf5Error : public std::runtime_error {
+        Hdf5Error(int64_t ierr) : std::runtime_error("HDF5 Error: " + std::to_string(ierr)) {}
+    };
+
+    // hdf5 returns a negative identifier or status on failure
+    friend void operator>>(int64_t ierr, const Hdf5ErrorChecker &errorChecker) {
+        if (ierr < 0) {
+            throw Hdf5Error(ierr);
+        }
+    }
+};
+}  // namespace utilities
+
+inline utilities::Hdf5ErrorChecker checkHdf5Error;
+}  // namespace ablate
+
+#endif  // ABLATELIBRARY_HDF5ERROR_HPP
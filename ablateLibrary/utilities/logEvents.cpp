@@ -0,0 +1,31 @@
+#include "logEvents.hpp"
+#include <algorithm>
+#include "petscError.hpp"
+
+PetscLogEvent ablate::utilities::LogEvents::Register(const std::string& name) {
+    auto existing = std::find_if(events.begin(), events.end(), [&name](const auto& entry) { return entry.name == name; });
+    if (existing != events.end()) {
+        return existing->event;
+    }
+
+    if (!classId) {
+        PetscClassIdRegister("ABLATE", &classId) >> checkError;
+    }
+
+    PetscLogEvent event;
+    PetscLogEventRegister(name.c_str(), classId, &event) >> checkError;
+    events.push_back(Event{.name = name, .event = event});
+    return event;
+}
+
+void ablate::utilities::LogEvents::Record(const std::string& name, PetscLogEvent event) {
+    auto existing = std::find_if(events.begin(), events.end(), [&name](const auto& entry) { return entry.name == name; });
+    if (existing == events.end()) {
+        events.push_back(Event{.name = name, .event = event});
+    }
+}
+
+ablate::utilities::LogEvents::Scope::Scope(PetscLogEvent event) : event(event) { PetscLogEventBegin(event, 0, 0, 0, 0) >> checkError; }
+
+// the destructor may run while unwinding, so an error ending the event is not thrown
+ablate::utilities::LogEvents::Scope::~Scope() { PetscLogEventEnd(event, 0, 0, 0, 0); }
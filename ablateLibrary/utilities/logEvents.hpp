@@ -0,0 +1,59 @@
+#ifndef ABLATELIBRARY_LOGEVENTS_HPP
+#define ABLATELIBRARY_LOGEVENTS_HPP
+#include <petsc.h>
+#include <string>
+#include <vector>
+
+namespace ablate::utilities {
+/**
+ * Registers the named PETSc log events used to profile ablate.  Each event is recorded (in registration order) so that it can be reported by the PerformanceMonitor.
+ * Events must be registered after PetscInitialize.
+ */
+class LogEvents {
+   public:
+    struct Event {
+        std::string name;
+        PetscLogEvent event;
+    };
+
+    /**
+     * Begins the event on construction and ends it when the scope is left, so that the event is balanced when an exception is thrown
+     */
+    class Scope {
+       private:
+        const PetscLogEvent event;
+
+       public:
+        explicit Scope(PetscLogEvent event);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * Registers (or returns the already registered) event with this name
+     * @param name
+     * @return
+     */
+    static PetscLogEvent Register(const std::string& name);
+
+    /**
+     * Records an event registered outside of this class (e.g. in ablateCore) so that it is reported
+     * @param name
+     * @param event
+     */
+    static void Record(const std::string& name, PetscLogEvent event);
+
+    /**
+     * Returns every registered or recorded event
+     * @return
+     */
+    static const std::vector<Event>& GetEvents() { return events; }
+
+   private:
+    inline static PetscClassId classId = 0;
+    inline static std::vector<Event> events;
+};
+}  // namespace ablate::utilities
+
+#endif  // ABLATELIBRARY_LOGEVENTS_HPP
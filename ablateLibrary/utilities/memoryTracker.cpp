@@ -0,0 +1,67 @@
+#include "memoryTracker.hpp"
+#include <algorithm>
+#include "petscError.hpp"
+
+void ablate::utilities::MemoryTracker::Register(const std::string& subsystem, const void* owner, Reporter reporter) {
+    entries.push_back(Entry{.subsystem = subsystem, .owner = owner, .reporter = reporter});
+}
+
+void ablate::utilities::MemoryTracker::Unregister(const void* owner) {
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [owner](const auto& entry) { return entry.owner == owner; }), entries.end());
+}
+
+std::vector<ablate::utilities::MemoryTracker::Usage> ablate::utilities::MemoryTracker::GetUsage() {
+    std::vector<Usage> usage{{Mesh, 0.0}, {Vectors, 0.0}, {Gradients, 0.0}, {ResidualWork, 0.0}, {Chemistry, 0.0}, {Particles, 0.0}};
+    for (const auto& entry : entries) {
+        auto existing = std::find_if(usage.begin(), usage.end(), [&entry](const auto& subsystemUsage) { return subsystemUsage.subsystem == entry.subsystem; });
+        if (existing == usage.end()) {
+            usage.push_back(Usage{.subsystem = entry.subsystem, .bytes = 0.0});
+            existing = usage.end() - 1;
+        }
+        existing->bytes += entry.reporter();
+    }
+    return usage;
+}
+
+PetscLogDouble ablate::utilities::MemoryTracker::GetBytes(Vec vec) {
+    if (!vec) {
+        return 0.0;
+    }
+    PetscInt size;
+    VecGetLocalSize(vec, &size) >> checkError;
+    return (PetscLogDouble)size * sizeof(PetscScalar);
+}
+
+PetscLogDouble ablate::utilities::MemoryTracker::GetBytes(DM dm, bool includeTopology) {
+    if (!dm) {
+        return 0.0;
+    }
+    PetscInt pStart, pEnd, numberFields;
+    DMPlexGetChart(dm, &pStart, &pEnd) >> checkError;
+    DMGetNumFields(dm, &numberFields) >> checkError;
+    const PetscLogDouble numberPoints = pEnd - pStart;
+
+    // the local and global sections hold a dof and offset for each point and field (and the total)
+    PetscLogDouble bytes = 2.0 * 2.0 * (numberFields + 1) * numberPoints * sizeof(PetscInt);
+
+    if (includeTopology) {
+        Vec coordinates;
+        DMGetCoordinatesLocal(dm, &coordinates) >> checkError;
+        bytes += GetBytes(coordinates);
+
+        // the cones, cone orientations, and supports each hold one entry per cone point, and the cone and support sections hold a dof and offset per point
+        PetscSection coneSection;
+        PetscInt coneStorage;
+        DMPlexGetConeSection(dm, &coneSection) >> checkError;
+        PetscSectionGetStorageSize(coneSection, &coneStorage) >> checkError;
+        bytes += (3.0 * coneStorage + 2.0 * 2.0 * numberPoints) * sizeof(PetscInt);
+
+        // each leaf of the point sf holds a local point and a remote (rank, point)
+        PetscSF pointSf;
+        PetscInt numberLeaves;
+        DMGetPointSF(dm, &pointSf) >> checkError;
+        PetscSFGetGraph(pointSf, NULL, &numberLeaves, NULL, NULL) >> checkError;
+        bytes += PetscMax(numberLeaves, 0) * (sizeof(PetscInt) + sizeof(PetscSFNode));
+    }
+    return bytes;
+}
@@ -0,0 +1,80 @@
+#ifndef ABLATELIBRARY_MEMORYTRACKER_HPP
+#define ABLATELIBRARY_MEMORYTRACKER_HPP
+#include <petsc.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ablate::utilities {
+/**
+ * Records the memory held by each subsystem so that it can be reported by the MemoryMonitor.  Each object holding significant memory registers a function that
+ * returns its current (estimated) local bytes under a subsystem name and unregisters the function before it is destroyed.
+ */
+class MemoryTracker {
+   public:
+    using Reporter = std::function<PetscLogDouble()>;
+
+    struct Usage {
+        std::string subsystem;
+        PetscLogDouble bytes;
+    };
+
+    // the subsystems reported by ablate, in the order they are reported
+    inline static const char Mesh[] = "mesh/DM";
+    inline static const char Vectors[] = "solution/aux vectors";
+    inline static const char Gradients[] = "gradients";
+    inline static const char ResidualWork[] = "residual work arrays";
+    inline static const char Chemistry[] = "chemistry";
+    inline static const char Particles[] = "particles";
+
+    /**
+     * Adds a reporter for the subsystem
+     * @param subsystem
+     * @param owner the object that owns the memory, used to unregister
+     * @param reporter returns the local bytes
+     */
+    static void Register(const std::string& subsystem, const void* owner, Reporter reporter);
+
+    /**
+     * Removes every reporter for the owner
+     * @param owner
+     */
+    static void Unregister(const void* owner);
+
+    /**
+     * Returns the local bytes of each subsystem (the ablate subsystems are always listed first, in order)
+     * @return
+     */
+    static std::vector<Usage> GetUsage();
+
+    /**
+     * Returns the local bytes held by the vector (zero for a null vector)
+     */
+    static PetscLogDouble GetBytes(Vec vec);
+
+    /**
+     * Estimates the local bytes held by a DMPlex: the local and global sections and (when includeTopology) the coordinates, cones, supports, and point sf
+     * @param dm
+     * @param includeTopology false for a clone that shares the topology and coordinates of another dm
+     */
+    static PetscLogDouble GetBytes(DM dm, bool includeTopology = true);
+
+    /**
+     * Returns the bytes allocated by the std::vector
+     */
+    template <typename T>
+    static PetscLogDouble GetBytes(const std::vector<T>& vector) {
+        return (PetscLogDouble)(vector.capacity() * sizeof(T));
+    }
+
+   private:
+    struct Entry {
+        std::string subsystem;
+        const void* owner;
+        Reporter reporter;
+    };
+    inline static std::vector<Entry> entries;
+};
+}  // namespace ablate::utilities
+
+#endif  // ABLATELIBRARY_MEMORYTRACKER_HPP
@@ -0,0 +1,11 @@
+#include "workingDirectory.hpp"
+
+ablate::utilities::WorkingDirectory::WorkingDirectory(const std::filesystem::path& directory) : lock(mutex), previousDirectory(std::filesystem::current_path()) {
+    std::filesystem::current_path(directory);
+}
+
+ablate::utilities::WorkingDirectory::~WorkingDirectory() {
+    // the directory is restored without throwing from the destructor
+    std::error_code errorCode;
+    std::filesystem::current_path(previousDirectory, errorCode);
+}
@@ -0,0 +1,33 @@
+#ifndef ABLATELIBRARY_WORKINGDIRECTORY_HPP
+#define ABLATELIBRARY_WORKINGDIRECTORY_HPP
+#include <filesystem>
+#include <mutex>
+#include <shared_mutex>
+
+namespace ablate::utilities {
+/**
+ * Changes the working directory of the process for the lifetime of the object and restores it when the scope is left, including when an exception is thrown.
+ * The working directory is shared by every thread, so the change waits for (and then blocks) any background thread holding a Use lock.
+ */
+class WorkingDirectory {
+   private:
+    inline static std::shared_mutex mutex;
+
+    std::unique_lock<std::shared_mutex> lock;
+    const std::filesystem::path previousDirectory;
+
+   public:
+    explicit WorkingDirectory(const std::filesystem::path& directory);
+    ~WorkingDirectory();
+    WorkingDirectory(const WorkingDirectory&) = delete;
+    WorkingDirectory& operator=(const WorkingDirectory&) = delete;
+
+    /**
+     * Held by background threads while they open files so that the working directory is not changed underneath them
+     * @return
+     */
+    static std::shared_lock<std::shared_mutex> Use() { return std::shared_lock<std::shared_mutex>(mutex); }
+};
+}  // namespace ablate::utilities
+
+#endif  // ABLATELIBRARY_WORKINGDIRECTORY_HPP
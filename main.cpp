@@ -5,11 +5,18 @@
 #include "environment/runEnvironment.hpp"
 #include "parser/listing.h"
 #include "parser/yamlParser.hpp"
+#include "utilities/mpiError.hpp"
 #include "utilities/petscError.hpp"
 
 using namespace ablate;
 
 int main(int argc, char **args) {
+    // initialize mpi with thread support for asynchronous output when petsc is thread safe
+#if defined(PETSC_HAVE_THREADSAFETY)
+    int threadLevel;
+    MPI_Init_thread(&argc, &args, MPI_THREAD_MULTIPLE, &threadLevel) >> checkMpiError;
+#endif
+
     // initialize petsc and mpi
     PetscInitialize(&argc, &args, NULL, NULL) >> checkError;
 
@@ -65,4 +72,7 @@ int main(int argc, char **args) {
         }
     }
     PetscFinalize() >> checkError;
+#if defined(PETSC_HAVE_THREADSAFETY)
+    MPI_Finalize() >> checkMpiError;
+#endif
 }
\ No newline at end of file
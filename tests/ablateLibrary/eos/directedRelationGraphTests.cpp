@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cmath>
+#include "eos/kinetics/chemkinParser.hpp"
+#include "eos/kinetics/directedRelationGraph.hpp"
+#include "gtest/gtest.h"
+
+struct DirectedRelationGraphParameters {
+    std::filesystem::path mechFile;
+    std::filesystem::path thermoFile;
+    std::map<std::string, double> yiIn;
+    double temperature;
+    double pressure;
+    std::vector<std::string> targets;
+};
+
+class DirectedRelationGraphTestFixture : public ::testing::TestWithParam<DirectedRelationGraphParameters> {
+   protected:
+    std::shared_ptr<ablate::eos::kinetics::Mechanism> mechanism;
+    std::vector<double> state;
+    std::vector<int> targets;
+
+    void SetUp() override {
+        const auto& params = GetParam();
+        mechanism = ablate::eos::kinetics::ChemkinParser::Parse(params.mechFile, params.thermoFile);
+
+        // fill the state (T, Yi)
+        state.assign(mechanism->NumberSpecies() + 1, 0.0);
+        state[0] = params.temperature;
+        for (const auto& value : params.yiIn) {
+            state[SpeciesIndex(value.first) + 1] = value.second;
+        }
+        for (const auto& target : params.targets) {
+            targets.push_back(SpeciesIndex(target));
+        }
+    }
+
+    int SpeciesIndex(const std::string& name) const {
+        auto it = std::find(mechanism->species.begin(), mechanism->species.end(), name);
+        return (int)std::distance(mechanism->species.begin(), it);
+    }
+};
+
+TEST_P(DirectedRelationGraphTestFixture, ShouldKeepTargetsAndOnlyReactionsWithActiveSpecies) {
+    // arrange
+    ablate::eos::kinetics::Kinetics kinetics(mechanism);
+    ablate::eos::kinetics::DirectedRelationGraph relationGraph(mechanism);
+    std::vector<unsigned char> activeSpecies;
+    std::vector<unsigned char> activeReactions;
+
+    // act
+    auto numberActive = relationGraph.Reduce(kinetics, GetParam().pressure, &state[0], targets, 0.1, activeSpecies, activeReactions);
+
+    // assert
+    ASSERT_EQ(numberActive, (std::size_t)std::count(activeSpecies.begin(), activeSpecies.end(), 1));
+    ASSERT_LT(numberActive, mechanism->NumberSpecies());
+    for (const auto& target : targets) {
+        ASSERT_TRUE(activeSpecies[target]) << "for target " << mechanism->species[target];
+    }
+    for (std::size_t r = 0; r < mechanism->NumberReactions(); r++) {
+        bool allActive = true;
+        for (std::size_t i = mechanism->reactantOffsets[r]; i < mechanism->reactantOffsets[r + 1]; i++) {
+            allActive = allActive && activeSpecies[mechanism->reactantSpecies[i]];
+        }
+        for (std::size_t i = mechanism->productOffsets[r]; i < mechanism->productOffsets[r + 1]; i++) {
+            allActive = allActive && activeSpecies[mechanism->productSpecies[i]];
+        }
+        ASSERT_EQ((bool)activeReactions[r], allActive) << "for reaction " << mechanism->equations[r];
+    }
+}
+
+TEST_P(DirectedRelationGraphTestFixture, ShouldNestReducedSpeciesAsThresholdIncreases) {
+    // arrange
+    ablate::eos::kinetics::Kinetics kinetics(mechanism);
+    ablate::eos::kinetics::DirectedRelationGraph relationGraph(mechanism);
+    std::vector<unsigned char> previousSpecies(mechanism->NumberSpecies(), 1);
+
+    for (double threshold : {0.0, 0.001, 0.01, 0.1, 0.5}) {
+        // act
+        std::vector<unsigned char> activeSpecies;
+        std::vector<unsigned char> activeReactions;
+        relationGraph.Reduce(kinetics, GetParam().pressure, &state[0], targets, threshold, activeSpecies, activeReactions);
+
+        // assert
+        for (std::size_t s = 0; s < mechanism->NumberSpecies(); s++) {
+            ASSERT_TRUE(!activeSpecies[s] || previousSpecies[s]) << "species " << mechanism->species[s] << " added at threshold " << threshold;
+        }
+        previousSpecies = activeSpecies;
+    }
+}
+
+TEST_P(DirectedRelationGraphTestFixture, ShouldReproduceFullSourceWithZeroThreshold) {
+    // arrange
+    ablate::eos::kinetics::Kinetics kinetics(mechanism);
+    ablate::eos::kinetics::DirectedRelationGraph relationGraph(mechanism);
+    std::vector<double> expectedSource(state.size());
+    kinetics.ComputeSource(1, &GetParam().pressure, &state[0], &expectedSource[0]);
+
+    // act
+    std::vector<unsigned char> activeSpecies;
+    std::vector<unsigned char> activeReactions;
+    relationGraph.Reduce(kinetics, GetParam().pressure, &state[0], targets, 0.0, activeSpecies, activeReactions);
+    kinetics.SetActiveReactions(activeReactions);
+    std::vector<double> source(state.size());
+    kinetics.ComputeSource(1, &GetParam().pressure, &state[0], &source[0]);
+
+    // assert
+    ASSERT_NEAR(source[0], expectedSource[0], 1E-8 * std::abs(expectedSource[0])) << "for the temperature source";
+    for (const auto& target : targets) {
+        ASSERT_NEAR(source[target + 1], expectedSource[target + 1], 1E-8 * std::abs(expectedSource[target + 1])) << "for target " << mechanism->species[target];
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(KineticsTests, DirectedRelationGraphTestFixture,
+                         testing::Values((DirectedRelationGraphParameters){.mechFile = "inputs/eos/grimech30.dat",
+                                                                           .thermoFile = "inputs/eos/thermo30.dat",
+                                                                           .yiIn = {{"CH4", .04}, {"O2", .2}, {"N2", .7}, {"H", .001}, {"OH", .004}, {"CO", .03}, {"H2O", .025}},
+                                                                           .temperature = 1500.0,
+                                                                           .pressure = 101325.0,
+                                                                           .targets = {"CH4", "O2"}},
+                                         (DirectedRelationGraphParameters){.mechFile = "inputs/eos/grimech30.dat",
+                                                                           .thermoFile = "inputs/eos/thermo30.dat",
+                                                                           .yiIn = {{"H2", .028}, {"O2", .226}, {"N2", .74}, {"HO2", .001}, {"H2O2", .005}},
+                                                                           .temperature = 1000.0,
+                                                                           .pressure = 506625.0,
+                                                                           .targets = {"H2", "O2"}}),
+                         [](const testing::TestParamInfo<DirectedRelationGraphParameters>& info) { return std::to_string(info.index); });
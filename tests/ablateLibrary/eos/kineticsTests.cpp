@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <numeric>
+#include "PetscTestFixture.hpp"
+#include "eos/kinetics/chemkinParser.hpp"
+#include "eos/kinetics/kinetics.hpp"
+#include "eos/tChem.hpp"
+#include "gtest/gtest.h"
+
+#if defined(PETSC_HAVE_TCHEM)
+#if defined(MAX)
+#undef MAX
+#endif
+#if defined(MIN)
+#undef MIN
+#endif
+#include <TC_interface.h>
+#else
+#error TChem is required for these tests.  Reconfigure PETSc using --download-tchem.
+#endif
+
+/*
+ * Helper function to fill the state (T, Yi)
+ */
+static std::vector<double> GetState(const std::vector<std::string>& species, const std::map<std::string, double>& yiIn, double temperature) {
+    std::vector<double> state(species.size() + 1, 0.0);
+    state[0] = temperature;
+    for (const auto& value : yiIn) {
+        auto it = std::find(species.begin(), species.end(), value.first);
+        if (it != species.end()) {
+            state[std::distance(species.begin(), it) + 1] = value.second;
+        }
+    }
+    return state;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Mechanism parser tests
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct ChemkinParserParameters {
+    std::filesystem::path mechFile;
+    std::filesystem::path thermoFile;
+    std::size_t expectedNumberReactions;
+};
+
+class ChemkinParserTestFixture : public testingResources::PetscTestFixture, public ::testing::WithParamInterface<ChemkinParserParameters> {};
+
+TEST_P(ChemkinParserTestFixture, ShouldParseSameSpeciesAsTChem) {
+    // arrange
+    auto eos = std::make_shared<ablate::eos::TChem>(GetParam().mechFile, GetParam().thermoFile);
+
+    // act
+    auto mechanism = ablate::eos::kinetics::ChemkinParser::Parse(GetParam().mechFile, GetParam().thermoFile);
+
+    // assert
+    ASSERT_EQ(mechanism->species, eos->GetSpecies());
+    ASSERT_EQ(mechanism->NumberReactions(), GetParam().expectedNumberReactions);
+
+    // the molecular weight of each species should match
+    std::vector<double> yi(mechanism->NumberSpecies());
+    for (std::size_t s = 0; s < mechanism->NumberSpecies(); s++) {
+        std::fill(yi.begin(), yi.end(), 0.0);
+        yi[s] = 1.0;
+        double mw;
+        ASSERT_EQ(TC_getMs2Wmix(&yi[0], mechanism->NumberSpecies(), &mw), 0);
+        ASSERT_NEAR(mechanism->molecularWeight[s], mw, 1E-8 * mw) << "for species " << mechanism->species[s];
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(KineticsTests, ChemkinParserTestFixture,
+                         testing::Values((ChemkinParserParameters){.mechFile = "inputs/eos/grimech30.dat", .thermoFile = "inputs/eos/thermo30.dat", .expectedNumberReactions = 325}),
+                         [](const testing::TestParamInfo<ChemkinParserParameters>& info) { return info.param.mechFile.stem().string() + "_" + info.param.thermoFile.stem().string(); });
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Kinetics source tests
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct KineticsSourceParameters {
+    std::filesystem::path mechFile;
+    std::filesystem::path thermoFile;
+    std::map<std::string, double> yiIn;
+    double temperature;
+    double pressure;
+};
+
+class KineticsSourceTestFixture : public testingResources::PetscTestFixture, public ::testing::WithParamInterface<KineticsSourceParameters> {};
+
+TEST_P(KineticsSourceTestFixture, ShouldComputeSourceMatchingTChem) {
+    // arrange
+    const auto& params = GetParam();
+    auto eos = std::make_shared<ablate::eos::TChem>(params.mechFile, params.thermoFile);
+    ablate::eos::kinetics::Kinetics kinetics(ablate::eos::kinetics::ChemkinParser::Parse(params.mechFile, params.thermoFile));
+    auto state = GetState(eos->GetSpecies(), params.yiIn, params.temperature);
+
+    // compute the expected source with TChem
+    std::vector<double> expectedSource(state.size());
+    std::vector<double> tchemState = state;
+    TC_setThermoPres(params.pressure);
+    ASSERT_EQ(TC_getSrc(&tchemState[0], tchemState.size(), &expectedSource[0]), 0);
+
+    // act
+    std::vector<double> source(state.size());
+    kinetics.ComputeSource(1, &params.pressure, &state[0], &source[0]);
+
+    // assert
+    const double scale = std::accumulate(expectedSource.begin() + 1, expectedSource.end(), 0.0, [](double m, double v) { return PetscMax(m, PetscAbs(v)); });
+    ASSERT_NEAR(source[0], expectedSource[0], 1E-4 * PetscAbs(expectedSource[0]) + 1E-8) << "for the temperature source";
+    for (std::size_t s = 1; s < state.size(); s++) {
+        ASSERT_NEAR(source[s], expectedSource[s], 1E-4 * scale + 1E-12) << "for species " << eos->GetSpecies()[s - 1];
+    }
+}
+
+TEST_P(KineticsSourceTestFixture, ShouldComputeJacobianMatchingFiniteDifference) {
+    // arrange
+    const auto& params = GetParam();
+    ablate::eos::kinetics::Kinetics kinetics(ablate::eos::kinetics::ChemkinParser::Parse(params.mechFile, params.thermoFile));
+    auto state = GetState(kinetics.GetMechanism().species, params.yiIn, params.temperature);
+    const std::size_t n = state.size();
+
+    // act
+    std::vector<double> source(n);
+    std::vector<double> jacobian(n * n);
+    kinetics.ComputeSourceJacobian(params.pressure, &state[0], &source[0], &jacobian[0]);
+
+    // assert using central differences of the source
+    std::vector<double> sourcePlus(n), sourceMinus(n);
+    for (std::size_t j = 0; j < n; j++) {
+        const double delta = j == 0 ? 1E-4 * state[0] : 1E-7;
+        auto statePlus = state;
+        auto stateMinus = state;
+        statePlus[j] += delta;
+        stateMinus[j] -= delta;
+        kinetics.ComputeSource(1, &params.pressure, &statePlus[0], &sourcePlus[0]);
+        kinetics.ComputeSource(1, &params.pressure, &stateMinus[0], &sourceMinus[0]);
+
+        double columnScale = 0.0;
+        for (std::size_t i = 0; i < n; i++) {
+            columnScale = PetscMax(columnScale, PetscAbs(jacobian[i + j * n]));
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            const double finiteDifference = (sourcePlus[i] - sourceMinus[i]) / (2.0 * delta);
+            ASSERT_NEAR(jacobian[i + j * n], finiteDifference, 1E-3 * columnScale + 1E-8) << "for d source_" << i << "/d state_" << j;
+        }
+    }
+}
+
+TEST_P(KineticsSourceTestFixture, ShouldComputeJacobianMatchingTChem) {
+    // arrange
+    const auto& params = GetParam();
+    auto eos = std::make_shared<ablate::eos::TChem>(params.mechFile, params.thermoFile);
+    ablate::eos::kinetics::Kinetics kinetics(ablate::eos::kinetics::ChemkinParser::Parse(params.mechFile, params.thermoFile));
+    auto state = GetState(eos->GetSpecies(), params.yiIn, params.temperature);
+    const std::size_t n = state.size();
+
+    // compute the expected analytic jacobian with TChem
+    std::vector<double> expectedJacobian(n * n);
+    std::vector<double> tchemState = state;
+    TC_setThermoPres(params.pressure);
+    ASSERT_EQ(TC_getJacTYN(&tchemState[0], (int)n - 1, &expectedJacobian[0], 1), 0);
+
+    // act
+    std::vector<double> source(n);
+    std::vector<double> jacobian(n * n);
+    kinetics.ComputeSourceJacobian(params.pressure, &state[0], &source[0], &jacobian[0]);
+
+    // assert
+    for (std::size_t j = 0; j < n; j++) {
+        double columnScale = 0.0;
+        for (std::size_t i = 0; i < n; i++) {
+            columnScale = PetscMax(columnScale, PetscAbs(expectedJacobian[i + j * n]));
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            ASSERT_NEAR(jacobian[i + j * n], expectedJacobian[i + j * n], 1E-3 * columnScale + 1E-8) << "for d source_" << i << "/d state_" << j;
+        }
+    }
+}
+
+TEST_P(KineticsSourceTestFixture, ShouldComputeBatchedSourceMatchingTChem) {
+    // arrange
+    const auto& params = GetParam();
+    auto eos = std::make_shared<ablate::eos::TChem>(params.mechFile, params.thermoFile);
+    ablate::eos::kinetics::Kinetics kinetics(ablate::eos::kinetics::ChemkinParser::Parse(params.mechFile, params.thermoFile));
+    const auto baseState = GetState(eos->GetSpecies(), params.yiIn, params.temperature);
+    const std::size_t n = baseState.size();
+
+    // span more than one batch with a different temperature at each point
+    const std::size_t numberPoints = 2 * ablate::eos::kinetics::Kinetics::BATCH_SIZE + 3;
+    std::vector<double> states(numberPoints * n);
+    std::vector<double> pressures(numberPoints, params.pressure);
+    for (std::size_t p = 0; p < numberPoints; p++) {
+        std::copy(baseState.begin(), baseState.end(), states.begin() + p * n);
+        states[p * n] = params.temperature * (0.8 + 0.4 * p / (double)numberPoints);
+    }
+
+    // act
+    std::vector<double> sources(numberPoints * n);
+    kinetics.ComputeSource(numberPoints, &pressures[0], &states[0], &sources[0]);
+
+    // assert
+    TC_setThermoPres(params.pressure);
+    std::vector<double> expectedSource(n);
+    for (std::size_t p = 0; p < numberPoints; p++) {
+        std::vector<double> tchemState(states.begin() + p * n, states.begin() + (p + 1) * n);
+        ASSERT_EQ(TC_getSrc(&tchemState[0], (int)n, &expectedSource[0]), 0);
+
+        const double scale = std::accumulate(expectedSource.begin() + 1, expectedSource.end(), 0.0, [](double m, double v) { return PetscMax(m, PetscAbs(v)); });
+        ASSERT_NEAR(sources[p * n], expectedSource[0], 1E-4 * PetscAbs(expectedSource[0]) + 1E-8) << "for the temperature source at point " << p;
+        for (std::size_t s = 1; s < n; s++) {
+            ASSERT_NEAR(sources[p * n + s], expectedSource[s], 1E-4 * scale + 1E-12) << "for species " << eos->GetSpecies()[s - 1] << " at point " << p;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(KineticsTests, KineticsSourceTestFixture,
+                         testing::Values((KineticsSourceParameters){.mechFile = "inputs/eos/grimech30.dat",
+                                                                    .thermoFile = "inputs/eos/thermo30.dat",
+                                                                    .yiIn = {{"CH4", .055}, {"O2", .22}, {"N2", .725}},
+                                                                    .temperature = 1500.0,
+                                                                    .pressure = 101325.0},
+                                         (KineticsSourceParameters){.mechFile = "inputs/eos/grimech30.dat",
+                                                                    .thermoFile = "inputs/eos/thermo30.dat",
+                                                                    .yiIn = {{"CH4", .04}, {"O2", .2}, {"N2", .7}, {"H", .001}, {"OH", .004}, {"CO", .03}, {"H2O", .025}},
+                                                                    .temperature = 2000.0,
+                                                                    .pressure = 506625.0},
+                                         (KineticsSourceParameters){.mechFile = "inputs/eos/grimech30.dat",
+                                                                    .thermoFile = "inputs/eos/thermo30.dat",
+                                                                    .yiIn = {{"H2", .028}, {"O2", .226}, {"N2", .74}, {"HO2", .001}, {"H2O2", .005}},
+                                                                    .temperature = 900.0,
+                                                                    .pressure = 2026500.0}),
+                         [](const testing::TestParamInfo<KineticsSourceParameters>& info) { return std::to_string(info.index); });
@@ -0,0 +1,119 @@
+#include <sstream>
+#include "eos/kinetics/chemkinParser.hpp"
+#include "eos/kinetics/mechanismCache.hpp"
+#include "gtest/gtest.h"
+
+struct MechanismCacheParameters {
+    std::filesystem::path mechFile;
+    std::filesystem::path thermoFile;
+};
+
+class MechanismCacheTestFixture : public ::testing::TestWithParam<MechanismCacheParameters> {};
+
+TEST_P(MechanismCacheTestFixture, ShouldRoundTripMechanism) {
+    // arrange
+    auto mechanism = ablate::eos::kinetics::ChemkinParser::Parse(GetParam().mechFile, GetParam().thermoFile);
+
+    // act
+    auto buffer = ablate::eos::kinetics::MechanismCache::Serialize(*mechanism);
+    auto result = ablate::eos::kinetics::MechanismCache::Deserialize(buffer);
+
+    // assert
+    ASSERT_EQ(result->elements, mechanism->elements);
+    ASSERT_EQ(result->species, mechanism->species);
+    ASSERT_EQ(result->equations, mechanism->equations);
+    ASSERT_EQ(result->molecularWeight, mechanism->molecularWeight);
+    ASSERT_EQ(result->thermoLowCoefficients, mechanism->thermoLowCoefficients);
+    ASSERT_EQ(result->thermoHighCoefficients, mechanism->thermoHighCoefficients);
+    ASSERT_EQ(result->preExponential, mechanism->preExponential);
+    ASSERT_EQ(result->activationTemperature, mechanism->activationTemperature);
+    ASSERT_EQ(result->reactantOffsets, mechanism->reactantOffsets);
+    ASSERT_EQ(result->productSpecies, mechanism->productSpecies);
+    ASSERT_EQ(result->efficiencies, mechanism->efficiencies);
+    ASSERT_EQ(result->troeT3, mechanism->troeT3);
+    ASSERT_EQ(result->troeHasT2, mechanism->troeHasT2);
+    ASSERT_EQ(ablate::eos::kinetics::MechanismCache::Serialize(*result), buffer);
+}
+
+TEST_P(MechanismCacheTestFixture, ShouldOnlyReadCacheWithMatchingHashes) {
+    // arrange
+    auto buffer = ablate::eos::kinetics::MechanismCache::Serialize(*ablate::eos::kinetics::ChemkinParser::Parse(GetParam().mechFile, GetParam().thermoFile));
+    auto mechHash = ablate::eos::kinetics::MechanismCache::Hash(GetParam().mechFile);
+    auto thermoHash = ablate::eos::kinetics::MechanismCache::Hash(GetParam().thermoFile);
+    std::stringstream cache;
+    ablate::eos::kinetics::MechanismCache::Write(cache, buffer, mechHash, thermoHash);
+    const auto cacheString = cache.str();
+
+    // act
+    std::vector<char> currentBuffer, staleMechBuffer, staleThermoBuffer, corruptBuffer;
+    std::istringstream currentStream(cacheString);
+    auto current = ablate::eos::kinetics::MechanismCache::Read(currentStream, mechHash, thermoHash, currentBuffer);
+    std::istringstream staleMechStream(cacheString);
+    auto staleMech = ablate::eos::kinetics::MechanismCache::Read(staleMechStream, mechHash + 1, thermoHash, staleMechBuffer);
+    std::istringstream staleThermoStream(cacheString);
+    auto staleThermo = ablate::eos::kinetics::MechanismCache::Read(staleThermoStream, mechHash, thermoHash + 1, staleThermoBuffer);
+    std::istringstream corruptStream(cacheString.substr(0, cacheString.size() / 2));
+    auto corrupt = ablate::eos::kinetics::MechanismCache::Read(corruptStream, mechHash, thermoHash, corruptBuffer);
+
+    // assert
+    ASSERT_TRUE(current);
+    ASSERT_EQ(currentBuffer, buffer);
+    ASSERT_FALSE(staleMech);
+    ASSERT_FALSE(staleThermo);
+    ASSERT_FALSE(corrupt);
+}
+
+TEST_P(MechanismCacheTestFixture, ShouldRejectCorruptCacheWithMatchingHashes) {
+    // arrange
+    auto buffer = ablate::eos::kinetics::MechanismCache::Serialize(*ablate::eos::kinetics::ChemkinParser::Parse(GetParam().mechFile, GetParam().thermoFile));
+    auto mechHash = ablate::eos::kinetics::MechanismCache::Hash(GetParam().mechFile);
+    auto thermoHash = ablate::eos::kinetics::MechanismCache::Hash(GetParam().thermoFile);
+
+    // a cache whose header claims more data than the file holds
+    std::stringstream oversizedCache;
+    std::vector<char> oversizedBuffer(buffer);
+    oversizedBuffer.resize(buffer.size() * 4, 0);
+    ablate::eos::kinetics::MechanismCache::Write(oversizedCache, oversizedBuffer, mechHash, thermoHash);
+    auto oversizedString = oversizedCache.str();
+    oversizedString.resize(oversizedString.size() - 3 * buffer.size());
+
+    // a cache with the right size whose contents are truncated (the first field is a species count larger than the data)
+    std::vector<char> truncatedBuffer(buffer.begin(), buffer.begin() + buffer.size() / 2);
+    truncatedBuffer.resize(buffer.size(), 0);
+    std::stringstream truncatedCache;
+    ablate::eos::kinetics::MechanismCache::Write(truncatedCache, truncatedBuffer, mechHash, thermoHash);
+
+    // a cache with corrupt contents
+    std::vector<char> garbageBuffer(buffer.size(), (char)0xff);
+    std::stringstream garbageCache;
+    ablate::eos::kinetics::MechanismCache::Write(garbageCache, garbageBuffer, mechHash, thermoHash);
+
+    // act
+    std::vector<char> oversizedResult, truncatedResult, garbageResult;
+    std::istringstream oversizedStream(oversizedString);
+    auto oversized = ablate::eos::kinetics::MechanismCache::Read(oversizedStream, mechHash, thermoHash, oversizedResult);
+    auto truncated = ablate::eos::kinetics::MechanismCache::Read(truncatedCache, mechHash, thermoHash, truncatedResult);
+    auto garbage = ablate::eos::kinetics::MechanismCache::Read(garbageCache, mechHash, thermoHash, garbageResult);
+
+    // assert
+    ASSERT_FALSE(oversized);
+    ASSERT_FALSE(truncated);
+    ASSERT_FALSE(garbage);
+}
+
+INSTANTIATE_TEST_SUITE_P(KineticsTests, MechanismCacheTestFixture,
+                         testing::Values((MechanismCacheParameters){.mechFile = "inputs/eos/grimech30.dat", .thermoFile = "inputs/eos/thermo30.dat"}),
+                         [](const testing::TestParamInfo<MechanismCacheParameters>& info) { return info.param.mechFile.stem().string() + "_" + info.param.thermoFile.stem().string(); });
+
+TEST(MechanismCacheTests, ShouldComputeFnv1aHash) {
+    // arrange
+    std::istringstream emptyStream("");
+    std::istringstream aStream("a");
+    std::istringstream fooBarStream("foobar");
+
+    // act
+    // assert
+    ASSERT_EQ(ablate::eos::kinetics::MechanismCache::Hash(emptyStream), 0xcbf29ce484222325ULL);
+    ASSERT_EQ(ablate::eos::kinetics::MechanismCache::Hash(aStream), 0xaf63dc4c8601ec8cULL);
+    ASSERT_EQ(ablate::eos::kinetics::MechanismCache::Hash(fooBarStream), 0x85944171f73967e8ULL);
+}
@@ -154,6 +154,31 @@ TEST_P(TChemStateTestFixture, ShouldComputeTemperature) {
     ASSERT_NEAR(temperature, params.expectedTemperature, 1E-2);
 }
 
+TEST_P(TChemStateTestFixture, ShouldReturnTheTemperatureIterations) {
+    // arrange
+    std::shared_ptr<ablate::eos::EOS> eos = std::make_shared<ablate::eos::TChem>(GetParam().mechFile, GetParam().thermoFile);
+    const auto& params = GetParam();
+    auto densityYi = GetDensityMassFraction(eos->GetSpecies(), params.yiIn, params.densityIn);
+    auto computeTemperatureIterations = eos->GetComputeTemperatureIterationsFunction();
+    ASSERT_NE(computeTemperatureIterations, nullptr);
+
+    // act
+    PetscReal temperature, repeatedTemperature;
+    PetscInt iterations, repeatedIterations;
+    PetscErrorCode ierr = computeTemperatureIterations(
+        params.massFluxIn.size(), params.densityIn, params.totalEnergyIn, &params.massFluxIn[0], &densityYi[0], &temperature, &iterations, eos->GetComputeTemperatureContext());
+    ASSERT_EQ(ierr, 0);
+    ierr = computeTemperatureIterations(
+        params.massFluxIn.size(), params.densityIn, params.totalEnergyIn, &params.massFluxIn[0], &densityYi[0], &repeatedTemperature, &repeatedIterations, eos->GetComputeTemperatureContext());
+    ASSERT_EQ(ierr, 0);
+
+    // assert
+    ASSERT_NEAR(temperature, params.expectedTemperature, 1E-2);
+    ASSERT_GT(iterations, 0) << "the temperature is not the initial guess so it should be iterated";
+    ASSERT_EQ(repeatedTemperature, temperature);
+    ASSERT_EQ(repeatedIterations, iterations) << "the iterations should only depend upon the state";
+}
+
 INSTANTIATE_TEST_SUITE_P(EOSTests, TChemStateTestFixture,
                          testing::Values((TChemStateParameters){.mechFile = "inputs/eos/grimech30.dat",
                                                                 .thermoFile = "inputs/eos/thermo30.dat",
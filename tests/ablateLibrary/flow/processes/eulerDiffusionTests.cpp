@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "PetscTestFixture.hpp"
+#include "eos/tChem.hpp"
+#include "flow/fvFlow.hpp"
+#include "flow/processes/eulerAdvection.hpp"
+#include "flow/processes/eulerDiffusion.hpp"
+#include "gtest/gtest.h"
+
+class EulerDiffusionCellCostTestFixture : public testingResources::PetscTestFixture {};
+
+TEST_F(EulerDiffusionCellCostTestFixture, ShouldAccumulateTheEosIterationsOverEachUpdate) {
+    // arrange
+    auto eos = std::make_shared<ablate::eos::TChem>("inputs/eos/grimech30.dat", "inputs/eos/thermo30.dat");
+    ASSERT_NE(eos->GetComputeTemperatureIterationsFunction(), nullptr);
+
+    ablate::flow::processes::EulerDiffusion::_EulerDiffusionData data{};
+    data.numberSpecies = eos->GetSpecies().size();
+    data.computeTemperatureFunction = eos->GetComputeTemperatureFunction();
+    data.computeTemperatureContext = eos->GetComputeTemperatureContext();
+    data.computeTemperatureIterationsFunction = eos->GetComputeTemperatureIterationsFunction();
+
+    // a pure N2 cell with a three dimensional velocity
+    const PetscInt dim = 3;
+    const PetscReal density = 3.3;
+    std::vector<PetscReal> conservedValues(ablate::flow::processes::EulerAdvection::RHOU + dim + data.numberSpecies, 0.0);
+    conservedValues[ablate::flow::processes::EulerAdvection::RHO] = density;
+    conservedValues[ablate::flow::processes::EulerAdvection::RHOE] = density * 1000.0;
+    conservedValues[ablate::flow::processes::EulerAdvection::RHOV] = density * 2.0;
+    conservedValues[ablate::flow::processes::EulerAdvection::RHOW] = density * 4.0;
+    const auto& species = eos->GetSpecies();
+    conservedValues[ablate::flow::processes::EulerAdvection::RHOU + dim + std::distance(species.begin(), std::find(species.begin(), species.end(), "N2"))] = density;
+
+    // the iterations used by a single temperature computation of the cell
+    const PetscReal* massFlux = &conservedValues[ablate::flow::processes::EulerAdvection::RHOU];
+    PetscReal temperature;
+    PetscInt iterations;
+    data.computeTemperatureIterationsFunction(dim, density, 1000.0, massFlux, massFlux + dim, &temperature, &iterations, data.computeTemperatureContext) >> errorChecker;
+    ASSERT_GT(iterations, 0);
+
+    // the cost of the other components is kept
+    PetscScalar cellCost[3] = {0.5, 2.0, 0.0};
+
+    // act
+    // each rhs evaluation of the step updates the aux fields
+    const int numberUpdates = 4;
+    for (int u = 0; u < numberUpdates; ++u) {
+        ablate::flow::processes::EulerDiffusion::UpdateAuxCellCostField(0.0, dim, nullptr, conservedValues.data(), cellCost, &data) >> errorChecker;
+    }
+
+    // assert
+    ASSERT_EQ(cellCost[ablate::flow::FVFlow::EOS_COST], numberUpdates * iterations);
+    ASSERT_EQ(cellCost[ablate::flow::FVFlow::CHEMISTRY_COST], 0.5);
+    ASSERT_EQ(cellCost[ablate::flow::FVFlow::PARTICLE_COST], 2.0);
+}
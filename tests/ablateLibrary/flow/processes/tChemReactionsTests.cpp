@@ -0,0 +1,293 @@
+#include <petsc.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "flow/processes/eulerAdvection.hpp"
+#include "flow/processes/tChemReactions.hpp"
+#include "flow/reactingCompressibleFlow.hpp"
+#include "gtest/gtest.h"
+#include "mesh/boxMesh.hpp"
+#include "parameters/mapParameters.hpp"
+
+#if defined(PETSC_HAVE_TCHEM)
+#if defined(MAX)
+#undef MAX
+#endif
+#if defined(MIN)
+#undef MIN
+#endif
+#include <TC_interface.h>
+#include <TC_params.h>
+#else
+#error TChem is required for these tests.  Reconfigure PETSc using --download-tchem.
+#endif
+
+using namespace ablate::flow::processes;
+
+struct ChemistryTransferTestParameters {
+    std::string testName;
+    std::vector<PetscReal> rankLoad;
+    PetscReal tolerance;
+    bool expectTransfers;
+};
+
+class ChemistryTransferTestFixture : public ::testing::TestWithParam<ChemistryTransferTestParameters> {};
+
+TEST_P(ChemistryTransferTestFixture, ShouldPlanBalancedTransfers) {
+    // arrange
+    const auto& params = GetParam();
+    const PetscReal averageLoad = std::accumulate(params.rankLoad.begin(), params.rankLoad.end(), 0.0) / params.rankLoad.size();
+
+    // act
+    auto transfers = TChemReactions::PlanChemistryTransfers(params.rankLoad, params.tolerance);
+
+    // assert
+    ASSERT_EQ(!transfers.empty(), params.expectTransfers);
+    if (params.expectTransfers) {
+        std::vector<PetscReal> balancedLoad = params.rankLoad;
+        for (const auto& transfer : transfers) {
+            ASSERT_GT(transfer.cost, 0.0);
+            ASSERT_NE(transfer.from, transfer.to);
+            balancedLoad[transfer.from] -= transfer.cost;
+            balancedLoad[transfer.to] += transfer.cost;
+        }
+        for (const auto& load : balancedLoad) {
+            ASSERT_NEAR(load, averageLoad, 1E-10 * averageLoad);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(TChemReactionsTests, ChemistryTransferTestFixture,
+                         testing::Values((ChemistryTransferTestParameters){.testName = "balanced", .rankLoad = {1.0, 1.0, 1.0, 1.0}, .tolerance = 0.1, .expectTransfers = false},
+                                         (ChemistryTransferTestParameters){.testName = "within_tolerance", .rankLoad = {1.05, 0.95, 1.0, 1.0}, .tolerance = 0.1, .expectTransfers = false},
+                                         (ChemistryTransferTestParameters){.testName = "single_hot_rank", .rankLoad = {5.0, 1.0, 1.0, 1.0}, .tolerance = 0.1, .expectTransfers = true},
+                                         (ChemistryTransferTestParameters){.testName = "multiple_hot_ranks", .rankLoad = {0.5, 4.0, 0.25, 3.0, 1.0, 0.0}, .tolerance = 0.1, .expectTransfers = true},
+                                         (ChemistryTransferTestParameters){.testName = "no_load", .rankLoad = {0.0, 0.0}, .tolerance = 0.1, .expectTransfers = false}),
+                         [](const testing::TestParamInfo<ChemistryTransferTestParameters>& info) { return info.param.testName; });
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Chemistry load balancing tests
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct LoadBalancedChemistryParameters {
+    testingResources::MpiTestParameter mpiTestParameter;
+    // the number of chemistry states on each rank, the first rank is the most loaded
+    std::vector<int> statesPerRank;
+};
+
+class LoadBalancedChemistryTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<LoadBalancedChemistryParameters> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam().mpiTestParameter); }
+};
+
+TEST_P(LoadBalancedChemistryTestFixture, ShouldComputeSameStatesWithLoadBalancing) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+            PetscMPIInt rank;
+            MPI_Comm_rank(PETSC_COMM_WORLD, &rank) >> testErrorChecker;
+
+            // arrange
+            auto eos = std::make_shared<ablate::eos::TChem>("inputs/eos/grimech30.dat", "inputs/eos/thermo30.dat");
+            auto balancedChemistry =
+                std::make_shared<TChemReactions>(eos, std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"loadBalance", "true"}, {"loadBalanceTolerance", "0.0"}}));
+            auto localChemistry = std::make_shared<TChemReactions>(eos);
+
+            // build a methane/air state (T, Yi..., p, dt) for each local cell with a different temperature in each cell
+            const auto& species = eos->GetSpecies();
+            const std::size_t stateSize = balancedChemistry->GetStateSize();
+            const int globalOffset = std::accumulate(GetParam().statesPerRank.begin(), GetParam().statesPerRank.begin() + rank, 0);
+            std::vector<PetscReal> states(GetParam().statesPerRank[rank] * stateSize, 0.0);
+            for (int i = 0; i < GetParam().statesPerRank[rank]; i++) {
+                PetscReal* state = &states[i * stateSize];
+                state[0] = 1200.0 + 25.0 * (globalOffset + i);
+                state[1 + std::distance(species.begin(), std::find(species.begin(), species.end(), "CH4"))] = 0.055;
+                state[1 + std::distance(species.begin(), std::find(species.begin(), species.end(), "O2"))] = 0.22;
+                state[1 + std::distance(species.begin(), std::find(species.begin(), species.end(), "N2"))] = 0.725;
+                state[species.size() + 1] = 101325.0;
+                state[species.size() + 2] = 1.0E-5;
+            }
+            std::vector<PetscReal> balancedStates = states;
+            std::vector<PetscReal> localStates = states;
+
+            // act
+            balancedChemistry->SolveChemistry(PETSC_COMM_WORLD, 0.0, balancedStates);
+            localChemistry->SolveChemistry(PETSC_COMM_WORLD, 0.0, localStates);
+
+            // assert that every state returned from another rank is the same as when integrated locally
+            ASSERT_EQ(balancedStates.size(), localStates.size());
+            for (std::size_t i = 0; i < localStates.size(); i++) {
+                ASSERT_NEAR(balancedStates[i], localStates[i], 1E-10 * PetscMax(1.0, PetscAbsReal(localStates[i]))) << "on rank " << rank << " at index " << i;
+            }
+
+            // the chemistry must change the states for the comparison to be meaningful
+            if (!states.empty()) {
+                ASSERT_NE(localStates, states);
+            }
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TChemReactionsTests, LoadBalancedChemistryTestFixture,
+    testing::Values((LoadBalancedChemistryParameters){.mpiTestParameter = {.testName = "load balanced chemistry 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""},
+                                                      .statesPerRank = {6, 1}},
+                    (LoadBalancedChemistryParameters){.mpiTestParameter = {.testName = "load balanced chemistry 3 ranks", .nproc = 3, .expectedOutputFile = "", .arguments = ""},
+                                                      .statesPerRank = {8, 0, 2}}),
+    [](const testing::TestParamInfo<LoadBalancedChemistryParameters>& info) { return info.param.mpiTestParameter.getTestName(); });
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Chemistry splitting tests
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * The temperature computed from the solution, the aux temperature, and the CH4 mass fraction after advancing a uniform periodic methane/air reactor
+ */
+struct HomogeneousReactorResult {
+    PetscReal solutionTemperature;
+    PetscReal auxTemperature;
+    PetscReal yCH4;
+};
+
+class ChemistrySplittingTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<testingResources::MpiTestParameter> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam()); }
+
+   protected:
+    HomogeneousReactorResult RunHomogeneousReactor(const std::shared_ptr<ablate::eos::TChem>& eos, const std::string& splitting, PetscReal dt, PetscInt steps) {
+        TS ts;
+        TSCreate(PETSC_COMM_WORLD, &ts) >> testErrorChecker;
+        TSSetProblemType(ts, TS_NONLINEAR) >> testErrorChecker;
+        TSSetType(ts, TSEULER) >> testErrorChecker;
+        TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP) >> testErrorChecker;
+        TSSetMaxTime(ts, 1.0) >> testErrorChecker;
+        TSSetMaxSteps(ts, steps) >> testErrorChecker;
+
+        // a uniform periodic domain so that the transport does not change the state and only the chemistry splitting differs
+        auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+            "reactorMesh", std::vector<int>{3, 3}, std::vector<double>{0.0, 0.0}, std::vector<double>{0.01, 0.01}, std::vector<std::string>{"PERIODIC", "PERIODIC"}, false /*simplex*/);
+        auto parameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"cfl", "0.5"}, {"mu", "0.0"}, {"k", "0.0"}});
+        auto flowObject = std::make_shared<ablate::flow::ReactingCompressibleFlow>("reactorFlow",
+                                                                                   mesh,
+                                                                                   eos,
+                                                                                   parameters,
+                                                                                   nullptr /*fluxCalculator*/,
+                                                                                   nullptr /*options*/,
+                                                                                   std::vector<std::shared_ptr<ablate::mathFunctions::FieldSolution>>{} /*initialization*/,
+                                                                                   std::vector<std::shared_ptr<ablate::flow::boundaryConditions::BoundaryCondition>>{} /*boundaryConditions*/,
+                                                                                   std::vector<std::shared_ptr<ablate::mathFunctions::FieldSolution>>{} /*exactSolutions*/,
+                                                                                   std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"splitting", splitting}}));
+        flowObject->CompleteProblemSetup(ts);
+        TSSetTimeStep(ts, dt) >> testErrorChecker;
+
+        // compute the conserved methane/air state at 2000 K and 1 atm
+        const auto& species = eos->GetSpecies();
+        const auto speciesIndex = [&species](const std::string& name) { return std::distance(species.begin(), std::find(species.begin(), species.end(), name)); };
+        std::vector<double> state(species.size() + 1, 0.0);
+        state[0] = 2000.0;
+        state[1 + speciesIndex("CH4")] = 0.055;
+        state[1 + speciesIndex("O2")] = 0.22;
+        state[1 + speciesIndex("N2")] = 0.725;
+        double mwMix;
+        TC_getMs2Wmix(&state[1], (int)species.size(), &mwMix) >> testErrorChecker;
+        double internalEnergy;
+        ablate::eos::TChem::ComputeSensibleInternalEnergy((int)species.size(), &state[0], mwMix, internalEnergy) >> testErrorChecker;
+        const double density = 101325.0 / (state[0] * 1000.0 * RUNIV / mwMix);
+
+        PetscInt cStart, cEnd;
+        DMPlexGetHeightStratum(flowObject->GetDM(), 0, &cStart, &cEnd) >> testErrorChecker;
+        const PetscInt eulerId = flowObject->GetFieldId("euler").value();
+        const PetscInt densityYiId = flowObject->GetFieldId("densityYi").value();
+        PetscScalar* solutionArray;
+        VecGetArray(flowObject->GetSolutionVector(), &solutionArray) >> testErrorChecker;
+        for (PetscInt c = cStart; c < cEnd; c++) {
+            PetscScalar* euler;
+            PetscScalar* densityYi;
+            DMPlexPointGlobalFieldRef(flowObject->GetDM(), c, eulerId, solutionArray, &euler) >> testErrorChecker;
+            DMPlexPointGlobalFieldRef(flowObject->GetDM(), c, densityYiId, solutionArray, &densityYi) >> testErrorChecker;
+            if (euler) {
+                euler[ablate::flow::processes::EulerAdvection::RHO] = density;
+                euler[ablate::flow::processes::EulerAdvection::RHOE] = density * internalEnergy;
+                euler[ablate::flow::processes::EulerAdvection::RHOU] = 0.0;
+                euler[ablate::flow::processes::EulerAdvection::RHOV] = 0.0;
+                for (std::size_t sp = 0; sp < species.size(); sp++) {
+                    densityYi[sp] = density * state[sp + 1];
+                }
+            }
+        }
+        VecRestoreArray(flowObject->GetSolutionVector(), &solutionArray) >> testErrorChecker;
+
+        // act
+        TSSolve(ts, flowObject->GetSolutionVector()) >> testErrorChecker;
+
+        // every cell is the same, so return the first cell
+        HomogeneousReactorResult result{};
+        const PetscInt temperatureId = flowObject->GetAuxFieldId("T").value();
+        const PetscScalar* constSolutionArray;
+        const PetscScalar* auxArray;
+        VecGetArrayRead(flowObject->GetSolutionVector(), &constSolutionArray) >> testErrorChecker;
+        VecGetArrayRead(flowObject->GetAuxField(), &auxArray) >> testErrorChecker;
+        const PetscScalar* euler;
+        const PetscScalar* densityYi;
+        const PetscScalar* auxTemperature;
+        DMPlexPointGlobalFieldRead(flowObject->GetDM(), cStart, eulerId, constSolutionArray, &euler) >> testErrorChecker;
+        DMPlexPointGlobalFieldRead(flowObject->GetDM(), cStart, densityYiId, constSolutionArray, &densityYi) >> testErrorChecker;
+        DMPlexPointLocalFieldRead(flowObject->GetAuxDM(), cStart, temperatureId, auxArray, &auxTemperature) >> testErrorChecker;
+        eos->GetComputeTemperatureFunction()(2,
+                                             euler[ablate::flow::processes::EulerAdvection::RHO],
+                                             euler[ablate::flow::processes::EulerAdvection::RHOE] / euler[ablate::flow::processes::EulerAdvection::RHO],
+                                             euler + ablate::flow::processes::EulerAdvection::RHOU,
+                                             densityYi,
+                                             &result.solutionTemperature,
+                                             eos->GetComputeTemperatureContext()) >> testErrorChecker;
+        result.auxTemperature = auxTemperature[0];
+        result.yCH4 = densityYi[speciesIndex("CH4")] / euler[ablate::flow::processes::EulerAdvection::RHO];
+        VecRestoreArrayRead(flowObject->GetAuxField(), &auxArray) >> testErrorChecker;
+        VecRestoreArrayRead(flowObject->GetSolutionVector(), &constSolutionArray) >> testErrorChecker;
+
+        TSDestroy(&ts) >> testErrorChecker;
+        return result;
+    }
+};
+
+TEST_P(ChemistrySplittingTestFixture, ShouldMatchSourceSplittingForHomogeneousReactor) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+            auto eos = std::make_shared<ablate::eos::TChem>("inputs/eos/grimech30.dat", "inputs/eos/thermo30.dat");
+            const PetscReal dt = 1.0E-5;
+            const PetscInt steps = 8;
+
+            // act
+            auto strang = RunHomogeneousReactor(eos, "strang", dt, steps);
+            auto source = RunHomogeneousReactor(eos, "source", dt, steps);
+            auto strangHalf = RunHomogeneousReactor(eos, "strang", 0.5 * dt, 2 * steps);
+            auto sourceHalf = RunHomogeneousReactor(eos, "source", 0.5 * dt, 2 * steps);
+
+            // assert that the chemistry advanced the reactor
+            ASSERT_GT(strang.solutionTemperature, 2010.0);
+            ASSERT_LT(strang.yCH4, 0.055);
+
+            // the aux temperature must include the chemistry applied after the transport
+            ASSERT_NEAR(strang.auxTemperature, strang.solutionTemperature, 1.0E-6 * strang.solutionTemperature);
+            ASSERT_NEAR(strangHalf.auxTemperature, strangHalf.solutionTemperature, 1.0E-6 * strangHalf.solutionTemperature);
+
+            // without transport both splittings integrate the same chemistry over the same time
+            ASSERT_NEAR(strang.solutionTemperature, source.solutionTemperature, 5.0E-2 * (source.solutionTemperature - 2000.0));
+            ASSERT_NEAR(strang.yCH4, source.yCH4, 5.0E-2 * (0.055 - source.yCH4));
+
+            // and the splittings converge to each other as the step is reduced
+            ASSERT_LE(PetscAbsReal(strangHalf.solutionTemperature - sourceHalf.solutionTemperature), PetscAbsReal(strang.solutionTemperature - source.solutionTemperature) + 1.0E-6);
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(TChemReactionsTests, ChemistrySplittingTestFixture,
+                         testing::Values((testingResources::MpiTestParameter){.testName = "homogeneous reactor splitting",
+                                                                              .nproc = 1,
+                                                                              .expectedOutputFile = "",
+                                                                              .arguments = "-automaticTimeStepCalculator off -ts_rtol 1E-8 -ts_atol 1E-12"}),
+                         [](const testing::TestParamInfo<testingResources::MpiTestParameter>& info) { return info.getTestName(); });
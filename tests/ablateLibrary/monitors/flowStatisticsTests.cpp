@@ -0,0 +1,99 @@
+#include <petsc.h>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "eos/perfectGas.hpp"
+#include "flow/compressibleFlow.hpp"
+#include "gtest/gtest.h"
+#include "mathFunctions/functionFactory.hpp"
+#include "mesh/boxMesh.hpp"
+#include "monitors/flowStatistics.hpp"
+#include "parameters/mapParameters.hpp"
+
+using namespace ablate;
+
+class FlowStatisticsTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<testingResources::MpiTestParameter> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam()); }
+};
+
+TEST_P(FlowStatisticsTestFixture, ShouldComputeTheTimeWeightedMeanAndRms) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange
+            TS ts;
+            TSCreate(PETSC_COMM_WORLD, &ts) >> testErrorChecker;
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+                "mesh", std::vector<int>{4, 4}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{} /*boundary*/, false /*simplex*/);
+            auto parameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"cfl", "0.5"}, {"mu", "0.0"}, {"k", "0.0"}});
+            auto eos = std::make_shared<ablate::eos::PerfectGas>(std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"gamma", "1.4"}, {"Rgas", "287"}}));
+            auto euler = std::make_shared<mathFunctions::FieldSolution>("euler", mathFunctions::Create(std::vector<double>{1.0, 2.5, 0.0, 0.0}));
+            auto flowObject = std::make_shared<ablate::flow::CompressibleFlow>(
+                "testFlow", mesh, eos, parameters, nullptr, nullptr, std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{euler});
+            flowObject->CompleteProblemSetup(ts);
+            ablate::monitors::FlowStatistics statistics("statistics", flowObject, {"euler.0"});
+
+            // a sine signal sampled with a time step that grows each step, the time weighted statistics differ from the sample statistics
+            std::vector<PetscReal> signal, timeSteps;
+            PetscReal time = 0.0;
+            for (int s = 0; s < 20; ++s) {
+                const PetscReal dt = 0.05 * (1.0 + 0.25 * s);
+                time += dt;
+                timeSteps.push_back(dt);
+                signal.push_back(2.0 + std::sin(time));
+            }
+            PetscReal totalTime = 0.0, expectedMean = 0.0;
+            for (std::size_t s = 0; s < signal.size(); ++s) {
+                totalTime += timeSteps[s];
+                expectedMean += timeSteps[s] * signal[s];
+            }
+            expectedMean /= totalTime;
+            PetscReal expectedVariance = 0.0;
+            for (std::size_t s = 0; s < signal.size(); ++s) {
+                expectedVariance += timeSteps[s] * (signal[s] - expectedMean) * (signal[s] - expectedMean);
+            }
+            const PetscReal expectedRms = std::sqrt(expectedVariance / totalTime);
+
+            // act
+            Vec u = flowObject->GetSolutionVector();
+            for (std::size_t s = 0; s < signal.size(); ++s) {
+                VecSet(u, signal[s]) >> testErrorChecker;
+                statistics.Accumulate(u, timeSteps[s]);
+            }
+            std::vector<Vec> vectors;
+            statistics.GetViewVectors((PetscInt)signal.size(), time, u, vectors);
+
+            // assert
+            ASSERT_EQ(statistics.GetSamples(), (PetscInt)signal.size());
+            ASSERT_NEAR(statistics.GetWeight(), totalTime, 1E-12);
+            ASSERT_EQ(vectors.size(), 1);
+
+            // each cell holds the mean followed by the rms
+            PetscInt size;
+            const PetscScalar* values;
+            VecGetLocalSize(vectors[0], &size) >> testErrorChecker;
+            VecGetArrayRead(vectors[0], &values) >> testErrorChecker;
+            ASSERT_GT(size, 0);
+            ASSERT_EQ(size % 2, 0);
+            for (PetscInt i = 0; i < size; i += 2) {
+                ASSERT_NEAR(PetscRealPart(values[i]), expectedMean, 1E-12);
+                ASSERT_NEAR(PetscRealPart(values[i + 1]), expectedRms, 1E-12);
+            }
+            VecRestoreArrayRead(vectors[0], &values) >> testErrorChecker;
+
+            // cleanup
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(FlowStatisticsTests, FlowStatisticsTestFixture,
+                         testing::Values((testingResources::MpiTestParameter){.testName = "time weighted statistics", .nproc = 1, .expectedOutputFile = "", .arguments = ""},
+                                         (testingResources::MpiTestParameter){.testName = "time weighted statistics 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""}),
+                         [](const testing::TestParamInfo<testingResources::MpiTestParameter>& info) { return info.getTestName(); });
@@ -0,0 +1,66 @@
+#include <petsc.h>
+#include <memory>
+#include "MpiTestFixture.hpp"
+#include "gtest/gtest.h"
+#include "monitors/memoryMonitor.hpp"
+#include "utilities/memoryTracker.hpp"
+
+using namespace ablate;
+
+class MemoryMonitorTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<testingResources::MpiTestParameter> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam()); }
+};
+
+TEST_P(MemoryMonitorTestFixture, ShouldReportTheTrackedSubsystems) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange, each rank holds (rank + 1) MB in a test subsystem split over two owners and a particle owner that is removed before reporting
+            PetscMPIInt rank;
+            MPI_Comm_rank(PETSC_COMM_WORLD, &rank) >> testErrorChecker;
+            const PetscLogDouble megabyte = 1024.0 * 1024.0;
+            int ownerA, ownerB, particleOwner;
+            utilities::MemoryTracker::Register("test subsystem", &ownerA, [&]() { return 0.25 * (rank + 1) * megabyte; });
+            utilities::MemoryTracker::Register("test subsystem", &ownerB, [&]() { return 0.75 * (rank + 1) * megabyte; });
+            utilities::MemoryTracker::Register(utilities::MemoryTracker::Particles, &particleOwner, [&]() { return 8.0 * megabyte; });
+
+            // the ablate subsystems are always listed first and the reporters of each subsystem are summed
+            auto usage = utilities::MemoryTracker::GetUsage();
+            ASSERT_EQ(usage.size(), 7u);
+            ASSERT_EQ(usage[0].subsystem, utilities::MemoryTracker::Mesh);
+            ASSERT_EQ(usage[5].subsystem, utilities::MemoryTracker::Particles);
+            ASSERT_DOUBLE_EQ(usage[5].bytes, 8.0 * megabyte);
+            ASSERT_EQ(usage[6].subsystem, "test subsystem");
+            ASSERT_DOUBLE_EQ(usage[6].bytes, (rank + 1) * megabyte);
+
+            // unregistering an owner only removes its reporters
+            utilities::MemoryTracker::Unregister(&particleOwner);
+            usage = utilities::MemoryTracker::GetUsage();
+            ASSERT_EQ(usage.size(), 7u);
+            ASSERT_DOUBLE_EQ(usage[5].bytes, 0.0);
+            ASSERT_DOUBLE_EQ(usage[6].bytes, (rank + 1) * megabyte);
+
+            // act, only every second step is reported
+            auto monitor = std::make_shared<monitors::MemoryMonitor>(2);
+            auto monitorFunction = monitor->GetPetscFunction();
+            for (PetscInt step = 0; step < 3; step++) {
+                monitorFunction(NULL, step, (PetscReal)step, NULL, monitor.get()) >> testErrorChecker;
+            }
+
+            // cleanup
+            utilities::MemoryTracker::Unregister(&ownerA);
+            utilities::MemoryTracker::Unregister(&ownerB);
+            ASSERT_EQ(utilities::MemoryTracker::GetUsage().size(), 6u);
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    MemoryMonitorTests, MemoryMonitorTestFixture,
+    testing::Values((testingResources::MpiTestParameter){.testName = "untraced malloc", .nproc = 2, .expectedOutputFile = "outputs/monitors/memoryMonitor_untraced", .arguments = "-malloc_debug 0"},
+                    (testingResources::MpiTestParameter){.testName = "traced malloc", .nproc = 2, .expectedOutputFile = "outputs/monitors/memoryMonitor_traced", .arguments = "-malloc_debug"}),
+    [](const testing::TestParamInfo<testingResources::MpiTestParameter>& info) { return info.getTestName(); });
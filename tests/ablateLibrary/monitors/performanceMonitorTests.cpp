@@ -0,0 +1,53 @@
+#include <petsc.h>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include "MpiTestFixture.hpp"
+#include "gtest/gtest.h"
+#include "monitors/performanceMonitor.hpp"
+#include "utilities/logEvents.hpp"
+
+using namespace ablate;
+
+class PerformanceMonitorTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<testingResources::MpiTestParameter> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam()); }
+};
+
+TEST_P(PerformanceMonitorTestFixture, ShouldReportTheEventChangeSinceTheLastReport) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange, the monitor starts the default logging before the events are used
+            auto monitor = std::make_shared<monitors::PerformanceMonitor>(2);
+            auto monitorFunction = monitor->GetPetscFunction();
+            auto stepEvent = utilities::LogEvents::Register("TestStepEvent");
+            auto firstStepEvent = utilities::LogEvents::Register("TestFirstStepEvent");
+
+            // act, step s spends 10*s ms in the step event and only the first step uses the first step event
+            monitorFunction(NULL, 0, 0.0, NULL, monitor.get()) >> testErrorChecker;
+            for (PetscInt step = 1; step <= 4; step++) {
+                {
+                    utilities::LogEvents::Scope scope(stepEvent);
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10 * step));
+                }
+                if (step == 1) {
+                    utilities::LogEvents::Scope scope(firstStepEvent);
+                }
+                monitorFunction(NULL, step, (PetscReal)step, NULL, monitor.get()) >> testErrorChecker;
+            }
+
+            // the expected output checks that the second report holds only steps 3-4 (35 ms/step, not the 50 ms/step since the start) and does not list the
+            // first step event, which was not used in the interval
+            PetscPrintf(PETSC_COMM_WORLD, "Done\n") >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(PerformanceMonitorTests, PerformanceMonitorTestFixture,
+                         testing::Values((testingResources::MpiTestParameter){
+                             .testName = "interval report", .nproc = 2, .expectedOutputFile = "outputs/monitors/performanceMonitor_interval", .arguments = ""}),
+                         [](const testing::TestParamInfo<testingResources::MpiTestParameter>& info) { return info.getTestName(); });
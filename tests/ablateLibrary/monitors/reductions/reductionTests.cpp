@@ -0,0 +1,140 @@
+#include <petsc.h>
+#include <map>
+#include <memory>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "eos/perfectGas.hpp"
+#include "flow/compressibleFlow.hpp"
+#include "gtest/gtest.h"
+#include "mathFunctions/functionFactory.hpp"
+#include "mesh/boxMesh.hpp"
+#include "monitors/reductions/boundaryIntegral.hpp"
+#include "monitors/reductions/extrema.hpp"
+#include "monitors/reductions/probe.hpp"
+#include "monitors/reductions/volumeIntegral.hpp"
+#include "parameters/mapParameters.hpp"
+#include "utilities/mpiError.hpp"
+#include "utilities/petscError.hpp"
+
+using namespace ablate;
+
+/**
+ * Computes the reduction over the flow and combines the columns across the ranks (the same as the ReductionMonitor)
+ */
+static std::vector<PetscReal> ComputeReduction(monitors::reductions::Reduction& reduction, flow::Flow& flow) {
+    reduction.Setup(flow);
+    const auto columns = reduction.GetColumns();
+
+    Vec localSolution;
+    DMGetLocalVector(flow.GetDM(), &localSolution) >> checkError;
+    DMGlobalToLocal(flow.GetDM(), flow.GetSolutionVector(), INSERT_VALUES, localSolution) >> checkError;
+    const PetscScalar* solutionArray;
+    VecGetArrayRead(localSolution, &solutionArray) >> checkError;
+    std::vector<PetscReal> localValues(columns.size());
+    reduction.Compute(solutionArray, nullptr, localValues.data());
+    VecRestoreArrayRead(localSolution, &solutionArray) >> checkError;
+    DMRestoreLocalVector(flow.GetDM(), &localSolution) >> checkError;
+
+    std::vector<PetscReal> values(columns.size());
+    for (std::size_t c = 0; c < columns.size(); ++c) {
+        MPI_Op op = columns[c].operation == monitors::reductions::Reduction::Operation::SUM ? MPI_SUM
+                    : columns[c].operation == monitors::reductions::Reduction::Operation::MIN ? MPI_MIN
+                                                                                                : MPI_MAX;
+        MPI_Allreduce(&localValues[c], &values[c], 1, MPIU_REAL, op, PETSC_COMM_WORLD) >> checkMpiError;
+    }
+    return values;
+}
+
+class ReductionTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<testingResources::MpiTestParameter> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam()); }
+};
+
+TEST_P(ReductionTestFixture, ShouldReduceAnAnalyticField) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange
+            // the field is linear so the cell averages are the values at the centroids and the midpoint sums are exact
+            TS ts;
+            TSCreate(PETSC_COMM_WORLD, &ts) >> testErrorChecker;
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+                "mesh", std::vector<int>{8, 4}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 2.0}, std::vector<std::string>{} /*boundary*/, false /*simplex*/);
+            auto parameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"cfl", "0.5"}, {"mu", "0.0"}, {"k", "0.0"}});
+            auto eos = std::make_shared<ablate::eos::PerfectGas>(std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"gamma", "1.4"}, {"Rgas", "287"}}));
+            auto euler = std::make_shared<mathFunctions::FieldSolution>("euler", mathFunctions::Create("1.0 + x, 2.0E5 + y, 3.0, 1.0 + x"));
+            auto flowObject = std::make_shared<ablate::flow::CompressibleFlow>(
+                "testFlow", mesh, eos, parameters, nullptr, nullptr, std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{euler});
+            flowObject->CompleteProblemSetup(ts);
+
+            // act
+            // the integral of rho = 1 + x over [0, 1] x [0, 2]
+            monitors::reductions::VolumeIntegral volumeIntegral("euler", {0, 1});
+            auto volumeValues = ComputeReduction(volumeIntegral, *flowObject);
+
+            // the cell centroids of rho are 1 + x for x in [1/16, 15/16]
+            monitors::reductions::Extrema extrema("euler", {0});
+            auto extremaValues = ComputeReduction(extrema, *flowObject);
+
+            // the boundary face sets are bottom (1), right (2), top (3), and left (4)
+            monitors::reductions::BoundaryIntegral topIntegral("euler", {3}, "", {0});
+            auto topValues = ComputeReduction(topIntegral, *flowObject);
+            monitors::reductions::BoundaryIntegral rightFlux("euler", {2}, "", {2, 3}, true);
+            auto rightFluxValues = ComputeReduction(rightFlux, *flowObject);
+            monitors::reductions::BoundaryIntegral leftFlux("euler", {4}, "", {2, 3}, true);
+            auto leftFluxValues = ComputeReduction(leftFlux, *flowObject);
+            monitors::reductions::BoundaryIntegral topFlux("euler", {3}, "", {2, 3}, true);
+            auto topFluxValues = ComputeReduction(topFlux, *flowObject);
+
+            // a point inside a cell and a point on the face between two cells (which may be on different ranks)
+            monitors::reductions::Probe probe("probe", {0.3, 0.7}, "euler", {0, 1});
+            auto probeValues = ComputeReduction(probe, *flowObject);
+            monitors::reductions::Probe faceProbe("faceProbe", {0.5, 1.1}, "euler", {0});
+            auto faceProbeValues = ComputeReduction(faceProbe, *flowObject);
+
+            // assert
+            ASSERT_EQ(volumeValues.size(), 2);
+            ASSERT_NEAR(volumeValues[0], 3.0, 1E-12);
+            ASSERT_NEAR(volumeValues[1], 2.0 * 2.0E5 + 2.0, 1E-6);
+
+            ASSERT_EQ(extremaValues.size(), 2);
+            ASSERT_NEAR(extremaValues[0], 1.0 + 1.0 / 16.0, 1E-12);
+            ASSERT_NEAR(extremaValues[1], 1.0 + 15.0 / 16.0, 1E-12);
+
+            ASSERT_EQ(topValues.size(), 1);
+            ASSERT_NEAR(topValues[0], 1.5, 1E-12);
+
+            // the normal integrals use the outward normal, so the constant rho u enters on the left and leaves on the right
+            ASSERT_EQ(rightFluxValues.size(), 1);
+            ASSERT_NEAR(rightFluxValues[0], 6.0, 1E-12);
+            ASSERT_NEAR(leftFluxValues[0], -6.0, 1E-12);
+            ASSERT_NEAR(topFluxValues[0], 1.5, 1E-12);
+
+            // the probe reports the cell holding the point (x in [0.25, 0.375], y in [0.5, 1.0])
+            ASSERT_EQ(probeValues.size(), 2);
+            ASSERT_NEAR(probeValues[0], 1.3125, 1E-12);
+            ASSERT_NEAR(probeValues[1], 2.0E5 + 0.75, 1E-6);
+
+            // only one of the cells sharing the face reports the probe
+            ASSERT_EQ(faceProbeValues.size(), 1);
+            ASSERT_TRUE(PetscAbsReal(faceProbeValues[0] - 1.4375) < 1E-12 || PetscAbsReal(faceProbeValues[0] - 1.5625) < 1E-12) << "the probe reported " << faceProbeValues[0];
+
+            // a probe outside of the domain cannot be located
+            monitors::reductions::Probe outsideProbe("outsideProbe", {1.5, 0.5}, "euler", {0});
+            ASSERT_THROW(outsideProbe.Setup(*flowObject), std::invalid_argument);
+
+            // cleanup
+            flowObject.reset();
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(ReductionTests, ReductionTestFixture,
+                         testing::Values((testingResources::MpiTestParameter){.testName = "reductions", .nproc = 1, .expectedOutputFile = "", .arguments = "-dm_plex_separate_marker"},
+                                         (testingResources::MpiTestParameter){.testName = "reductions 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = "-dm_plex_separate_marker"},
+                                         (testingResources::MpiTestParameter){.testName = "reductions 3 ranks", .nproc = 3, .expectedOutputFile = "", .arguments = "-dm_plex_separate_marker"}),
+                         [](const testing::TestParamInfo<testingResources::MpiTestParameter>& info) { return info.getTestName(); });
@@ -0,0 +1,179 @@
+#include <petsc.h>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "eos/perfectGas.hpp"
+#include "flow/compressibleFlow.hpp"
+#include "gtest/gtest.h"
+#include "mathFunctions/functionFactory.hpp"
+#include "mesh/boxMesh.hpp"
+#include "monitors/solutionErrorMonitor.hpp"
+#include "parameters/mapParameters.hpp"
+
+using namespace ablate;
+
+/**
+ * Creates a compressible flow with the exact solution on a small box
+ */
+static std::shared_ptr<ablate::flow::CompressibleFlow> CreateFlow(TS ts, const std::string& exactSolution) {
+    auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+        "mesh", std::vector<int>{5, 4}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{} /*boundary*/, false /*simplex*/);
+    auto parameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"cfl", "0.5"}, {"mu", "0.0"}, {"k", "0.0"}});
+    auto eos = std::make_shared<ablate::eos::PerfectGas>(std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"gamma", "1.4"}, {"Rgas", "287"}}));
+    auto exact = std::make_shared<mathFunctions::FieldSolution>("euler", mathFunctions::Create(exactSolution));
+    auto flowObject = std::make_shared<ablate::flow::CompressibleFlow>("testFlow",
+                                                                       mesh,
+                                                                       eos,
+                                                                       parameters,
+                                                                       nullptr,
+                                                                       nullptr,
+                                                                       std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{exact},
+                                                                       std::vector<std::shared_ptr<flow::boundaryConditions::BoundaryCondition>>{},
+                                                                       std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{exact});
+    flowObject->CompleteProblemSetup(ts);
+    return flowObject;
+}
+
+/**
+ * Projects the exact solution set in the PetscDS with quadrature (DMProjectFunction)
+ */
+static void ProjectWithQuadrature(DM dm, PetscReal time, Vec exactVec, PetscTestErrorChecker& errorChecker) {
+    PetscDS ds;
+    DMGetDS(dm, &ds) >> errorChecker;
+    PetscInt numberOfFields;
+    PetscDSGetNumFields(ds, &numberOfFields) >> errorChecker;
+    std::vector<mathFunctions::PetscFunction> exactFuncs(numberOfFields);
+    std::vector<void*> exactCtxs(numberOfFields);
+    for (PetscInt f = 0; f < numberOfFields; ++f) {
+        PetscDSGetExactSolution(ds, f, &exactFuncs[f], &exactCtxs[f]) >> errorChecker;
+    }
+    DMProjectFunction(dm, time, exactFuncs.data(), exactCtxs.data(), INSERT_ALL_VALUES, exactVec) >> errorChecker;
+}
+
+/**
+ * Returns the largest difference between the vectors
+ */
+static PetscReal MaxDifference(Vec a, Vec b, PetscTestErrorChecker& errorChecker) {
+    Vec difference;
+    VecDuplicate(a, &difference) >> errorChecker;
+    VecWAXPY(difference, -1.0, a, b) >> errorChecker;
+    PetscReal norm;
+    VecNorm(difference, NORM_INFINITY, &norm) >> errorChecker;
+    VecDestroy(&difference) >> errorChecker;
+    return norm;
+}
+
+class SolutionErrorMonitorTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<testingResources::MpiTestParameter> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam()); }
+};
+
+TEST_P(SolutionErrorMonitorTestFixture, ShouldMatchTheQuadratureProjectionWhenCached) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // the time independent exact solution is cached, the time dependent solution is projected each time
+            for (const auto& [exactSolution, timeDependent] : std::vector<std::pair<std::string, bool>>{{"1.0 + x*x, 2.0 + y*y, 3.0*x*y, x + y", false},
+                                                                                                      {"1.0 + t*x*x, 2.0 + y*y, 3.0*x*y*t, x + t", true}}) {
+                // arrange
+                TS ts;
+                TSCreate(PETSC_COMM_WORLD, &ts) >> testErrorChecker;
+                auto flowObject = CreateFlow(ts, exactSolution);
+                Vec exactVec, expectedVec;
+                VecDuplicate(flowObject->GetSolutionVector(), &exactVec) >> testErrorChecker;
+                VecDuplicate(flowObject->GetSolutionVector(), &expectedVec) >> testErrorChecker;
+
+                // act
+                // the first projection fills the cache, the second is read from the cache when the solution does not depend upon time
+                flowObject->ProjectExactSolution(0.5, exactVec);
+                ProjectWithQuadrature(flowObject->GetDM(), 0.5, expectedVec, testErrorChecker);
+                const auto firstDifference = MaxDifference(exactVec, expectedVec, testErrorChecker);
+
+                flowObject->ProjectExactSolution(2.0, exactVec);
+                ProjectWithQuadrature(flowObject->GetDM(), 2.0, expectedVec, testErrorChecker);
+                const auto secondDifference = MaxDifference(exactVec, expectedVec, testErrorChecker);
+
+                // assert
+                ASSERT_EQ(flowObject->IsExactSolutionTimeDependent(), timeDependent);
+                ASSERT_LT(firstDifference, 1E-12) << "for " << exactSolution;
+                ASSERT_LT(secondDifference, 1E-12) << "for " << exactSolution;
+
+                // cleanup
+                VecDestroy(&expectedVec) >> testErrorChecker;
+                VecDestroy(&exactVec) >> testErrorChecker;
+                flowObject.reset();
+                TSDestroy(&ts) >> testErrorChecker;
+            }
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+TEST_P(SolutionErrorMonitorTestFixture, ShouldComputeTheErrorAtTheCellCenters) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange
+            TS ts;
+            TSCreate(PETSC_COMM_WORLD, &ts) >> testErrorChecker;
+            auto flowObject = CreateFlow(ts, "1.0 + x*x, 2.0 + y*y, 3.0*x*y, x + y");
+            auto monitor = std::make_shared<ablate::monitors::SolutionErrorMonitor>(
+                ablate::monitors::SolutionErrorMonitor::Scope::COMPONENT, ablate::monitors::SolutionErrorMonitor::Norm::L2_NORM, 0, true);
+            monitor->Register(flowObject);
+
+            // the solution is the exact solution evaluated independently at each owned cell centroid and offset by a constant
+            const PetscReal offset = 0.25;
+            DM dm = flowObject->GetDM();
+            Vec u = flowObject->GetSolutionVector();
+            PetscInt cStart, cEnd;
+            DMPlexGetSimplexOrBoxCells(dm, 0, &cStart, &cEnd) >> testErrorChecker;
+            PetscScalar* uArray;
+            VecGetArray(u, &uArray) >> testErrorChecker;
+            for (PetscInt c = cStart; c < cEnd; ++c) {
+                PetscScalar* values = nullptr;
+                DMPlexPointGlobalFieldRef(dm, c, 0, uArray, &values) >> testErrorChecker;
+                if (values) {
+                    PetscReal centroid[3];
+                    DMPlexComputeCellGeometryFVM(dm, c, NULL, centroid, NULL) >> testErrorChecker;
+                    const PetscReal x = centroid[0], y = centroid[1];
+                    values[0] = 1.0 + x * x + offset;
+                    values[1] = 2.0 + y * y + offset;
+                    values[2] = 3.0 * x * y + offset;
+                    values[3] = x + y + offset;
+                }
+            }
+            VecRestoreArray(u, &uArray) >> testErrorChecker;
+
+            // act
+            // the second error is computed from the cached cell center solution
+            auto errors = monitor->ComputeError(ts, 0.0, u);
+            auto cachedErrors = monitor->ComputeError(ts, 1.0, u);
+
+            // assert
+            // the normalized l2 norm of a constant offset is the offset
+            ASSERT_EQ(errors.size(), 4u);
+            ASSERT_EQ(cachedErrors.size(), 4u);
+            for (std::size_t c = 0; c < errors.size(); ++c) {
+                ASSERT_NEAR(errors[c], offset, 1E-12) << "for component " << c;
+                ASSERT_NEAR(cachedErrors[c], offset, 1E-12) << "for component " << c;
+            }
+
+            // cleanup
+            monitor.reset();
+            flowObject.reset();
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(SolutionErrorMonitorTests, SolutionErrorMonitorTestFixture,
+                         testing::Values((testingResources::MpiTestParameter){.testName = "exact solution", .nproc = 1, .expectedOutputFile = "", .arguments = ""},
+                                         (testingResources::MpiTestParameter){.testName = "exact solution 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""}),
+                         [](const testing::TestParamInfo<testingResources::MpiTestParameter>& info) { return info.getTestName(); });
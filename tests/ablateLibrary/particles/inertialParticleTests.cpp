@@ -7,6 +7,9 @@
 #include <parameters/petscOptionParameters.hpp>
 #include <parameters/petscPrefixOptions.hpp>
 #include <particles/initializers/boxInitializer.hpp>
+#include "eos/perfectGas.hpp"
+#include "flow/boundaryConditions/essentialGhost.hpp"
+#include "flow/compressibleFlow.hpp"
 #include "MpiTestFixture.hpp"
 #include "gtest/gtest.h"
 #include "incompressibleFlow.h"
@@ -361,3 +364,117 @@ INSTANTIATE_TEST_SUITE_P(InertialParticleTests, InertialParticleExactTestFixture
                                                                            .particleInitializer = std::make_shared<ablate::particles::initializers::BoxInitializer>(std::vector<double>{0.92, 0.3},
                                                                                                                                                                     std::vector<double>{.98, .6}, 10)}),
                          [](const testing::TestParamInfo<InertialParticleExactParameters> &info) { return info.param.mpiTestParameter.getTestName(); });
+
+struct InertialParticleExponentialParameters {
+    testingResources::MpiTestParameter mpiTestParameter;
+    ExactSolutionParameters parameters;
+    PetscReal dt;
+    PetscInt steps;
+};
+
+class InertialParticleExponentialTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<InertialParticleExponentialParameters> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam().mpiTestParameter); }
+};
+
+TEST_P(InertialParticleExponentialTestFixture, ShouldMatchAnalyticRelaxationAtLargeSteps) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+            auto testingParam = GetParam();
+
+            // arrange
+            TS ts;
+            TSCreate(PETSC_COMM_WORLD, &ts) >> testErrorChecker;
+            TSSetProblemType(ts, TS_NONLINEAR) >> testErrorChecker;
+            TSSetType(ts, TSEULER) >> testErrorChecker;
+            TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP) >> testErrorChecker;
+            TSSetTimeStep(ts, testingParam.dt) >> testErrorChecker;
+            TSSetMaxSteps(ts, testingParam.steps) >> testErrorChecker;
+
+            // a quiescent compressible flow
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+                "mesh", std::vector<int>{10, 10}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{} /*boundary*/, false /*simplex*/);
+            auto parameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"cfl", "0.5"}, {"mu", "0.0"}, {"k", "0.0"}});
+            auto eos = std::make_shared<ablate::eos::PerfectGas>(std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"gamma", "1.4"}, {"Rgas", "287"}}));
+            auto quiescentFlow = mathFunctions::Create(std::vector<double>{testingParam.parameters.rhoF, 2.5, 0.0, 0.0});
+            auto flowObject = std::make_shared<ablate::flow::CompressibleFlow>(
+                "testFlow",
+                mesh,
+                eos,
+                parameters,
+                nullptr,
+                nullptr,
+                std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{std::make_shared<mathFunctions::FieldSolution>("euler", quiescentFlow)},
+                std::vector<std::shared_ptr<boundaryConditions::BoundaryCondition>>{
+                    std::make_shared<boundaryConditions::EssentialGhost>("euler", "walls", std::vector<int>{1, 2, 3, 4}, quiescentFlow)});
+            flowObject->CompleteProblemSetup(ts);
+
+            // a single particle released from rest settles under gravity in the x direction
+            auto particleParameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"fluidDensity", std::to_string(testingParam.parameters.rhoF)},
+                                                                                                                             {"fluidViscosity", std::to_string(testingParam.parameters.muF)},
+                                                                                                                             {"gravityField", std::to_string(testingParam.parameters.grav) + " 0"},
+                                                                                                                             {"exponentialIntegrator", "true"}});
+            auto fieldInitialization = std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{
+                std::make_shared<mathFunctions::FieldSolution>(ablate::particles::Inertial::ParticleVelocity, ablate::mathFunctions::Create(testingParam.parameters.pVel)),
+                std::make_shared<mathFunctions::FieldSolution>(ablate::particles::Inertial::ParticleDiameter, ablate::mathFunctions::Create(testingParam.parameters.dp)),
+                std::make_shared<mathFunctions::FieldSolution>(ablate::particles::Inertial::ParticleDensity, ablate::mathFunctions::Create(testingParam.parameters.rhoP)),
+            };
+            const PetscReal x0[2] = {0.3, 0.5};
+            auto initializer = std::make_shared<ablate::particles::initializers::BoxInitializer>(std::vector<double>{x0[0], x0[1]}, std::vector<double>{x0[0], x0[1]}, 1);
+            auto particleOptions = std::make_shared<ablate::parameters::PetscPrefixOptions>("-particle_");
+            auto particles = std::make_shared<ablate::particles::Inertial>("particle", 2, particleParameters, initializer, fieldInitialization, nullptr, particleOptions);
+            particles->InitializeFlow(flowObject);
+            TSSetFromOptions(ts) >> testErrorChecker;
+
+            // act
+            TSSolve(ts, flowObject->GetSolutionVector()) >> testErrorChecker;
+
+            // assert
+            PetscReal time;
+            TSGetTime(ts, &time) >> testErrorChecker;
+            const PetscReal tauP = testingParam.parameters.rhoP * PetscSqr(testingParam.parameters.dp) / (18.0 * testingParam.parameters.muF);
+            ASSERT_GT(testingParam.dt / tauP, 5.0) << "the test should take steps much larger than the relaxation time";
+            PetscScalar expected[4];
+            settling(2, time, x0, 4, expected, &testingParam.parameters) >> testErrorChecker;
+
+            PetscInt particleCount;
+            DMSwarmGetSize(particles->GetDM(), &particleCount) >> testErrorChecker;
+            ASSERT_EQ(particleCount, 1);
+            PetscInt np;
+            DMSwarmGetLocalSize(particles->GetDM(), &np) >> testErrorChecker;
+            const PetscReal* kinematics;
+            DMSwarmGetField(particles->GetDM(), "PackedSolution", NULL, NULL, (void**)&kinematics) >> testErrorChecker;
+            for (PetscInt p = 0; p < np; ++p) {
+                // the packed solution holds the position and then the velocity of each particle
+                for (PetscInt i = 0; i < 4; ++i) {
+                    ASSERT_NEAR(kinematics[p * 4 + i], PetscRealPart(expected[i]), 1E-10) << "for component " << i << " at time " << time;
+                }
+            }
+            DMSwarmRestoreField(particles->GetDM(), "PackedSolution", NULL, NULL, (void**)&kinematics) >> testErrorChecker;
+
+            // cleanup
+            particles.reset();
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(InertialParticleTests, InertialParticleExponentialTestFixture,
+                         testing::Values((InertialParticleExponentialParameters){.mpiTestParameter = {.testName = "exponential integrator settling",
+                                                                                                      .nproc = 1,
+                                                                                                      .expectedOutputFile = "",
+                                                                                                      .arguments = "-automaticTimeStepCalculator false -particle_ts_dt 0.5"},
+                                                                                 .parameters = {.dim = 2, .pVel = {0.0, 0.0}, .dp = 0.1, .rhoP = 90.0, .rhoF = 1.0, .muF = 1.0, .grav = 1.0},
+                                                                                 .dt = 0.5,
+                                                                                 .steps = 4},
+                                         (InertialParticleExponentialParameters){.mpiTestParameter = {.testName = "exponential integrator settling 2 ranks",
+                                                                                                      .nproc = 2,
+                                                                                                      .expectedOutputFile = "",
+                                                                                                      .arguments = "-automaticTimeStepCalculator false -particle_ts_dt 0.25"},
+                                                                                 .parameters = {.dim = 2, .pVel = {0.0, 0.0}, .dp = 0.1, .rhoP = 90.0, .rhoF = 1.0, .muF = 1.0, .grav = 1.0},
+                                                                                 .dt = 0.5,
+                                                                                 .steps = 4}),
+                         [](const testing::TestParamInfo<InertialParticleExponentialParameters> &info) { return info.param.mpiTestParameter.getTestName(); });
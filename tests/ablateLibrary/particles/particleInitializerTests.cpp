@@ -0,0 +1,176 @@
+#include <petsc.h>
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "eos/perfectGas.hpp"
+#include "flow/compressibleFlow.hpp"
+#include "gtest/gtest.h"
+#include "mathFunctions/functionFactory.hpp"
+#include "mesh/boxMesh.hpp"
+#include "mesh/dmWrapper.hpp"
+#include "parameters/mapParameters.hpp"
+#include "particles/initializers/boxInitializer.hpp"
+#include "particles/initializers/cellInitializer.hpp"
+
+using namespace ablate;
+
+// the pid and coordinates of each particle
+using ParticleRecord = std::array<PetscReal, 3>;
+
+class ParticleInitializerTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<testingResources::MpiTestParameter> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam()); }
+
+   protected:
+    inline static const std::vector<int> faces = {8, 6};
+
+    /**
+     * Initializes the particles on a flow over comm and returns every particle (pid, x, y) from every rank sorted by pid
+     */
+    std::vector<ParticleRecord> InitializeParticles(MPI_Comm comm, initializers::Initializer& initializer) {
+        // the world mesh is distributed by the flow, the self mesh is the serial layout on each rank
+        std::shared_ptr<mesh::Mesh> mesh;
+        if (comm == PETSC_COMM_WORLD) {
+            mesh = std::make_shared<mesh::BoxMesh>("mesh", faces, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{} /*boundary*/, false /*simplex*/);
+        } else {
+            DM serialDm;
+            const PetscInt serialFaces[2] = {faces[0], faces[1]};
+            DMPlexCreateBoxMesh(comm, 2, PETSC_FALSE, serialFaces, NULL, NULL, NULL, PETSC_TRUE, &serialDm) >> testErrorChecker;
+            mesh = std::make_shared<mesh::DMWrapper>(serialDm);
+        }
+        auto parameters = std::make_shared<parameters::MapParameters>(std::map<std::string, std::string>{{"cfl", "0.5"}, {"mu", "0.0"}, {"k", "0.0"}});
+        auto eos = std::make_shared<eos::PerfectGas>(std::make_shared<parameters::MapParameters>(std::map<std::string, std::string>{{"gamma", "1.4"}, {"Rgas", "287"}}));
+        auto flowObject = std::make_shared<flow::CompressibleFlow>("testFlow", mesh, eos, parameters, nullptr, nullptr);
+
+        DM swarm;
+        DMCreate(comm, &swarm) >> testErrorChecker;
+        DMSetType(swarm, DMSWARM) >> testErrorChecker;
+        DMSetDimension(swarm, 2) >> testErrorChecker;
+        DMSwarmSetType(swarm, DMSWARM_PIC) >> testErrorChecker;
+        DMSwarmSetCellDM(swarm, flowObject->GetDM()) >> testErrorChecker;
+        DMSwarmFinalizeFieldRegister(swarm) >> testErrorChecker;
+
+        // act
+        initializer.Initialize(*flowObject, swarm);
+
+        // gather every particle to every rank
+        PetscInt np;
+        DMSwarmGetLocalSize(swarm, &np) >> testErrorChecker;
+        std::vector<PetscReal> localRecords;
+        PetscReal* coordinates;
+        PetscInt64* pid;
+        DMSwarmGetField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+        DMSwarmGetField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+        for (PetscInt p = 0; p < np; ++p) {
+            localRecords.insert(localRecords.end(), {(PetscReal)pid[p], coordinates[p * 2], coordinates[p * 2 + 1]});
+        }
+        DMSwarmRestoreField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+        DMSwarmRestoreField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+
+        PetscMPIInt size;
+        MPI_Comm_size(comm, &size) >> testErrorChecker;
+        PetscMPIInt localSize = (PetscMPIInt)localRecords.size();
+        std::vector<PetscMPIInt> sizes(size), offsets(size + 1, 0);
+        MPI_Allgather(&localSize, 1, MPI_INT, sizes.data(), 1, MPI_INT, comm) >> testErrorChecker;
+        for (PetscMPIInt r = 0; r < size; ++r) {
+            offsets[r + 1] = offsets[r] + sizes[r];
+        }
+        std::vector<PetscReal> globalRecords(offsets[size]);
+        MPI_Allgatherv(localRecords.data(), localSize, MPIU_REAL, globalRecords.data(), sizes.data(), offsets.data(), MPIU_REAL, comm) >> testErrorChecker;
+
+        std::vector<ParticleRecord> records(globalRecords.size() / 3);
+        for (std::size_t p = 0; p < records.size(); ++p) {
+            records[p] = {globalRecords[p * 3], globalRecords[p * 3 + 1], globalRecords[p * 3 + 2]};
+        }
+        std::sort(records.begin(), records.end());
+
+        // cleanup
+        DMDestroy(&swarm) >> testErrorChecker;
+        flowObject.reset();
+        if (comm != PETSC_COMM_WORLD) {
+            DMDestroy(&mesh->GetDomain()) >> testErrorChecker;
+        }
+        return records;
+    }
+
+    /**
+     * Checks that every pid is unique
+     */
+    static void AssertUniqueIds(const std::vector<ParticleRecord>& records) {
+        for (std::size_t p = 1; p < records.size(); ++p) {
+            ASSERT_NE(records[p - 1][0], records[p][0]) << "duplicate particle id " << records[p][0];
+        }
+    }
+};
+
+TEST_P(ParticleInitializerTestFixture, ShouldMatchTheSerialBoxLayout) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange a box with points on the shared cell faces (x = 0.5)
+            initializers::BoxInitializer initializer(std::vector<double>{0.05, 0.05}, std::vector<double>{0.95, 0.95}, 9);
+
+            // act
+            auto serial = InitializeParticles(PETSC_COMM_SELF, initializer);
+            auto parallel = InitializeParticles(PETSC_COMM_WORLD, initializer);
+
+            // assert that each box point is created exactly once with the same id and location as in serial
+            ASSERT_EQ(serial.size(), 81u);
+            ASSERT_EQ(parallel.size(), serial.size());
+            AssertUniqueIds(parallel);
+            for (std::size_t p = 0; p < serial.size(); ++p) {
+                ASSERT_EQ(parallel[p][0], serial[p][0]) << "for particle " << p;
+                ASSERT_NEAR(parallel[p][1], serial[p][1], 1E-12) << "for particle " << parallel[p][0];
+                ASSERT_NEAR(parallel[p][2], serial[p][2], 1E-12) << "for particle " << parallel[p][0];
+            }
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+TEST_P(ParticleInitializerTestFixture, ShouldMatchTheSerialCellLayout) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange
+            const PetscInt particlesPerCell = 3;
+            initializers::CellInitializer initializer(particlesPerCell);
+
+            // act
+            auto serial = InitializeParticles(PETSC_COMM_SELF, initializer);
+            auto parallel = InitializeParticles(PETSC_COMM_WORLD, initializer);
+
+            // assert that every owned cell creates its particles exactly once
+            const std::size_t expectedNumber = faces[0] * faces[1] * particlesPerCell;
+            ASSERT_EQ(serial.size(), expectedNumber);
+            ASSERT_EQ(parallel.size(), expectedNumber);
+            AssertUniqueIds(parallel);
+            for (std::size_t p = 0; p < parallel.size(); ++p) {
+                ASSERT_EQ(parallel[p][0], serial[p][0]) << "the ids are not contiguous";
+            }
+
+            // the ids follow the global cell numbering, which depends upon the partition, but the particle locations do not
+            const auto byLocation = [](const ParticleRecord& a, const ParticleRecord& b) { return std::make_pair(a[1], a[2]) < std::make_pair(b[1], b[2]); };
+            std::sort(serial.begin(), serial.end(), byLocation);
+            std::sort(parallel.begin(), parallel.end(), byLocation);
+            for (std::size_t p = 0; p < serial.size(); ++p) {
+                ASSERT_NEAR(parallel[p][1], serial[p][1], 1E-12) << "for particle " << p;
+                ASSERT_NEAR(parallel[p][2], serial[p][2], 1E-12) << "for particle " << p;
+            }
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(ParticleInitializerTests, ParticleInitializerTestFixture,
+                         testing::Values((testingResources::MpiTestParameter){.testName = "initializer 1 rank", .nproc = 1, .expectedOutputFile = "", .arguments = ""},
+                                         (testingResources::MpiTestParameter){.testName = "initializer 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""},
+                                         (testingResources::MpiTestParameter){.testName = "initializer 4 ranks", .nproc = 4, .expectedOutputFile = "", .arguments = ""}),
+                         [](const testing::TestParamInfo<testingResources::MpiTestParameter>& info) { return info.getTestName(); });
@@ -0,0 +1,399 @@
+#include <petsc.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "eos/perfectGas.hpp"
+#include "flow/boundaryConditions/essentialGhost.hpp"
+#include "flow/compressibleFlow.hpp"
+#include "gtest/gtest.h"
+#include "mathFunctions/functionFactory.hpp"
+#include "mesh/boxMesh.hpp"
+#include "parameters/mapParameters.hpp"
+#include "particles/initializers/boxInitializer.hpp"
+#include "particles/injectors/boundaryInjector.hpp"
+#include "particles/injectors/boxInjector.hpp"
+#include "particles/injectors/pointInjector.hpp"
+#include "particles/tracer.hpp"
+
+using namespace ablate;
+
+/**
+ * Creates a compressible flow with a uniform state that is kept by the ghost boundary
+ */
+static std::shared_ptr<ablate::flow::CompressibleFlow> CreateUniformFlow(std::shared_ptr<ablate::mesh::Mesh> mesh, std::vector<double> state) {
+    const auto dim = state.size() - 2;
+    auto parameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"cfl", "0.5"}, {"mu", "0.0"}, {"k", "0.0"}});
+    auto eos = std::make_shared<ablate::eos::PerfectGas>(std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"gamma", "1.4"}, {"Rgas", "287"}}));
+    auto uniformFlow = mathFunctions::Create(state);
+    std::vector<int> walls;
+    for (std::size_t w = 1; w <= 2 * dim; ++w) {
+        walls.push_back((int)w);
+    }
+    return std::make_shared<ablate::flow::CompressibleFlow>(
+        "testFlow",
+        mesh,
+        eos,
+        parameters,
+        nullptr,
+        nullptr,
+        std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{std::make_shared<mathFunctions::FieldSolution>("euler", uniformFlow)},
+        std::vector<std::shared_ptr<flow::boundaryConditions::BoundaryCondition>>{std::make_shared<flow::boundaryConditions::EssentialGhost>("euler", "walls", walls, uniformFlow)});
+}
+
+/**
+ * Creates the flow ts stepping with a fixed dt
+ */
+static TS CreateTS(PetscReal dt, PetscInt steps) {
+    TS ts;
+    TSCreate(PETSC_COMM_WORLD, &ts) >> testErrorChecker;
+    TSSetProblemType(ts, TS_NONLINEAR) >> testErrorChecker;
+    TSSetType(ts, TSEULER) >> testErrorChecker;
+    TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP) >> testErrorChecker;
+    TSSetTimeStep(ts, dt) >> testErrorChecker;
+    TSSetMaxSteps(ts, steps) >> testErrorChecker;
+    return ts;
+}
+
+/**
+ * Gathers the coordinates of the local particles with a particle id of at least firstId
+ */
+static std::vector<std::vector<PetscReal>> GetParticles(DM swarm, PetscInt dim, PetscInt64 firstId, std::vector<PetscInt64>& ids) {
+    std::vector<std::vector<PetscReal>> particles;
+    PetscInt np;
+    DMSwarmGetLocalSize(swarm, &np) >> testErrorChecker;
+    const PetscReal* coordinates;
+    const PetscInt64* pid;
+    DMSwarmGetField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+    DMSwarmGetField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+    for (PetscInt p = 0; p < np; ++p) {
+        if (pid[p] >= firstId) {
+            particles.emplace_back(coordinates + p * dim, coordinates + (p + 1) * dim);
+            ids.push_back(pid[p]);
+        }
+    }
+    DMSwarmRestoreField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+    DMSwarmRestoreField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+    return particles;
+}
+
+struct ParticleInjectorParameters {
+    testingResources::MpiTestParameter mpiTestParameter;
+    std::function<std::shared_ptr<ablate::particles::injectors::Injector>(double rate)> createInjector;
+    // returns true if the point is inside of the injection region
+    std::function<bool(const std::vector<PetscReal>&)> insideRegion;
+    // returns true if the point is in the first half (by measure) of the injection region
+    std::function<bool(const std::vector<PetscReal>&)> firstHalf;
+};
+
+class ParticleInjectorTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<ParticleInjectorParameters> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam().mpiTestParameter); }
+};
+
+TEST_P(ParticleInjectorTestFixture, ShouldInjectTheRateInsideTheRegion) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+            const auto& params = GetParam();
+
+            // arrange
+            // 15.5 particles are injected each step, so 155 particles over 10 steps
+            const PetscReal dt = 1.0 / 64.0;
+            TS ts = CreateTS(dt, 10);
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+                "mesh", std::vector<int>{10, 10}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{} /*boundary*/, false /*simplex*/);
+            auto flowObject = CreateUniformFlow(mesh, {1.0, 2.5, 0.0, 0.0});
+            flowObject->CompleteProblemSetup(ts);
+
+            // a single initial particle (id 0) in the center, the injected particles are numbered after it
+            auto initializer = std::make_shared<ablate::particles::initializers::BoxInitializer>(std::vector<double>{0.5, 0.5}, std::vector<double>{0.5, 0.5}, 1);
+            auto particles = std::make_shared<ablate::particles::Tracer>(
+                "particle", 2, initializer, nullptr, nullptr, 0, "", std::vector<std::shared_ptr<particles::injectors::Injector>>{params.createInjector(15.5 / dt)});
+            particles->InitializeFlow(flowObject);
+            TSSetFromOptions(ts) >> testErrorChecker;
+
+            // act
+            TSSolve(ts, flowObject->GetSolutionVector()) >> testErrorChecker;
+
+            // assert
+            std::vector<PetscInt64> ids;
+            auto injected = GetParticles(particles->GetDM(), 2, 1, ids);
+            PetscInt localFirstHalf = 0;
+            for (std::size_t p = 0; p < injected.size(); ++p) {
+                ASSERT_TRUE(params.insideRegion(injected[p])) << "particle " << ids[p] << " at (" << injected[p][0] << ", " << injected[p][1] << ") is outside of the region";
+                localFirstHalf += params.firstHalf(injected[p]) ? 1 : 0;
+            }
+
+            // every injection index is used exactly once over all ranks
+            PetscInt64 localSums[3] = {(PetscInt64)injected.size(), 0, 0}, sums[3];
+            PetscInt64 localMaxId = 0, maxId;
+            for (const auto id : ids) {
+                localSums[1] += id;
+                localSums[2] += id * id;
+                localMaxId = PetscMax(localMaxId, id);
+            }
+            MPIU_Allreduce(localSums, sums, 3, MPIU_INT64, MPI_SUM, PETSC_COMM_WORLD) >> testErrorChecker;
+            MPIU_Allreduce(&localMaxId, &maxId, 1, MPIU_INT64, MPI_MAX, PETSC_COMM_WORLD) >> testErrorChecker;
+            ASSERT_EQ(sums[0], 155) << "the injected particles should match the rate";
+            ASSERT_EQ(maxId, 155);
+            ASSERT_EQ(sums[1], 155 * 156 / 2) << "the particle ids should be unique";
+            ASSERT_EQ(sums[2], 155 * 156 * 311 / 6) << "the particle ids should be unique";
+
+            // the particles are spread evenly over the region
+            PetscInt firstHalf;
+            MPIU_Allreduce(&localFirstHalf, &firstHalf, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD) >> testErrorChecker;
+            ASSERT_NEAR(firstHalf, 155 / 2.0, 0.1 * 155) << "the particles should be uniformly distributed";
+
+            // cleanup
+            particles.reset();
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+static const std::string injectorArguments = "-dm_plex_separate_marker -automaticTimeStepCalculator false";
+
+static std::function<std::shared_ptr<ablate::particles::injectors::Injector>(double)> boxInjector = [](double rate) {
+    return std::make_shared<ablate::particles::injectors::BoxInjector>(rate, std::vector<double>{0.2, 0.1}, std::vector<double>{0.7, 0.9});
+};
+static std::function<std::shared_ptr<ablate::particles::injectors::Injector>(double)> pointInjector = [](double rate) {
+    return std::make_shared<ablate::particles::injectors::PointInjector>(rate, std::vector<double>{0.45, 0.55}, 0.3);
+};
+static std::function<std::shared_ptr<ablate::particles::injectors::Injector>(double)> boundaryInjector = [](double rate) {
+    // the bottom (1) and top (3) walls
+    return std::make_shared<ablate::particles::injectors::BoundaryInjector>(rate, std::vector<int>{1, 3});
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    ParticleInjectorTests, ParticleInjectorTestFixture,
+    testing::Values(
+        (ParticleInjectorParameters){.mpiTestParameter = {.testName = "box injector", .nproc = 1, .expectedOutputFile = "", .arguments = injectorArguments},
+                                     .createInjector = boxInjector,
+                                     .insideRegion = [](const std::vector<PetscReal>& x) { return x[0] >= 0.2 && x[0] <= 0.7 && x[1] >= 0.1 && x[1] <= 0.9; },
+                                     .firstHalf = [](const std::vector<PetscReal>& x) { return x[0] < 0.45; }},
+        (ParticleInjectorParameters){.mpiTestParameter = {.testName = "box injector 3 ranks", .nproc = 3, .expectedOutputFile = "", .arguments = injectorArguments},
+                                     .createInjector = boxInjector,
+                                     .insideRegion = [](const std::vector<PetscReal>& x) { return x[0] >= 0.2 && x[0] <= 0.7 && x[1] >= 0.1 && x[1] <= 0.9; },
+                                     .firstHalf = [](const std::vector<PetscReal>& x) { return x[1] < 0.5; }},
+        (ParticleInjectorParameters){.mpiTestParameter = {.testName = "point injector", .nproc = 1, .expectedOutputFile = "", .arguments = injectorArguments},
+                                     .createInjector = pointInjector,
+                                     .insideRegion = [](const std::vector<PetscReal>& x) { return PetscSqr(x[0] - 0.45) + PetscSqr(x[1] - 0.55) <= 0.09 + 1E-12; },
+                                     .firstHalf = [](const std::vector<PetscReal>& x) { return PetscSqr(x[0] - 0.45) + PetscSqr(x[1] - 0.55) < 0.045; }},
+        (ParticleInjectorParameters){.mpiTestParameter = {.testName = "point injector 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = injectorArguments},
+                                     .createInjector = pointInjector,
+                                     .insideRegion = [](const std::vector<PetscReal>& x) { return PetscSqr(x[0] - 0.45) + PetscSqr(x[1] - 0.55) <= 0.09 + 1E-12; },
+                                     .firstHalf = [](const std::vector<PetscReal>& x) { return x[0] < 0.45; }},
+        (ParticleInjectorParameters){.mpiTestParameter = {.testName = "boundary injector", .nproc = 1, .expectedOutputFile = "", .arguments = injectorArguments},
+                                     .createInjector = boundaryInjector,
+                                     .insideRegion = [](const std::vector<PetscReal>& x) { return x[1] < 1E-6 || x[1] > 1.0 - 1E-6; },
+                                     .firstHalf = [](const std::vector<PetscReal>& x) { return x[1] < 0.5; }},
+        (ParticleInjectorParameters){.mpiTestParameter = {.testName = "boundary injector 3 ranks", .nproc = 3, .expectedOutputFile = "", .arguments = injectorArguments},
+                                     .createInjector = boundaryInjector,
+                                     .insideRegion = [](const std::vector<PetscReal>& x) { return x[1] < 1E-6 || x[1] > 1.0 - 1E-6; },
+                                     .firstHalf = [](const std::vector<PetscReal>& x) { return x[0] < 0.5; }}),
+    [](const testing::TestParamInfo<ParticleInjectorParameters>& info) { return info.param.mpiTestParameter.getTestName(); });
+
+class ParticleInjectorAreaTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<testingResources::MpiTestParameter> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam()); }
+};
+
+TEST_P(ParticleInjectorAreaTestFixture, ShouldInjectUniformlyOverQuadrilateralFaces) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange
+            const PetscReal dt = 1.0 / 64.0;
+            const PetscInt numberInjected = 30000;
+            TS ts = CreateTS(dt, 1);
+
+            // stretch the unit cube (y -> y (1 + 3x)) so the bottom faces are trapezoids
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+                "mesh", std::vector<int>{2, 2, 2}, std::vector<double>{0.0, 0.0, 0.0}, std::vector<double>{1.0, 1.0, 1.0}, std::vector<std::string>{} /*boundary*/, false /*simplex*/);
+            {
+                Vec coordinates;
+                DMGetCoordinatesLocal(mesh->GetDomain(), &coordinates) >> testErrorChecker;
+                PetscInt size;
+                PetscScalar* coordinateArray;
+                VecGetLocalSize(coordinates, &size) >> testErrorChecker;
+                VecGetArray(coordinates, &coordinateArray) >> testErrorChecker;
+                for (PetscInt v = 0; v < size / 3; ++v) {
+                    coordinateArray[v * 3 + 1] *= 1.0 + 3.0 * coordinateArray[v * 3];
+                }
+                VecRestoreArray(coordinates, &coordinateArray) >> testErrorChecker;
+                DMSetCoordinatesLocal(mesh->GetDomain(), coordinates) >> testErrorChecker;
+            }
+            auto flowObject = CreateUniformFlow(mesh, {1.0, 2.5, 0.0, 0.0, 0.0});
+            flowObject->CompleteProblemSetup(ts);
+
+            auto initializer = std::make_shared<ablate::particles::initializers::BoxInitializer>(std::vector<double>{0.5, 0.5, 0.5}, std::vector<double>{0.5, 0.5, 0.5}, 1);
+            auto injector = std::make_shared<ablate::particles::injectors::BoundaryInjector>(numberInjected / dt, std::vector<int>{1, 2, 3, 4, 5, 6});
+            auto particles = std::make_shared<ablate::particles::Tracer>(
+                "particle", 3, initializer, nullptr, nullptr, 0, "", std::vector<std::shared_ptr<particles::injectors::Injector>>{injector});
+            particles->InitializeFlow(flowObject);
+            TSSetFromOptions(ts) >> testErrorChecker;
+
+            // act
+            TSSolve(ts, flowObject->GetSolutionVector()) >> testErrorChecker;
+
+            // assert
+            std::vector<PetscInt64> ids;
+            auto injected = GetParticles(particles->GetDM(), 3, 1, ids);
+            PetscInt localCounts[3] = {(PetscInt)injected.size(), 0, 0};
+            for (const auto& x : injected) {
+                if (x[2] < 1E-6) {
+                    localCounts[1]++;
+                    localCounts[2] += x[0] < 0.25 ? 1 : 0;
+                }
+            }
+            PetscInt counts[3];
+            MPIU_Allreduce(localCounts, counts, 3, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD) >> testErrorChecker;
+            ASSERT_EQ(counts[0], numberInjected);
+
+            // the bottom is 2.5 of the 11 + sqrt(10) total area
+            const PetscReal totalArea = 11.0 + PetscSqrtReal(10.0);
+            ASSERT_NEAR(counts[1] / (PetscReal)numberInjected, 2.5 / totalArea, 0.015) << "the particles should be distributed by the face area";
+
+            // the area with x < 0.25 is 0.34375 of the 2.5 bottom area (sampling the bilinear face coordinates would give 0.4375)
+            ASSERT_NEAR(counts[2] / (PetscReal)counts[1], 0.34375 / 2.5, 0.015) << "the particles should be uniformly distributed over each face";
+
+            // cleanup
+            particles.reset();
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(ParticleInjectorTests, ParticleInjectorAreaTestFixture,
+                         testing::Values((testingResources::MpiTestParameter){.testName = "quadrilateral faces", .nproc = 1, .expectedOutputFile = "", .arguments = injectorArguments},
+                                         (testingResources::MpiTestParameter){
+                                             .testName = "quadrilateral faces 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = injectorArguments}),
+                         [](const testing::TestParamInfo<testingResources::MpiTestParameter>& info) { return info.getTestName(); });
+
+class ParticleInjectorFlowTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<testingResources::MpiTestParameter> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam()); }
+
+   protected:
+    /**
+     * Records each distinct address of the local swarm coordinate storage
+     */
+    static PetscErrorCode MonitorStorage(TS ts, PetscInt steps, PetscReal time, Vec u, void* ctx) {
+        PetscFunctionBeginUser;
+        auto monitorContext = (std::pair<ablate::particles::Particles*, std::set<void*>>*)ctx;
+        PetscReal* coordinates;
+        DMSwarmGetField(monitorContext->first->GetDM(), DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+        monitorContext->second.insert(coordinates);
+        DMSwarmRestoreField(monitorContext->first->GetDM(), DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+        PetscFunctionReturn(0);
+    }
+};
+
+TEST_P(ParticleInjectorFlowTestFixture, ShouldReuseTheSwarmStorage) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange
+            // 10 particles are injected each step
+            const PetscReal dt = 1.0 / 64.0;
+            TS ts = CreateTS(dt, 20);
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+                "mesh", std::vector<int>{10, 10}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{} /*boundary*/, false /*simplex*/);
+            auto flowObject = CreateUniformFlow(mesh, {1.0, 2.5, 0.0, 0.0});
+            flowObject->CompleteProblemSetup(ts);
+
+            auto initializer = std::make_shared<ablate::particles::initializers::BoxInitializer>(std::vector<double>{0.5, 0.5}, std::vector<double>{0.5, 0.5}, 1);
+            auto injector = std::make_shared<ablate::particles::injectors::BoxInjector>(10.0 / dt, std::vector<double>{0.1, 0.1}, std::vector<double>{0.9, 0.9});
+            auto particles = std::make_shared<ablate::particles::Tracer>(
+                "particle", 2, initializer, nullptr, nullptr, 0, "", std::vector<std::shared_ptr<particles::injectors::Injector>>{injector});
+            particles->InitializeFlow(flowObject);
+
+            std::pair<ablate::particles::Particles*, std::set<void*>> monitorContext(particles.get(), {});
+            TSMonitorSet(ts, MonitorStorage, &monitorContext, NULL) >> testErrorChecker;
+            TSSetFromOptions(ts) >> testErrorChecker;
+
+            // act
+            TSSolve(ts, flowObject->GetSolutionVector()) >> testErrorChecker;
+
+            // assert
+            PetscInt globalNp;
+            DMSwarmGetSize(particles->GetDM(), &globalNp) >> testErrorChecker;
+            ASSERT_EQ(globalNp, 201);
+
+            // the initial storage and the storage grown by the first injection, which has room for every later injection
+            ASSERT_LE(monitorContext.second.size(), 2) << "the swarm storage should only grow once";
+
+            // cleanup
+            particles.reset();
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+TEST_P(ParticleInjectorFlowTestFixture, ShouldRemoveTheParticlesLeavingTheDomain) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange
+            // 2 particles are injected each step at the inflow, and take 143 steps to cross the domain
+            const PetscReal dt = 1.0 / 64.0;
+            const PetscReal velocity = 0.45;
+            TS ts = CreateTS(dt, 200);
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+                "mesh", std::vector<int>{10, 10}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{} /*boundary*/, false /*simplex*/);
+            auto flowObject = CreateUniformFlow(mesh, {1.0, 2.5 + 0.5 * velocity * velocity, velocity, 0.0});
+            flowObject->CompleteProblemSetup(ts);
+
+            // the left (4) wall
+            auto initializer = std::make_shared<ablate::particles::initializers::BoxInitializer>(std::vector<double>{0.5, 0.5}, std::vector<double>{0.5, 0.5}, 1);
+            auto injector = std::make_shared<ablate::particles::injectors::BoundaryInjector>(2.0 / dt, std::vector<int>{4});
+            auto particles = std::make_shared<ablate::particles::Tracer>(
+                "particle", 2, initializer, nullptr, nullptr, 0, "", std::vector<std::shared_ptr<particles::injectors::Injector>>{injector}, true);
+            particles->InitializeFlow(flowObject);
+            TSSetFromOptions(ts) >> testErrorChecker;
+
+            // act
+            TSSolve(ts, flowObject->GetSolutionVector()) >> testErrorChecker;
+
+            // assert
+            // only the particles injected over the last crossing time (and not the initial particle) remain
+            PetscInt globalNp;
+            DMSwarmGetSize(particles->GetDM(), &globalNp) >> testErrorChecker;
+            ASSERT_GE(globalNp, 2 * 141);
+            ASSERT_LE(globalNp, 2 * 145);
+
+            std::vector<PetscInt64> ids;
+            auto remaining = GetParticles(particles->GetDM(), 2, 0, ids);
+            for (std::size_t p = 0; p < remaining.size(); ++p) {
+                ASSERT_GT(ids[p], 0) << "the initial particle should have left the domain";
+                ASSERT_GE(remaining[p][0], 0.0);
+                ASSERT_LE(remaining[p][0], 1.0) << "particle " << ids[p] << " should have been removed";
+                ASSERT_NEAR(remaining[p][0], velocity * dt * PetscRoundReal(remaining[p][0] / (velocity * dt)), 1E-5) << "particle " << ids[p] << " should move with the flow";
+            }
+
+            // cleanup
+            particles.reset();
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(ParticleInjectorTests, ParticleInjectorFlowTestFixture,
+                         testing::Values((testingResources::MpiTestParameter){.testName = "injection", .nproc = 1, .expectedOutputFile = "", .arguments = injectorArguments},
+                                         (testingResources::MpiTestParameter){.testName = "injection 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = injectorArguments}),
+                         [](const testing::TestParamInfo<testingResources::MpiTestParameter>& info) { return info.getTestName(); });
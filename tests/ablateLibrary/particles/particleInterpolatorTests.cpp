@@ -0,0 +1,397 @@
+#include <petsc.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "eos/perfectGas.hpp"
+#include "flow/compressibleFlow.hpp"
+#include "gtest/gtest.h"
+#include "mathFunctions/functionFactory.hpp"
+#include "mesh/boxMesh.hpp"
+#include "parameters/mapParameters.hpp"
+#include "particles/particleInterpolator.hpp"
+
+/**
+ * Quasi random points spread over the inside of the unit square
+ */
+static std::vector<PetscReal> CreatePoints(PetscInt np) {
+    std::vector<PetscReal> coordinates(np * 2);
+    for (PetscInt p = 0; p < np; ++p) {
+        coordinates[p * 2] = 0.01 + 0.98 * std::fmod(0.5 + 0.754877666 * (p + 1), 1.0);
+        coordinates[p * 2 + 1] = 0.01 + 0.98 * std::fmod(0.5 + 0.569840296 * (p + 1), 1.0);
+    }
+    return coordinates;
+}
+
+struct ParticleInterpolatorParameters {
+    testingResources::MpiTestParameter mpiTestParameter;
+    bool simplex;
+    bool finiteVolume;
+};
+
+class ParticleInterpolatorTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<ParticleInterpolatorParameters> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam().mpiTestParameter); }
+
+   protected:
+    /**
+     * Adds a two component field to the dm and returns a global vector holding the linear field (evaluated at the centroid for finite volume fields)
+     */
+    Vec CreateLinearField(DM dm, bool simplex, bool finiteVolume) {
+        if (finiteVolume) {
+            PetscFV fv;
+            PetscFVCreate(PETSC_COMM_WORLD, &fv) >> testErrorChecker;
+            PetscFVSetNumComponents(fv, 2) >> testErrorChecker;
+            PetscFVSetSpatialDimension(fv, 2) >> testErrorChecker;
+            DMAddField(dm, NULL, (PetscObject)fv) >> testErrorChecker;
+            PetscFVDestroy(&fv) >> testErrorChecker;
+        } else {
+            PetscFE fe;
+            PetscFECreateDefault(PETSC_COMM_WORLD, 2, 2, simplex ? PETSC_TRUE : PETSC_FALSE, "interp_", PETSC_DEFAULT, &fe) >> testErrorChecker;
+            DMAddField(dm, NULL, (PetscObject)fe) >> testErrorChecker;
+            PetscFEDestroy(&fe) >> testErrorChecker;
+        }
+        DMCreateDS(dm) >> testErrorChecker;
+
+        Vec source;
+        DMCreateGlobalVector(dm, &source) >> testErrorChecker;
+        if (finiteVolume) {
+            PetscInt cStart, cEnd;
+            DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd) >> testErrorChecker;
+            PetscScalar* sourceArray;
+            VecGetArray(source, &sourceArray) >> testErrorChecker;
+            for (PetscInt c = cStart; c < cEnd; ++c) {
+                PetscReal volume, centroid[3];
+                DMPlexComputeCellGeometryFVM(dm, c, &volume, centroid, NULL) >> testErrorChecker;
+                PetscScalar* values = NULL;
+                DMPlexPointGlobalRef(dm, c, sourceArray, &values) >> testErrorChecker;
+                if (values) {
+                    LinearField(centroid, values);
+                }
+            }
+            VecRestoreArray(source, &sourceArray) >> testErrorChecker;
+        } else {
+            PetscErrorCode (*functions[1])(PetscInt, PetscReal, const PetscReal[], PetscInt, PetscScalar*, void*) = {LinearFieldFunction};
+            DMProjectFunction(dm, 0.0, functions, NULL, INSERT_ALL_VALUES, source) >> testErrorChecker;
+        }
+        return source;
+    }
+
+    /**
+     * A linear field that is reproduced exactly by a linear element
+     */
+    static void LinearField(const PetscReal* x, PetscScalar* u) {
+        u[0] = 1.0 + 2.0 * x[0] + 3.0 * x[1];
+        u[1] = 4.0 - x[0] + 0.5 * x[1];
+    }
+
+    static PetscErrorCode LinearFieldFunction(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nf, PetscScalar* u, void* ctx) {
+        LinearField(x, u);
+        return 0;
+    }
+};
+
+TEST_P(ParticleInterpolatorTestFixture, ShouldLocateAndInterpolateWithAnyHint) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+            const auto& params = GetParam();
+
+            // arrange
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>("mesh", std::vector<int>{5, 4}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{}, params.simplex);
+            DM dm = mesh->GetDomain();
+            Vec source = CreateLinearField(dm, params.simplex, params.finiteVolume);
+            auto interpolator = std::make_shared<ablate::particles::ParticleInterpolator>(dm, 0, source);
+            interpolator->Advance(0.0);
+
+            const PetscInt np = 64;
+            auto coordinates = CreatePoints(np);
+
+            // the expected cell of each point from a full search
+            Vec pointVec;
+            VecCreateSeqWithArray(PETSC_COMM_SELF, 2, np * 2, coordinates.data(), &pointVec) >> testErrorChecker;
+            PetscSF cellSF = NULL;
+            DMLocatePoints(dm, pointVec, DM_POINTLOCATION_NONE, &cellSF) >> testErrorChecker;
+            const PetscSFNode* foundCells;
+            PetscSFGetGraph(cellSF, NULL, NULL, NULL, &foundCells) >> testErrorChecker;
+            std::vector<PetscInt> expectedCells(np);
+            for (PetscInt p = 0; p < np; ++p) {
+                expectedCells[p] = foundCells[p].index >= 0 ? foundCells[p].index : -1;
+            }
+            PetscSFDestroy(&cellSF) >> testErrorChecker;
+            VecDestroy(&pointVec) >> testErrorChecker;
+
+            // no hints, a poor hint (the first cell), and the hints found by the previous call
+            std::vector<PetscInt> cells(np, -1);
+            std::vector<PetscReal> values(np * 2);
+            for (const auto& hint : {"none", "first", "previous"}) {
+                if (std::string(hint) == "none") {
+                    std::fill(cells.begin(), cells.end(), -1);
+                } else if (std::string(hint) == "first") {
+                    std::fill(cells.begin(), cells.end(), interpolator->GetCellStart());
+                }
+
+                // act
+                interpolator->Interpolate(0.0, np, coordinates.data(), 2, cells.data(), values.data());
+
+                // assert
+                for (PetscInt p = 0; p < np; ++p) {
+                    ASSERT_EQ(cells[p], expectedCells[p]) << "for point " << p << " with the " << hint << " hint";
+                    PetscScalar expected[2] = {0.0, 0.0};
+                    if (cells[p] >= 0) {
+                        // the finite volume field is constant in each cell
+                        LinearField(params.finiteVolume ? interpolator->GetCentroid(cells[p]) : &coordinates[p * 2], expected);
+                    }
+                    for (PetscInt c = 0; c < 2; ++c) {
+                        ASSERT_NEAR(values[p * 2 + c], PetscRealPart(expected[c]), 1E-10) << "for point " << p << " component " << c << " with the " << hint << " hint";
+                    }
+                }
+            }
+
+            // every point is located on exactly one rank
+            PetscInt localLocated = (PetscInt)std::count_if(cells.begin(), cells.end(), [](PetscInt cell) { return cell >= 0; });
+            PetscInt globalLocated;
+            MPIU_Allreduce(&localLocated, &globalLocated, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD) >> testErrorChecker;
+            ASSERT_EQ(globalLocated, np);
+
+            // cleanup
+            interpolator.reset();
+            VecDestroy(&source) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+TEST_P(ParticleInterpolatorTestFixture, ShouldInterpolateLinearlyInTime) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+            const auto& params = GetParam();
+
+            // arrange
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>("mesh", std::vector<int>{5, 4}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{}, params.simplex);
+            DM dm = mesh->GetDomain();
+            Vec source = CreateLinearField(dm, params.simplex, params.finiteVolume);
+            auto interpolator = std::make_shared<ablate::particles::ParticleInterpolator>(dm, 0, source);
+
+            // the field is f at t = 1 and 3f at t = 2
+            interpolator->Advance(1.0);
+            VecScale(source, 3.0) >> testErrorChecker;
+            interpolator->Advance(2.0);
+
+            const PetscInt np = 64;
+            auto coordinates = CreatePoints(np);
+            std::vector<PetscInt> cells(np, -1);
+            std::vector<PetscReal> values(np * 2);
+
+            // the time is limited to the window
+            for (const auto& [time, scale] : std::vector<std::pair<PetscReal, PetscReal>>{{1.0, 1.0}, {1.25, 1.5}, {1.5, 2.0}, {2.0, 3.0}, {0.0, 1.0}, {5.0, 3.0}}) {
+                // act
+                interpolator->Interpolate(time, np, coordinates.data(), 2, cells.data(), values.data());
+
+                // assert
+                for (PetscInt p = 0; p < np; ++p) {
+                    PetscScalar expected[2] = {0.0, 0.0};
+                    if (cells[p] >= 0) {
+                        LinearField(params.finiteVolume ? interpolator->GetCentroid(cells[p]) : &coordinates[p * 2], expected);
+                    }
+                    for (PetscInt c = 0; c < 2; ++c) {
+                        ASSERT_NEAR(values[p * 2 + c], scale * PetscRealPart(expected[c]), 1E-10) << "for point " << p << " component " << c << " at time " << time;
+                    }
+                }
+            }
+
+            // cleanup
+            interpolator.reset();
+            VecDestroy(&source) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+TEST_P(ParticleInterpolatorTestFixture, ShouldInterpolateAnyNumberOfPointsBetweenCalls) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+            const auto& params = GetParam();
+
+            // arrange
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>("mesh", std::vector<int>{5, 4}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{}, params.simplex);
+            DM dm = mesh->GetDomain();
+            Vec source = CreateLinearField(dm, params.simplex, params.finiteVolume);
+            auto interpolator = std::make_shared<ablate::particles::ParticleInterpolator>(dm, 0, source);
+            interpolator->Advance(0.0);
+
+            // the work held between calls must grow and shrink with the number of points
+            for (PetscInt np : {8, 64, 3, 0, 64}) {
+                auto coordinates = CreatePoints(np);
+                std::vector<PetscInt> cells(np, -1);
+                std::vector<PetscReal> values(np * 2);
+
+                // act
+                interpolator->Interpolate(0.0, np, coordinates.data(), 2, cells.data(), values.data());
+
+                // assert
+                for (PetscInt p = 0; p < np; ++p) {
+                    PetscScalar expected[2] = {0.0, 0.0};
+                    if (cells[p] >= 0) {
+                        LinearField(params.finiteVolume ? interpolator->GetCentroid(cells[p]) : &coordinates[p * 2], expected);
+                    }
+                    for (PetscInt c = 0; c < 2; ++c) {
+                        ASSERT_NEAR(values[p * 2 + c], PetscRealPart(expected[c]), 1E-10) << "for point " << p << " component " << c << " of " << np << " points";
+                    }
+                }
+            }
+
+            // cleanup
+            interpolator.reset();
+            VecDestroy(&source) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ParticleInterpolatorTests, ParticleInterpolatorTestFixture,
+    testing::Values(
+        (ParticleInterpolatorParameters){.mpiTestParameter = {.testName = "fe simplex", .nproc = 1, .expectedOutputFile = "", .arguments = "-interp_petscspace_degree 1"}, .simplex = true, .finiteVolume = false},
+        (ParticleInterpolatorParameters){.mpiTestParameter = {.testName = "fe tensor", .nproc = 1, .expectedOutputFile = "", .arguments = "-interp_petscspace_degree 1"}, .simplex = false, .finiteVolume = false},
+        (ParticleInterpolatorParameters){.mpiTestParameter = {.testName = "fe simplex 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = "-interp_petscspace_degree 1"}, .simplex = true, .finiteVolume = false},
+        (ParticleInterpolatorParameters){.mpiTestParameter = {.testName = "fv tensor", .nproc = 1, .expectedOutputFile = "", .arguments = ""}, .simplex = false, .finiteVolume = true},
+        (ParticleInterpolatorParameters){.mpiTestParameter = {.testName = "fv tensor 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""}, .simplex = false, .finiteVolume = true}),
+    [](const testing::TestParamInfo<ParticleInterpolatorParameters>& info) { return info.param.mpiTestParameter.getTestName(); });
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Shared flow velocity interpolator tests
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class FlowVelocityInterpolatorTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<testingResources::MpiTestParameter> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam()); }
+
+   protected:
+    /**
+     * Creates a uniform periodic compressible flow with the velocity and updates the vel aux field from the solution
+     */
+    static std::shared_ptr<ablate::flow::CompressibleFlow> CreateUniformFlow(TS ts, const std::vector<double>& velocity) {
+        auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+            "mesh", std::vector<int>{5, 4}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{"PERIODIC", "PERIODIC"}, false /*simplex*/);
+        auto eos = std::make_shared<ablate::eos::PerfectGas>(std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"gamma", "1.4"}, {"Rgas", "287"}}));
+        auto parameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"cfl", "0.5"}, {"mu", "0.0"}, {"k", "0.0"}});
+
+        // rho, rhoE, rhoU, rhoV with a density of one and a pressure of one atmosphere
+        const double kineticEnergy = 0.5 * (velocity[0] * velocity[0] + velocity[1] * velocity[1]);
+        auto euler = std::make_shared<ablate::mathFunctions::FieldSolution>("euler", ablate::mathFunctions::Create(std::vector<double>{1.0, 101325.0 / 0.4 + kineticEnergy, velocity[0], velocity[1]}));
+
+        auto flow = std::make_shared<ablate::flow::CompressibleFlow>(
+            "flow", mesh, eos, parameters, nullptr /*fluxCalculator*/, nullptr /*options*/, std::vector<std::shared_ptr<ablate::mathFunctions::FieldSolution>>{euler} /*initialization*/);
+        flow->CompleteProblemSetup(ts);
+        flow->UpdateAuxFieldsFromSolution(0.0, flow->GetSolutionVector());
+        return flow;
+    }
+
+    /**
+     * Interpolates the points with the interpolator and checks each located point against the velocity.  Returns the number of located points.
+     */
+    PetscInt InterpolateUniformVelocity(ablate::particles::ParticleInterpolator& interpolator, const std::vector<PetscReal>& coordinates, const std::vector<double>& velocity) {
+        const auto np = (PetscInt)coordinates.size() / 2;
+        std::vector<PetscInt> cells(np, -1);
+        std::vector<PetscReal> values(np * 2);
+        interpolator.Interpolate(0.0, np, coordinates.data(), 2, cells.data(), values.data());
+
+        PetscInt located = 0;
+        for (PetscInt p = 0; p < np; ++p) {
+            if (cells[p] < 0) {
+                continue;
+            }
+            located++;
+            for (PetscInt c = 0; c < 2; ++c) {
+                EXPECT_NEAR(values[p * 2 + c], velocity[c], 1E-10) << "for point " << p << " component " << c;
+            }
+        }
+        return located;
+    }
+};
+
+TEST_P(FlowVelocityInterpolatorTestFixture, ShouldShareTheVelocityInterpolatorBetweenGroupsOfTheSameFlow) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+            TS ts;
+            TSCreate(PETSC_COMM_WORLD, &ts) >> testErrorChecker;
+            const std::vector<double> velocity = {10.0, -5.0};
+            auto flow = CreateUniformFlow(ts, velocity);
+
+            // act
+            auto firstGroup = ablate::particles::ParticleInterpolator::GetFlowVelocityInterpolator(*flow);
+            auto secondGroup = ablate::particles::ParticleInterpolator::GetFlowVelocityInterpolator(*flow);
+            firstGroup->Advance(0.0);
+            secondGroup->Advance(0.0);
+
+            // assert that both groups share the interpolator and each of their particles sees the flow velocity
+            ASSERT_EQ(firstGroup, secondGroup);
+            PetscInt localLocated[2] = {InterpolateUniformVelocity(*firstGroup, CreatePoints(16), velocity), InterpolateUniformVelocity(*secondGroup, CreatePoints(40), velocity)};
+            PetscInt globalLocated[2];
+            MPIU_Allreduce(localLocated, globalLocated, 2, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD) >> testErrorChecker;
+            ASSERT_EQ(globalLocated[0], 16);
+            ASSERT_EQ(globalLocated[1], 40);
+
+            // cleanup
+            firstGroup.reset();
+            secondGroup.reset();
+            flow.reset();
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+TEST_P(FlowVelocityInterpolatorTestFixture, ShouldNotShareTheVelocityInterpolatorWithANewFlow) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange an interpolator that outlives its flow, so the new flow dm may reuse the address of the old dm
+            TS firstTs;
+            TSCreate(PETSC_COMM_WORLD, &firstTs) >> testErrorChecker;
+            auto firstFlow = CreateUniformFlow(firstTs, {10.0, -5.0});
+            auto firstInterpolator = ablate::particles::ParticleInterpolator::GetFlowVelocityInterpolator(*firstFlow);
+            firstFlow.reset();
+            TSDestroy(&firstTs) >> testErrorChecker;
+
+            TS secondTs;
+            TSCreate(PETSC_COMM_WORLD, &secondTs) >> testErrorChecker;
+            const std::vector<double> velocity = {3.0, 7.0};
+            auto secondFlow = CreateUniformFlow(secondTs, velocity);
+
+            // act
+            auto secondInterpolator = ablate::particles::ParticleInterpolator::GetFlowVelocityInterpolator(*secondFlow);
+            secondInterpolator->Advance(0.0);
+
+            // assert
+            ASSERT_NE(firstInterpolator, secondInterpolator);
+            PetscInt localLocated = InterpolateUniformVelocity(*secondInterpolator, CreatePoints(16), velocity);
+            PetscInt globalLocated;
+            MPIU_Allreduce(&localLocated, &globalLocated, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD) >> testErrorChecker;
+            ASSERT_EQ(globalLocated, 16);
+
+            // cleanup
+            firstInterpolator.reset();
+            secondInterpolator.reset();
+            secondFlow.reset();
+            TSDestroy(&secondTs) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(ParticleInterpolatorTests, FlowVelocityInterpolatorTestFixture,
+                         testing::Values((testingResources::MpiTestParameter){.testName = "flow velocity interpolator", .nproc = 1, .expectedOutputFile = "", .arguments = ""},
+                                         (testingResources::MpiTestParameter){.testName = "flow velocity interpolator 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""}),
+                         [](const testing::TestParamInfo<testingResources::MpiTestParameter>& info) { return info.getTestName(); });
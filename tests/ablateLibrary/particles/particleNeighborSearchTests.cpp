@@ -0,0 +1,247 @@
+#include <petsc.h>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "eos/perfectGas.hpp"
+#include "flow/compressibleFlow.hpp"
+#include "gtest/gtest.h"
+#include "mathFunctions/functionFactory.hpp"
+#include "mesh/boxMesh.hpp"
+#include "parameters/mapParameters.hpp"
+#include "particles/inertial.hpp"
+#include "particles/initializers/cellInitializer.hpp"
+#include "particles/particleNeighborSearch.hpp"
+
+using namespace ablate;
+
+/**
+ * Random points in the cube [lower, lower + size)^dim, with a few repeated points
+ */
+static std::vector<PetscReal> CreatePoints(PetscInt dim, PetscInt np, PetscReal lower, PetscReal size, unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<PetscReal> distribution(lower, lower + size);
+    std::vector<PetscReal> points(np * dim);
+    for (auto& x : points) {
+        x = distribution(generator);
+    }
+    for (PetscInt p = 0; p < np / 10; ++p) {
+        std::copy(&points[p * dim], &points[(p + 1) * dim], &points[(np - 1 - p) * dim]);
+    }
+    return points;
+}
+
+static PetscReal DistanceSquared(PetscInt dim, const PetscReal* a, const PetscReal* b) {
+    PetscReal distanceSquared = 0.0;
+    for (PetscInt d = 0; d < dim; ++d) {
+        const PetscReal delta = b[d] - a[d];
+        distanceSquared += delta * delta;
+    }
+    return distanceSquared;
+}
+
+TEST(ParticleNeighborSearchTests, ShouldFindTheSamePairsAsBruteForce) {
+    // the dense cases have many points per bin, the sparse cases have many bins sharing hash buckets
+    for (PetscInt dim = 1; dim <= 3; ++dim) {
+        for (const auto& [size, cutoff] : std::vector<std::pair<PetscReal, PetscReal>>{{1.0, 0.15}, {100.0, 5.0}}) {
+            for (const PetscInt nGhost : {0, 50}) {
+                SCOPED_TRACE("dim " + std::to_string(dim) + " size " + std::to_string(size) + " ghosts " + std::to_string(nGhost));
+
+                // arrange
+                const PetscInt np = 300;
+                auto points = CreatePoints(dim, np, -0.3 * size, size, 7 * dim);
+                auto ghostPoints = CreatePoints(dim, nGhost, 0.5 * size, size, 11 * dim);
+                std::vector<PetscReal> allPoints(points);
+                allPoints.insert(allPoints.end(), ghostPoints.begin(), ghostPoints.end());
+
+                std::set<std::pair<PetscInt, PetscInt>> expectedPairs;
+                for (PetscInt i = 0; i < np; ++i) {
+                    for (PetscInt j = i + 1; j < np + nGhost; ++j) {
+                        if (DistanceSquared(dim, &allPoints[i * dim], &allPoints[j * dim]) < cutoff * cutoff) {
+                            expectedPairs.insert({i, j});
+                        }
+                    }
+                }
+
+                ablate::particles::ParticleNeighborSearch neighborSearch;
+                neighborSearch.Build(dim, cutoff, np, points.data(), dim, nGhost, ghostPoints.data());
+
+                // act
+                std::multiset<std::pair<PetscInt, PetscInt>> pairs;
+                neighborSearch.ForEachPair([&](PetscInt i, PetscInt j, PetscReal distanceSquared) {
+                    pairs.insert({i, j});
+                    ASSERT_DOUBLE_EQ(distanceSquared, DistanceSquared(dim, &allPoints[i * dim], &allPoints[j * dim]));
+                });
+
+                // assert
+                ASSERT_GT(expectedPairs.size(), 0) << "the test should have neighbors";
+                ASSERT_EQ(pairs.size(), expectedPairs.size()) << "each pair should be visited once";
+                ASSERT_EQ(std::set<std::pair<PetscInt, PetscInt>>(pairs.begin(), pairs.end()), expectedPairs);
+            }
+        }
+    }
+}
+
+TEST(ParticleNeighborSearchTests, ShouldFindTheSameNeighborsAsBruteForce) {
+    for (PetscInt dim = 1; dim <= 3; ++dim) {
+        SCOPED_TRACE("dim " + std::to_string(dim));
+
+        // arrange
+        const PetscInt np = 200, nGhost = 40, nQuery = 50;
+        const PetscReal cutoff = 0.2;
+        auto points = CreatePoints(dim, np, 0.0, 1.0, 3 * dim);
+        auto ghostPoints = CreatePoints(dim, nGhost, 0.8, 1.0, 5 * dim);
+        auto queryPoints = CreatePoints(dim, nQuery, -0.1, 2.0, 13 * dim);
+        std::vector<PetscReal> allPoints(points);
+        allPoints.insert(allPoints.end(), ghostPoints.begin(), ghostPoints.end());
+
+        ablate::particles::ParticleNeighborSearch neighborSearch;
+        neighborSearch.Build(dim, cutoff, np, points.data(), dim, nGhost, ghostPoints.data());
+
+        for (PetscInt q = 0; q < nQuery; ++q) {
+            const PetscReal* query = &queryPoints[q * dim];
+            std::set<PetscInt> expectedNeighbors;
+            for (PetscInt j = 0; j < np + nGhost; ++j) {
+                if (DistanceSquared(dim, query, &allPoints[j * dim]) < cutoff * cutoff) {
+                    expectedNeighbors.insert(j);
+                }
+            }
+
+            // act
+            std::multiset<PetscInt> neighbors;
+            neighborSearch.ForEachNeighbor(query, [&](PetscInt j, PetscReal) { neighbors.insert(j); });
+
+            // assert
+            ASSERT_EQ(neighbors.size(), expectedNeighbors.size()) << "each neighbor of query " << q << " should be visited once";
+            ASSERT_EQ(std::set<PetscInt>(neighbors.begin(), neighbors.end()), expectedNeighbors) << "for query " << q;
+        }
+    }
+}
+
+class ParticleNeighborSearchTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<testingResources::MpiTestParameter> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam()); }
+};
+
+TEST_P(ParticleNeighborSearchTestFixture, ShouldVisitEveryPairWithTheGhostParticles) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+            const PetscInt dim = 2;
+            const PetscReal cutoff = 0.2;
+
+            // arrange
+            TS ts;
+            TSCreate(PETSC_COMM_WORLD, &ts) >> testErrorChecker;
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+                "mesh", std::vector<int>{6, 6}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{} /*boundary*/, false /*simplex*/);
+            auto parameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"cfl", "0.5"}, {"mu", "0.0"}, {"k", "0.0"}});
+            auto eos = std::make_shared<ablate::eos::PerfectGas>(std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"gamma", "1.4"}, {"Rgas", "287"}}));
+            auto euler = std::make_shared<mathFunctions::FieldSolution>("euler", mathFunctions::Create(std::vector<double>{1.0, 2.5, 0.0, 0.0}));
+            auto flowObject = std::make_shared<ablate::flow::CompressibleFlow>(
+                "testFlow", mesh, eos, parameters, nullptr, nullptr, std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{euler});
+            flowObject->CompleteProblemSetup(ts);
+
+            // random particles with a velocity that is a function of the location (stored in the packed solution)
+            auto particleParameters = std::make_shared<ablate::parameters::MapParameters>(
+                std::map<std::string, std::string>{{"fluidDensity", "1.0"}, {"fluidViscosity", "0.1"}, {"gravityField", "0 0"}});
+            auto fieldInitialization = std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{
+                std::make_shared<mathFunctions::FieldSolution>(ablate::particles::Inertial::ParticleVelocity, mathFunctions::Create("x + 2*y, 3*x - y"))};
+            auto initializer = std::make_shared<ablate::particles::initializers::CellInitializer>(4);
+            auto particles = std::make_shared<ablate::particles::Inertial>("particle", dim, particleParameters, initializer, fieldInitialization, nullptr, nullptr);
+            particles->InitializeFlow(flowObject);
+            DM swarm = particles->GetDM();
+
+            // gather every particle to find the pairs by brute force
+            PetscInt np;
+            DMSwarmGetLocalSize(swarm, &np) >> testErrorChecker;
+            std::vector<PetscInt64> localIds(np);
+            std::vector<PetscReal> localCoordinates(np * dim);
+            {
+                const PetscReal* coordinates;
+                const PetscInt64* pid;
+                DMSwarmGetField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+                DMSwarmGetField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+                std::copy(pid, pid + np, localIds.begin());
+                std::copy(coordinates, coordinates + np * dim, localCoordinates.begin());
+                DMSwarmRestoreField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+                DMSwarmRestoreField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+            }
+            PetscMPIInt size;
+            MPI_Comm_size(PETSC_COMM_WORLD, &size) >> testErrorChecker;
+            std::vector<PetscMPIInt> counts(size), offsets(size + 1, 0), coordinateCounts(size), coordinateOffsets(size, 0);
+            const PetscMPIInt localCount = (PetscMPIInt)np;
+            MPI_Allgather(&localCount, 1, MPI_INT, counts.data(), 1, MPI_INT, PETSC_COMM_WORLD) >> testErrorChecker;
+            for (PetscMPIInt r = 0; r < size; ++r) {
+                offsets[r + 1] = offsets[r] + counts[r];
+                coordinateCounts[r] = counts[r] * dim;
+                coordinateOffsets[r] = offsets[r] * dim;
+            }
+            std::vector<PetscInt64> ids(offsets[size]);
+            std::vector<PetscReal> coordinates(offsets[size] * dim);
+            MPI_Allgatherv(localIds.data(), localCount, MPIU_INT64, ids.data(), counts.data(), offsets.data(), MPIU_INT64, PETSC_COMM_WORLD) >> testErrorChecker;
+            MPI_Allgatherv(localCoordinates.data(), localCount * dim, MPIU_REAL, coordinates.data(), coordinateCounts.data(), coordinateOffsets.data(), MPIU_REAL, PETSC_COMM_WORLD) >>
+                testErrorChecker;
+
+            // the pairs with at least one local particle
+            const std::set<PetscInt64> localIdSet(localIds.begin(), localIds.end());
+            std::set<std::pair<PetscInt64, PetscInt64>> expectedPairs;
+            for (std::size_t i = 0; i < ids.size(); ++i) {
+                for (std::size_t j = i + 1; j < ids.size(); ++j) {
+                    if ((localIdSet.count(ids[i]) || localIdSet.count(ids[j])) && DistanceSquared(dim, &coordinates[i * dim], &coordinates[j * dim]) < cutoff * cutoff) {
+                        expectedPairs.insert({PetscMin(ids[i], ids[j]), PetscMax(ids[i], ids[j])});
+                    }
+                }
+            }
+
+            // act
+            particles->UpdateNeighborSearch(cutoff, {ablate::particles::Inertial::ParticleVelocity});
+
+            // assert
+            const auto& ghostIds = particles->GetGhostParticleIds();
+            std::multiset<std::pair<PetscInt64, PetscInt64>> pairs;
+            particles->ForEachParticlePair([&](PetscInt i, PetscInt j, PetscReal) {
+                const PetscInt64 idI = localIds[i];
+                const PetscInt64 idJ = j < np ? localIds[j] : ghostIds[j - np];
+                pairs.insert({PetscMin(idI, idJ), PetscMax(idI, idJ)});
+            });
+            ASSERT_GT(expectedPairs.size(), 0) << "the test should have neighbors";
+            ASSERT_EQ(pairs.size(), expectedPairs.size()) << "each pair should be visited once on each rank";
+            ASSERT_EQ(std::set<std::pair<PetscInt64, PetscInt64>>(pairs.begin(), pairs.end()), expectedPairs);
+
+            // the ghost particles carry the requested field
+            const auto& neighborSearch = particles->GetNeighborSearch();
+            PetscInt components;
+            const auto& ghostVelocity = particles->GetGhostField(ablate::particles::Inertial::ParticleVelocity, &components);
+            ASSERT_EQ(components, dim);
+            ASSERT_EQ(neighborSearch.GetNumberGhost(), (PetscInt)ghostIds.size());
+            if (size > 1) {
+                PetscInt globalGhosts;
+                PetscInt localGhosts = neighborSearch.GetNumberGhost();
+                MPIU_Allreduce(&localGhosts, &globalGhosts, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD) >> testErrorChecker;
+                ASSERT_GT(globalGhosts, 0) << "the test should have ghost particles";
+            }
+            for (PetscInt g = 0; g < neighborSearch.GetNumberGhost(); ++g) {
+                ASSERT_EQ(localIdSet.count(ghostIds[g]), 0) << "ghost particles should come from other ranks";
+                const PetscReal* x = neighborSearch.GetCoordinates(np + g);
+                ASSERT_NEAR(ghostVelocity[g * dim], x[0] + 2.0 * x[1], 1E-12);
+                ASSERT_NEAR(ghostVelocity[g * dim + 1], 3.0 * x[0] - x[1], 1E-12);
+            }
+
+            // cleanup
+            particles.reset();
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(ParticleNeighborSearchTests, ParticleNeighborSearchTestFixture,
+                         testing::Values((testingResources::MpiTestParameter){.testName = "without ghost particles", .nproc = 1, .expectedOutputFile = "", .arguments = ""},
+                                         (testingResources::MpiTestParameter){.testName = "with ghost particles 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""},
+                                         (testingResources::MpiTestParameter){.testName = "with ghost particles 4 ranks", .nproc = 4, .expectedOutputFile = "", .arguments = ""}),
+                         [](const testing::TestParamInfo<testingResources::MpiTestParameter>& info) { return info.getTestName(); });
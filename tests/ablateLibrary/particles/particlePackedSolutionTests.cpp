@@ -0,0 +1,220 @@
+#include <petsc.h>
+#include <map>
+#include <memory>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "eos/perfectGas.hpp"
+#include "flow/boundaryConditions/essentialGhost.hpp"
+#include "flow/compressibleFlow.hpp"
+#include "gtest/gtest.h"
+#include "mathFunctions/functionFactory.hpp"
+#include "mesh/boxMesh.hpp"
+#include "parameters/mapParameters.hpp"
+#include "particles/inertial.hpp"
+#include "particles/initializers/boxInitializer.hpp"
+
+using namespace ablate;
+
+class ParticlePackedSolutionTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<testingResources::MpiTestParameter> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam()); }
+
+   protected:
+    // the particles move with the uniform flow
+    inline static const PetscReal flowVelocity[2] = {0.5, 0.0};
+
+    struct PackedSolutionContext {
+        ablate::particles::Particles* particles;
+        std::map<PetscInt64, std::vector<PetscReal>> initialCoordinates;
+        PetscInt checkedSteps = 0;
+    };
+
+    /**
+     * Checks that the packed solution of every local particle holds its coordinates followed by its velocity, that the coordinate field matches the packed
+     * coordinates, and that each particle (by pid) is where the uniform flow has carried it
+     */
+    static void CheckPackedSolution(PackedSolutionContext& context, PetscReal time) {
+        DM swarm = context.particles->GetDM();
+        PetscInt np;
+        DMSwarmGetLocalSize(swarm, &np) >> testErrorChecker;
+
+        PetscInt solutionComponents;
+        const PetscReal* packedSolution;
+        const PetscReal* coordinates;
+        const PetscInt64* pid;
+        DMSwarmGetField(swarm, "PackedSolution", &solutionComponents, NULL, (void**)&packedSolution) >> testErrorChecker;
+        DMSwarmGetField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+        DMSwarmGetField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+        if (solutionComponents != 4) {
+            throw std::runtime_error("the packed solution should interleave the coordinates and velocity, found " + std::to_string(solutionComponents) + " components");
+        }
+
+        for (PetscInt p = 0; p < np; ++p) {
+            const auto initial = context.initialCoordinates.find(pid[p]);
+            if (initial == context.initialCoordinates.end()) {
+                throw std::runtime_error("unknown particle id " + std::to_string(pid[p]));
+            }
+            for (PetscInt d = 0; d < 2; ++d) {
+                const PetscReal packedCoordinate = packedSolution[p * solutionComponents + d];
+                const PetscReal packedVelocity = packedSolution[p * solutionComponents + 2 + d];
+                if (packedCoordinate != coordinates[p * 2 + d]) {
+                    throw std::runtime_error("the coordinate field of particle " + std::to_string(pid[p]) + " does not match the packed solution");
+                }
+                if (PetscAbsReal(packedVelocity - flowVelocity[d]) > 1E-10) {
+                    throw std::runtime_error("the packed velocity of particle " + std::to_string(pid[p]) + " is " + std::to_string(packedVelocity));
+                }
+                if (PetscAbsReal(packedCoordinate - (initial->second[d] + flowVelocity[d] * time)) > 1E-10) {
+                    throw std::runtime_error("particle " + std::to_string(pid[p]) + " is not where the flow carried it");
+                }
+            }
+        }
+
+        DMSwarmRestoreField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+        DMSwarmRestoreField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+        DMSwarmRestoreField(swarm, "PackedSolution", NULL, NULL, (void**)&packedSolution) >> testErrorChecker;
+    }
+
+    /**
+     * Checks the packed solution after every flow step, after the particles have been advected, migrated and sorted
+     */
+    static PetscErrorCode MonitorPackedSolution(TS ts, PetscInt steps, PetscReal time, Vec u, void* ctx) {
+        PetscFunctionBeginUser;
+        auto context = (PackedSolutionContext*)ctx;
+        CheckPackedSolution(*context, time);
+        context->checkedSteps++;
+        PetscFunctionReturn(0);
+    }
+};
+
+TEST_P(ParticlePackedSolutionTestFixture, ShouldKeepPackedSolutionConsistentAfterMigrationAndSorting) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange
+            TS ts;
+            TSCreate(PETSC_COMM_WORLD, &ts) >> testErrorChecker;
+            TSSetProblemType(ts, TS_NONLINEAR) >> testErrorChecker;
+            TSSetType(ts, TSEULER) >> testErrorChecker;
+            TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP) >> testErrorChecker;
+            TSSetMaxTime(ts, 0.4) >> testErrorChecker;
+            TSSetTimeStep(ts, 0.01) >> testErrorChecker;
+            TSSetMaxSteps(ts, 1000) >> testErrorChecker;
+
+            // a uniform flow (rho = 1, p = 1, u = 0.5) in the x direction is preserved by the ghost boundary
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+                "mesh", std::vector<int>{10, 10}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{} /*boundary*/, false /*simplex*/);
+            auto parameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"cfl", "0.5"}, {"mu", "0.0"}, {"k", "0.0"}});
+            auto eos = std::make_shared<ablate::eos::PerfectGas>(std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"gamma", "1.4"}, {"Rgas", "287"}}));
+            auto uniformFlow = mathFunctions::Create(std::vector<double>{1.0, 2.625, 0.5, 0.0});
+            auto flowObject = std::make_shared<ablate::flow::CompressibleFlow>(
+                "testFlow",
+                mesh,
+                eos,
+                parameters,
+                nullptr,
+                nullptr,
+                std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{std::make_shared<mathFunctions::FieldSolution>("euler", uniformFlow)},
+                std::vector<std::shared_ptr<flow::boundaryConditions::BoundaryCondition>>{
+                    std::make_shared<flow::boundaryConditions::EssentialGhost>("euler", "walls", std::vector<int>{1, 2, 3, 4}, uniformFlow)});
+            flowObject->CompleteProblemSetup(ts);
+
+            // inertial particles have two solution fields, so the coordinates and velocity are packed.  Starting at the flow velocity there is no drag.
+            auto initializer = std::make_shared<ablate::particles::initializers::BoxInitializer>(std::vector<double>{0.15, 0.15}, std::vector<double>{0.45, 0.85}, 5);
+            auto particleParameters = std::make_shared<ablate::parameters::MapParameters>(
+                std::map<std::string, std::string>{{"fluidDensity", "1.0"}, {"fluidViscosity", "1.0E-3"}, {"gravityField", "0 0 0"}});
+            auto fieldInitialization = std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{
+                std::make_shared<mathFunctions::FieldSolution>(ablate::particles::Inertial::ParticleVelocity,
+                                                               ablate::mathFunctions::Create(std::vector<double>{flowVelocity[0], flowVelocity[1]})),
+                std::make_shared<mathFunctions::FieldSolution>(ablate::particles::Inertial::ParticleDiameter, ablate::mathFunctions::Create(std::vector<double>{1.0E-4})),
+                std::make_shared<mathFunctions::FieldSolution>(ablate::particles::Inertial::ParticleDensity, ablate::mathFunctions::Create(std::vector<double>{100.0})),
+            };
+            auto particles = std::make_shared<ablate::particles::Inertial>(
+                "particle", 2, particleParameters, initializer, fieldInitialization, nullptr, nullptr, 1 /*sortInterval*/, "morton");
+            particles->InitializeFlow(flowObject);
+
+            // record where each particle starts, the particles that cross x = 0.5 are migrated when there is more than one rank
+            PackedSolutionContext context{.particles = particles.get()};
+            {
+                DM swarm = particles->GetDM();
+                PetscInt np;
+                DMSwarmGetLocalSize(swarm, &np) >> testErrorChecker;
+                PetscReal* coordinates;
+                PetscInt64* pid;
+                DMSwarmGetField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+                DMSwarmGetField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+                std::vector<PetscReal> localRecords;
+                for (PetscInt p = 0; p < np; ++p) {
+                    localRecords.insert(localRecords.end(), {(PetscReal)pid[p], coordinates[p * 2], coordinates[p * 2 + 1]});
+                }
+                DMSwarmRestoreField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+                DMSwarmRestoreField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+
+                PetscMPIInt size;
+                MPI_Comm_size(PETSC_COMM_WORLD, &size) >> testErrorChecker;
+                PetscMPIInt localSize = (PetscMPIInt)localRecords.size();
+                std::vector<PetscMPIInt> sizes(size), offsets(size + 1, 0);
+                MPI_Allgather(&localSize, 1, MPI_INT, sizes.data(), 1, MPI_INT, PETSC_COMM_WORLD) >> testErrorChecker;
+                for (PetscMPIInt r = 0; r < size; ++r) {
+                    offsets[r + 1] = offsets[r] + sizes[r];
+                }
+                std::vector<PetscReal> globalRecords(offsets[size]);
+                MPI_Allgatherv(localRecords.data(), localSize, MPIU_REAL, globalRecords.data(), sizes.data(), offsets.data(), MPIU_REAL, PETSC_COMM_WORLD) >> testErrorChecker;
+                for (std::size_t r = 0; r < globalRecords.size(); r += 3) {
+                    context.initialCoordinates[(PetscInt64)globalRecords[r]] = {globalRecords[r + 1], globalRecords[r + 2]};
+                }
+            }
+            ASSERT_EQ(context.initialCoordinates.size(), 25u);
+
+            // the initial packing and the field initialization
+            CheckPackedSolution(context, 0.0);
+
+            TSMonitorSet(ts, MonitorPackedSolution, &context, NULL) >> testErrorChecker;
+            TSSetFromOptions(ts) >> testErrorChecker;
+
+            // act
+            TSSolve(ts, flowObject->GetSolutionVector()) >> testErrorChecker;
+
+            // assert that no particle was lost
+            PetscInt globalNp;
+            DMSwarmGetSize(particles->GetDM(), &globalNp) >> testErrorChecker;
+            ASSERT_EQ(globalNp, 25);
+            ASSERT_GT(context.checkedSteps, 0);
+
+            // sorting again reorders every swarm field and must keep them consistent
+            PetscReal time;
+            TSGetTime(ts, &time) >> testErrorChecker;
+            particles->SortParticles();
+            CheckPackedSolution(context, time);
+
+            // viewing copies the packed velocity out to the separately registered field
+            PetscViewer viewer;
+            PetscViewerASCIIOpen(PETSC_COMM_WORLD, "/dev/null", &viewer) >> testErrorChecker;
+            particles->View(viewer, 0, time, NULL);
+            PetscViewerDestroy(&viewer) >> testErrorChecker;
+            {
+                DM swarm = particles->GetDM();
+                PetscInt np;
+                DMSwarmGetLocalSize(swarm, &np) >> testErrorChecker;
+                PetscReal* velocity;
+                DMSwarmGetField(swarm, ablate::particles::Inertial::ParticleVelocity, NULL, NULL, (void**)&velocity) >> testErrorChecker;
+                for (PetscInt p = 0; p < np; ++p) {
+                    ASSERT_NEAR(velocity[p * 2], flowVelocity[0], 1E-10) << "for particle " << p;
+                    ASSERT_NEAR(velocity[p * 2 + 1], flowVelocity[1], 1E-10) << "for particle " << p;
+                }
+                DMSwarmRestoreField(swarm, ablate::particles::Inertial::ParticleVelocity, NULL, NULL, (void**)&velocity) >> testErrorChecker;
+            }
+
+            // cleanup
+            particles.reset();
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(ParticlePackedSolutionTests, ParticlePackedSolutionTestFixture,
+                         testing::Values((testingResources::MpiTestParameter){.testName = "packed solution", .nproc = 1, .expectedOutputFile = "", .arguments = ""},
+                                         (testingResources::MpiTestParameter){.testName = "packed solution 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""}),
+                         [](const testing::TestParamInfo<testingResources::MpiTestParameter>& info) { return info.getTestName(); });
@@ -0,0 +1,123 @@
+#include <petsc.h>
+#include <map>
+#include <memory>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "eos/perfectGas.hpp"
+#include "flow/boundaryConditions/essentialGhost.hpp"
+#include "flow/compressibleFlow.hpp"
+#include "gtest/gtest.h"
+#include "mathFunctions/functionFactory.hpp"
+#include "mesh/boxMesh.hpp"
+#include "parameters/mapParameters.hpp"
+#include "parameters/petscPrefixOptions.hpp"
+#include "particles/initializers/boxInitializer.hpp"
+#include "particles/tracer.hpp"
+
+using namespace ablate;
+
+class ParticleSolutionVectorTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<testingResources::MpiTestParameter> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam()); }
+
+   protected:
+    /**
+     * Checks after every flow step that the particle ts solution vector holds exactly the local particles
+     */
+    static PetscErrorCode MonitorSolutionVectorSize(TS ts, PetscInt steps, PetscReal time, Vec u, void* ctx) {
+        PetscFunctionBeginUser;
+        auto particles = (ablate::particles::Particles*)ctx;
+        PetscInt np;
+        DMSwarmGetLocalSize(particles->GetDM(), &np) >> testErrorChecker;
+
+        Vec solution;
+        TSGetSolution(particles->GetTS(), &solution) >> testErrorChecker;
+        if (solution) {
+            PetscInt solutionSize;
+            VecGetLocalSize(solution, &solutionSize) >> testErrorChecker;
+            if (solutionSize != np * 2) {
+                throw std::runtime_error("the particle solution vector holds " + std::to_string(solutionSize) + " values for " + std::to_string(np) + " particles");
+            }
+        }
+        PetscFunctionReturn(0);
+    }
+};
+
+TEST_P(ParticleSolutionVectorTestFixture, ShouldSizeSolutionVectorToTheParticles) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange
+            TS ts;
+            TSCreate(PETSC_COMM_WORLD, &ts) >> testErrorChecker;
+            TSSetProblemType(ts, TS_NONLINEAR) >> testErrorChecker;
+            TSSetType(ts, TSEULER) >> testErrorChecker;
+            TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP) >> testErrorChecker;
+            TSSetMaxTime(ts, 0.8) >> testErrorChecker;
+            TSSetTimeStep(ts, 0.01) >> testErrorChecker;
+            TSSetMaxSteps(ts, 1000) >> testErrorChecker;
+
+            // a uniform flow (rho = 1, p = 1, u = 0.5) in the x direction is preserved by the ghost boundary
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+                "mesh", std::vector<int>{10, 10}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{} /*boundary*/, false /*simplex*/);
+            auto parameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"cfl", "0.5"}, {"mu", "0.0"}, {"k", "0.0"}});
+            auto eos = std::make_shared<ablate::eos::PerfectGas>(std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"gamma", "1.4"}, {"Rgas", "287"}}));
+            auto uniformFlow = mathFunctions::Create(std::vector<double>{1.0, 2.625, 0.5, 0.0});
+            auto flowObject = std::make_shared<ablate::flow::CompressibleFlow>(
+                "testFlow",
+                mesh,
+                eos,
+                parameters,
+                nullptr,
+                nullptr,
+                std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{std::make_shared<mathFunctions::FieldSolution>("euler", uniformFlow)},
+                std::vector<std::shared_ptr<flow::boundaryConditions::BoundaryCondition>>{
+                    std::make_shared<flow::boundaryConditions::EssentialGhost>("euler", "walls", std::vector<int>{1, 2, 3, 4}, uniformFlow)});
+            flowObject->CompleteProblemSetup(ts);
+
+            // the particles in the two columns nearest the outflow leave the domain and are removed
+            auto initializer = std::make_shared<ablate::particles::initializers::BoxInitializer>(std::vector<double>{0.35, 0.2}, std::vector<double>{0.95, 0.8}, 4);
+            auto particleOptions = std::make_shared<ablate::parameters::PetscPrefixOptions>("-particle_");
+            auto particles = std::make_shared<ablate::particles::Tracer>("particle", 2, initializer, nullptr, particleOptions, 0, "", std::vector<std::shared_ptr<particles::injectors::Injector>>{}, true);
+            particles->InitializeFlow(flowObject);
+
+            TSMonitorSet(ts, MonitorSolutionVectorSize, particles.get(), NULL) >> testErrorChecker;
+            TSSetFromOptions(ts) >> testErrorChecker;
+
+            // act
+            TSSolve(ts, flowObject->GetSolutionVector()) >> testErrorChecker;
+
+            // assert
+            PetscInt globalNp;
+            DMSwarmGetSize(particles->GetDM(), &globalNp) >> testErrorChecker;
+            ASSERT_EQ(globalNp, 8) << "only the particles that left the domain should be removed";
+
+            // the remaining particles started in the first two columns (x = 0.35 and 0.55) and only move downstream
+            DM swarm = particles->GetDM();
+            PetscInt np;
+            DMSwarmGetLocalSize(swarm, &np) >> testErrorChecker;
+            PetscReal* coordinates;
+            DMSwarmGetField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+            for (PetscInt p = 0; p < np; ++p) {
+                ASSERT_GT(coordinates[p * 2], 0.65) << "particle " << p << " should have advected";
+                const PetscReal row = (coordinates[p * 2 + 1] - 0.2) / 0.2;
+                ASSERT_NEAR(row, PetscRoundReal(row), 1E-12) << "particle " << p << " should not move normal to the flow";
+            }
+            DMSwarmRestoreField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+
+            // cleanup
+            particles.reset();
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(ParticleSolutionVectorTests, ParticleSolutionVectorTestFixture,
+                         testing::Values((testingResources::MpiTestParameter){.testName = "outflow", .nproc = 1, .expectedOutputFile = "", .arguments = ""},
+                                         (testingResources::MpiTestParameter){.testName = "outflow 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""},
+                                         (testingResources::MpiTestParameter){
+                                             .testName = "outflow adaptive", .nproc = 2, .expectedOutputFile = "", .arguments = "-particle_ts_type rk -particle_ts_adapt_type basic"}),
+                         [](const testing::TestParamInfo<testingResources::MpiTestParameter>& info) { return info.getTestName(); });
@@ -0,0 +1,118 @@
+#include <petsc.h>
+#include <map>
+#include <memory>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "eos/perfectGas.hpp"
+#include "flow/compressibleFlow.hpp"
+#include "gtest/gtest.h"
+#include "mathFunctions/functionFactory.hpp"
+#include "mesh/boxMesh.hpp"
+#include "parameters/mapParameters.hpp"
+#include "particles/initializers/boxInitializer.hpp"
+#include "particles/tracer.hpp"
+
+using namespace ablate;
+
+struct ParticleSortParameters {
+    testingResources::MpiTestParameter mpiTestParameter;
+    std::string sortOrder;
+};
+
+class ParticleSortTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<ParticleSortParameters> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam().mpiTestParameter); }
+};
+
+TEST_P(ParticleSortTestFixture, ShouldGroupParticlesByCell) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+
+            // arrange
+            TS ts;
+            TSCreate(PETSC_COMM_WORLD, &ts) >> testErrorChecker;
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+                "mesh", std::vector<int>{6, 5}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{} /*boundary*/, false /*simplex*/);
+            auto parameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"cfl", "0.5"}, {"mu", "0.0"}, {"k", "0.0"}});
+            auto eos = std::make_shared<ablate::eos::PerfectGas>(std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"gamma", "1.4"}, {"Rgas", "287"}}));
+            auto euler = std::make_shared<mathFunctions::FieldSolution>("euler", mathFunctions::Create(std::vector<double>{1.0, 250000.0, 0.0, 0.0}));
+            auto flowObject = std::make_shared<ablate::flow::CompressibleFlow>(
+                "testFlow", mesh, eos, parameters, nullptr, nullptr, std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{euler});
+            flowObject->CompleteProblemSetup(ts);
+
+            // the box initializer places the particles in box (not cell) order
+            auto initializer = std::make_shared<ablate::particles::initializers::BoxInitializer>(std::vector<double>{0.05, 0.05}, std::vector<double>{0.95, 0.95}, 9);
+            auto particles = std::make_shared<ablate::particles::Tracer>("particle", 2, initializer, nullptr, nullptr, 1, GetParam().sortOrder);
+            particles->InitializeFlow(flowObject);
+            DM swarm = particles->GetDM();
+
+            // record the location of each particle before sorting
+            PetscInt np;
+            DMSwarmGetLocalSize(swarm, &np) >> testErrorChecker;
+            std::map<PetscInt64, std::vector<PetscReal>> initialCoordinates;
+            {
+                PetscReal* coordinates;
+                PetscInt64* pid;
+                DMSwarmGetField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+                DMSwarmGetField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+                for (PetscInt p = 0; p < np; ++p) {
+                    initialCoordinates[pid[p]] = {coordinates[p * 2], coordinates[p * 2 + 1]};
+                }
+                DMSwarmRestoreField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+                DMSwarmRestoreField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+            }
+
+            // act
+            particles->SortParticles();
+
+            // assert
+            PetscInt npSorted;
+            DMSwarmGetLocalSize(swarm, &npSorted) >> testErrorChecker;
+            ASSERT_EQ(npSorted, np) << "sorting should not change the local particles";
+
+            PetscReal* coordinates;
+            PetscInt64* pid;
+            PetscInt* cells;
+            DMSwarmGetField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+            DMSwarmGetField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+            DMSwarmGetField(swarm, DMSwarmPICField_cellid, NULL, NULL, (void**)&cells) >> testErrorChecker;
+            for (PetscInt p = 0; p < np; ++p) {
+                // every field is permuted together
+                ASSERT_EQ(initialCoordinates.count(pid[p]), 1) << "particle " << pid[p] << " should still be local";
+                ASSERT_DOUBLE_EQ(coordinates[p * 2], initialCoordinates[pid[p]][0]);
+                ASSERT_DOUBLE_EQ(coordinates[p * 2 + 1], initialCoordinates[pid[p]][1]);
+
+                // the particle is listed in the contiguous range of its cell
+                PetscInt start, end;
+                ASSERT_TRUE(particles->GetCellParticleRange(cells[p], start, end)) << "the cell index should be valid after sorting";
+                ASSERT_LE(start, p);
+                ASSERT_LT(p, end);
+                for (PetscInt q = start; q < end; ++q) {
+                    ASSERT_EQ(cells[q], cells[p]) << "particle " << q << " is not in the cell of particle " << p;
+                }
+            }
+            DMSwarmRestoreField(swarm, DMSwarmPICField_cellid, NULL, NULL, (void**)&cells) >> testErrorChecker;
+            DMSwarmRestoreField(swarm, DMSwarmField_pid, NULL, NULL, (void**)&pid) >> testErrorChecker;
+            DMSwarmRestoreField(swarm, DMSwarmPICField_coor, NULL, NULL, (void**)&coordinates) >> testErrorChecker;
+
+            // no particle was lost or duplicated across the ranks
+            PetscInt globalNp;
+            MPIU_Allreduce(&np, &globalNp, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD) >> testErrorChecker;
+            ASSERT_EQ(globalNp, 81);
+
+            // cleanup
+            particles.reset();
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(ParticleSortTests, ParticleSortTestFixture,
+                         testing::Values((ParticleSortParameters){.mpiTestParameter = {.testName = "sort by cell", .nproc = 1, .expectedOutputFile = "", .arguments = ""}, .sortOrder = "cell"},
+                                         (ParticleSortParameters){.mpiTestParameter = {.testName = "sort by morton", .nproc = 1, .expectedOutputFile = "", .arguments = ""}, .sortOrder = "morton"},
+                                         (ParticleSortParameters){.mpiTestParameter = {.testName = "sort by morton 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""},
+                                                                  .sortOrder = "morton"}),
+                         [](const testing::TestParamInfo<ParticleSortParameters>& info) { return info.param.mpiTestParameter.getTestName(); });
@@ -0,0 +1,163 @@
+#include <petsc.h>
+#include <map>
+#include <memory>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "eos/perfectGas.hpp"
+#include "flow/boundaryConditions/essentialGhost.hpp"
+#include "flow/compressibleFlow.hpp"
+#include "flow/processes/eulerAdvection.hpp"
+#include "gtest/gtest.h"
+#include "mathFunctions/functionFactory.hpp"
+#include "mesh/boxMesh.hpp"
+#include "parameters/mapParameters.hpp"
+#include "particles/inertial.hpp"
+#include "particles/initializers/boxInitializer.hpp"
+
+using namespace ablate;
+
+/**
+ * Exposes the deposited particle source for the test
+ */
+class InertialWithSource : public ablate::particles::Inertial {
+   public:
+    using Inertial::Inertial;
+    Vec GetFlowSource() const { return flowSource; }
+};
+
+struct ParticleSourceDepositionParameters {
+    testingResources::MpiTestParameter mpiTestParameter;
+    bool simplex;
+};
+
+class ParticleSourceDepositionTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<ParticleSourceDepositionParameters> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam().mpiTestParameter); }
+};
+
+TEST_P(ParticleSourceDepositionTestFixture, ShouldConserveMomentumBetweenParticlesAndFlow) {
+    StartWithMPI
+        {
+            // initialize petsc and mpi
+            PetscInitialize(argc, argv, NULL, NULL) >> testErrorChecker;
+            const PetscInt dim = 2;
+            const PetscReal muF = 0.1;
+            const PetscReal dp = 0.01;
+
+            // arrange
+            TS ts;
+            TSCreate(PETSC_COMM_WORLD, &ts) >> testErrorChecker;
+            TSSetProblemType(ts, TS_NONLINEAR) >> testErrorChecker;
+            TSSetType(ts, TSEULER) >> testErrorChecker;
+            TSSetExactFinalTime(ts, TS_EXACTFINALTIME_MATCHSTEP) >> testErrorChecker;
+            TSSetTimeStep(ts, 1E-3) >> testErrorChecker;
+            TSSetMaxSteps(ts, 2) >> testErrorChecker;
+
+            // a uniform flow (rho = 1, p = 1, u = (0.5, 0.25)) preserved by the ghost boundary
+            auto mesh = std::make_shared<ablate::mesh::BoxMesh>(
+                "mesh", std::vector<int>{6, 6}, std::vector<double>{0.0, 0.0}, std::vector<double>{1.0, 1.0}, std::vector<std::string>{} /*boundary*/, GetParam().simplex);
+            auto parameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"cfl", "0.5"}, {"mu", "0.0"}, {"k", "0.0"}});
+            auto eos = std::make_shared<ablate::eos::PerfectGas>(std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{{"gamma", "1.4"}, {"Rgas", "287"}}));
+            auto uniformFlow = mathFunctions::Create(std::vector<double>{1.0, 2.65625, 0.5, 0.25});
+            auto flowObject = std::make_shared<ablate::flow::CompressibleFlow>(
+                "testFlow",
+                mesh,
+                eos,
+                parameters,
+                nullptr,
+                nullptr,
+                std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{std::make_shared<mathFunctions::FieldSolution>("euler", uniformFlow)},
+                std::vector<std::shared_ptr<flow::boundaryConditions::BoundaryCondition>>{
+                    std::make_shared<flow::boundaryConditions::EssentialGhost>("euler", "walls", std::vector<int>{1, 2, 3, 4}, uniformFlow)});
+
+            // small (Stokes drag) particles moving against the flow
+            auto particleParameters = std::make_shared<ablate::parameters::MapParameters>(std::map<std::string, std::string>{
+                {"fluidDensity", "1.0"}, {"fluidViscosity", std::to_string(muF)}, {"gravityField", "0 0"}, {"twoWayCoupling", "true"}});
+            auto fieldInitialization = std::vector<std::shared_ptr<mathFunctions::FieldSolution>>{
+                std::make_shared<mathFunctions::FieldSolution>(ablate::particles::Inertial::ParticleVelocity, mathFunctions::Create(std::vector<double>{-0.1, 0.2})),
+                std::make_shared<mathFunctions::FieldSolution>(ablate::particles::Inertial::ParticleDiameter, mathFunctions::Create(dp)),
+                std::make_shared<mathFunctions::FieldSolution>(ablate::particles::Inertial::ParticleDensity, mathFunctions::Create(100.0)),
+            };
+            auto initializer = std::make_shared<ablate::particles::initializers::BoxInitializer>(std::vector<double>{0.2, 0.2}, std::vector<double>{0.8, 0.8}, 5);
+            auto particles = std::make_shared<InertialWithSource>("particle", dim, particleParameters, initializer, fieldInitialization, nullptr, nullptr, 1);
+
+            flowObject->CompleteProblemSetup(ts);
+            particles->InitializeFlow(flowObject);
+            TSSetFromOptions(ts) >> testErrorChecker;
+
+            // act
+            TSSolve(ts, flowObject->GetSolutionVector()) >> testErrorChecker;
+
+            // assert
+            // the Stokes drag force on each particle, 3 pi mu d (uf - vp), from the fluid velocity used by the particles
+            PetscReal localParticleDrag[dim + 1] = {0.0, 0.0, 0.0};
+            {
+                DM swarm = particles->GetDM();
+                PetscInt np;
+                DMSwarmGetLocalSize(swarm, &np) >> testErrorChecker;
+                const PetscReal *kinematics, *fluidVel;
+                DMSwarmGetField(swarm, "PackedSolution", NULL, NULL, (void**)&kinematics) >> testErrorChecker;
+                DMSwarmGetField(swarm, ablate::particles::Inertial::FluidVelocity, NULL, NULL, (void**)&fluidVel) >> testErrorChecker;
+                for (PetscInt p = 0; p < np; ++p) {
+                    // the packed solution holds the position and then the velocity of each particle
+                    const PetscReal* partVel = kinematics + p * 2 * dim + dim;
+                    for (PetscInt n = 0; n < dim; ++n) {
+                        const PetscReal drag = 3.0 * PETSC_PI * muF * dp * (fluidVel[p * dim + n] - partVel[n]);
+                        localParticleDrag[n] += drag;
+                        localParticleDrag[dim] += drag * partVel[n];
+                    }
+                }
+                DMSwarmRestoreField(swarm, ablate::particles::Inertial::FluidVelocity, NULL, NULL, (void**)&fluidVel) >> testErrorChecker;
+                DMSwarmRestoreField(swarm, "PackedSolution", NULL, NULL, (void**)&kinematics) >> testErrorChecker;
+            }
+
+            // the source (per volume) deposited in the flow cells
+            PetscReal localDeposited[dim + 1] = {0.0, 0.0, 0.0};
+            {
+                DM flowDM = flowObject->GetDM();
+                const PetscInt eulerField = flowObject->GetFieldId("euler").value();
+                PetscInt cStart, cEnd;
+                DMPlexGetHeightStratum(flowDM, 0, &cStart, &cEnd) >> testErrorChecker;
+                const PetscScalar* sourceArray;
+                VecGetArrayRead(particles->GetFlowSource(), &sourceArray) >> testErrorChecker;
+                for (PetscInt c = cStart; c < cEnd; ++c) {
+                    const PetscScalar* cellSource = NULL;
+                    DMPlexPointGlobalFieldRead(flowDM, c, eulerField, sourceArray, &cellSource) >> testErrorChecker;
+                    if (!cellSource) {
+                        continue;
+                    }
+                    PetscReal volume;
+                    DMPlexComputeCellGeometryFVM(flowDM, c, &volume, NULL, NULL) >> testErrorChecker;
+                    for (PetscInt n = 0; n < dim; ++n) {
+                        localDeposited[n] += PetscRealPart(cellSource[ablate::flow::processes::EulerAdvection::RHOU + n]) * volume;
+                    }
+                    localDeposited[dim] += PetscRealPart(cellSource[ablate::flow::processes::EulerAdvection::RHOE]) * volume;
+                    ASSERT_EQ(PetscRealPart(cellSource[ablate::flow::processes::EulerAdvection::RHO]), 0.0) << "the particles should not deposit mass";
+                }
+                VecRestoreArrayRead(particles->GetFlowSource(), &sourceArray) >> testErrorChecker;
+            }
+
+            PetscReal particleDrag[dim + 1], deposited[dim + 1];
+            MPIU_Allreduce(localParticleDrag, particleDrag, dim + 1, MPIU_REAL, MPIU_SUM, PETSC_COMM_WORLD) >> testErrorChecker;
+            MPIU_Allreduce(localDeposited, deposited, dim + 1, MPIU_REAL, MPIU_SUM, PETSC_COMM_WORLD) >> testErrorChecker;
+
+            // the momentum and energy given to the flow is the opposite of the drag on the particles
+            for (PetscInt n = 0; n <= dim; ++n) {
+                ASSERT_GT(PetscAbsReal(particleDrag[n]), 1E-6) << "the test should have a nonzero drag in component " << n;
+                ASSERT_NEAR(deposited[n], -particleDrag[n], 1E-10 * PetscAbsReal(particleDrag[n])) << "for component " << n;
+            }
+
+            // cleanup
+            particles.reset();
+            TSDestroy(&ts) >> testErrorChecker;
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ParticleSourceDepositionTests, ParticleSourceDepositionTestFixture,
+    testing::Values((ParticleSourceDepositionParameters){.mpiTestParameter = {.testName = "tensor", .nproc = 1, .expectedOutputFile = "", .arguments = ""}, .simplex = false},
+                    (ParticleSourceDepositionParameters){.mpiTestParameter = {.testName = "tensor 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""}, .simplex = false},
+                    (ParticleSourceDepositionParameters){.mpiTestParameter = {.testName = "simplex 3 ranks", .nproc = 3, .expectedOutputFile = "", .arguments = ""}, .simplex = true}),
+    [](const testing::TestParamInfo<ParticleSourceDepositionParameters>& info) { return info.param.mpiTestParameter.getTestName(); });
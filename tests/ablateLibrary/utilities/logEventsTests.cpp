@@ -0,0 +1,28 @@
+#include <PetscTestFixture.hpp>
+#include <stdexcept>
+#include "gtest/gtest.h"
+#include "utilities/logEvents.hpp"
+
+class LogEventsTestFixture : public testingResources::PetscTestFixture {};
+
+TEST_F(LogEventsTestFixture, ShouldEndTheScopedEventWhenAnExceptionIsThrown) {
+    // arrange
+    PetscLogDefaultBegin() >> errorChecker;
+    auto event = ablate::utilities::LogEvents::Register("ScopeTestEvent");
+
+    // act
+    try {
+        ablate::utilities::LogEvents::Scope scope(event);
+        throw std::runtime_error("thrown inside the event");
+    } catch (std::runtime_error&) {
+    }
+    {
+        ablate::utilities::LogEvents::Scope scope(event);
+    }
+
+    // assert
+    PetscEventPerfInfo info;
+    PetscLogEventGetPerfInfo(PETSC_DETERMINE, event, &info) >> errorChecker;
+    ASSERT_EQ(info.depth, 0);
+    ASSERT_EQ(info.count, 2);
+}
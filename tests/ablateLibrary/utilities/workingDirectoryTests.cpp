@@ -0,0 +1,48 @@
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <stdexcept>
+#include "gtest/gtest.h"
+#include "utilities/workingDirectory.hpp"
+
+TEST(WorkingDirectoryTests, ShouldRestoreTheWorkingDirectoryWhenAnExceptionIsThrown) {
+    // arrange
+    const auto initialDirectory = std::filesystem::current_path();
+    const auto scratchDirectory = std::filesystem::temp_directory_path() / "ablateWorkingDirectoryTest";
+    std::filesystem::create_directories(scratchDirectory);
+    std::filesystem::path changedDirectory;
+
+    // act
+    try {
+        ablate::utilities::WorkingDirectory workingDirectory(scratchDirectory);
+        changedDirectory = std::filesystem::current_path();
+        throw std::runtime_error("thrown inside the working directory");
+    } catch (std::runtime_error&) {
+    }
+
+    // assert
+    ASSERT_EQ(std::filesystem::canonical(changedDirectory), std::filesystem::canonical(scratchDirectory));
+    ASSERT_EQ(std::filesystem::current_path(), initialDirectory);
+    std::filesystem::remove_all(scratchDirectory);
+}
+
+TEST(WorkingDirectoryTests, ShouldWaitForThreadsUsingTheWorkingDirectory) {
+    // arrange
+    const auto initialDirectory = std::filesystem::current_path();
+    const auto scratchDirectory = std::filesystem::temp_directory_path() / "ablateWorkingDirectoryWaitTest";
+    std::filesystem::create_directories(scratchDirectory);
+    auto useLock = ablate::utilities::WorkingDirectory::Use();
+
+    // act
+    auto change = std::async(std::launch::async, [&scratchDirectory]() { ablate::utilities::WorkingDirectory workingDirectory(scratchDirectory); });
+    const auto statusWhileUsed = change.wait_for(std::chrono::milliseconds(100));
+    const auto directoryWhileUsed = std::filesystem::current_path();
+    useLock.unlock();
+    change.get();
+
+    // assert
+    ASSERT_EQ(statusWhileUsed, std::future_status::timeout);
+    ASSERT_EQ(directoryWhileUsed, initialDirectory);
+    ASSERT_EQ(std::filesystem::current_path(), initialDirectory);
+    std::filesystem::remove_all(scratchDirectory);
+}
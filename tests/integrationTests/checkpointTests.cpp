@@ -0,0 +1,197 @@
+static char help[] = "Checkpoint Restart Testing";
+
+#include <petscviewerhdf5.h>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "builder.hpp"
+#include "environment/runEnvironment.hpp"
+#include "gtest/gtest.h"
+#include "parameters/mapParameters.hpp"
+#include "parser/yamlParser.hpp"
+
+struct CheckpointParameters {
+    std::string testName;
+    // the relative path to the yaml file, the input must write a checkpoint every two steps
+    std::filesystem::path inputPath;
+    // the rank count used to write the checkpoint and the reference
+    int saveRanks;
+    // the rank count used to restart from the checkpoint
+    int restartRanks;
+};
+
+class CheckpointTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<CheckpointParameters> {
+   public:
+    void SetUp() override { SetMpiParameters({.testName = GetParam().testName, .nproc = GetParam().saveRanks, .expectedOutputFile = "", .arguments = ""}); }
+
+   protected:
+    /**
+     * Runs the input to the max steps (optionally from a restart file), the output is written to the directory
+     */
+    static void RunInput(const std::filesystem::path& inputPath, int maxSteps, const std::filesystem::path& restartFile, const std::filesystem::path& outputDirectory) {
+        int rank;
+        MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+        if (rank == 0) {
+            std::filesystem::remove_all(outputDirectory);
+        }
+        MPI_Barrier(PETSC_COMM_WORLD);
+
+        YAML::Node input = YAML::LoadFile(inputPath.string());
+        input["timestepper"]["arguments"]["ts_max_steps"] = maxSteps;
+        if (!restartFile.empty()) {
+            input["restart"] = restartFile.string();
+        }
+
+        ablate::parameters::MapParameters runEnvironmentParameters(
+            std::map<std::string, std::string>{{"outputDirectory", outputDirectory}, {"tagDirectory", "false"}, {"title", outputDirectory.filename().string()}});
+        ablate::environment::RunEnvironment::Setup(runEnvironmentParameters);
+        {
+            std::shared_ptr<ablate::parser::Factory> parser = std::make_shared<ablate::parser::YamlParser>(YAML::Dump(input));
+            ablate::Builder::Run(parser);
+        }
+        MPI_Barrier(PETSC_COMM_WORLD);
+    }
+
+    /**
+     * Reads the dataset as doubles
+     */
+    static std::vector<double> ReadDataset(hid_t file, const std::string& name) {
+        hid_t dataset = H5Dopen2(file, name.c_str(), H5P_DEFAULT);
+        hid_t space = H5Dget_space(dataset);
+        std::vector<double> values(H5Sget_simple_extent_npoints(space));
+        H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+        H5Sclose(space);
+        H5Dclose(dataset);
+        return values;
+    }
+
+    /**
+     * Reads every dataset in the checkpoint.  The point records of each dataset are stored with their key and sorted, so that checkpoints written with a
+     * different partition (or rank count) can be compared.
+     */
+    static void ReadCheckpoint(hid_t file, const std::string& group, std::map<std::string, std::vector<double>>& datasets) {
+        hid_t groupId = H5Gopen2(file, group.empty() ? "/" : group.c_str(), H5P_DEFAULT);
+        H5G_info_t info;
+        H5Gget_info(groupId, &info);
+        std::vector<std::string> names;
+        for (hsize_t i = 0; i < info.nlinks; ++i) {
+            const auto size = H5Lget_name_by_idx(groupId, ".", H5_INDEX_NAME, H5_ITER_INC, i, NULL, 0, H5P_DEFAULT);
+            std::string name(size, '\0');
+            H5Lget_name_by_idx(groupId, ".", H5_INDEX_NAME, H5_ITER_INC, i, name.data(), size + 1, H5P_DEFAULT);
+            names.push_back(group + "/" + name);
+        }
+        H5Gclose(groupId);
+
+        const auto hasName = [&names](const std::string& name) { return std::find(names.begin(), names.end(), name) != names.end(); };
+        for (const auto& name : names) {
+            hid_t object = H5Oopen(file, name.c_str(), H5P_DEFAULT);
+            const auto type = H5Iget_type(object);
+            H5Oclose(object);
+            if (type == H5I_GROUP) {
+                ReadCheckpoint(file, name, datasets);
+                continue;
+            }
+
+            // the keys and sizes are stored with the records
+            const auto endsWith = [&name](const std::string& suffix) { return name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0; };
+            if ((endsWith("_keys") || endsWith("_sizes")) && hasName(name.substr(0, name.rfind('_')) + "_records")) {
+                continue;
+            }
+            const auto values = ReadDataset(file, name);
+            if (!hasName(name + "_records")) {
+                datasets[name] = values;
+                continue;
+            }
+
+            // each record is the key followed by the values
+            const auto keys = ReadDataset(file, name + "_keys");
+            const auto sizes = ReadDataset(file, name + "_sizes");
+            std::vector<std::vector<double>> records;
+            std::size_t offset = 0;
+            for (std::size_t r = 0; r < sizes.size(); ++r) {
+                std::vector<double> record(keys.begin() + 3 * r, keys.begin() + 3 * r + 3);
+                record.insert(record.end(), values.begin() + offset, values.begin() + offset + (std::size_t)sizes[r]);
+                offset += (std::size_t)sizes[r];
+                records.push_back(record);
+            }
+            std::sort(records.begin(), records.end());
+            auto& dataset = datasets[name];
+            for (const auto& record : records) {
+                dataset.insert(dataset.end(), record.begin(), record.end());
+            }
+        }
+    }
+};
+
+TEST_P(CheckpointTestFixture, ShouldRestartAtADifferentRankCount) {
+    if (ShouldRunMpiCode()) {
+        PetscInitialize(argc, argv, NULL, help) >> testErrorChecker;
+        {
+            int rank;
+            MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+            const auto& params = GetParam();
+            const auto testName = testingResources::MpiTestParameter{.testName = params.testName}.getTestName();
+            const auto initialDirectory = std::filesystem::current_path() / (testName + "_initial");
+            const auto referenceDirectory = std::filesystem::current_path() / (testName + "_reference");
+            const auto restartDirectory = std::filesystem::current_path() / testName;
+
+            PetscBool restartStage = PETSC_FALSE;
+            PetscOptionsGetBool(NULL, NULL, "-restartStage", &restartStage, NULL) >> testErrorChecker;
+            if (!restartStage) {
+                // the checkpoint at step two is restarted, the uninterrupted run to step four is the reference
+                RunInput(params.inputPath, 2, {}, initialDirectory);
+                RunInput(params.inputPath, 4, {}, referenceDirectory);
+            } else {
+                // act
+                RunInput(params.inputPath, 4, initialDirectory / "checkpoint.hdf5", restartDirectory);
+
+                // assert
+                if (rank == 0) {
+                    // the checkpoint at step four holds the same flow, particles, and statistics as the reference
+                    std::map<std::string, std::vector<double>> expected, actual;
+                    hid_t expectedFile = H5Fopen((referenceDirectory / "checkpoint.hdf5").c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+                    hid_t actualFile = H5Fopen((restartDirectory / "checkpoint.hdf5").c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+                    ASSERT_GE(expectedFile, 0);
+                    ASSERT_GE(actualFile, 0);
+                    ReadCheckpoint(expectedFile, "", expected);
+                    ReadCheckpoint(actualFile, "", actual);
+                    H5Fclose(actualFile);
+                    H5Fclose(expectedFile);
+
+                    for (const auto& group : {"/timeStepper", "/compressibleFlowField", "/flowTracerParticles", "/statistics"}) {
+                        ASSERT_TRUE(std::any_of(expected.begin(), expected.end(), [&group](const auto& dataset) { return dataset.first.rfind(group, 0) == 0; }))
+                            << "the checkpoint should hold " << group;
+                    }
+                    ASSERT_EQ(actual.size(), expected.size());
+                    for (const auto& [name, expectedValues] : expected) {
+                        ASSERT_EQ(actual.count(name), 1u) << "the restarted checkpoint should hold " << name;
+                        const auto& actualValues = actual[name];
+                        ASSERT_EQ(actualValues.size(), expectedValues.size()) << "for " << name;
+                        for (std::size_t i = 0; i < expectedValues.size(); ++i) {
+                            ASSERT_NEAR(actualValues[i], expectedValues[i], 1E-8 * std::max(1.0, std::abs(expectedValues[i]))) << "for value " << i << " of " << name;
+                        }
+                    }
+                }
+            }
+        }
+        exit(PetscFinalize());
+    } else {
+        // the checkpoint is written with one rank count and restarted with another
+        RunWithMPI();
+        if (HasFatalFailure()) {
+            return;
+        }
+        SetMpiParameters({.testName = GetParam().testName, .nproc = GetParam().restartRanks, .expectedOutputFile = "", .arguments = "-restartStage"});
+        RunWithMPI();
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Tests, CheckpointTestFixture,
+                         testing::Values((CheckpointParameters){.testName = "restart 1 to 3 ranks", .inputPath = "inputs/compressibleFlowCheckpoint.yaml", .saveRanks = 1, .restartRanks = 3},
+                                         (CheckpointParameters){.testName = "restart 3 to 2 ranks", .inputPath = "inputs/compressibleFlowCheckpoint.yaml", .saveRanks = 3, .restartRanks = 2}),
+                         [](const testing::TestParamInfo<CheckpointParameters>& info) { return testingResources::MpiTestParameter{.testName = info.param.testName}.getTestName(); });
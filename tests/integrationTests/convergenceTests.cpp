@@ -0,0 +1,97 @@
+static char help[] = "Convergence Monitor Testing";
+
+#include <petscviewerhdf5.h>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "builder.hpp"
+#include "environment/runEnvironment.hpp"
+#include "gtest/gtest.h"
+#include "parameters/mapParameters.hpp"
+#include "parser/yamlParser.hpp"
+
+struct ConvergenceParameters {
+    testingResources::MpiTestParameter mpiTestParameter;
+    // the relative path to the yaml file, the input must stop before the hdf5 interval is reached after the first output
+    std::filesystem::path inputPath;
+    // the hdf5 output file written by the flow
+    std::string outputFile;
+};
+
+class ConvergenceTestFixture : public testingResources::MpiTestFixture, public ::testing::WithParamInterface<ConvergenceParameters> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam().mpiTestParameter); }
+
+   protected:
+    /**
+     * Reads the dataset as doubles
+     */
+    static std::vector<double> ReadDataset(hid_t file, const std::string& name, std::vector<hsize_t>& dims) {
+        hid_t dataset = H5Dopen2(file, name.c_str(), H5P_DEFAULT);
+        if (dataset < 0) {
+            dims.clear();
+            return {};
+        }
+        hid_t space = H5Dget_space(dataset);
+        dims.resize(H5Sget_simple_extent_ndims(space));
+        H5Sget_simple_extent_dims(space, dims.data(), NULL);
+        std::vector<double> values(H5Sget_simple_extent_npoints(space));
+        H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+        H5Sclose(space);
+        H5Dclose(dataset);
+        return values;
+    }
+};
+
+TEST_P(ConvergenceTestFixture, ShouldStopEarlyAndWriteTheFinalOutput) {
+    StartWithMPI
+        PetscInitialize(argc, argv, NULL, help) >> testErrorChecker;
+        {
+            int rank;
+            MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+            const auto testName = GetParam().mpiTestParameter.getTestName();
+            const auto resultDirectory = std::filesystem::current_path() / testName;
+            if (rank == 0) {
+                std::filesystem::remove_all(resultDirectory);
+            }
+            MPI_Barrier(PETSC_COMM_WORLD);
+
+            // act
+            ablate::parameters::MapParameters runEnvironmentParameters(std::map<std::string, std::string>{{"outputDirectory", resultDirectory}, {"tagDirectory", "false"}, {"title", testName}});
+            ablate::environment::RunEnvironment::Setup(runEnvironmentParameters, GetParam().inputPath);
+            {
+                // the monitors close their files when the parser is destroyed
+                std::shared_ptr<ablate::parser::Factory> parser = std::make_shared<ablate::parser::YamlParser>(GetParam().inputPath);
+                ablate::Builder::Run(parser);
+            }
+            MPI_Barrier(PETSC_COMM_WORLD);
+
+            // assert
+            if (rank == 0) {
+                hid_t file = H5Fopen((resultDirectory / GetParam().outputFile).c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+                ASSERT_GE(file, 0) << "the hdf5 output should be written";
+                std::vector<hsize_t> timeDims;
+                auto times = ReadDataset(file, "/time", timeDims);
+                H5Fclose(file);
+
+                // without the early stop there would be an output every interval, without the final output there would only be the initial output
+                ASSERT_EQ(times.size(), 2u) << "only the initial and the converged state should be written";
+                ASSERT_EQ(times[0], 0.0);
+                ASSERT_GT(times[1], 0.0);
+            }
+        }
+        PetscFinalize() >> testErrorChecker;
+        exit(0);
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(Tests, ConvergenceTestFixture,
+                         testing::Values((ConvergenceParameters){.mpiTestParameter = {.testName = "couette convergence", .nproc = 1, .expectedOutputFile = "", .arguments = ""},
+                                                                 .inputPath = "inputs/compressibleCouetteFlowConvergence.yaml",
+                                                                 .outputFile = "couetteFlowField.hdf5"},
+                                         (ConvergenceParameters){.mpiTestParameter = {.testName = "couette convergence 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""},
+                                                                 .inputPath = "inputs/compressibleCouetteFlowConvergence.yaml",
+                                                                 .outputFile = "couetteFlowField.hdf5"}),
+                         [](const testing::TestParamInfo<ConvergenceParameters>& info) { return info.param.mpiTestParameter.getTestName(); });
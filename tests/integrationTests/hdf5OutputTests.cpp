@@ -0,0 +1,365 @@
+static char help[] = "Hdf5 Output Testing";
+
+#include <petscviewerhdf5.h>
+#include <yaml-cpp/yaml.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "MpiTestFixture.hpp"
+#include "builder.hpp"
+#include "environment/runEnvironment.hpp"
+#include "gtest/gtest.h"
+#include "parameters/mapParameters.hpp"
+#include "parser/yamlParser.hpp"
+
+/**
+ * Runs an input and reads back the hdf5 and xdmf output
+ */
+class Hdf5OutputTest : public testingResources::MpiTestFixture {
+   protected:
+    /**
+     * Runs the input with the options added to every Hdf5Monitor of the flow, the output is written to the directory
+     */
+    static void RunInput(const std::filesystem::path& inputPath, const std::string& monitorOptions, const std::filesystem::path& outputDirectory) {
+        int rank;
+        MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+        if (rank == 0) {
+            std::filesystem::remove_all(outputDirectory);
+        }
+        MPI_Barrier(PETSC_COMM_WORLD);
+
+        YAML::Node input = YAML::LoadFile(inputPath.string());
+        const YAML::Node options = YAML::Load(monitorOptions);
+        for (auto monitor : input["flow"]["monitors"]) {
+            if (monitor.Tag() == "!ablate::monitors::Hdf5Monitor") {
+                for (const auto& option : options) {
+                    monitor[option.first.as<std::string>()] = option.second;
+                }
+            }
+        }
+
+        ablate::parameters::MapParameters runEnvironmentParameters(
+            std::map<std::string, std::string>{{"outputDirectory", outputDirectory}, {"tagDirectory", "false"}, {"title", outputDirectory.filename().string()}});
+        ablate::environment::RunEnvironment::Setup(runEnvironmentParameters);
+        {
+            // the monitors close their files and write the xdmf when the parser is destroyed
+            std::shared_ptr<ablate::parser::Factory> parser = std::make_shared<ablate::parser::YamlParser>(YAML::Dump(input));
+            ablate::Builder::Run(parser);
+        }
+        MPI_Barrier(PETSC_COMM_WORLD);
+    }
+
+    /**
+     * Returns the name of every link in the group
+     */
+    static std::vector<std::string> GetNames(hid_t file, const std::string& group) {
+        std::vector<std::string> names;
+        hid_t groupId = H5Gopen2(file, group.c_str(), H5P_DEFAULT);
+        if (groupId < 0) {
+            return names;
+        }
+        H5G_info_t info;
+        H5Gget_info(groupId, &info);
+        for (hsize_t i = 0; i < info.nlinks; ++i) {
+            const auto size = H5Lget_name_by_idx(groupId, ".", H5_INDEX_NAME, H5_ITER_INC, i, NULL, 0, H5P_DEFAULT);
+            std::string name(size, '\0');
+            H5Lget_name_by_idx(groupId, ".", H5_INDEX_NAME, H5_ITER_INC, i, name.data(), size + 1, H5P_DEFAULT);
+            names.push_back(group + "/" + name);
+        }
+        H5Gclose(groupId);
+        return names;
+    }
+
+    /**
+     * Reads the dataset as doubles
+     */
+    static std::vector<double> ReadDataset(hid_t file, const std::string& name, std::vector<hsize_t>& dims) {
+        hid_t dataset = H5Dopen2(file, name.c_str(), H5P_DEFAULT);
+        if (dataset < 0) {
+            dims.clear();
+            return {};
+        }
+        hid_t space = H5Dget_space(dataset);
+        dims.resize(H5Sget_simple_extent_ndims(space));
+        H5Sget_simple_extent_dims(space, dims.data(), NULL);
+        std::vector<double> values(H5Sget_simple_extent_npoints(space));
+        H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+        H5Sclose(space);
+        H5Dclose(dataset);
+        return values;
+    }
+
+    /**
+     * Reads the raw value of each attribute of the object
+     */
+    static std::map<std::string, std::vector<char>> ReadAttributes(hid_t file, const std::string& name) {
+        std::map<std::string, std::vector<char>> attributes;
+        hid_t object = H5Oopen(file, name.c_str(), H5P_DEFAULT);
+        if (object < 0) {
+            return attributes;
+        }
+        H5Aiterate2(
+            object,
+            H5_INDEX_NAME,
+            H5_ITER_INC,
+            NULL,
+            [](hid_t location, const char* attributeName, const H5A_info_t*, void* data) -> herr_t {
+                hid_t attribute = H5Aopen(location, attributeName, H5P_DEFAULT);
+                hid_t type = H5Aget_type(attribute);
+                std::vector<char> value(H5Aget_storage_size(attribute));
+                H5Aread(attribute, type, value.data());
+                H5Tclose(type);
+                H5Aclose(attribute);
+                (*(std::map<std::string, std::vector<char>>*)data)[attributeName] = value;
+                return 0;
+            },
+            &attributes);
+        H5Oclose(object);
+        return attributes;
+    }
+
+    /**
+     * Reads the entire text file
+     */
+    static std::string ReadFile(const std::filesystem::path& path) {
+        std::ifstream stream(path);
+        return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    }
+};
+
+struct Hdf5OutputParameters {
+    testingResources::MpiTestParameter mpiTestParameter;
+    // the relative path to the yaml file
+    std::filesystem::path inputPath;
+    // the yaml map of options added to every Hdf5Monitor of the flow
+    std::string monitorOptions;
+};
+
+class Hdf5OutputTestFixture : public Hdf5OutputTest, public ::testing::WithParamInterface<Hdf5OutputParameters> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam().mpiTestParameter); }
+};
+
+TEST_P(Hdf5OutputTestFixture, ShouldWriteTheSameOutputAsTheSynchronousMonitor) {
+    StartWithMPI
+        // the asynchronous writer requires MPI_THREAD_MULTIPLE, otherwise the monitor falls back to synchronous output
+        int provided;
+        MPI_Init_thread(argc, argv, MPI_THREAD_MULTIPLE, &provided);
+        PetscInitialize(argc, argv, NULL, help) >> testErrorChecker;
+        {
+            int rank;
+            MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+            const auto& params = GetParam();
+            const auto testName = params.mpiTestParameter.getTestName();
+            const auto expectedDirectory = std::filesystem::current_path() / (testName + "_expected");
+            const auto actualDirectory = std::filesystem::current_path() / testName;
+
+            // act
+            RunInput(params.inputPath, "{}", expectedDirectory);
+            RunInput(params.inputPath, params.monitorOptions, actualDirectory);
+
+            // assert
+            if (rank == 0) {
+                std::size_t comparedFiles = 0;
+                for (const auto& entry : std::filesystem::directory_iterator(expectedDirectory)) {
+                    if (entry.path().extension() != ".hdf5") {
+                        continue;
+                    }
+                    const auto actualPath = actualDirectory / entry.path().filename();
+                    ASSERT_TRUE(std::filesystem::exists(actualPath)) << "the output " << actualPath << " should be written";
+                    comparedFiles++;
+
+                    hid_t expectedFile = H5Fopen(entry.path().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+                    hid_t actualFile = H5Fopen(actualPath.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+                    ASSERT_GE(expectedFile, 0);
+                    ASSERT_GE(actualFile, 0);
+
+                    // every dataset is written with the same values, shape, and attributes (used by the xdmf generator)
+                    auto names = GetNames(expectedFile, "/fields");
+                    ASSERT_FALSE(names.empty()) << "the test should write fields to " << entry.path();
+                    ASSERT_EQ(GetNames(actualFile, "/fields"), names);
+                    names.push_back("/time");
+                    for (const auto& name : names) {
+                        std::vector<hsize_t> expectedDims, actualDims;
+                        const auto expectedValues = ReadDataset(expectedFile, name, expectedDims);
+                        const auto actualValues = ReadDataset(actualFile, name, actualDims);
+                        ASSERT_EQ(actualDims, expectedDims) << "for " << name;
+                        ASSERT_EQ(actualValues, expectedValues) << "for " << name;
+
+                        const auto actualAttributes = ReadAttributes(actualFile, name);
+                        for (const auto& [attributeName, value] : ReadAttributes(expectedFile, name)) {
+                            auto actualAttribute = actualAttributes.find(attributeName);
+                            ASSERT_TRUE(actualAttribute != actualAttributes.end()) << "the attribute " << attributeName << " should be written for " << name;
+                            ASSERT_EQ(actualAttribute->second, value) << "for the attribute " << attributeName << " of " << name;
+                        }
+                    }
+                    H5Fclose(actualFile);
+                    H5Fclose(expectedFile);
+
+                    // the xdmf generated from the files describes the same output
+                    auto xdmfPath = entry.path();
+                    xdmfPath.replace_extension(".xmf");
+                    auto actualXdmf = ReadFile(actualDirectory / xdmfPath.filename());
+                    auto expectedXdmf = ReadFile(xdmfPath);
+                    ASSERT_FALSE(expectedXdmf.empty()) << "the xdmf should be generated for " << entry.path();
+                    for (auto position = expectedXdmf.find(expectedDirectory.string()); position != std::string::npos; position = expectedXdmf.find(expectedDirectory.string(), position)) {
+                        expectedXdmf.replace(position, expectedDirectory.string().size(), actualDirectory.string());
+                    }
+                    ASSERT_EQ(actualXdmf, expectedXdmf) << "for " << xdmfPath;
+                }
+                ASSERT_GT(comparedFiles, 0u) << "the test should write hdf5 output";
+            }
+        }
+        PetscFinalize() >> testErrorChecker;
+        MPI_Finalize();
+        exit(0);
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Tests, Hdf5OutputTestFixture,
+    testing::Values(
+        (Hdf5OutputParameters){.mpiTestParameter = {.testName = "asynchronous", .nproc = 1, .expectedOutputFile = "", .arguments = ""},
+                               .inputPath = "inputs/compressibleFlowHdf5Output.yaml",
+                               .monitorOptions = "{asynchronous: true}"},
+        (Hdf5OutputParameters){.mpiTestParameter = {.testName = "asynchronous 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""},
+                               .inputPath = "inputs/compressibleFlowHdf5Output.yaml",
+                               .monitorOptions = "{asynchronous: true, queueSize: 1}"}),
+    [](const testing::TestParamInfo<Hdf5OutputParameters>& info) { return info.param.mpiTestParameter.getTestName(); });
+
+struct Hdf5FieldSelectionParameters {
+    testingResources::MpiTestParameter mpiTestParameter;
+    // the relative path to the yaml file
+    std::filesystem::path inputPath;
+    // the options for the reference output holding every component of the fields in double precision
+    std::string referenceOptions;
+    // the options that select the components, precision, and compression
+    std::string monitorOptions;
+    // each selected dataset and the component of the reference dataset that it holds
+    std::vector<std::tuple<std::string, std::string, hsize_t>> selectedDatasets;
+};
+
+class Hdf5FieldSelectionTestFixture : public Hdf5OutputTest, public ::testing::WithParamInterface<Hdf5FieldSelectionParameters> {
+   public:
+    void SetUp() override { SetMpiParameters(GetParam().mpiTestParameter); }
+};
+
+TEST_P(Hdf5FieldSelectionTestFixture, ShouldWriteTheSelectedComponentsReferencedByTheXdmf) {
+    StartWithMPI
+        PetscInitialize(argc, argv, NULL, help) >> testErrorChecker;
+        {
+            int rank;
+            MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+            const auto& params = GetParam();
+            const auto testName = params.mpiTestParameter.getTestName();
+            const auto referenceDirectory = std::filesystem::current_path() / (testName + "_reference");
+            const auto actualDirectory = std::filesystem::current_path() / testName;
+
+            // act
+            RunInput(params.inputPath, params.referenceOptions, referenceDirectory);
+            RunInput(params.inputPath, params.monitorOptions, actualDirectory);
+
+            // assert
+            if (rank == 0) {
+                std::size_t comparedFiles = 0;
+                for (const auto& entry : std::filesystem::directory_iterator(actualDirectory)) {
+                    if (entry.path().extension() != ".hdf5") {
+                        continue;
+                    }
+                    comparedFiles++;
+                    hid_t actualFile = H5Fopen(entry.path().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+                    hid_t referenceFile = H5Fopen((referenceDirectory / entry.path().filename()).c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+                    ASSERT_GE(actualFile, 0);
+                    ASSERT_GE(referenceFile, 0);
+
+                    // only the selected components are written
+                    std::set<std::string> expectedNames;
+                    for (const auto& selectedDataset : params.selectedDatasets) {
+                        expectedNames.insert("/fields/" + std::get<0>(selectedDataset));
+                    }
+                    const auto names = GetNames(actualFile, "/fields");
+                    ASSERT_EQ(std::set<std::string>(names.begin(), names.end()), expectedNames) << "for " << entry.path();
+
+                    for (const auto& [name, referenceName, component] : params.selectedDatasets) {
+                        // the dataset is chunked, compressed, and single precision
+                        hid_t dataset = H5Dopen2(actualFile, ("/fields/" + name).c_str(), H5P_DEFAULT);
+                        ASSERT_GE(dataset, 0) << "for " << name;
+                        hid_t type = H5Dget_type(dataset);
+                        ASSERT_EQ(H5Tget_size(type), sizeof(float)) << "for " << name;
+                        H5Tclose(type);
+                        hid_t createProperties = H5Dget_create_plist(dataset);
+                        ASSERT_EQ(H5Pget_layout(createProperties), H5D_CHUNKED) << "for " << name;
+                        ASSERT_EQ(H5Pget_nfilters(createProperties), 2) << "the shuffle and deflate filters should be applied to " << name;
+                        H5Pclose(createProperties);
+                        H5Dclose(dataset);
+
+                        // each step holds the component of the reference output
+                        std::vector<hsize_t> dims, referenceDims;
+                        const auto values = ReadDataset(actualFile, "/fields/" + name, dims);
+                        const auto referenceValues = ReadDataset(referenceFile, "/fields/" + referenceName, referenceDims);
+                        ASSERT_EQ(dims.size(), 2u) << "a single component is written without a component dimension for " << name;
+                        ASSERT_GE(referenceDims.size(), 2u) << "for " << referenceName;
+                        ASSERT_EQ(dims[0], referenceDims[0]) << "for " << name;
+                        ASSERT_EQ(dims[1], referenceDims[1]) << "for " << name;
+                        const hsize_t referenceComponents = referenceDims.size() > 2 ? referenceDims[2] : 1;
+                        ASSERT_LT(component, referenceComponents) << "for " << name;
+                        for (std::size_t i = 0; i < values.size(); ++i) {
+                            const auto referenceValue = referenceValues[i * referenceComponents + component];
+                            ASSERT_NEAR(values[i], referenceValue, 1E-6 * PetscMax(1.0, std::abs(referenceValue))) << "for value " << i << " of " << name;
+                        }
+                    }
+                    H5Fclose(referenceFile);
+
+                    // every dataset referenced by the xdmf exists, and every selected dataset is referenced
+                    auto xdmfPath = entry.path();
+                    xdmfPath.replace_extension(".xmf");
+                    const auto xdmf = ReadFile(xdmfPath);
+                    ASSERT_FALSE(xdmf.empty()) << "the xdmf should be generated for " << entry.path();
+                    std::set<std::string> referencedNames;
+                    const std::regex datasetReference(R"(([^\s<>"]+\.hdf5):(/[^\s<>"]+))");
+                    for (auto match = std::sregex_iterator(xdmf.begin(), xdmf.end(), datasetReference); match != std::sregex_iterator(); ++match) {
+                        ASSERT_EQ(std::filesystem::path((*match)[1].str()).filename(), entry.path().filename()) << "for " << match->str();
+                        const auto datasetName = (*match)[2].str();
+                        ASSERT_GT(H5Lexists(actualFile, datasetName.c_str(), H5P_DEFAULT), 0) << "the xdmf references the missing dataset " << datasetName;
+                        referencedNames.insert(datasetName);
+                    }
+                    for (const auto& name : expectedNames) {
+                        ASSERT_TRUE(referencedNames.count(name)) << "the xdmf should reference " << name;
+                    }
+                    H5Fclose(actualFile);
+                }
+                ASSERT_GT(comparedFiles, 0u) << "the test should write hdf5 output";
+            }
+        }
+        exit(PetscFinalize());
+    EndWithMPI
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Tests, Hdf5FieldSelectionTestFixture,
+    testing::Values(
+        (Hdf5FieldSelectionParameters){.mpiTestParameter = {.testName = "field selection", .nproc = 1, .expectedOutputFile = "", .arguments = ""},
+                                       .inputPath = "inputs/compressibleFlowHdf5Output.yaml",
+                                       .referenceOptions = "{fields: [euler, T]}",
+                                       .monitorOptions = "{fields: [euler.0, euler.2, T], singlePrecision: true, compression: 4}",
+                                       .selectedDatasets = {{"flowField_euler_0", "flowField_euler", 0},
+                                                            {"flowField_euler_2", "flowField_euler", 2},
+                                                            {"exact_euler_0", "exact_euler", 0},
+                                                            {"exact_euler_2", "exact_euler", 2},
+                                                            {"auxField_T", "auxField_T", 0}}},
+        (Hdf5FieldSelectionParameters){.mpiTestParameter = {.testName = "field selection 2 ranks", .nproc = 2, .expectedOutputFile = "", .arguments = ""},
+                                       .inputPath = "inputs/compressibleFlowHdf5Output.yaml",
+                                       .referenceOptions = "{fields: [euler, T]}",
+                                       .monitorOptions = "{fields: [euler.0, euler.2, T], singlePrecision: true, compression: 4}",
+                                       .selectedDatasets = {{"flowField_euler_0", "flowField_euler", 0},
+                                                            {"flowField_euler_2", "flowField_euler", 2},
+                                                            {"exact_euler_0", "exact_euler", 0},
+                                                            {"exact_euler_2", "exact_euler", 2},
+                                                            {"auxField_T", "auxField_T", 0}}}),
+    [](const testing::TestParamInfo<Hdf5FieldSelectionParameters>& info) { return info.param.mpiTestParameter.getTestName(); });